@@ -17,6 +17,7 @@ set(BASE_UNIX_AND_DARWIN_SRC
     src/unix/utilsunx.cpp
     src/unix/wakeuppipe.cpp
     src/unix/fswatcher_kqueue.cpp
+    src/unix/iouringdispatcher.cpp
 )
 
 set(BASE_UNIX_AND_DARWIN_HDR
@@ -483,6 +484,10 @@ set(BASE_CMN_SRC
     src/common/lzmastream.cpp
     src/common/uilocale.cpp
     src/common/fs_data.cpp
+    src/common/threadpool.cpp
+    src/common/evtprofiler.cpp
+    src/common/logasync.cpp
+    src/common/logbinary.cpp
 )
 
 set(BASE_AND_GUI_CMN_SRC
@@ -660,6 +665,10 @@ set(BASE_CMN_HDR
     wx/localedefs.h
     wx/uilocale.h
     wx/fs_data.h
+    wx/threadpool.h
+    wx/evtprofiler.h
+    wx/logasync.h
+    wx/logbinary.h
 )
 
 set(NET_UNIX_SRC
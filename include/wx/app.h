@@ -375,8 +375,9 @@ public:
     // the handlers with pending events
     void RemovePendingEventHandler(wxEvtHandler* toRemove);
 
-    // adds an event handler to the list of the handlers with pending events
-    void AppendPendingEventHandler(wxEvtHandler* toAppend);
+    // adds an event handler to the list of the handlers with pending events,
+    // returns true if the event loop needs to be woken up to process them
+    bool AppendPendingEventHandler(wxEvtHandler* toAppend);
 
     // moves the event handler from the list of the handlers with pending events
     //to the list of the handlers with _delayed_ pending events
@@ -544,8 +545,12 @@ protected:
     // pending events)
     wxEvtHandlerArray m_handlersWithPendingDelayedEvents;
 
+    // true if the event loop had been woken up to process the pending events
+    // since the last call to ProcessPendingEvents()
+    bool m_wakeUpRequested = false;
+
 #if wxUSE_THREADS
-    // this critical section protects both the lists above
+    // this critical section protects both the lists and the flag above
     wxCriticalSection m_handlersWithPendingEventsLocker;
 #endif
 
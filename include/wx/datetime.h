@@ -1701,6 +1701,55 @@ protected:
                                 wxDateTimeArray& holidays) const override;
 };
 
+// ----------------------------------------------------------------------------
+// wxDateTimeFormatter: formats and parses dates using the given format
+// ----------------------------------------------------------------------------
+
+// This class produces the same results as wxDateTime::Format() and
+// wxDateTime::ParseFormat(), but analyzes the format string only once and
+// then reuses the result. It also remembers the broken down time of the day
+// (or the part of it with the same UTC offset) it used last, so formatting
+// consecutive timestamps from the same day is much faster than calling
+// wxDateTime::Format() for each of them.
+//
+// Objects of this class are not thread-safe, create a separate one for each
+// thread if necessary.
+class WXDLLIMPEXP_BASE wxDateTimeFormatter
+{
+public:
+    explicit
+    wxDateTimeFormatter(const wxString& format = wxASCII_STR(wxDefaultDateTimeFormat),
+                        const wxDateTime::TimeZone& tz = wxDateTime::Local);
+    ~wxDateTimeFormatter();
+
+    // Change the format or the time zone used by Format().
+    void SetFormat(const wxString& format);
+    const wxString& GetFormat() const;
+
+    void SetTimeZone(const wxDateTime::TimeZone& tz);
+    const wxDateTime::TimeZone& GetTimeZone() const;
+
+    // Format the given date, returning a reference to the internal buffer,
+    // which remains valid until the next call to this function.
+    const wxString& Format(const wxDateTime& dt);
+
+    // Append the result of formatting the given date to the provided string.
+    void AppendFormat(wxString& str, const wxDateTime& dt);
+
+    // Parse the string, just as wxDateTime::ParseFormat() does, and store
+    // the result in the provided object.
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               wxString::const_iterator* end,
+               const wxDateTime& dateDef = wxDefaultDateTime);
+
+private:
+    struct Impl;
+    Impl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxDateTimeFormatter);
+};
+
 // ============================================================================
 // inline functions implementation
 // ============================================================================
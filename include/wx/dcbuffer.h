@@ -35,6 +35,14 @@
 // is private style and not returned by GetStyle.
 #define wxBUFFER_USES_SHARED_BUFFER 0x04
 
+// Only draws on the part of the buffer corresponding to the window update
+// region, useful with a persistent buffer bitmap in wxBufferedPaintDC
+#define wxBUFFER_UPDATE_AREA_ONLY   0x08
+
+// Uses a buffer bitmap kept for the window between paint events instead of
+// the shared one, only used by wxBufferedPaintDC
+#define wxBUFFER_PERSISTENT         0x10
+
 class WXDLLIMPEXP_CORE wxBufferedDC : public wxMemoryDC
 {
 public:
@@ -102,6 +110,17 @@ public:
     void SetStyle(int style) { m_style = style; }
     int GetStyle() const { return m_style & ~wxBUFFER_USES_SHARED_BUFFER; }
 
+    // Get the total number of pixels copied from the buffers to the
+    // underlying DCs by UnMask() since the last call to ResetPixelsBlitted().
+    static wxUint64 GetPixelsBlitted();
+    static void ResetPixelsBlitted();
+
+protected:
+    // Only blit the given part of the buffer, in buffer coordinates, in
+    // UnMask() and, if wxBUFFER_UPDATE_AREA_ONLY style is used, also restrict
+    // drawing on the buffer to it. Does nothing if the rectangle is empty.
+    void SetUpdateArea(const wxRect& rect);
+
 private:
     // common part of Init()s
     void InitCommon(wxDC *dc, int style)
@@ -130,6 +149,9 @@ private:
 
     wxSize m_area;
 
+    // the part of the buffer to blit, the entire buffer if empty
+    wxRect m_updateArea;
+
     wxDECLARE_DYNAMIC_CLASS(wxBufferedDC);
     wxDECLARE_NO_COPY_CLASS(wxBufferedDC);
 };
@@ -185,16 +207,48 @@ private:
         if (style & wxBUFFER_VIRTUAL_AREA)
             window->PrepareDC( m_paintdc );
 
+        // A newly created persistent buffer doesn't have any valid contents
+        // yet, so it must be entirely redrawn.
+        bool isNewBuffer = false;
+        if ( !(buffer && buffer->IsOk()) && (style & wxBUFFER_PERSISTENT) )
+        {
+            buffer = GetPersistentBuffer(window, &m_paintdc,
+                                         GetBufferedSize(window, style),
+                                         &isNewBuffer);
+        }
+
         if ( buffer && buffer->IsOk() )
             Init(&m_paintdc, *buffer, style);
         else
             Init(&m_paintdc, GetBufferedSize(window, style), style);
 
+        // Nothing outside of the update region is drawn by wxPaintDC anyhow,
+        // so there is no need to copy the rest of the buffer to it.
+        if ( !isNewBuffer )
+        {
+            wxRect updateRect = window->GetUpdateClientRect();
+            if ( style & wxBUFFER_VIRTUAL_AREA )
+            {
+                updateRect = wxRect
+                             (
+                                m_paintdc.DeviceToLogical(updateRect.GetPosition()),
+                                m_paintdc.DeviceToLogicalRel(updateRect.GetSize())
+                             );
+            }
+
+            SetUpdateArea(updateRect);
+        }
+
         // This class should behave similarly to wxPaintDC, which inherits the
         // font and colours of the associated window, so do it here as well.
         GetImpl()->InheritAttributes(window);
     }
 
+    // Return the buffer of the given size kept for this window, creating it
+    // if necessary, in which case isNew is set to true.
+    static wxBitmap* GetPersistentBuffer(wxWindow* window, wxDC* dc,
+                                         const wxSize& size, bool* isNew);
+
     wxPaintDC m_paintdc;
 
     wxDECLARE_ABSTRACT_CLASS(wxBufferedPaintDC);
@@ -19,6 +19,7 @@
 #include "wx/dc.h"
 
 #include <memory>
+#include <unordered_map>
 
 #define wxSVGVersion wxT("v0101")
 
@@ -33,6 +34,8 @@ enum wxSVGShapeRenderingMode
 };
 
 class WXDLLIMPEXP_FWD_BASE wxFileOutputStream;
+class WXDLLIMPEXP_FWD_BASE wxOutputStream;
+class WXDLLIMPEXP_FWD_BASE wxMemoryOutputStream;
 
 class WXDLLIMPEXP_FWD_CORE wxSVGFileDC;
 
@@ -90,6 +93,9 @@ public:
     wxSVGFileDCImpl(wxSVGFileDC* owner, const wxString& filename,
                     int width = 320, int height = 240, double dpi = 72.0,
                     const wxString& title = wxString());
+    wxSVGFileDCImpl(wxSVGFileDC* owner, wxOutputStream& stream,
+                    int width = 320, int height = 240, double dpi = 72.0,
+                    const wxString& title = wxString());
 
     virtual ~wxSVGFileDCImpl();
 
@@ -143,6 +149,8 @@ public:
 
     void SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode);
 
+    void EnableStyleClasses(bool enable);
+
 private:
     virtual bool DoGetPixel(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
                             wxColour* WXUNUSED(col)) const override
@@ -254,12 +262,50 @@ private:
 
     virtual wxSize ToDIP(const wxSize& sz) const override;
 
-    void Init(const wxString& filename, int width, int height,
-              double dpi, const wxString& title);
+    void Init(int width, int height, double dpi, const wxString& title);
+
+    // Create the buffered stream used for the output on top of the given one.
+    void InitStream(wxOutputStream& stream);
 
     void write(const wxString& s);
 
 private:
+    // Write the string to the output stream without flushing the pending path.
+    void DoWrite(const wxString& s);
+
+    // Return the stream to write the document body to, writing the header
+    // first if it hasn't been done yet and it doesn't need to be delayed.
+    wxOutputStream& PrepareOutput();
+
+    // Write the document header, including the style definitions, if any.
+    void WriteHeader();
+
+    // Write the string to the given stream as UTF-8.
+    void WriteUTF8(wxOutputStream& stream, const wxString& s);
+
+    // Kinds of the elements which can be combined into a single path.
+    enum PathKind
+    {
+        Path_Line,      // Simple line drawn by DrawLine().
+        Path_Stroke,    // Unfilled shape, e.g. polyline.
+        Path_Fill       // Filled shape without any outline.
+    };
+
+    // Prepare for appending an element of the given kind, drawn with the
+    // current pen and brush, to the pending path and return the path data to
+    // append to. EndPathData() must be called after appending to it.
+    wxString& StartPathData(PathKind kind);
+    void EndPathData();
+
+    // Return true if a filled shape could be drawn by StartPathData(Path_Fill).
+    bool CanCombineFill() const;
+
+    // Write out the pending path, if any.
+    void FlushPath();
+
+    // Return the attributes depending on the current pen and rendering mode.
+    const wxString& GetPenAttrs();
+
     // If m_graphics_changed is true, close the current <g> element and start a
     // new one for the last pen/brush change.
     void NewGraphicsIfNeeded();
@@ -273,7 +319,13 @@ private:
     bool                m_graphics_changed;  // set by Set{Brush,Pen}()
     int                 m_width, m_height;
     double              m_dpi;
+    // The stream all output goes to: it is buffered and writes to either the
+    // stream provided by the user or m_outfile, possibly via m_zstream. Notice
+    // that the order of these fields matters as they must be destroyed in the
+    // reverse order of their declaration.
     std::unique_ptr<wxFileOutputStream> m_outfile;
+    std::unique_ptr<wxOutputStream> m_zstream; // Only used for ".svgz" files.
+    std::unique_ptr<wxOutputStream> m_stream;
     std::unique_ptr<wxSVGBitmapHandler> m_bmp_handler; // class to handle bitmaps
     wxSVGShapeRenderingMode m_renderingMode;
 
@@ -288,6 +340,29 @@ private:
     // Unique ID for every gradient.
     size_t m_gradientUniqueId;
 
+    // The data of the path element which is being built from consecutive
+    // elements drawn with the same attributes, the kind of these elements and
+    // the attributes themselves, cached as they only change with the pen.
+    wxString m_pathData;
+    PathKind m_pathKind;
+    wxString m_penAttrs;
+
+    // Reusable buffer for converting the output to UTF-8.
+    wxMemoryBuffer m_utf8Buf;
+
+    // The document header, which is only written before the first element of
+    // the body, as the style definitions may need to be included into it.
+    wxString m_header;
+
+    // Map of the graphics group styles to the ID of the CSS class used for
+    // them and the definitions of these classes, only used if style classes
+    // are enabled. In this case the body of the document is accumulated in
+    // m_body and only written out, after the header containing all the style
+    // definitions, when the DC is destroyed.
+    std::unordered_map<wxString, size_t> m_styleClasses;
+    wxString m_styleDefs;
+    std::unique_ptr<wxMemoryOutputStream> m_body;
+
     wxDECLARE_ABSTRACT_CLASS(wxSVGFileDCImpl);
     wxDECLARE_NO_COPY_CLASS(wxSVGFileDCImpl);
 };
@@ -305,6 +380,15 @@ public:
     {
     }
 
+    wxSVGFileDC(wxOutputStream& stream,
+                int width = 320,
+                int height = 240,
+                double dpi = 72.0,
+                const wxString& title = wxString())
+        : wxDC(new wxSVGFileDCImpl(this, stream, width, height, dpi, title))
+    {
+    }
+
     // wxSVGFileDC-specific methods:
 
     // Use a custom bitmap handler: takes ownership of the handler.
@@ -312,6 +396,9 @@ public:
 
     void SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode);
 
+    // Use CSS classes instead of inline styles for the graphics groups.
+    void EnableStyleClasses(bool enable = true);
+
 private:
     wxDECLARE_ABSTRACT_CLASS(wxSVGFileDC);
 };
@@ -959,6 +959,17 @@ enum wxEventCategory
         wxEVT_CATEGORY_CLIPBOARD
 };
 
+// Priority of the events queued for later processing using QueueEvent():
+// pending events of the same handler are processed in the order of decreasing
+// priority and, for the events with the same priority, in the order in which
+// they were queued.
+enum wxEventQueuePriority
+{
+    wxEVENT_QUEUE_PRIORITY_LOW = -1,
+    wxEVENT_QUEUE_PRIORITY_NORMAL = 0,
+    wxEVENT_QUEUE_PRIORITY_HIGH = 1
+};
+
 /*
  * wxWidgets events, covering all interesting things that might happen
  * (button clicking, resizing, setting text in widgets, etc.).
@@ -1010,6 +1021,18 @@ public:
     virtual wxEventCategory GetEventCategory() const
         { return wxEVT_CATEGORY_UI; }
 
+    // If the coalescing key is non-zero, queuing this event replaces any
+    // still pending event of the same type with the same key instead of
+    // adding a new one to the queue.
+    void SetCoalescingKey(wxUIntPtr key) { m_coalescingKey = key; }
+    wxUIntPtr GetCoalescingKey() const { return m_coalescingKey; }
+
+    // Priority determines the position of this event among the other pending
+    // events of the same handler when it is queued.
+    void SetQueuePriority(wxEventQueuePriority priority)
+        { m_queuePriority = priority; }
+    wxEventQueuePriority GetQueuePriority() const { return m_queuePriority; }
+
     // Implementation only: this test is explicitly anti OO and this function
     // exists only for optimization purposes.
     bool IsCommandEvent() const { return m_isCommandEvent; }
@@ -1111,6 +1134,10 @@ protected:
     // only set by wxPropagateOnce.
     wxEvtHandler*     m_propagatedFrom;
 
+    // These fields are only used by wxEvtHandler::QueueEvent().
+    wxUIntPtr            m_coalescingKey;
+    wxEventQueuePriority m_queuePriority;
+
     bool              m_skipped;
     bool              m_isCommandEvent;
 
@@ -3816,6 +3843,20 @@ public:
         QueueEvent(new wxAsyncMethodCallEventFunctor<T>(this, fn));
     }
 
+    // Same as CallAfter() with a functor, but replaces the call previously
+    // scheduled with the same non-zero key if it's still pending instead of
+    // scheduling another one.
+    template <typename T>
+    void CallAfterCoalesced(wxUIntPtr key,
+                            const T& fn,
+                            wxEventQueuePriority priority = wxEVENT_QUEUE_PRIORITY_NORMAL)
+    {
+        wxEvent* const event = new wxAsyncMethodCallEventFunctor<T>(this, fn);
+        event->SetCoalescingKey(key);
+        event->SetQueuePriority(priority);
+        QueueEvent(event);
+    }
+
 
     // Connecting and disconnecting
     // ----------------------------
@@ -4068,7 +4109,15 @@ protected:
     typedef wxVector<wxDynamicEventTableEntry*> DynamicEvents;
     DynamicEvents* m_dynamicEvents;
 
-    wxList*             m_pendingEvents;
+    // Index of m_dynamicEvents by event type, only created when there are
+    // many dynamic event handlers to avoid iterating over all of them when
+    // searching for the handler of an event.
+    class DynamicEventsIndex;
+    DynamicEventsIndex* m_dynamicEventsIndex;
+
+    // Queue of the events waiting to be processed, see QueueEvent().
+    class PendingEvents;
+    PendingEvents*      m_pendingEvents;
 
 #if wxUSE_THREADS
     // critical section protecting m_pendingEvents
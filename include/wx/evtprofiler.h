@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/evtprofiler.h
+// Purpose:     wxEventProfiler class for measuring event processing costs
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_EVTPROFILER_H_
+#define _WX_EVTPROFILER_H_
+
+#include "wx/event.h"
+#include "wx/longlong.h"
+
+#include <atomic>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// wxEventProfiler: collects statistics about the events processing
+// ----------------------------------------------------------------------------
+
+// This class only has static members as there is a single global profiler.
+// It is disabled by default and doesn't have any noticeable overhead then.
+//
+// All times are in microseconds and the timestamps are relative to the time
+// when profiling was enabled.
+class WXDLLIMPEXP_BASE wxEventProfiler
+{
+public:
+    // Statistics about all the handler calls for the events of some type.
+    struct EventTypeStats
+    {
+        EventTypeStats() : type(wxEVT_NULL), count(0) { }
+
+        wxEventType type;
+        wxString eventClass;
+        unsigned long count;
+        wxLongLong totalTime;
+        wxLongLong maxTime;
+    };
+
+    // Information about a single handler call.
+    struct HandlerCall
+    {
+        HandlerCall() : type(wxEVT_NULL) { }
+
+        wxEventType type;
+        wxString eventClass;
+        wxString handlerClass;
+        wxString functorClass;
+        wxLongLong start;
+        wxLongLong duration;
+    };
+
+    // Statistics about the idle processing: only the time spent in the idle
+    // events handlers is counted.
+    struct IdleStats
+    {
+        IdleStats() : count(0) { }
+
+        unsigned long count;
+        wxLongLong totalTime;
+        wxLongLong maxTime;
+    };
+
+    // Number of the events in the queue of an event handler taken when it
+    // starts processing the next one of them.
+    struct PendingSample
+    {
+        PendingSample() : events(0) { }
+
+        wxLongLong time;
+        size_t events;
+    };
+
+
+    // Enable or disable profiling: enabling it resets all the data collected
+    // previously, while disabling it keeps the data which can be retrieved
+    // using the functions below.
+    static void Enable(bool enable = true);
+    static bool IsEnabled() { return ms_enabled.load(std::memory_order_relaxed); }
+
+    // Forget all the data collected so far.
+    static void Reset();
+
+    // Set the maximal number of the trace records (handler calls, idle and
+    // pending events processing and pending queue samples) kept for
+    // GetChromeTrace(): once it is reached, the statistics are still updated
+    // but no more records are added. The default is 100000.
+    static void SetMaxTraceRecords(size_t count);
+
+    // Set the number of the slowest handler calls kept, 20 by default.
+    static void SetSlowestHandlersCount(size_t count);
+
+
+    // Get the statistics for all event types for which any handlers were
+    // called, sorted by the total time in decreasing order.
+    static std::vector<EventTypeStats> GetEventTypeStats();
+
+    // Get the slowest handler calls, sorted by decreasing duration.
+    static std::vector<HandlerCall> GetSlowestHandlers();
+
+    // Get the idle processing statistics.
+    static IdleStats GetIdleStats();
+
+    // Get all the samples of the pending events queues depth.
+    static std::vector<PendingSample> GetPendingSamples();
+
+    // Get all the collected records in Chrome trace event format, which can
+    // be loaded into chrome://tracing or Perfetto UI.
+    static wxString GetChromeTrace();
+
+    // Save the result of GetChromeTrace() to the given file.
+    static bool SaveChromeTrace(const wxString& filename);
+
+private:
+    // This flag is checked without locking before every handler call.
+    static std::atomic<bool> ms_enabled;
+
+    wxDECLARE_NO_COPY_CLASS(wxEventProfiler);
+};
+
+#endif // _WX_EVTPROFILER_H_
@@ -20,6 +20,8 @@
 #include "wx/cmndata.h"
 #include "wx/strvararg.h"
 
+class WXDLLIMPEXP_FWD_BASE wxOutputStream;
+
 //-----------------------------------------------------------------------------
 // wxPostScriptDC
 //-----------------------------------------------------------------------------
@@ -33,6 +35,12 @@ public:
     // Recommended constructor
     wxPostScriptDC(const wxPrintData& printData);
 
+    // Set the PostScript language level of the output, either 2 (default) or
+    // 3, which allows compressing the bitmaps. Must be called before
+    // StartDoc().
+    void SetLanguageLevel(int level);
+    int GetLanguageLevel() const;
+
 private:
     wxDECLARE_DYNAMIC_CLASS(wxPostScriptDC);
 };
@@ -89,6 +97,9 @@ public:
     void SetPrintData(const wxPrintData& data);
     wxPrintData& GetPrintData() { return m_printData; }
 
+    void SetLanguageLevel(int level);
+    int GetLanguageLevel() const { return m_languageLevel; }
+
     virtual int GetDepth() const override { return 24; }
 
     void PsPrint( const wxString& psdata );
@@ -148,8 +159,15 @@ protected:
     void SetPSFont();
     // Set PostScript color
     void SetPSColour(const wxColour& col);
+    // Forget the graphics state we think the interpreter is in, this must be
+    // called whenever it may have been changed behind our back, e.g. after
+    // "grestore" or at the page boundary.
+    void InvalidatePSState();
+    // Write raw data to the output file or stream.
+    void PsWrite(const char* data, size_t len);
 
     FILE*             m_pstream;    // PostScript output stream
+    wxOutputStream*   m_outputStream; // Output stream in wxPRINT_MODE_STREAM
     unsigned char     m_currentRed;
     unsigned char     m_currentGreen;
     unsigned char     m_currentBlue;
@@ -161,6 +179,15 @@ protected:
     double            m_pageHeight;
     wxArrayString     m_definedPSFonts;
     bool              m_isFontChanged;
+    int               m_languageLevel;  // 2 or 3, see SetLanguageLevel()
+
+    // The values of the graphics state parameters last emitted, reset by
+    // InvalidatePSState() to force emitting them again.
+    bool              m_psColourValid;  // m_currentRed &c are valid
+    double            m_psLineWidth;
+    wxString          m_psDash;
+    wxPenCap          m_psLineCap;
+    wxPenJoin         m_psLineJoin;
 
 private:
     wxDECLARE_DYNAMIC_CLASS(wxPostScriptDCImpl);
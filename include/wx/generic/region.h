@@ -39,6 +39,7 @@ protected:
     virtual bool DoOffset(wxCoord x, wxCoord y);
     virtual bool DoUnionWithRect(const wxRect& rect);
     virtual bool DoUnionWithRegion(const wxRegion& region);
+    virtual bool DoUnionWithRects(size_t count, const wxRect* rects);
     virtual bool DoIntersect(const wxRegion& region);
     virtual bool DoSubtract(const wxRegion& region);
     virtual bool DoXor(const wxRegion& region);
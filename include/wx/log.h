@@ -411,8 +411,15 @@ public:
 
     // return the effective log level for this component, falling back to
     // parent component and to the default global log level if necessary
+    //
+    // this function doesn't lock anything nor allocate memory, so it is cheap
+    // to call, especially if no component levels were set at all
     static wxLogLevel GetComponentLevel(const wxString& component);
 
+    // overload for ASCII component names, such as wxLOG_COMPONENT, avoiding
+    // the construction of a wxString
+    static wxLogLevel GetComponentLevel(const char* component);
+
 
     // is logging of messages from this component enabled at this level?
     //
@@ -422,6 +429,11 @@ public:
         return IsEnabled() && level <= GetComponentLevel(component);
     }
 
+    static bool IsLevelEnabled(wxLogLevel level, const char* component)
+    {
+        return IsEnabled() && level <= GetComponentLevel(component);
+    }
+
 
     // enable/disable messages at wxLOG_Verbose level (only relevant if the
     // current log level is greater or equal to it)
@@ -496,8 +508,13 @@ public:
     static const wxArrayString& GetTraceMasks();
 
     // is this trace mask in the list?
+    //
+    // as GetComponentLevel(), this function is lock-free and doesn't allocate
     static bool IsAllowedTraceMask(const wxString& mask);
 
+    // overload avoiding the construction of a wxString for the mask
+    static bool IsAllowedTraceMask(const char* mask);
+
 
     // log formatting
     // -----------------
@@ -602,6 +619,16 @@ protected:
     // this one as the default implementation of it simply asserts
     virtual void DoLogText(const wxString& msg);
 
+#if wxUSE_THREADS
+    // override this to return true if the messages logged from the threads
+    // other than main can be passed to this log target directly, i.e. if its
+    // DoLogRecord() is thread-safe, instead of being buffered until they are
+    // flushed from the main thread
+    //
+    // notice that repetition counting is not used for such messages
+    virtual bool CanLogFromAnyThread() const { return false; }
+#endif // wxUSE_THREADS
+
     // log a message indicating the number of times the previous message was
     // repeated if previous repetition counter is strictly positive, does
     // nothing otherwise; return the old value of repetition counter
@@ -633,6 +660,13 @@ private:
                       const wxString& msg,
                       const wxLogRecordInfo& info);
 
+    // called by CallDoLogNow() after handling repetition counting: adds the
+    // extra information stored in the record info to the message and passes
+    // it to DoLogRecord()
+    void DoLogWithExtras(wxLogLevel level,
+                         const wxString& msg,
+                         const wxLogRecordInfo& info);
+
 
     // variables
     // ----------------
@@ -941,7 +975,7 @@ public:
     {
         // remember that fatal errors can't be disabled
         if ( m_level == wxLOG_FatalError ||
-                wxLog::IsLevelEnabled(m_level, wxASCII_STR(m_info.component)) )
+                wxLog::IsLevelEnabled(m_level, m_info.component) )
             DoCallOnLog(wxString::FormatV(format, argptr));
     }
 
@@ -1031,7 +1065,7 @@ public:
     template <typename... Targs>
     void LogAtLevel(wxLogLevel level, const wxString& format, Targs... args)
     {
-        if ( !wxLog::IsLevelEnabled(level, wxASCII_STR(m_info.component)) )
+        if ( !wxLog::IsLevelEnabled(level, m_info.component) )
             return;
 
         DoCallOnLog(level, wxString::Format(format, args...));
@@ -1051,6 +1085,21 @@ public:
         DoCallOnLog(wxString::Format(format, args...));
     }
 
+#ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
+    // overload for the most common case of a string literal mask, which
+    // allows to avoid creating a wxString from it unless it's really needed
+    template <typename... Targs>
+    void LogTrace(const char* mask, const wxString& format, Targs... args)
+    {
+        if ( !wxLog::IsAllowedTraceMask(mask) )
+            return;
+
+        Store(wxLOG_KEY_TRACE_MASK, wxString(mask));
+
+        DoCallOnLog(wxString::Format(format, args...));
+    }
+#endif // !wxNO_IMPLICIT_WXSTRING_ENCODING
+
 private:
     void DoCallOnLog(wxLogLevel level, const wxString& msg)
     {
@@ -1148,7 +1197,7 @@ WXDLLIMPEXP_BASE wxString wxSysErrorMsgStr(unsigned long nErrCode = 0);
 
 // Macro evaluating to true if logging at the given level is enabled.
 #define wxLOG_IS_ENABLED(level) \
-    wxLog::IsLevelEnabled(wxLOG_##level, wxASCII_STR(wxLOG_COMPONENT))
+    wxLog::IsLevelEnabled(wxLOG_##level, wxLOG_COMPONENT)
 
 // Macro used to define most of the actual wxLogXXX() macros: just calls
 // wxLogger::Log(), if logging at the specified level is enabled.
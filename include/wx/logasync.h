@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logasync.h
+// Purpose:     wxLogAsync class writing log messages in a background thread
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_LOGASYNC_H_
+#define _WX_LOGASYNC_H_
+
+#include "wx/log.h"
+
+#if wxUSE_LOG && wxUSE_THREADS
+
+#include "wx/msgqueue.h"
+
+class wxLogAsyncImpl;
+
+// ----------------------------------------------------------------------------
+// wxLogAsync: log target writing messages to a FILE from a background thread
+// ----------------------------------------------------------------------------
+
+// Unlike the other log targets, this one can be used from any thread directly,
+// without the messages logged from the background threads being buffered until
+// they are flushed from the main thread. Each thread logging messages puts
+// them into its own lock-free queue and they are formatted and written, in
+// batches, by a dedicated writer thread.
+//
+// Notice that the formatter must not be changed while this target is in use.
+class WXDLLIMPEXP_BASE wxLogAsync : public wxLog
+{
+public:
+    // Log to the given file, stderr by default, using per-thread queues of the
+    // given size and handling the queue overflow as specified, with
+    // wxMSGQUEUE_OVERFLOW_FAIL meaning that the new messages are discarded.
+    explicit wxLogAsync(FILE *fp = nullptr,
+                        size_t queueSize = 1024,
+                        wxMessageQueueOverflow overflow = wxMSGQUEUE_OVERFLOW_BLOCK,
+                        const wxMBConv& conv = wxConvWhateverWorks);
+
+    // Write all the pending messages and stop the writer thread.
+    virtual ~wxLogAsync();
+
+    // Wake up the writer thread to write all the pending messages, but don't
+    // wait for it to do it.
+    virtual void Flush() override;
+
+    // Wait until all the messages logged by this thread before calling this
+    // function are written.
+    void FlushAndWait();
+
+    // Wait until all the messages logged before calling this function are
+    // written by all existing wxLogAsync objects. This is called by wxAbort()
+    // and on program exit.
+    static void FlushAll();
+
+    // Return the number of messages discarded due to the queue overflow.
+    size_t GetDroppedCount() const;
+
+protected:
+    virtual bool CanLogFromAnyThread() const override { return true; }
+
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) override;
+
+    virtual void DoLogTextAtLevel(wxLogLevel level,
+                                  const wxString& msg) override;
+
+private:
+    // Called by the writer thread to format the record using wxLogFormatter.
+    void FormatRecord(wxLogLevel level,
+                      const wxString& msg,
+                      const wxLogRecordInfo& info);
+
+    wxLogAsyncImpl* const m_impl;
+
+    friend class wxLogAsyncImpl;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsync);
+};
+
+#endif // wxUSE_LOG && wxUSE_THREADS
+
+#endif // _WX_LOGASYNC_H_
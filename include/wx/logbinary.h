@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logbinary.h
+// Purpose:     wxLogBinary class writing log records in binary format
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_LOGBINARY_H_
+#define _WX_LOGBINARY_H_
+
+#include "wx/log.h"
+
+#if wxUSE_LOG
+
+#include <vector>
+
+class wxLogBinaryImpl;
+
+// ----------------------------------------------------------------------------
+// wxLogBinary: log target writing compact binary records to a mapped file
+// ----------------------------------------------------------------------------
+
+// The records written by this target preserve all the information from
+// wxLogRecordInfo instead of formatting it as text. The file, function and
+// component names are written only once per file and referenced by their
+// index afterwards. The file is mapped into memory, so the records written to
+// it are not lost even if the program crashes.
+//
+// This target can be used from any thread and the records can be read back
+// using wxLogBinaryReader, e.g. by the logdump utility.
+class WXDLLIMPEXP_BASE wxLogBinary : public wxLog
+{
+public:
+    // Create or truncate the given file and write the log records to it.
+    explicit wxLogBinary(const wxString& filename);
+
+    // Truncate the file to the size of the data actually written and close it.
+    virtual ~wxLogBinary();
+
+    // Return true if the file was opened successfully.
+    bool IsOk() const;
+
+protected:
+#if wxUSE_THREADS
+    virtual bool CanLogFromAnyThread() const override { return true; }
+#endif // wxUSE_THREADS
+
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) override;
+
+private:
+    wxLogBinaryImpl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogBinary);
+};
+
+// ----------------------------------------------------------------------------
+// wxLogBinaryRecord: a record read from a file written by wxLogBinary
+// ----------------------------------------------------------------------------
+
+struct wxLogBinaryRecord
+{
+    wxLogLevel level = 0;
+    wxString msg;
+
+    wxLongLong_t timestampMS = 0;
+    wxULongLong_t threadId = 0;
+
+    wxString filename;
+    int line = 0;
+    wxString func;
+    wxString component;
+};
+
+// ----------------------------------------------------------------------------
+// wxLogBinaryReader: read the records from a file written by wxLogBinary
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLogBinaryReader
+{
+public:
+    wxLogBinaryReader() = default;
+
+    // Load the given file, return false if it couldn't be read or is not in
+    // the expected format.
+    bool Open(const wxString& filename);
+
+    // Get the next record, return false if there are no more of them.
+    bool GetNext(wxLogBinaryRecord& record);
+
+    // Return true if reading stopped because of invalid data, which may be
+    // the case if the program writing the file crashed while doing it.
+    bool HasError() const { return m_error; }
+
+private:
+    bool ReadNumber(wxULongLong_t& value);
+    bool ReadString(wxString& str);
+    bool GetString(wxULongLong_t id, wxString& str) const;
+
+    std::vector<char> m_data;
+    size_t m_pos = 0;
+    bool m_error = false;
+
+    // All the strings defined so far, indexed by their ids minus 1.
+    std::vector<wxString> m_strings;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogBinaryReader);
+};
+
+#endif // wxUSE_LOG
+
+#endif // _WX_LOGBINARY_H_
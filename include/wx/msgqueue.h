@@ -21,15 +21,20 @@
 #include "wx/stopwatch.h"
 
 #include "wx/beforestd.h"
+#include <atomic>
+#include <memory>
+#include <new>
 #include <queue>
 #include <utility>
+#include <vector>
 #include "wx/afterstd.h"
 
 enum wxMessageQueueError
 {
     wxMSGQUEUE_NO_ERROR = 0, // operation completed successfully
     wxMSGQUEUE_TIMEOUT,      // no messages received before timeout expired
-    wxMSGQUEUE_MISC_ERROR    // some unexpected (and fatal) error has occurred
+    wxMSGQUEUE_MISC_ERROR,   // some unexpected (and fatal) error has occurred
+    wxMSGQUEUE_FULL          // bounded queue is full and can't block
 };
 
 // ---------------------------------------------------------------------------
@@ -180,6 +185,469 @@ private:
     std::queue<T>   m_messages;
 };
 
+// ---------------------------------------------------------------------------
+// Bounded message queue using a lock-free ring buffer.
+//
+// Unlike wxMessageQueue, this class only uses its mutex when a thread needs to
+// wait for a message or for free space in the queue, so posting and receiving
+// messages don't serialize the producers and consumers as long as the queue is
+// neither empty nor full.
+// ---------------------------------------------------------------------------
+
+// Which threads may use wxBoundedMessageQueue.
+enum wxMessageQueueKind
+{
+    wxMSGQUEUE_SPSC,    // single producer thread, single consumer thread
+    wxMSGQUEUE_MPMC     // any number of producer and consumer threads
+};
+
+// What Post() does when wxBoundedMessageQueue is full.
+enum wxMessageQueueOverflow
+{
+    wxMSGQUEUE_OVERFLOW_BLOCK,          // wait until there is free space
+    wxMSGQUEUE_OVERFLOW_DROP_OLDEST,    // discard the oldest message
+    wxMSGQUEUE_OVERFLOW_FAIL            // return wxMSGQUEUE_FULL
+};
+
+// Statistics returned by wxBoundedMessageQueue::GetStats().
+struct wxMessageQueueStats
+{
+    size_t dropped;         // discarded due to wxMSGQUEUE_OVERFLOW_DROP_OLDEST
+    size_t rejected;        // not posted due to wxMSGQUEUE_OVERFLOW_FAIL
+    size_t producerWaits;   // number of times producers had to wait
+    size_t consumerWaits;   // number of times consumers had to wait
+    size_t retries;         // number of retries due to other threads contention
+};
+
+template <typename T, wxMessageQueueKind kind = wxMSGQUEUE_MPMC>
+class wxBoundedMessageQueue
+{
+public:
+    // The type of the messages transported by this queue
+    typedef T Message;
+
+    // Create the queue which can contain at least the given number of messages
+    // (the capacity is rounded up to a power of 2).
+    explicit wxBoundedMessageQueue(size_t capacity,
+                                   wxMessageQueueOverflow overflow
+                                        = wxMSGQUEUE_OVERFLOW_BLOCK)
+        : m_overflow(overflow),
+          // Discarding the oldest message makes the producer a consumer too.
+          m_multiConsumer(kind == wxMSGQUEUE_MPMC ||
+                            overflow == wxMSGQUEUE_OVERFLOW_DROP_OLDEST),
+          m_consumers(m_mutex),
+          m_producers(m_mutex)
+    {
+        size_t size = 2;
+        while ( size < capacity )
+            size *= 2;
+
+        m_mask = size - 1;
+        m_cells.reset(new Cell[size]);
+        for ( size_t n = 0; n < size; n++ )
+            m_cells[n].seq.store(n, std::memory_order_relaxed);
+    }
+
+    ~wxBoundedMessageQueue()
+    {
+        while ( TryPop([](T&) { }) )
+            ;
+    }
+
+    // Add a message to the queue, handling the case when it's full according
+    // to the overflow policy specified in the ctor.
+    //
+    // For wxMSGQUEUE_SPSC queues, this may be called from a single thread only.
+    wxMessageQueueError Post(const Message& msg)
+    {
+        const wxMessageQueueError rc = DoPost(msg);
+        if ( rc == wxMSGQUEUE_NO_ERROR )
+            WakeUpConsumers();
+
+        return rc;
+    }
+
+    wxMessageQueueError Post(Message&& msg)
+    {
+        const wxMessageQueueError rc = DoPost(std::move(msg));
+        if ( rc == wxMSGQUEUE_NO_ERROR )
+            WakeUpConsumers();
+
+        return rc;
+    }
+
+    // Add all messages in the given range to the queue, waking up the waiting
+    // consumers only once, and return the number of messages posted, which can
+    // be less than the number of messages in the range only if the overflow
+    // policy is wxMSGQUEUE_OVERFLOW_FAIL (or in case of a fatal error).
+    template <typename InputIterator>
+    size_t PostBatch(InputIterator first, InputIterator last)
+    {
+        size_t count = 0;
+        for ( ; first != last; ++first )
+        {
+            if ( DoPost(*first) != wxMSGQUEUE_NO_ERROR )
+                break;
+
+            count++;
+        }
+
+        if ( count )
+            WakeUpConsumers();
+
+        return count;
+    }
+
+    // Wait no more than timeout milliseconds until a message becomes available
+    // or don't wait at all if timeout is 0.
+    wxMessageQueueError ReceiveTimeout(long timeout, T& msg)
+    {
+        return DoReceive(timeout,
+                         [this, &msg]()
+                         {
+                            return TryPop([&msg](T& m) { msg = std::move(m); });
+                         });
+    }
+
+    // Same as ReceiveTimeout() but waits for as long as it takes for a message
+    // to become available (so it can't return wxMSGQUEUE_TIMEOUT)
+    wxMessageQueueError Receive(T& msg)
+    {
+        return ReceiveTimeout(-1, msg);
+    }
+
+    // Wait no more than timeout milliseconds until at least one message becomes
+    // available and then append all the messages in the queue, but no more
+    // than its capacity, to the provided vector.
+    wxMessageQueueError ReceiveAllTimeout(long timeout, std::vector<T>& msgs)
+    {
+        return DoReceive(timeout,
+                         [this, &msgs]()
+                         {
+                            size_t count = 0;
+                            while ( count <= m_mask &&
+                                        TryPop([&msgs](T& m)
+                                               {
+                                                  msgs.push_back(std::move(m));
+                                               }) )
+                            {
+                                count++;
+                            }
+
+                            return count != 0;
+                         });
+    }
+
+    // Same as ReceiveAllTimeout() but without timeout.
+    wxMessageQueueError ReceiveAll(std::vector<T>& msgs)
+    {
+        return ReceiveAllTimeout(-1, msgs);
+    }
+
+    // Return the maximal number of messages in the queue.
+    size_t GetCapacity() const { return m_mask + 1; }
+
+    // Return the statistics about the queue use since its creation.
+    wxMessageQueueStats GetStats() const
+    {
+        wxMessageQueueStats stats;
+        stats.dropped = m_dropped.load(std::memory_order_relaxed);
+        stats.rejected = m_rejected.load(std::memory_order_relaxed);
+        stats.producerWaits = m_producers.waits.load(std::memory_order_relaxed);
+        stats.consumerWaits = m_consumers.waits.load(std::memory_order_relaxed);
+        stats.retries = m_retries.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // Return false only if there was a fatal error in ctor
+    bool IsOk() const
+    {
+        return m_consumers.condition.IsOk() && m_producers.condition.IsOk();
+    }
+
+private:
+    // Each cell contains a message, if its sequence number is one more than
+    // the position of the cell, or is free for the message at the position
+    // equal to its sequence number (this is D. Vyukov's bounded MPMC queue).
+    struct Cell
+    {
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char data[sizeof(T)];
+
+        T* GetMessage() { return reinterpret_cast<T*>(data); }
+    };
+
+    // Try to add a message without blocking and return false if the queue is
+    // full.
+    template <typename U>
+    bool TryPush(U&& msg)
+    {
+        size_t pos = m_pushPos.load(std::memory_order_relaxed);
+        for ( ;; )
+        {
+            Cell& cell = m_cells[pos & m_mask];
+            const size_t seq = cell.seq.load(std::memory_order_acquire);
+            const wxIntPtr diff = static_cast<wxIntPtr>(seq - pos);
+            if ( diff == 0 )
+            {
+                if ( kind == wxMSGQUEUE_SPSC )
+                {
+                    m_pushPos.store(pos + 1, std::memory_order_relaxed);
+                }
+                else if ( !m_pushPos.compare_exchange_weak
+                                     (
+                                        pos, pos + 1,
+                                        std::memory_order_relaxed
+                                     ) )
+                {
+                    m_retries.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                new (cell.GetMessage()) T(std::forward<U>(msg));
+                cell.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            if ( diff < 0 )
+                return false;
+
+            // Another producer has already taken this position.
+            m_retries.fetch_add(1, std::memory_order_relaxed);
+            pos = m_pushPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Try to remove the oldest message, passing it to the given function
+    // before destroying it, and return false if the queue is empty.
+    template <typename F>
+    bool TryPop(F consume)
+    {
+        size_t pos = m_popPos.load(std::memory_order_relaxed);
+        for ( ;; )
+        {
+            Cell& cell = m_cells[pos & m_mask];
+            const size_t seq = cell.seq.load(std::memory_order_acquire);
+            const wxIntPtr diff = static_cast<wxIntPtr>(seq - (pos + 1));
+            if ( diff == 0 )
+            {
+                if ( !m_multiConsumer )
+                {
+                    m_popPos.store(pos + 1, std::memory_order_relaxed);
+                }
+                else if ( !m_popPos.compare_exchange_weak
+                                    (
+                                        pos, pos + 1,
+                                        std::memory_order_relaxed
+                                    ) )
+                {
+                    m_retries.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                T* const msg = cell.GetMessage();
+                consume(*msg);
+                msg->~T();
+                cell.seq.store(pos + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+
+            if ( diff < 0 )
+                return false;
+
+            m_retries.fetch_add(1, std::memory_order_relaxed);
+            pos = m_popPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Threads waiting for the queue to become non-empty or non-full.
+    struct Waiters
+    {
+        explicit Waiters(wxMutex& mutex) : condition(mutex) { }
+
+        wxCondition condition;
+
+        // Number of threads waiting and not woken up yet: this is only
+        // modified while holding m_mutex, but can be read without it.
+        std::atomic<int> count{0};
+
+        // Incremented, while holding m_mutex, whenever all the waiting threads
+        // are woken up.
+        unsigned generation = 0;
+
+        // Total number of times a thread had to wait, for statistics only.
+        std::atomic<size_t> waits{0};
+    };
+
+    // Add the message handling overflow, but don't wake up the consumers.
+    template <typename U>
+    wxMessageQueueError DoPost(U&& msg)
+    {
+        for ( ;; )
+        {
+            if ( TryPush(std::forward<U>(msg)) )
+                return wxMSGQUEUE_NO_ERROR;
+
+            switch ( m_overflow )
+            {
+                case wxMSGQUEUE_OVERFLOW_BLOCK:
+                    // Consumers may be waiting for the messages we've already
+                    // posted, e.g. by PostBatch().
+                    WakeUp(m_consumers);
+
+                    return WaitUntil(-1,
+                                     [this, &msg]()
+                                     {
+                                        return TryPush(std::forward<U>(msg));
+                                     },
+                                     m_producers);
+
+                case wxMSGQUEUE_OVERFLOW_DROP_OLDEST:
+                    if ( TryPop([](T&) { }) )
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    break;
+
+                case wxMSGQUEUE_OVERFLOW_FAIL:
+                    m_rejected.fetch_add(1, std::memory_order_relaxed);
+                    return wxMSGQUEUE_FULL;
+            }
+        }
+    }
+
+    // Wait for tryReceive() to succeed and wake up the producers waiting for
+    // free space, if there can be any, after it does.
+    template <typename F>
+    wxMessageQueueError DoReceive(long timeout, F tryReceive)
+    {
+        const wxMessageQueueError rc = WaitUntil(timeout, tryReceive, m_consumers);
+        if ( rc == wxMSGQUEUE_NO_ERROR && m_overflow == wxMSGQUEUE_OVERFLOW_BLOCK )
+            WakeUpProducers();
+
+        return rc;
+    }
+
+    // Call tryOp() until it succeeds, waiting for the other side to wake us
+    // up between the calls, for no more than timeout milliseconds, if it's
+    // non-negative.
+    template <typename F>
+    wxMessageQueueError WaitUntil(long timeout, F tryOp, Waiters& waiters)
+    {
+        if ( tryOp() )
+            return wxMSGQUEUE_NO_ERROR;
+
+        wxMutexLocker locker(m_mutex);
+
+        wxCHECK( locker.IsOk(), wxMSGQUEUE_MISC_ERROR );
+
+        const wxMilliClock_t waitUntil = wxGetLocalTimeMillis() + timeout;
+        for ( ;; )
+        {
+            // Announce that we're going to wait before checking the queue
+            // once again: together with the fence in WakeUp(), this ensures
+            // that the other side either sees us waiting or we see its change.
+            waiters.count.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if ( tryOp() )
+            {
+                waiters.count.fetch_sub(1);
+                return wxMSGQUEUE_NO_ERROR;
+            }
+
+            if ( timeout == 0 )
+            {
+                waiters.count.fetch_sub(1);
+                return wxMSGQUEUE_TIMEOUT;
+            }
+
+            waiters.waits.fetch_add(1, std::memory_order_relaxed);
+
+            const unsigned generation = waiters.generation;
+            const wxCondError result = timeout < 0
+                                        ? waiters.condition.Wait()
+                                        : waiters.condition.WaitTimeout(timeout);
+
+            // If we were not woken up by WakeUp(), which resets the count, we
+            // must stop being counted ourselves.
+            if ( waiters.generation == generation )
+                waiters.count.fetch_sub(1);
+
+            if ( result == wxCOND_NO_ERROR || timeout < 0 )
+            {
+                wxCHECK( result == wxCOND_NO_ERROR, wxMSGQUEUE_MISC_ERROR );
+                continue;
+            }
+
+            wxCHECK( result == wxCOND_TIMEOUT, wxMSGQUEUE_MISC_ERROR );
+
+            const wxMilliClock_t now = wxGetLocalTimeMillis();
+
+            if ( now >= waitUntil )
+                return tryOp() ? wxMSGQUEUE_NO_ERROR : wxMSGQUEUE_TIMEOUT;
+
+            timeout = (waitUntil - now).ToLong();
+        }
+    }
+
+    // Wake up all the waiting threads, if any.
+    //
+    // Waking up all of them and resetting their count ensures that we don't
+    // lock the mutex and signal the condition again until they wait again,
+    // even if they don't get to run for some time after being woken up.
+    void WakeUp(Waiters& waiters)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ( !waiters.count.load(std::memory_order_relaxed) )
+            return;
+
+        wxMutexLocker locker(m_mutex);
+        if ( waiters.count.load(std::memory_order_relaxed) )
+        {
+            waiters.count.store(0, std::memory_order_relaxed);
+            waiters.generation++;
+            waiters.condition.Broadcast();
+        }
+    }
+
+    void WakeUpConsumers()
+    {
+        WakeUp(m_consumers);
+    }
+
+    // Notice that the producers must be woken up as soon as any space becomes
+    // available in the queue, as the consumer may be going to wait for
+    // something that the producer will only do after posting its message.
+    void WakeUpProducers()
+    {
+        WakeUp(m_producers);
+    }
+
+
+    // Producers and consumers positions are kept in different cache lines to
+    // avoid false sharing between them.
+    std::atomic<size_t> m_pushPos{0};
+    char m_padding1[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_popPos{0};
+    char m_padding2[64 - sizeof(std::atomic<size_t>)];
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+
+    const wxMessageQueueOverflow m_overflow;
+    const bool m_multiConsumer;
+
+    // Only used for waiting when the queue is empty or full.
+    wxMutex m_mutex;
+    Waiters m_consumers,
+            m_producers;
+
+    std::atomic<size_t> m_dropped{0},
+                        m_rejected{0},
+                        m_retries{0};
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS_2(wxBoundedMessageQueue, T, kind);
+};
+
 #endif // wxUSE_THREADS
 
 #endif // _WX_MSGQUEUE_H_
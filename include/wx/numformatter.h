@@ -40,6 +40,22 @@ public:
                              int precision,
                              int style = Style_WithThousandsSep);
 
+    // Format a number into the provided buffer of the given size, using the
+    // same rules as ToString(). The result is always NUL-terminated and its
+    // length, not including the terminating NUL, is returned. If the buffer
+    // is too small, nothing is written and 0 is returned.
+    static size_t ToChars(wxChar* buf, size_t size, long val,
+                          int style = Style_WithThousandsSep);
+#ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+    static size_t ToChars(wxChar* buf, size_t size, wxLongLong_t val,
+                          int style = Style_WithThousandsSep);
+#endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+    static size_t ToChars(wxChar* buf, size_t size, wxULongLong_t val,
+                          int style = Style_WithThousandsSep);
+    static size_t ToChars(wxChar* buf, size_t size, double val,
+                          int precision,
+                          int style = Style_WithThousandsSep);
+
     // Format the given number using one of the floating point formats and
     // ensure that the result uses the correct decimal separator.
     // Prefer using ToString() if possible, i.e. if format is "%g" or "%.Nf"
@@ -51,12 +67,21 @@ public:
     //
     // Return true on success and stores the result in the provided location
     // which must be a valid non-null pointer.
-    static bool FromString(wxString s, long *val);
+    static bool FromString(const wxString& s, long *val);
+#ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+    static bool FromString(const wxString& s, wxLongLong_t *val);
+#endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+    static bool FromString(const wxString& s, wxULongLong_t *val);
+    static bool FromString(const wxString& s, double *val);
+
+    // Same as FromString() but parses the given number of characters, which
+    // don't need to be NUL-terminated.
+    static bool FromChars(const wxChar* s, size_t len, long *val);
 #ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
-    static bool FromString(wxString s, wxLongLong_t *val);
+    static bool FromChars(const wxChar* s, size_t len, wxLongLong_t *val);
 #endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
-    static bool FromString(wxString s, wxULongLong_t *val);
-    static bool FromString(wxString s, double *val);
+    static bool FromChars(const wxChar* s, size_t len, wxULongLong_t *val);
+    static bool FromChars(const wxChar* s, size_t len, double *val);
 
 
     // Get the decimal separator for the current locale. It is always defined
@@ -67,22 +92,6 @@ public:
     // current locale. The value returned in sep should be only used if the
     // function returns true.
     static bool GetThousandsSeparatorIfUsed(wxChar *sep);
-
-private:
-    // Post-process the string representing an integer.
-    static wxString PostProcessIntString(wxString s, int style);
-
-    // Add the thousands separators to a string representing a number without
-    // the separators. This is used by ToString(Style_WithThousandsSep).
-    static void AddThousandsSeparators(wxString& s);
-
-    // Remove trailing zeroes and, if there is nothing left after it, the
-    // decimal separator itself from a string representing a floating point
-    // number. Also used by ToString().
-    static void RemoveTrailingZeroes(wxString& s);
-
-    // Remove all thousands separators from a string representing a number.
-    static void RemoveThousandsSeparators(wxString& s);
 };
 
 #endif // _WX_NUMFORMATTER_H_
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/evtprofiler.h
+// Purpose:     Helpers for collecting wxEventProfiler data
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_EVTPROFILER_H_
+#define _WX_PRIVATE_EVTPROFILER_H_
+
+#include "wx/evtprofiler.h"
+#include "wx/time.h"
+
+// ----------------------------------------------------------------------------
+// wxEventProfilerHandlerCall: measures the time taken by an event handler
+// ----------------------------------------------------------------------------
+
+// Everything needed to identify the handler is collected before calling it,
+// as the handler object or the functor could be destroyed by the call.
+class WXDLLIMPEXP_BASE wxEventProfilerHandlerCall
+{
+public:
+    wxEventProfilerHandlerCall(const wxEventFunctor& functor,
+                               const wxEvtHandler* handler,
+                               const wxEvent& event)
+        : m_active(wxEventProfiler::IsEnabled())
+    {
+        if ( m_active )
+            Start(functor, handler, event);
+    }
+
+    ~wxEventProfilerHandlerCall()
+    {
+        if ( m_active )
+            End();
+    }
+
+private:
+    void Start(const wxEventFunctor& functor,
+               const wxEvtHandler* handler,
+               const wxEvent& event);
+    void End();
+
+    const bool m_active;
+
+    wxEventType m_type;
+    const wxChar* m_eventClass;
+    const wxChar* m_handlerClass;
+
+    // The type names are only available when using RTTI and are mangled.
+    const char* m_handlerType;
+    const char* m_functorType;
+
+    wxLongLong m_start;
+
+    wxDECLARE_NO_COPY_CLASS(wxEventProfilerHandlerCall);
+};
+
+// ----------------------------------------------------------------------------
+// wxEventProfilerTimer: measures the time of event loop operations
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxEventProfilerTimer
+{
+public:
+    enum Kind
+    {
+        Idle,
+        Pending
+    };
+
+    explicit wxEventProfilerTimer(Kind kind)
+        : m_kind(kind),
+          m_active(wxEventProfiler::IsEnabled() && Start())
+    {
+    }
+
+    ~wxEventProfilerTimer()
+    {
+        if ( m_active )
+            End();
+    }
+
+private:
+    // Return false if this timer shouldn't record anything because it's
+    // nested inside another idle timer.
+    bool Start();
+    void End();
+
+    const Kind m_kind;
+    const bool m_active;
+    wxLongLong m_start;
+
+    // For the idle timer only: the total time spent in the idle events
+    // handlers in this thread when the timer was started, as only the time
+    // of the handlers themselves is counted as idle processing time.
+    wxLongLong m_idleHandlersTime;
+
+    wxDECLARE_NO_COPY_CLASS(wxEventProfilerTimer);
+};
+
+// Record the number of events in the queue of the handler which is about to
+// process one of them.
+WXDLLIMPEXP_BASE void wxEventProfilerSamplePending(size_t events);
+
+#endif // _WX_PRIVATE_EVTPROFILER_H_
@@ -11,6 +11,7 @@
 #define _WX_PRIVATE_FDIODISPATCHER_H_
 
 #include "wx/private/fdiohandler.h"
+#include "wx/longlong.h"
 
 #include <unordered_map>
 
@@ -20,10 +21,44 @@ enum wxFDIODispatcherEntryFlags
     wxFDIO_INPUT = 1,
     wxFDIO_OUTPUT = 2,
     wxFDIO_EXCEPTION = 4,
-    wxFDIO_ALL = wxFDIO_INPUT | wxFDIO_OUTPUT | wxFDIO_EXCEPTION
+    wxFDIO_ALL = wxFDIO_INPUT | wxFDIO_OUTPUT | wxFDIO_EXCEPTION,
+
+    // this flag can be combined with the ones above to request to be notified
+    // only when the descriptor becomes ready, and not as long as it remains
+    // ready, if supported by the dispatcher (currently only epoll-based one
+    // supports it and the others just ignore it): the handler must then read
+    // or write until getting EAGAIN, as it won't be notified again otherwise
+    wxFDIO_EDGE_TRIGGERED = 8
 };
 
-// base class for wxSelectDispatcher and wxEpollDispatcher
+// statistics collected by wxFDIODispatcher::Dispatch()
+struct wxFDIODispatcherStats
+{
+    wxFDIODispatcherStats()
+    {
+        iterations =
+        wakeups =
+        readyFDs =
+        maxReadyFDs = 0;
+    }
+
+    // number of calls to Dispatch()
+    unsigned long iterations;
+
+    // number of them that returned because some descriptors were ready
+    unsigned long wakeups;
+
+    // total number of descriptors found ready
+    unsigned long readyFDs;
+
+    // maximal number of descriptors found ready at once
+    unsigned long maxReadyFDs;
+
+    // total time spent in the handlers, in microseconds
+    wxLongLong handlersTime;
+};
+
+// base class for wxSelectDispatcher, wxEpollDispatcher and wxIOUringDispatcher
 class WXDLLIMPEXP_BASE wxFDIODispatcher
 {
 public:
@@ -59,7 +94,31 @@ public:
     // -1 if an error occurred
     virtual int Dispatch(int timeout = TIMEOUT_INFINITE) = 0;
 
+    // get the statistics collected by Dispatch() since the dispatcher creation
+    // or the last call to ResetStats()
+    const wxFDIODispatcherStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = wxFDIODispatcherStats(); }
+
     virtual ~wxFDIODispatcher() = default;
+
+protected:
+    // must be called by Dispatch() implementations after each wait
+    void UpdateStats(int readyFDs, const wxLongLong& handlersTime)
+    {
+        m_stats.iterations++;
+
+        if ( readyFDs > 0 )
+        {
+            m_stats.wakeups++;
+            m_stats.readyFDs += readyFDs;
+            if ( static_cast<unsigned long>(readyFDs) > m_stats.maxReadyFDs )
+                m_stats.maxReadyFDs = readyFDs;
+            m_stats.handlersTime += handlersTime;
+        }
+    }
+
+private:
+    wxFDIODispatcherStats m_stats;
 };
 
 //entry for wxFDIOHandlerMap
@@ -16,6 +16,19 @@
 
 #include "wx/sysopt.h"
 
+// Return false if "catch-unhandled-exceptions" system option is set to 0.
+//
+// This function is called for every event processed, so it caches the value
+// of the option instead of looking it up every time. The cached value is
+// recomputed when any option is changed using wxSystemOptions::SetOption(),
+// but not when the environment variable which can also be used to set this
+// option changes, as checking for it would be too expensive.
+#if wxUSE_EXCEPTIONS && wxUSE_SYSTEM_OPTIONS
+WXDLLIMPEXP_BASE bool wxShouldCatchUnhandledExceptions();
+#else // !(wxUSE_EXCEPTIONS && wxUSE_SYSTEM_OPTIONS)
+inline bool wxShouldCatchUnhandledExceptions() { return true; }
+#endif // wxUSE_EXCEPTIONS && wxUSE_SYSTEM_OPTIONS
+
 // General version calls the given function or function-like object and
 // executes the provided handler if an exception is thrown.
 //
@@ -26,7 +39,7 @@ inline R wxSafeCall(const T1& func, const T2& handler)
 {
     // This special option exists in order to avoid having try/catch blocks
     // around potentially throwing code.
-    if ( wxSystemOptions::IsFalse("catch-unhandled-exceptions") )
+    if ( !wxShouldCatchUnhandledExceptions() )
     {
         return func();
     }
@@ -23,6 +23,12 @@ const wxLanguageInfos& wxGetLanguageInfos();
 // Function returning hard-coded values for the "C" locale.
 wxString wxGetStdCLocaleInfo(wxLocaleInfo index, wxLocaleCategory cat);
 
+// Return the number which changes whenever the current UI locale changes.
+//
+// This can be used to check whether any information cached from the current
+// locale is still valid. It may be called from any thread.
+unsigned wxGetUILocaleGeneration();
+
 // ----------------------------------------------------------------------------
 // wxUILocaleImpl provides the implementation of public wxUILocale functions
 // ----------------------------------------------------------------------------
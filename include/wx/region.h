@@ -126,6 +126,11 @@ public:
     bool Union(const wxRegion& region)
         { return DoUnionWithRegion(region); }
 
+    // Union all the given rectangles with this region at once, which is
+    // faster than doing it for each of them individually.
+    bool Union(size_t count, const wxRect* rects)
+        { return DoUnionWithRects(count, rects); }
+
 #if wxUSE_IMAGE
     // Use the non-transparent pixels of a wxBitmap for the region to combine
     // with this region.  First version takes transparency from bitmap's mask,
@@ -170,6 +175,7 @@ protected:
 
     virtual bool DoUnionWithRect(const wxRect& rect) = 0;
     virtual bool DoUnionWithRegion(const wxRegion& region) = 0;
+    virtual bool DoUnionWithRects(size_t count, const wxRect* rects);
 
     virtual bool DoIntersect(const wxRegion& region) = 0;
     virtual bool DoSubtract(const wxRegion& region) = 0;
@@ -438,6 +438,12 @@ private:
                                  const wxMBConv& conv wxSTRING_DEFAULT_CONV_ARG)
     { return ConvertStr(str, n, conv); }
 
+  // replaces the string contents with the given C string, this is equivalent
+  // to assigning ImplStr(str, n, conv) to m_impl but is more efficient for
+  // short strings as it avoids allocating a temporary buffer for them
+  void DoAssignFromMB(const char* str, size_t n,
+                      const wxMBConv& conv wxSTRING_DEFAULT_CONV_ARG);
+
   // translates position index in wxString to/from index in underlying
   // wxStringImpl:
   static size_t PosToImpl(size_t pos) { return pos; }
@@ -469,6 +475,13 @@ private:
   static SubstrBufFromWC ImplStr(const wchar_t* str, size_t n)
     { return ConvertStr(str, n, wxMBConvUTF8()); }
 
+  void DoAssignFromMB(const char* str, size_t n,
+                      const wxMBConv& conv wxSTRING_DEFAULT_CONV_ARG)
+  {
+      SubstrBufFromMB buf(ImplStr(str, n, conv));
+      m_impl.assign(buf.data, buf.len);
+  }
+
 #if wxUSE_STRING_POS_CACHE
   // this is an extremely simple cache used by PosToImpl(): each cache element
   // contains the string it applies to and the index corresponding to the last
@@ -1204,36 +1217,30 @@ public:
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
     // ctors from char* strings:
   wxString(const char *psz)
-    : m_impl(ImplStr(psz)) {}
+    { DoAssignFromMB(psz, npos); }
 #endif // wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString(const char *psz, const wxMBConv& conv)
-    : m_impl(ImplStr(psz, conv)) {}
+    { DoAssignFromMB(psz, npos, conv); }
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString(const char *psz, size_t nLength)
     { assign(psz, nLength); }
 #endif // wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString(const char *psz, const wxMBConv& conv, size_t nLength)
-  {
-    SubstrBufFromMB str(ImplStr(psz, nLength, conv));
-    m_impl.assign(str.data, str.len);
-  }
+    { DoAssignFromMB(psz, nLength, conv); }
 
     // and unsigned char*:
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString(const unsigned char *psz)
-    : m_impl(ImplStr((const char*)psz)) {}
+    { DoAssignFromMB((const char*)psz, npos); }
 #endif // wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString(const unsigned char *psz, const wxMBConv& conv)
-    : m_impl(ImplStr((const char*)psz, conv)) {}
+    { DoAssignFromMB((const char*)psz, npos, conv); }
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString(const unsigned char *psz, size_t nLength)
     { assign((const char*)psz, nLength); }
 #endif // wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString(const unsigned char *psz, const wxMBConv& conv, size_t nLength)
-  {
-    SubstrBufFromMB str(ImplStr((const char*)psz, nLength, conv));
-    m_impl.assign(str.data, str.len);
-  }
+    { DoAssignFromMB((const char*)psz, nLength, conv); }
 
     // ctors from wchar_t* strings:
   wxString(const wchar_t *pwz)
@@ -1759,7 +1766,7 @@ public:
       { return FromUTF8Unchecked(utf8.c_str(), utf8.length()); }
 
     std::string utf8_string() const { return ToStdString(wxMBConvUTF8()); }
-    const wxScopedCharBuffer utf8_str() const { return mb_str(wxMBConvUTF8()); }
+    const wxScopedCharBuffer utf8_str() const { return AsUTF8Buf(); }
 #endif // wxUSE_UNICODE_UTF8/wxUSE_UNICODE_WCHAR
 
 // Conversion from std::string_view is the same for both of the two cases above
@@ -1891,10 +1898,7 @@ public:
   {
       wxSTRING_INVALIDATE_CACHE();
 
-      if ( psz )
-          m_impl = ImplStr(psz);
-      else
-          clear();
+      DoAssignFromMB(psz, npos);
 
       return *this;
   }
@@ -2727,7 +2731,7 @@ public:
   {
       wxSTRING_INVALIDATE_CACHE();
 
-      m_impl.assign(ImplStr(sz));
+      DoAssignFromMB(sz, npos);
 
       return *this;
   }
@@ -2747,8 +2751,7 @@ public:
   {
       wxSTRING_INVALIDATE_CACHE();
 
-      SubstrBufFromMB str(ImplStr(sz, n));
-      m_impl.assign(str.data, str.len);
+      DoAssignFromMB(sz, n);
 
       return *this;
   }
@@ -3733,6 +3736,12 @@ private:
 
   ConvertedBuffer<char> m_convertedToChar;
 
+#if wxUSE_UNICODE_WCHAR
+  // utf8_str() implementation helper: converts short strings in a single
+  // pass using a stack buffer, but always returns an owned buffer
+  wxScopedCharBuffer AsUTF8Buf() const;
+#endif // wxUSE_UNICODE_WCHAR
+
 #if wxUSE_UNICODE_UTF8
   // common wc_str() and wxCStrData::AsWChar() helper for UTF-8 builds:
   // converts the string contents into m_convertedToWChar and returns a pointer
@@ -245,6 +245,14 @@ private:
 #endif // !wxUSE_UTF8_LOCALE_ONLY
 
 private:
+    // returns the entry for this format string in the per-thread cache of
+    // converted and parsed format strings, or nullptr if it can't be cached
+    struct CacheEntry;
+    CacheEntry* GetCacheEntry() const;
+
+    // returns the cache entry with the argument types filled in, or nullptr
+    const CacheEntry* GetParsedCacheEntry() const;
+
     wxScopedCharBuffer  m_char;
     wxScopedWCharBuffer m_wchar;
 
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     wxThreadPool class for executing tasks in worker threads
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_THREADPOOL_H_
+#define _WX_THREADPOOL_H_
+
+#include "wx/thread.h"
+
+#if wxUSE_THREADS
+
+#include "wx/event.h"
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+
+class wxThreadPoolImpl;
+
+// ----------------------------------------------------------------------------
+// wxCancellationToken: allows to request the tasks to stop
+// ----------------------------------------------------------------------------
+
+// All copies of the token share the same state, so a copy of it can be passed
+// to the tasks, which should check IsCancelled() periodically and return as
+// soon as possible if it returns true, while the original is used to Cancel()
+// them.
+class wxCancellationToken
+{
+public:
+    wxCancellationToken()
+        : m_cancelled(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    void Cancel() { *m_cancelled = true; }
+
+    bool IsCancelled() const { return *m_cancelled; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: executes tasks using a fixed number of worker threads
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    // Create the pool with the given number of worker threads or, by default,
+    // with as many of them as there are CPUs.
+    explicit wxThreadPool(int numThreads = -1);
+
+    // Wait until all the queued tasks complete and stop the worker threads.
+    ~wxThreadPool();
+
+    // Return the global pool which can be shared by the entire application.
+    static wxThreadPool& Get();
+
+
+    // Return the number of worker threads.
+    int GetThreadCount() const;
+
+    // Return true if called from one of the worker threads of this pool.
+    bool IsWorkerThread() const;
+
+
+    // Queue the task for execution by one of the worker threads. If it
+    // throws, wxApp::OnUnhandledException() is called in the worker thread.
+    void Post(const std::function<void ()>& task);
+
+    // Queue the given function for execution and return the future which can
+    // be used to wait until it completes and retrieve its result.
+    template <typename F>
+    std::future<decltype(std::declval<F&>()())> Submit(F func)
+    {
+        typedef decltype(func()) R;
+
+        auto task = std::make_shared<std::packaged_task<R ()>>(std::move(func));
+        std::future<R> future = task->get_future();
+        Post([task]() { (*task)(); });
+
+        return future;
+    }
+
+    // Queue the given function for execution and call onCompletion() with the
+    // (ready) std::future<R> containing its result in the main thread, using
+    // handler->CallAfter(), once it completes.
+    template <typename F, typename C>
+    void Submit(F func, wxEvtHandler* handler, C onCompletion)
+    {
+        typedef decltype(func()) R;
+
+        auto task = std::make_shared<std::packaged_task<R ()>>(std::move(func));
+        auto future = std::make_shared<std::future<R>>(task->get_future());
+        Post([task, future, handler, onCompletion]()
+            {
+                (*task)();
+
+                handler->CallAfter([future, onCompletion]()
+                    {
+                        onCompletion(*future);
+                    });
+            });
+    }
+
+    // Call func(i) for all i in [from, to) range using both the worker
+    // threads and the calling thread, and return once all calls complete.
+    //
+    // If func() throws, the remaining indices are skipped and the exception
+    // is rethrown from this function. The second overload also skips them as
+    // soon as the token is cancelled.
+    void ParallelFor(size_t from, size_t to,
+                     const std::function<void (size_t)>& func)
+    {
+        DoParallelFor(from, to, func, nullptr);
+    }
+
+    void ParallelFor(size_t from, size_t to,
+                     const std::function<void (size_t)>& func,
+                     const wxCancellationToken& cancel)
+    {
+        DoParallelFor(from, to, func, &cancel);
+    }
+
+private:
+    void DoParallelFor(size_t from, size_t to,
+                       const std::function<void (size_t)>& func,
+                       const wxCancellationToken* cancel);
+
+    wxThreadPoolImpl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_THREADPOOL_H_
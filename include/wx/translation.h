@@ -28,7 +28,9 @@
 // compile.
 #include "wx/wxcrt.h"
 
+#include <atomic>
 #include <memory>
+#include <type_traits>
 #include <unordered_map>
 
 using wxTranslationsHashMap = std::unordered_map<wxString, wxString>;
@@ -41,11 +43,32 @@ using wxTranslationsHashMap = std::unordered_map<wxString, wxString>;
 // macros
 // ----------------------------------------------------------------------------
 
+// Caching translations of string literals requires computing their hashes at
+// compile-time, which is only possible with C++14 constexpr functions.
+#if wxCHECK_CXX_STD(201402L)
+    #define wxHAS_CACHED_TRANSLATIONS
+#endif
+
+// Predefine wxCACHE_TRANSLATIONS to make _() and wxGETTEXT_IN_CONTEXT() cache
+// the translations, this can't be done if non-literal strings may be used.
+// The caching macros can also be used explicitly, in which case xgettext needs
+// --keyword="wxGETTEXT_CACHED" --keyword="wxGETTEXT_IN_CONTEXT_CACHED:1c,2"
+// options.
+#if defined(wxCACHE_TRANSLATIONS) && \
+    defined(wxHAS_CACHED_TRANSLATIONS) && \
+    !defined(wxNO_REQUIRE_LITERAL_MSGIDS)
+    #define wxUSE_CACHED_GETTEXT_MACROS
+#endif
+
 // gettext() style macros (notice that xgettext should be invoked with
 // --keyword="_" --keyword="wxPLURAL:1,2" options
 // to extract the strings from the sources)
 #ifndef WXINTL_NO_GETTEXT_MACRO
-    #define _(s)                               wxUnderscoreWrapper((s))
+    #ifdef wxUSE_CACHED_GETTEXT_MACROS
+        #define _(s)                           wxGETTEXT_CACHED(s)
+    #else
+        #define _(s)                           wxUnderscoreWrapper((s))
+    #endif
 #endif
 
 #define wxPLURAL(sing, plur, n)                wxPluralWrapper((sing), (plur), n)
@@ -54,8 +77,13 @@ using wxTranslationsHashMap = std::unordered_map<wxString, wxString>;
 // them, you need to also add
 // --keyword="wxGETTEXT_IN_CONTEXT:1c,2" --keyword="wxGETTEXT_IN_CONTEXT_PLURAL:1c,2,3"
 // options to xgettext invocation.
-#define wxGETTEXT_IN_CONTEXT(c, s) \
-    wxGettextInContextWrapper((c), (s))
+#ifdef wxUSE_CACHED_GETTEXT_MACROS
+    #define wxGETTEXT_IN_CONTEXT(c, s) \
+        wxGETTEXT_IN_CONTEXT_CACHED(c, s)
+#else
+    #define wxGETTEXT_IN_CONTEXT(c, s) \
+        wxGettextInContextWrapper((c), (s))
+#endif
 #define wxGETTEXT_IN_CONTEXT_PLURAL(c, sing, plur, n) \
     wxGettextInContextPluralWrapper((c), (sing), (plur), (n))
 
@@ -76,6 +104,7 @@ class WXDLLIMPEXP_FWD_BASE wxArrayString;
 class WXDLLIMPEXP_FWD_BASE wxTranslationsLoader;
 class WXDLLIMPEXP_FWD_BASE wxLocale;
 
+class wxMsgCatalogFile;
 class wxPluralFormsCalculator;
 using wxPluralFormsCalculatorPtr = std::unique_ptr<wxPluralFormsCalculator>;
 
@@ -98,6 +127,12 @@ public:
     static wxMsgCatalog *CreateFromData(const wxScopedCharBuffer& data,
                                         const wxString& domain);
 
+    // this overload doesn't copy the data, which must remain valid for as
+    // long as the catalog exists
+    static wxMsgCatalog *CreateFromData(const void* data,
+                                        size_t size,
+                                        const wxString& domain);
+
     // get name of the catalog
     wxString GetDomain() const { return m_domain; }
 
@@ -108,11 +143,22 @@ protected:
     wxMsgCatalog(const wxString& domain);
 
 private:
+    // common part of both CreateFromData() overloads, uses the data directly
+    static wxMsgCatalog *DoCreateFromData(const wxScopedCharBuffer& data,
+                                          const wxString& domain);
+
+    // get the translation of the string in the given context using the hash
+    // of the key computed at compile-time by wxGetTranslationHash()
+    const wxString *GetStringWithHash(const wxString& sz,
+                                      const wxString& ct,
+                                      wxUint32 hash) const;
+
     // variable pointing to the next element in a linked list (or nullptr)
     wxMsgCatalog *m_pNext;
     friend class wxTranslations;
 
-    wxTranslationsHashMap   m_messages; // all messages in the catalog
+    // the catalog data, which is accessed directly without copying it
+    std::unique_ptr<wxMsgCatalogFile> m_file;
     wxString                m_domain;   // name of the domain
 
     wxPluralFormsCalculatorPtr m_pluralFormsCalculator;
@@ -206,6 +252,23 @@ private:
 
     wxString DoGetBestAvailableTranslation(const wxString& domain, const wxString& additionalAvailableLanguage);
 
+    // used by wxCachedTranslation: get the translation of the string in the
+    // given context in any domain using the precomputed hash of its key
+    const wxString *GetCachedTranslation(const wxString& origString,
+                                         const wxString& context,
+                                         wxUint32 hash) const;
+
+    // the generation is incremented whenever the result of the translation
+    // may change, e.g. because the language changed or a catalog was added
+    static unsigned GetGeneration()
+        { return ms_generation.load(std::memory_order_acquire); }
+    static void IncGeneration()
+        { ms_generation.fetch_add(1, std::memory_order_acq_rel); }
+
+    static std::atomic<unsigned> ms_generation;
+
+    friend class wxCachedTranslation;
+
 private:
     wxString m_lang;
     wxTranslationsLoader *m_loader;
@@ -348,6 +411,126 @@ inline wxString wxTRANS_INPUT_STR(const wchar_t* s)
     #define wxTRANS_INPUT_STR(s) s
 #endif // wxNO_IMPLICIT_WXSTRING_ENCODING
 
+// Translation of a single string literal, only used by
+// wxGETTEXT_CACHED() and wxGETTEXT_IN_CONTEXT_CACHED() macros.
+class WXDLLIMPEXP_BASE wxCachedTranslation
+{
+public:
+    wxCachedTranslation(const wxString& context,
+                        const wxString& msg,
+                        wxUint32 hash)
+        : m_context(context),
+          m_msg(msg),
+          m_hash(hash)
+    {
+    }
+
+    // Return the translation, only looking it up if it's not cached yet or
+    // the translations changed since it was done.
+    const wxString& Get()
+    {
+        // Notice that the translation may have been stored by an Update()
+        // done after the one which stored the generation, but it is then for
+        // the same or a newer generation as Update() calls are serialized, so
+        // it's still up to date.
+        if ( m_generation.load(std::memory_order_acquire) ==
+                wxTranslations::GetGeneration() )
+            return *m_translation.load(std::memory_order_acquire);
+
+        return Update();
+    }
+
+private:
+    const wxString& Update();
+
+    const wxString m_context;
+    const wxString m_msg;
+    const wxUint32 m_hash;
+
+    std::atomic<const wxString*> m_translation{nullptr};
+
+    // The generation of translations corresponding to m_translation, 0
+    // initially, which never matches the current generation.
+    std::atomic<unsigned> m_generation{0};
+
+    wxDECLARE_NO_COPY_CLASS(wxCachedTranslation);
+};
+
+#ifdef wxHAS_CACHED_TRANSLATIONS
+
+// Compute the hash of the string as used by the hash table in the message
+// catalogs. This is done at compile-time for the literals translated using
+// wxGETTEXT_CACHED() and wxGETTEXT_IN_CONTEXT_CACHED(), the hash is only used
+// for the keys containing only ASCII characters as it doesn't depend on the
+// encoding of the catalog in this case.
+template <typename T>
+constexpr wxUint32 wxDoGetTranslationHash(wxUint32 hval, const T* str)
+{
+    for ( ; *str; ++str )
+    {
+        hval = (hval << 4) + static_cast<unsigned char>(*str);
+
+        const wxUint32 g = hval & 0xf0000000;
+        hval ^= g >> 24;
+        hval ^= g;
+    }
+
+    return hval;
+}
+
+template <typename T>
+constexpr wxUint32 wxGetTranslationHash(const T* msg)
+{
+    return wxDoGetTranslationHash(0, msg);
+}
+
+template <typename T>
+constexpr wxUint32 wxGetTranslationHash(const T* ctx, const T* msg)
+{
+    // The key consists of the context and the string separated by EOT.
+    const T eot[] = { 4, 0 };
+    return wxDoGetTranslationHash(
+                wxDoGetTranslationHash(wxDoGetTranslationHash(0, ctx), eot),
+                msg);
+}
+
+// Each use of these macros has its own cache for the translation, so getting
+// it is very fast after the first time. Like the other translation macros,
+// they can only be used with string literals.
+#define wxGETTEXT_CACHED(s) \
+    ([]() -> const wxString& \
+    { \
+        static wxCachedTranslation wxCachedTranslationForThis \
+        ( \
+            wxString(), \
+            wxTRANS_INPUT_STR(s), \
+            std::integral_constant<wxUint32, wxGetTranslationHash(s)>::value \
+        ); \
+        return wxCachedTranslationForThis.Get(); \
+    }())
+
+#define wxGETTEXT_IN_CONTEXT_CACHED(c, s) \
+    ([]() -> const wxString& \
+    { \
+        static wxCachedTranslation wxCachedTranslationForThis \
+        ( \
+            wxTRANS_INPUT_STR(c), \
+            wxTRANS_INPUT_STR(s), \
+            std::integral_constant<wxUint32, wxGetTranslationHash(c, s)>::value \
+        ); \
+        return wxCachedTranslationForThis.Get(); \
+    }())
+
+#else // !wxHAS_CACHED_TRANSLATIONS
+
+// Without caching these macros are the same as the usual ones.
+#define wxGETTEXT_CACHED(s) \
+    wxUnderscoreWrapper((s))
+#define wxGETTEXT_IN_CONTEXT_CACHED(c, s) \
+    wxGettextInContextWrapper((c), (s))
+
+#endif // wxHAS_CACHED_TRANSLATIONS/!wxHAS_CACHED_TRANSLATIONS
+
 #ifndef wxNO_REQUIRE_LITERAL_MSGIDS
 
 // Wrapper functions that only accept string literals as arguments,
@@ -493,6 +676,8 @@ inline const wxString& wxGettextInContextPluralWrapper(const char *ctx,
     #define wxPLURAL(sing, plur, n)  ((n) == 1 ? (sing) : (plur))
     #define wxGETTEXT_IN_CONTEXT(c, s)                     (s)
     #define wxGETTEXT_IN_CONTEXT_PLURAL(c, sing, plur, n)  wxPLURAL(sing, plur, n)
+    #define wxGETTEXT_CACHED(s)                            _(s)
+    #define wxGETTEXT_IN_CONTEXT_CACHED(c, s)              wxGETTEXT_IN_CONTEXT(c, s)
 #endif
 
 #define wxTRANSLATE(str) str
@@ -16,6 +16,8 @@
 
 #include "wx/private/fdiodispatcher.h"
 
+#include <memory>
+
 struct epoll_event;
 
 class WXDLLIMPEXP_BASE wxEpollDispatcher : public wxFDIODispatcher
@@ -36,7 +38,17 @@ public:
     virtual bool HasPending() const override;
     virtual int Dispatch(int timeout = TIMEOUT_INFINITE) override;
 
+    // set the maximal number of ready descriptors processed by a single call
+    // to Dispatch(), the remaining ones are processed by the next call
+    void SetMaxEventsPerDispatch(int maxEvents);
+    int GetMaxEventsPerDispatch() const { return m_maxEvents; }
+
 private:
+    // events returned by the epoll_wait() call in Dispatch() and the index of
+    // the one being currently processed: there can be more than one of them if
+    // Dispatch() is reentered from one of the handlers
+    struct Batch;
+
     // ctor is private, use Create()
     wxEpollDispatcher(int epollDescriptor);
 
@@ -44,8 +56,25 @@ private:
     // given timeout
     int DoPoll(epoll_event *events, int numEvents, int timeout) const;
 
+    // common part of RegisterFD() and ModifyFD()
+    bool DoControl(int op, int fd, int flags);
+
+    // forget all the not yet processed events for the given descriptor
+    void ForgetPendingEvents(int fd);
+
 
     int m_epollDescriptor;
+
+    // the handlers of all registered descriptors and the flags they were
+    // registered with, used to dispatch the events for them
+    wxFDIOHandlerMap m_handlers;
+
+    // the buffer used for the events by the outermost Dispatch() call
+    std::unique_ptr<epoll_event[]> m_events;
+    int m_maxEvents;
+
+    // the innermost batch being currently processed, if any
+    Batch* m_batch;
 };
 
 #endif // wxUSE_EPOLL_DISPATCHER
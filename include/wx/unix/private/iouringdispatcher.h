@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/unix/private/iouringdispatcher.h
+// Purpose:     wxIOUringDispatcher class
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_IOURINGDISPATCHER_H_
+#define _WX_PRIVATE_IOURINGDISPATCHER_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_EPOLL_DISPATCHER && defined(wxHAS_IO_URING)
+
+#include "wx/private/fdiodispatcher.h"
+
+#include <memory>
+#include <unordered_map>
+
+// This dispatcher uses io_uring poll requests instead of epoll: the requests
+// re-arming the descriptors after their handlers are called are queued and
+// submitted together with waiting for the next events, so that each loop
+// iteration requires a single system call.
+class WXDLLIMPEXP_BASE wxIOUringDispatcher : public wxFDIODispatcher
+{
+public:
+    // create a new instance of this class, return nullptr if io_uring is not
+    // supported by the kernel (or disabled) or is too old to be used
+    //
+    // the caller should delete the returned pointer
+    static wxIOUringDispatcher *Create();
+
+    virtual ~wxIOUringDispatcher();
+
+    // implement base class pure virtual methods
+    virtual bool RegisterFD(int fd, wxFDIOHandler* handler, int flags = wxFDIO_ALL) override;
+    virtual bool ModifyFD(int fd, wxFDIOHandler* handler, int flags = wxFDIO_ALL) override;
+    virtual bool UnregisterFD(int fd) override;
+    virtual bool HasPending() const override;
+    virtual int Dispatch(int timeout = TIMEOUT_INFINITE) override;
+
+private:
+    // the memory shared with the kernel and the associated descriptor
+    struct Ring;
+
+    // the registered descriptor: its generation is incremented whenever it is
+    // modified, to recognize the completions of the outdated poll requests
+    struct Entry
+    {
+        wxFDIOHandler *handler;
+        int flags;
+        wxUint32 generation;
+        bool armed;
+    };
+
+    using EntriesMap = std::unordered_map<int, Entry>;
+
+    // ctor is private, use Create()
+    explicit wxIOUringDispatcher(Ring* ring);
+
+    // queue the poll request for the given entry or the request cancelling it
+    void QueuePoll(int fd, Entry& entry);
+    void QueueCancel(int fd, Entry& entry);
+
+    // return the next generation to use for a new or modified entry
+    wxUint32 GetNextGeneration();
+
+
+    std::unique_ptr<Ring> m_ring;
+
+    EntriesMap m_entries;
+
+    wxUint32 m_lastGeneration;
+
+    wxDECLARE_NO_COPY_CLASS(wxIOUringDispatcher);
+};
+
+#endif // wxUSE_EPOLL_DISPATCHER && wxHAS_IO_URING
+
+#endif // _WX_PRIVATE_IOURINGDISPATCHER_H_
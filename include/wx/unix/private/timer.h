@@ -14,7 +14,7 @@
 
 #include "wx/private/timer.h"
 
-#include <list>
+#include <vector>
 
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
@@ -45,8 +45,14 @@ public:
         m_isRunning = false;
     }
 
+    // for wxTimerScheduler only: the position of this timer in its heap
+    size_t GetHeapIndex() const { return m_heapIndex; }
+    void SetHeapIndex(size_t index) { m_heapIndex = index; }
+
 private:
     bool m_isRunning;
+
+    size_t m_heapIndex;
 };
 
 // ----------------------------------------------------------------------------
@@ -68,8 +74,8 @@ struct wxTimerSchedule
     wxUsecClock_t m_expiration;
 };
 
-// the linked list of all active timers, we keep it sorted by expiration time
-using wxTimerList = std::list<wxTimerSchedule>;
+// all active timers, organized as a binary min-heap by expiration time
+using wxTimerHeap = std::vector<wxTimerSchedule>;
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -98,6 +104,9 @@ public:
     }
 
     // adds timer which should expire at the given absolute time to the list
+    //
+    // notice that the timer may expire slightly later than requested, to allow
+    // notifying the timers expiring at nearly the same time together
     void AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration);
 
     // remove timer from the list, called automatically from timer dtor
@@ -123,12 +132,31 @@ private:
     wxTimerScheduler() = default;
     ~wxTimerScheduler() = default;
 
-    // add the given timer schedule to the list in the right place
+    // add the given timer schedule to the heap in the right place
     void DoAddTimer(const wxTimerSchedule& s);
 
+    // remove the timer at the given position from the heap
+    void DoRemoveTimer(size_t index);
+
+    // move the timer at the given position up or down the heap until the heap
+    // property is restored
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+
+    // store the schedule at the given position in the heap
+    void SetAt(size_t index, const wxTimerSchedule& s)
+    {
+        m_timers[index] = s;
+        s.m_timer->SetHeapIndex(index);
+    }
+
+
+    // the heap of all currently active timers with the earliest one first
+    wxTimerHeap m_timers;
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // the timers to notify, only used by NotifyExpired() and kept here just
+    // to avoid allocating it every time
+    std::vector<wxUnixTimerImpl *> m_toNotify;
 
     static wxTimerScheduler *ms_instance;
 };
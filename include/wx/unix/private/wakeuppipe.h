@@ -13,12 +13,20 @@
 #include "wx/unix/pipe.h"
 #include "wx/evtloopsrc.h"
 
+// Under Linux we use eventfd, which requires a single descriptor instead of
+// two for the pipe, if possible.
+#ifdef __LINUX__
+    #define wxHAS_EVENTFD
+#endif
+
 // ----------------------------------------------------------------------------
 // wxWakeUpPipe: allows to wake up the event loop by writing to it
 // ----------------------------------------------------------------------------
 
 // This class is not MT-safe, see wxWakeUpPipeMT below for a wake up pipe
 // usable from other threads.
+//
+// Notice that it doesn't necessarily use a pipe, but an eventfd, if available.
 
 class wxWakeUpPipe : public wxEventLoopSourceHandler
 {
@@ -29,6 +37,8 @@ public:
     // returned by GetReadFd(), to the code blocking on input.
     wxWakeUpPipe();
 
+    virtual ~wxWakeUpPipe();
+
     // Wake up the blocking operation involving this pipe.
     //
     // It simply writes to the write end of the pipe.
@@ -37,10 +47,16 @@ public:
     // called only from the main thread.
     void WakeUpNoLock();
 
-    // Same as WakeUp() but without locking.
-
     // Return the read end of the pipe.
-    int GetReadFd() { return m_pipe[wxPipe::Read]; }
+    int GetReadFd()
+    {
+#ifdef wxHAS_EVENTFD
+        if ( m_eventFD != wxPipe::INVALID_FD )
+            return m_eventFD;
+#endif // wxHAS_EVENTFD
+
+        return m_pipe[wxPipe::Read];
+    }
 
 
     // Implement wxEventLoopSourceHandler pure virtual methods
@@ -49,6 +65,11 @@ public:
     virtual void OnExceptionWaiting() override { }
 
 private:
+#ifdef wxHAS_EVENTFD
+    // The eventfd used instead of the pipe if it could be created.
+    int m_eventFD;
+#endif // wxHAS_EVENTFD
+
     wxPipe m_pipe;
 
     // This flag is set to true after writing to the pipe and reset to false
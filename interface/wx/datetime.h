@@ -1783,6 +1783,109 @@ protected:
                                 wxDateTimeArray& holidays) const override;
 };
 
+/**
+    @class wxDateTimeFormatter
+
+    wxDateTimeFormatter formats and parses dates using the given format string
+    and time zone.
+
+    It produces exactly the same results as wxDateTime::Format() and
+    wxDateTime::ParseFormat() but is faster when many dates are formatted or
+    parsed using the same format, e.g. when writing timestamps of log
+    records, because the format string is analyzed only once, when it is
+    used for the first time, and the result of formatting is stored in the
+    buffer reused for the subsequent calls. The broken down representation of
+    the date used last is also remembered, so formatting consecutive dates
+    falling on the same day doesn't need to convert them to the broken down
+    form at all.
+
+    Example of using this class:
+    @code
+        wxDateTimeFormatter formatter("%Y-%m-%d %H:%M:%S.%l");
+        for ( const auto& record : records )
+            file.Write(formatter.Format(record.time) + " " + record.msg + "\n");
+    @endcode
+
+    Notice that, as the objects of this class contain the cached data, they
+    can't be used from multiple threads at once, a separate object needs to be
+    used in each thread instead.
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.0
+
+    @see wxDateTime::Format(), wxDateTime::ParseFormat()
+*/
+class wxDateTimeFormatter
+{
+public:
+    /**
+        Constructor using the given format and time zone.
+
+        @param format
+            The format string, see wxDateTime::Format() for its syntax.
+        @param tz
+            The time zone used for formatting the dates, parsing always uses
+            the local time zone, as wxDateTime::ParseFormat() does.
+    */
+    explicit
+    wxDateTimeFormatter(const wxString& format = wxDefaultDateTimeFormat,
+                        const wxDateTime::TimeZone& tz = wxDateTime::Local);
+
+    /**
+        Changes the format used by this object.
+    */
+    void SetFormat(const wxString& format);
+
+    /**
+        Returns the format used by this object.
+    */
+    const wxString& GetFormat() const;
+
+    /**
+        Changes the time zone used for formatting.
+    */
+    void SetTimeZone(const wxDateTime::TimeZone& tz);
+
+    /**
+        Returns the time zone used for formatting.
+    */
+    const wxDateTime::TimeZone& GetTimeZone() const;
+
+    /**
+        Returns the string representation of the given date.
+
+        This is the same as wxDateTime::Format() called with the format and
+        time zone used by this object.
+
+        Notice that the returned reference is only valid until the next call
+        to this function, so the result must be copied if it needs to be
+        preserved.
+    */
+    const wxString& Format(const wxDateTime& dt);
+
+    /**
+        Appends the string representation of the given date to @a str.
+
+        This is similar to Format() but avoids copying the result when it's
+        a part of a bigger string.
+    */
+    void AppendFormat(wxString& str, const wxDateTime& dt);
+
+    /**
+        Parses the date using the format used by this object.
+
+        This is the same as wxDateTime::ParseFormat() called with this object
+        format, please see its documentation for the meaning of the
+        parameters and the return value.
+    */
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               wxString::const_iterator* end,
+               const wxDateTime& dateDef = wxDefaultDateTime);
+};
+
 /**
     @class wxDateSpan
 
@@ -17,6 +17,16 @@
 // is private style and not returned by GetStyle.
 #define wxBUFFER_USES_SHARED_BUFFER 0x04
 
+// Only draws on the part of the buffer corresponding to the window update
+// region, useful with a persistent buffer bitmap in wxBufferedPaintDC.
+// This style is available since wxWidgets 3.3.0.
+#define wxBUFFER_UPDATE_AREA_ONLY   0x08
+
+// Uses a buffer bitmap kept for the window between paint events instead of
+// the shared one, only used by wxBufferedPaintDC.
+// This style is available since wxWidgets 3.3.0.
+#define wxBUFFER_PERSISTENT         0x10
+
 
 /**
     @class wxBufferedDC
@@ -138,6 +148,26 @@ public:
        Get the style.
     */
     int GetStyle() const;
+
+    /**
+       Returns the total number of pixels copied from the buffers of all
+       wxBufferedDC objects to their associated DCs by UnMask().
+
+       This can be used to check how much work double buffering is doing, e.g.
+       to verify that only the update region is being repainted.
+
+       @see ResetPixelsBlitted()
+
+       @since 3.3.0
+    */
+    static wxUint64 GetPixelsBlitted();
+
+    /**
+       Resets the counter returned by GetPixelsBlitted() to 0.
+
+       @since 3.3.0
+    */
+    static void ResetPixelsBlitted();
 };
 
 
@@ -213,6 +243,21 @@ public:
         just the client area of the window is buffered, or
         wxBUFFER_VIRTUAL_AREA to indicate that the buffer bitmap covers the
         virtual area.
+
+        Only the part of the buffer corresponding to the window update region
+        is copied to the window when this object is destroyed. If
+        wxBUFFER_UPDATE_AREA_ONLY is combined with one of the styles above,
+        drawing on the buffer is also clipped to this part, which can make
+        repainting small parts of big windows much faster. This is mostly
+        useful with a persistent @a buffer kept by the window, as the rest of
+        it then retains its previous contents. This style is new since
+        wxWidgets 3.3.0.
+
+        Instead of keeping the buffer in the window, wxBUFFER_PERSISTENT style
+        can be used with the constructor not taking the buffer to let this
+        class keep a buffer for the window until it is destroyed. The buffer
+        is recreated, and hence entirely repainted, when the window size
+        changes. This style is new since wxWidgets 3.3.0 too.
     */
     wxBufferedPaintDC(wxWindow* window, wxBitmap& buffer,
                       int style = wxBUFFER_CLIENT_AREA);
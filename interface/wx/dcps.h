@@ -32,5 +32,30 @@ public:
     */
     wxPostScriptDC(const wxPrintData& printData);
 
+    /**
+        Sets the PostScript language level of the generated output.
+
+        By default, the output uses PostScript language level 2 features only
+        and can be printed by any level 2 or later interpreter. Setting the
+        level to 3 allows compressing the bitmaps, if zlib support is
+        available, which can make the output much smaller, but requires a
+        level 3 interpreter.
+
+        This function must be called before StartDoc().
+
+        @param level Either 2 or 3.
+
+        @since 3.3.0
+    */
+    void SetLanguageLevel(int level);
+
+    /**
+        Returns the PostScript language level of the generated output.
+
+        @see SetLanguageLevel()
+
+        @since 3.3.0
+    */
+    int GetLanguageLevel() const;
 };
 
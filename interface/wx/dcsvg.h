@@ -64,6 +64,28 @@ public:
     wxSVGFileDC(const wxString& filename, int width = 320, int height = 240,
                 double dpi = 72, const wxString& title = wxString());
 
+    /**
+        Initializes a wxSVGFileDC writing its output to the given stream.
+
+        This is similar to the constructor taking the file name, but writes
+        the SVG document to the provided @a stream, which must remain valid
+        for the lifetime of this object. The output is only guaranteed to be
+        completely written to the stream when this object is destroyed.
+
+        Because there is no file name to derive the names of the bitmap files
+        from, wxSVGBitmapEmbedHandler is used by default for the bitmaps drawn
+        on the DC created using this constructor.
+
+        Note that compressed SVG can be produced by passing wxZlibOutputStream
+        using @c wxZLIB_GZIP flag to this constructor. Alternatively, the
+        output is also compressed automatically when using the constructor
+        taking the file name if this name has @c .svgz extension.
+
+        @since 3.3.0
+    */
+    wxSVGFileDC(wxOutputStream& stream, int width = 320, int height = 240,
+                double dpi = 72, const wxString& title = wxString());
+
     /**
         Draws a rectangle the size of the SVG using the wxDC::SetBackground() brush.
     */
@@ -102,6 +124,28 @@ public:
     */
     void SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode);
 
+    /**
+        Use CSS classes for the drawing styles.
+
+        By default, the style corresponding to the current pen and brush is
+        specified directly in the SVG output every time it changes. If this
+        function is called, a CSS class is defined for each distinct style
+        instead and only this class is referenced by the drawing elements,
+        which results in much smaller output when the drawing code switches
+        between a few pens and brushes a lot.
+
+        The class definitions are written in the @c \<defs\> element at the
+        beginning of the document, so the rest of the document is kept in
+        memory until this object is destroyed when using this option. This
+        function must be called before drawing anything on the DC.
+
+        This is not enabled by default because some simple SVG renderers,
+        including the one used by wxBitmapBundle::FromSVG(), don't support CSS.
+
+        @since 3.3.0
+    */
+    void EnableStyleClasses(bool enable = true);
+
     /**
         Destroys the current clipping region so that none of the DC is clipped.
         Since intersections arising from sequential calls to SetClippingRegion are represented
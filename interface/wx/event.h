@@ -68,6 +68,29 @@ enum wxEventCategory
         wxEVT_CATEGORY_TIMER|wxEVT_CATEGORY_THREAD
 };
 
+/**
+    Priority of the events queued using wxEvtHandler::QueueEvent().
+
+    Pending events of the same event handler are processed in the order of
+    decreasing priority and, among the events with the same priority, in the
+    order in which they were queued.
+
+    @see wxEvent::SetQueuePriority()
+
+    @since 3.3.0
+*/
+enum wxEventQueuePriority
+{
+    /// Priority for bulk notifications which may be processed after others.
+    wxEVENT_QUEUE_PRIORITY_LOW = -1,
+
+    /// Default priority of all events.
+    wxEVENT_QUEUE_PRIORITY_NORMAL = 0,
+
+    /// Priority for events which should be processed before the others.
+    wxEVENT_QUEUE_PRIORITY_HIGH = 1
+};
+
 /**
     @class wxEvent
 
@@ -155,6 +178,24 @@ public:
     */
     virtual wxEventCategory GetEventCategory() const;
 
+    /**
+        Returns the coalescing key of this event.
+
+        @see SetCoalescingKey()
+
+        @since 3.3.0
+    */
+    wxUIntPtr GetCoalescingKey() const;
+
+    /**
+        Returns the priority used when this event is queued.
+
+        @see SetQueuePriority()
+
+        @since 3.3.0
+    */
+    wxEventQueuePriority GetQueuePriority() const;
+
     /**
         Returns the identifier associated with this event, such as a button command id.
     */
@@ -207,6 +248,34 @@ public:
     */
     void SetEventObject(wxObject* object);
 
+    /**
+        Sets the key used to coalesce this event with the other queued events.
+
+        If the key is non-zero, wxEvtHandler::QueueEvent() replaces the event
+        of the same type with the same key which is still pending for this
+        handler with this one, if any, instead of adding a new event to the
+        queue. This is useful for events such as progress notifications sent
+        by worker threads, where only the most recent one matters, and ensures
+        that the number of pending events remains bounded even if they are
+        sent faster than they can be processed.
+
+        The key is 0 by default, meaning that the event is never coalesced.
+
+        @since 3.3.0
+    */
+    void SetCoalescingKey(wxUIntPtr key);
+
+    /**
+        Sets the priority used when this event is queued.
+
+        Events with higher priority are processed before the other events
+        pending for the same handler, see ::wxEventQueuePriority. By default,
+        all events use @c wxEVENT_QUEUE_PRIORITY_NORMAL.
+
+        @since 3.3.0
+    */
+    void SetQueuePriority(wxEventQueuePriority priority);
+
     /**
         Sets the event type.
     */
@@ -450,6 +519,11 @@ public:
         if it is currently idle by calling ::wxWakeUpIdle() so there is no need
         to do it manually when using it.
 
+        The position of the event in the queue depends on its priority, see
+        wxEvent::SetQueuePriority(), and, if the event has a coalescing key,
+        it replaces the still pending event with the same key instead of being
+        added to the queue, see wxEvent::SetCoalescingKey().
+
         @since 2.9.0
 
         @param event
@@ -560,6 +634,35 @@ public:
     template<typename T>
     void CallAfter(const T& functor);
 
+    /**
+         Asynchronously call the given functor, replacing the previous call.
+
+         This function is similar to CallAfter() taking a functor, but if a
+         call scheduled with the same @a key is still pending, it is replaced
+         by this one instead of scheduling another call, so that only the last
+         one is executed. This is convenient for updating the UI from worker
+         threads without flooding the event queue:
+         @code
+         // in a worker thread
+         frame->CallAfterCoalesced(reinterpret_cast<wxUIntPtr>(this),
+                                   [frame, percent]{
+                                       frame->UpdateProgress(percent);
+                                   });
+         @endcode
+
+         @param key Non-zero key identifying the calls to coalesce.
+         @param functor The functor to call.
+         @param priority The priority of the call, see ::wxEventQueuePriority.
+
+         @see wxEvent::SetCoalescingKey()
+
+         @since 3.3.0
+     */
+    template<typename T>
+    void CallAfterCoalesced(wxUIntPtr key,
+                            const T& functor,
+                            wxEventQueuePriority priority = wxEVENT_QUEUE_PRIORITY_NORMAL);
+
     /**
         Processes an event, searching event tables and calling zero or more suitable
         event handler function(s).
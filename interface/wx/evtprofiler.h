@@ -0,0 +1,225 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/evtprofiler.h
+// Purpose:     interface of wxEventProfiler
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxEventProfiler
+
+    Collects statistics about the time spent in the event handlers and in the
+    event loop.
+
+    The profiler is disabled by default and must be enabled by calling
+    Enable() to start collecting the data. When it is disabled, it has no
+    noticeable effect on the performance.
+
+    When enabled, the profiler records:
+    - The number of calls and total and maximal duration of the handlers for
+      each event type, see GetEventTypeStats().
+    - The slowest handler calls, including the type of the event handler
+      object and of the functor used to call the handler, see
+      GetSlowestHandlers(). Note that the type names are only available when
+      RTTI is enabled.
+    - The number of events pending for an event handler whenever it processes
+      the next one of them, see GetPendingSamples().
+    - The time spent in idle events handlers, see GetIdleStats().
+
+    All this information, together with the time spent processing pending
+    events in each event loop iteration, can also be exported in Chrome trace
+    event format using GetChromeTrace() or SaveChromeTrace() and analysed
+    using chrome://tracing or Perfetto UI later, e.g.
+    @code
+    bool MyApp::OnInit()
+    {
+        if ( wxGetEnv("MYAPP_PROFILE_EVENTS", nullptr) )
+            wxEventProfiler::Enable();
+
+        ...
+    }
+
+    int MyApp::OnExit()
+    {
+        if ( wxEventProfiler::IsEnabled() )
+            wxEventProfiler::SaveChromeTrace("myapp-events.json");
+
+        ...
+    }
+    @endcode
+
+    All times are expressed in microseconds and all timestamps are relative
+    to the time when the profiler was enabled or Reset() was last called.
+
+    All functions of this class are static and may be called from any thread.
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{events}
+*/
+class wxEventProfiler
+{
+public:
+    /**
+        Statistics about all the handler calls for the events of some type.
+    */
+    struct EventTypeStats
+    {
+        /// The event type.
+        wxEventType type;
+
+        /// The name of the event class, e.g. "wxPaintEvent".
+        wxString eventClass;
+
+        /// The number of calls to the handlers for this event type.
+        unsigned long count;
+
+        /// The total time spent in the handlers for this event type.
+        wxLongLong totalTime;
+
+        /// The duration of the slowest handler call for this event type.
+        wxLongLong maxTime;
+    };
+
+    /**
+        Information about a single handler call.
+    */
+    struct HandlerCall
+    {
+        /// The event type.
+        wxEventType type;
+
+        /// The name of the event class, e.g. "wxPaintEvent".
+        wxString eventClass;
+
+        /// The type of the object which processed the event.
+        wxString handlerClass;
+
+        /// The type of the functor, identifying the bound function or method
+        /// if the handler was connected using Bind(), may be empty.
+        wxString functorClass;
+
+        /// The time when the handler was called.
+        wxLongLong start;
+
+        /// The time taken by the handler.
+        wxLongLong duration;
+    };
+
+    /**
+        Statistics about the idle events processing.
+    */
+    struct IdleStats
+    {
+        /// The number of times idle events were processed.
+        unsigned long count;
+
+        /**
+            The total time spent in idle events handlers.
+
+            Notice that only the handlers themselves are timed, i.e. anything
+            else done during idle processing, such as flushing the log
+            messages or deleting the objects scheduled for destruction, is
+            not counted.
+         */
+        wxLongLong totalTime;
+
+        /// The maximal time taken by idle events handlers during one idle
+        /// processing.
+        wxLongLong maxTime;
+    };
+
+    /**
+        The number of events pending for an event handler.
+
+        These samples are taken whenever a handler processes one of its
+        pending events.
+    */
+    struct PendingSample
+    {
+        /// The time when the sample was taken.
+        wxLongLong time;
+
+        /// The number of pending events, including the one being processed.
+        size_t events;
+    };
+
+    /**
+        Enable or disable profiling.
+
+        Enabling the profiler, if it was disabled, discards all the data
+        collected previously. Disabling it keeps the collected data, so that
+        it can still be retrieved using the other functions of this class.
+    */
+    static void Enable(bool enable = true);
+
+    /**
+        Return @true if the profiler is currently enabled.
+    */
+    static bool IsEnabled();
+
+    /**
+        Discard all the data collected so far.
+    */
+    static void Reset();
+
+    /**
+        Set the maximal number of records kept for the trace.
+
+        Each handler call, pending events processing, idle events processing
+        and pending events sample results in a record. Once their maximal
+        number is reached, the statistics are still updated, but no more
+        records are added to the trace. The default maximum is 100000.
+    */
+    static void SetMaxTraceRecords(size_t count);
+
+    /**
+        Set the number of the slowest handler calls to keep.
+
+        The default is 20.
+    */
+    static void SetSlowestHandlersCount(size_t count);
+
+    /**
+        Return the statistics for all event types for which any handlers were
+        called, sorted by the total time spent in them in decreasing order.
+    */
+    static std::vector<EventTypeStats> GetEventTypeStats();
+
+    /**
+        Return the slowest handler calls, sorted by decreasing duration.
+
+        @see SetSlowestHandlersCount()
+    */
+    static std::vector<HandlerCall> GetSlowestHandlers();
+
+    /**
+        Return the idle events processing statistics.
+    */
+    static IdleStats GetIdleStats();
+
+    /**
+        Return all the samples of the number of pending events.
+    */
+    static std::vector<PendingSample> GetPendingSamples();
+
+    /**
+        Return the collected data in Chrome trace event JSON format.
+
+        The handler calls are represented as complete events with the event
+        class as name, the event type, handler and functor types as arguments
+        and the thread calling the handler as thread ID. Pending events and
+        idle processing are represented as complete events named "pending
+        events" and "idle" and the pending events samples as counter events
+        named "pending queue".
+    */
+    static wxString GetChromeTrace();
+
+    /**
+        Save the result of GetChromeTrace() to the given file.
+
+        Returns @true if the file was written successfully.
+    */
+    static bool SaveChromeTrace(const wxString& filename);
+};
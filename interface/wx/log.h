@@ -273,10 +273,23 @@ public:
     /**
         Returns @true if the @a mask is one of allowed masks for wxLogTrace().
 
+        This function doesn't lock any mutexes nor allocate memory and so is
+        cheap to call from any thread.
+
         See also: AddTraceMask(), RemoveTraceMask()
     */
     static bool IsAllowedTraceMask(const wxString& mask);
 
+    /**
+        Overload of IsAllowedTraceMask() avoiding the creation of a wxString.
+
+        This overload is used by wxLogTrace() when it's called with a string
+        literal as mask.
+
+        @since 3.3.0
+    */
+    static bool IsAllowedTraceMask(const char* mask);
+
     /**
         Remove the @a mask from the list of allowed masks for
         wxLogTrace().
@@ -436,6 +449,37 @@ public:
      */
     static bool IsLevelEnabled(wxLogLevel level, wxString component);
 
+    /**
+        Overload of IsLevelEnabled() for ASCII component names.
+
+        This overload is used by wxLogXXX() macros with ::wxLOG_COMPONENT and,
+        unlike the overload taking wxString, doesn't allocate any memory.
+
+        @since 3.3.0
+     */
+    static bool IsLevelEnabled(wxLogLevel level, const char* component);
+
+    /**
+        Returns the effective log level for the given component.
+
+        This is the level set for this component using SetComponentLevel() or,
+        if none was set, for its nearest parent component, or the global log
+        level returned by GetLogLevel() if no levels were set for any of them.
+
+        This function doesn't lock any mutexes nor allocate memory and so is
+        cheap to call from any thread.
+
+        @since 2.9.1
+     */
+    static wxLogLevel GetComponentLevel(const wxString& component);
+
+    /**
+        Overload of GetComponentLevel() for ASCII component names.
+
+        @since 3.3.0
+     */
+    static wxLogLevel GetComponentLevel(const char* component);
+
     /**
         Sets the log level for the given component.
 
@@ -688,6 +732,26 @@ protected:
     */
     virtual void DoLogText(const wxString& msg);
 
+    /**
+        Return @true if this log target can be used from any thread.
+
+        By default, messages logged from threads other than the main one are
+        buffered and only passed to the active log target when it is flushed
+        from the main thread, unless a thread-specific log target is set with
+        SetThreadActiveTarget(). Log targets whose DoLogRecord() is thread-safe
+        can override this function to return @true, in which case the messages
+        from all threads are passed to it directly. Notice that repetition
+        counting (see SetRepetitionCounting()) is not done for the messages
+        logged from the other threads in this case.
+
+        Only available if @c wxUSE_THREADS is 1.
+
+        @see wxLogAsync
+
+        @since 3.3.0
+    */
+    virtual bool CanLogFromAnyThread() const;
+
     ///@}
 };
 
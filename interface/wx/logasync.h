@@ -0,0 +1,120 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logasync.h
+// Purpose:     interface of wxLogAsync
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxLogAsync
+
+    Log target writing the messages to a C file stream from a background
+    thread.
+
+    This log target is useful for multi-threaded programs logging many
+    messages, as it minimizes the time spent by the logging threads: each of
+    them simply puts the messages into its own lock-free queue, while
+    formatting them, using wxLogFormatter, and writing them to the file, in
+    batches, is done by a dedicated writer thread.
+
+    Unlike with the other log targets, the messages logged by the threads other
+    than the main one are written immediately, without waiting for Flush() to
+    be called from the main thread, see wxLog::CanLogFromAnyThread().
+
+    The size of the per-thread queues and what happens when a thread logs
+    messages faster than they can be written, so that its queue becomes full,
+    are specified when creating the object. By default, the logging thread
+    waits until there is space in its queue, so that no messages are lost.
+
+    All the pending messages are written when this object is destroyed, when
+    the library is cleaned up, when wxAbort() is called, e.g. after a fatal
+    error is logged, and on program exit. FlushAndWait() can also be used to
+    wait until all the pending messages are written at any moment.
+
+    Example of using this class:
+    @code
+    bool MyApp::OnInit()
+    {
+        FILE* fp = fopen("myapp.log", "a");
+        if ( fp )
+            delete wxLog::SetActiveTarget(new wxLogAsync(fp));
+
+        ...
+    }
+    @endcode
+
+    Notice that the formatter used by this log target (see wxLog::SetFormatter())
+    must not be changed while it's in use.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{logging}
+
+    @see wxLogStderr
+*/
+class wxLogAsync : public wxLog
+{
+public:
+    /**
+        Create the log target writing to the given file.
+
+        @param fp
+            The file to write the messages to, @c stderr if @NULL. This file
+            is not closed by this object.
+        @param queueSize
+            The maximal number of the messages waiting to be written for each
+            thread, rounded up to a power of 2.
+        @param overflow
+            What to do when a thread logs a message while its queue is full:
+            wait until there is space in it with wxMSGQUEUE_OVERFLOW_BLOCK,
+            discard the oldest message in the queue with
+            wxMSGQUEUE_OVERFLOW_DROP_OLDEST or discard the new message with
+            wxMSGQUEUE_OVERFLOW_FAIL.
+        @param conv
+            The conversion used for writing the messages, as for wxLogStderr.
+    */
+    explicit wxLogAsync(FILE* fp = nullptr,
+                        size_t queueSize = 1024,
+                        wxMessageQueueOverflow overflow = wxMSGQUEUE_OVERFLOW_BLOCK,
+                        const wxMBConv& conv = wxConvWhateverWorks);
+
+    /**
+        Destructor writes all the pending messages and stops the writer
+        thread.
+    */
+    virtual ~wxLogAsync();
+
+    /**
+        Wake up the writer thread to write all the pending messages.
+
+        Unlike FlushAndWait(), this function doesn't wait until they're
+        actually written.
+    */
+    virtual void Flush();
+
+    /**
+        Wait until all the messages logged by the current thread before
+        calling this function are written.
+    */
+    void FlushAndWait();
+
+    /**
+        Wait until all the messages logged before calling this function are
+        written by all the existing wxLogAsync objects.
+
+        This function is called by wxAbort() and on program exit, so it
+        usually doesn't need to be called explicitly.
+    */
+    static void FlushAll();
+
+    /**
+        Return the number of messages discarded because the queue of the
+        thread which logged them was full.
+
+        This is always 0 when using wxMSGQUEUE_OVERFLOW_BLOCK.
+    */
+    size_t GetDroppedCount() const;
+};
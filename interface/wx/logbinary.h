@@ -0,0 +1,179 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logbinary.h
+// Purpose:     interface of wxLogBinary and wxLogBinaryReader
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxLogBinary
+
+    Log target writing the log records to a file in a compact binary format.
+
+    Unlike the other log targets, this one doesn't format the log records as
+    text but preserves all the information from wxLogRecordInfo: the time
+    stamp, the id of the thread which logged the message, the source file
+    name, line and function and the log component. The names of the files,
+    functions and components are written only once per file and referenced by
+    their index in all the subsequent records, so each record takes just a few
+    bytes in addition to the message itself, which is stored in UTF-8.
+
+    The file is mapped into memory and the records are simply copied to it,
+    making logging with this target very fast. Moreover, as the data is
+    written directly into the file contents, no records are lost even if the
+    program crashes.
+
+    This log target can be used from any thread and the messages logged by the
+    threads other than the main one are written immediately, see
+    wxLog::CanLogFromAnyThread().
+
+    The files written by this class can be read using wxLogBinaryReader, e.g.
+    by the @c logdump utility included in wxWidgets distribution, which
+    allows showing only the records with the given level, component or thread.
+
+    Example of using this class:
+    @code
+    bool MyApp::OnInit()
+    {
+        wxLogBinary* const log = new wxLogBinary("myapp.wxlog");
+        if ( log->IsOk() )
+            delete wxLog::SetActiveTarget(log);
+        else
+            delete log;
+
+        ...
+    }
+    @endcode
+
+    Notice that the log formatter (see wxLog::SetFormatter()) is not used by
+    this class.
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{logging}
+
+    @see wxLogBinaryReader
+*/
+class wxLogBinary : public wxLog
+{
+public:
+    /**
+        Create the log target writing to the given file.
+
+        If the file already exists, it is overwritten.
+
+        Use IsOk() to check if the file could be created.
+    */
+    explicit wxLogBinary(const wxString& filename);
+
+    /**
+        Destructor closes the file.
+    */
+    virtual ~wxLogBinary();
+
+    /**
+        Return @true if the file was successfully created.
+    */
+    bool IsOk() const;
+};
+
+/**
+    A log record read from a file written by wxLogBinary.
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{logging}
+*/
+struct wxLogBinaryRecord
+{
+    /// The level of the message.
+    wxLogLevel level;
+
+    /// The message itself.
+    wxString msg;
+
+    /// The time of the message in milliseconds since Epoch.
+    wxLongLong_t timestampMS;
+
+    /// The id of the thread which logged the message.
+    wxULongLong_t threadId;
+
+    /// The source file name, may be empty.
+    wxString filename;
+
+    /// The source line number, may be 0.
+    int line;
+
+    /// The function name, may be empty.
+    wxString func;
+
+    /// The log component, may be empty.
+    wxString component;
+};
+
+/**
+    @class wxLogBinaryReader
+
+    Reads the log records from a file written by wxLogBinary.
+
+    Example of using this class:
+    @code
+    wxLogBinaryReader reader;
+    if ( reader.Open("myapp.wxlog") )
+    {
+        wxLogBinaryRecord record;
+        while ( reader.GetNext(record) )
+        {
+            if ( record.level <= wxLOG_Warning )
+                wxPuts(record.msg);
+        }
+
+        if ( reader.HasError() )
+            wxPuts("The log file is corrupted.");
+    }
+    @endcode
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{logging}
+
+    @see wxLogBinary
+*/
+class wxLogBinaryReader
+{
+public:
+    /**
+        Default constructor.
+
+        Open() must be called before using the other functions.
+    */
+    wxLogBinaryReader();
+
+    /**
+        Load the given file.
+
+        Returns @false, after logging an error, if the file couldn't be read
+        or was not written by wxLogBinary.
+    */
+    bool Open(const wxString& filename);
+
+    /**
+        Read the next record from the file.
+
+        Returns @false if there are no more records, either because the end
+        of the file was reached or because the file is corrupted. Use
+        HasError() to distinguish between these cases.
+    */
+    bool GetNext(wxLogBinaryRecord& record);
+
+    /**
+        Return @true if GetNext() stopped because invalid data was found.
+
+        This can happen if the file was truncated, e.g. because the disk was
+        full or the program writing it was killed while doing it.
+    */
+    bool HasError() const;
+};
@@ -26,7 +26,18 @@ enum wxMessageQueueError
     wxMSGQUEUE_TIMEOUT,
 
     /// Some unexpected (and fatal) error has occurred.
-    wxMSGQUEUE_MISC_ERROR
+    wxMSGQUEUE_MISC_ERROR,
+
+    /**
+        Indicates that the message couldn't be posted because the queue is
+        full.
+
+        This return value is only used by wxBoundedMessageQueue<>::Post() when
+        using wxMSGQUEUE_OVERFLOW_FAIL policy.
+
+        @since 3.3.0
+     */
+    wxMSGQUEUE_FULL
 };
 
 /**
@@ -119,3 +130,222 @@ public:
     wxMessageQueueError ReceiveTimeout(long timeout, T& msg);
 };
 
+
+/**
+    Threads which can use wxBoundedMessageQueue<>.
+
+    @since 3.3.0
+    @category{threading}
+ */
+enum wxMessageQueueKind
+{
+    /// Only a single thread may post messages and a single one receive them.
+    wxMSGQUEUE_SPSC,
+
+    /// Any number of threads may post and receive messages.
+    wxMSGQUEUE_MPMC
+};
+
+/**
+    Policy used by wxBoundedMessageQueue<>::Post() when the queue is full.
+
+    @since 3.3.0
+    @category{threading}
+ */
+enum wxMessageQueueOverflow
+{
+    /// Wait until a message is received and there is space in the queue.
+    wxMSGQUEUE_OVERFLOW_BLOCK,
+
+    /// Discard the oldest message in the queue to make space for the new one.
+    wxMSGQUEUE_OVERFLOW_DROP_OLDEST,
+
+    /// Don't post the message and return ::wxMSGQUEUE_FULL.
+    wxMSGQUEUE_OVERFLOW_FAIL
+};
+
+/**
+    Statistics about wxBoundedMessageQueue<> use.
+
+    All the fields are counted since the queue creation.
+
+    @since 3.3.0
+    @category{threading}
+ */
+struct wxMessageQueueStats
+{
+    /// Number of messages discarded due to ::wxMSGQUEUE_OVERFLOW_DROP_OLDEST.
+    size_t dropped;
+
+    /// Number of messages not posted due to ::wxMSGQUEUE_OVERFLOW_FAIL.
+    size_t rejected;
+
+    /// Number of times a producer had to wait for free space in the queue.
+    size_t producerWaits;
+
+    /// Number of times a consumer had to wait for a message.
+    size_t consumerWaits;
+
+    /**
+        Number of times an operation had to be retried because another thread
+        modified the queue concurrently.
+     */
+    size_t retries;
+};
+
+/**
+    wxBoundedMessageQueue is a fixed capacity message queue for passing
+    messages between threads.
+
+    This class provides the same functionality as wxMessageQueue<>, but stores
+    the messages in a ring buffer of fixed size and doesn't use any locks for
+    posting and receiving messages as long as the queue is neither empty nor
+    full, making it much more efficient when many messages are passed between
+    the threads. Its mutex is only used when a thread needs to wait for a
+    message or for free space in the queue.
+
+    Moreover, this class allows to post several messages at once using
+    PostBatch() and, more importantly, to receive all of them at once using
+    ReceiveAll(), avoiding the overhead of waking up the receiving thread for
+    each of them.
+
+    Example of using this class:
+    @code
+    // Drop the oldest messages if the worker thread can't keep up.
+    wxBoundedMessageQueue<Request> queue(256, wxMSGQUEUE_OVERFLOW_DROP_OLDEST);
+
+    // In the worker thread:
+    std::vector<Request> requests;
+    while ( queue.ReceiveAll(requests) == wxMSGQUEUE_NO_ERROR )
+    {
+        for ( const auto& req : requests )
+            ProcessRequest(req);
+
+        requests.clear();
+    }
+    @endcode
+
+    @tparam T
+        The type of the messages, which must be movable or copyable. Notice
+        that moving or copying it must not throw.
+    @tparam kind
+        Either ::wxMSGQUEUE_MPMC (default) allowing to use the queue from any
+        number of threads, or ::wxMSGQUEUE_SPSC, which is slightly more
+        efficient but may only be used by a single producer and a single
+        consumer thread.
+
+    @since 3.3.0
+
+    @nolibrary
+    @category{threading}
+
+    @see wxMessageQueue<>
+*/
+template <typename T, wxMessageQueueKind kind = wxMSGQUEUE_MPMC>
+class wxBoundedMessageQueue<T, kind>
+{
+public:
+    /**
+        Create the queue with the given capacity.
+
+        @param capacity
+            The minimal number of messages which can be stored in the queue.
+            The actual capacity, returned by GetCapacity(), is rounded up to
+            the next power of 2.
+        @param overflow
+            What to do when trying to post a message to the full queue.
+    */
+    explicit wxBoundedMessageQueue(size_t capacity,
+                                   wxMessageQueueOverflow overflow
+                                        = wxMSGQUEUE_OVERFLOW_BLOCK);
+
+    /**
+        Destroy the queue and all the messages remaining in it.
+    */
+    ~wxBoundedMessageQueue();
+
+    /**
+        Returns @true if the object had been initialized successfully, @false
+        if an error occurred.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the maximal number of messages in the queue.
+    */
+    size_t GetCapacity() const;
+
+    /**
+        Returns the statistics about the queue use.
+
+        The statistics can be used to choose the appropriate capacity of the
+        queue, e.g. if the producers or consumers need to wait often.
+    */
+    wxMessageQueueStats GetStats() const;
+
+    /**
+        Add a message to this queue and wake up the threads waiting for
+        messages.
+
+        If the queue is full, either waits until there is space in it, removes
+        the oldest message from it or returns ::wxMSGQUEUE_FULL, depending on
+        the overflow policy specified in the constructor.
+    */
+    wxMessageQueueError Post(T const& msg);
+
+    /**
+        Post a message of move-only type.
+
+        This function has the same semantics as the other overload but can be
+        used for non-copyable (but movable) types.
+    */
+    wxMessageQueueError Post(T&& msg);
+
+    /**
+        Add all messages in the given range to this queue.
+
+        This is similar to calling Post() for all of them, but only wakes up
+        the threads waiting for messages once, after posting all of them.
+
+        Returns the number of messages posted, which can only be less than the
+        number of messages in the range when using ::wxMSGQUEUE_OVERFLOW_FAIL
+        policy (or if an error occurs).
+    */
+    template <typename InputIterator>
+    size_t PostBatch(InputIterator first, InputIterator last);
+
+    /**
+        Block until a message becomes available in the queue.
+
+        The message is returned in @a msg.
+    */
+    wxMessageQueueError Receive(T& msg);
+
+    /**
+        Block until a message becomes available in the queue, but no more than
+        @a timeout milliseconds.
+
+        If @a timeout is 0, returns immediately if there are no messages in the
+        queue.
+    */
+    wxMessageQueueError ReceiveTimeout(long timeout, T& msg);
+
+    /**
+        Block until at least one message becomes available in the queue and
+        retrieve all the messages in it.
+
+        The messages are appended to the provided vector, which is not
+        cleared by this function. Notice that at most GetCapacity() messages
+        are returned, even if more messages are posted while this function
+        executes.
+    */
+    wxMessageQueueError ReceiveAll(std::vector<T>& msgs);
+
+    /**
+        Same as ReceiveAll(), but waits no more than @a timeout milliseconds.
+
+        If @a timeout is 0, returns immediately if there are no messages in the
+        queue.
+    */
+    wxMessageQueueError ReceiveAllTimeout(long timeout, std::vector<T>& msgs);
+};
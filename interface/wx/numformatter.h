@@ -15,6 +15,11 @@
     This class contains only static functions, so users must not create instances
     but directly call the member functions.
 
+    The locale conventions are retrieved once and reused until the current UI
+    locale changes, so formatting and parsing many numbers is relatively
+    cheap. ToChars() and FromChars() can be used to avoid creating temporary
+    strings too.
+
     @see wxUILocale
 
     @since 2.9.2
@@ -93,6 +98,47 @@ public:
     static wxString
     ToString(double val, int precision, int flags = Style_WithThousandsSep);
 
+    /**
+        Format a number into the provided buffer.
+
+        These functions produce the same result as the corresponding ToString()
+        overloads, but write it directly into the buffer provided by the
+        caller instead of returning a new string, which makes them more
+        efficient when many numbers need to be formatted.
+
+        The result is always NUL-terminated. A buffer of 32 characters is
+        always big enough for any integer value.
+
+        @param buf
+            The buffer to write the result to, must be non-@NULL unless @a
+            size is 0.
+        @param size
+            The size of the buffer, including space for the terminating NUL.
+        @param val
+            The number to format.
+        @param precision
+            Number of decimals to write, as for ToString().
+        @param flags
+            Combination of values from the Style enumeration.
+        @return
+            The number of characters written, not including the terminating
+            NUL, or 0 if the buffer is too small, in which case nothing is
+            written to it.
+
+        @since 3.3.0
+     */
+    ///@{
+    static size_t ToChars(wxChar* buf, size_t size, long val,
+                          int flags = Style_WithThousandsSep);
+    static size_t ToChars(wxChar* buf, size_t size, long long val,
+                          int flags = Style_WithThousandsSep);
+    static size_t ToChars(wxChar* buf, size_t size, unsigned long long val,
+                          int flags = Style_WithThousandsSep);
+    static size_t ToChars(wxChar* buf, size_t size, double val,
+                          int precision,
+                          int flags = Style_WithThousandsSep);
+    ///@}
+
     /**
         Format the given number using one of the floating point formats and
         ensure that the result uses the correct decimal separator.
@@ -121,10 +167,28 @@ public:
         @see wxString::ToLong(), wxString::ToDouble()
      */
     ///@{
-    static bool FromString(wxString s, long *val);
-    static bool FromString(wxString s, long long *val);
-    static bool FromString(wxString s, unsigned long long *val);
-    static bool FromString(wxString s, double *val);
+    static bool FromString(const wxString& s, long *val);
+    static bool FromString(const wxString& s, long long *val);
+    static bool FromString(const wxString& s, unsigned long long *val);
+    static bool FromString(const wxString& s, double *val);
+    ///@}
+
+    /**
+        Parse the given characters representing a number possibly including
+        thousands separators.
+
+        These functions are the same as FromString() but take a pointer to
+        the characters and their number instead of a string, which allows to
+        parse a part of a bigger buffer without copying it. The characters
+        don't need to be NUL-terminated.
+
+        @since 3.3.0
+     */
+    ///@{
+    static bool FromChars(const wxChar* s, size_t len, long *val);
+    static bool FromChars(const wxChar* s, size_t len, long long *val);
+    static bool FromChars(const wxChar* s, size_t len, unsigned long long *val);
+    static bool FromChars(const wxChar* s, size_t len, double *val);
     ///@}
 
     /**
@@ -415,6 +415,28 @@ public:
                  region.
     */
     bool Union(const wxRegion& region);
+    /**
+        Finds the union of this region and all the given rectangles.
+
+        This is equivalent to calling Union() for each of the rectangles, but
+        can be significantly faster when combining many rectangles, e.g. when
+        accumulating the damaged areas of a window.
+
+        This method can be used even if this region is invalid and has the
+        natural behaviour in this case, i.e. makes this region equal to the
+        union of the given rectangles.
+
+        @param count
+            The number of elements in the @a rects array.
+        @param rects
+            Pointer to the rectangles to combine with this region, may be
+            @NULL only if @a count is 0.
+
+        @return @true if successful, @false otherwise.
+
+        @since 3.3.0
+    */
+    bool Union(size_t count, const wxRect* rects);
     /**
         Finds the union of this region and the non-transparent pixels of a
         bitmap. The bitmap's mask is used to determine transparency. If the
@@ -45,7 +45,10 @@
         The same applies to any crash dumps generated due to unhandled exceptions.
         By default unhandled exceptions are eventually caught by wxWidgets.
         This flag should be set very early during program startup, within
-        the constructor of the wxApp derivative. This option has been added in
+        the constructor of the wxApp derivative. Changing it later with
+        SetOption() is taken into account, but changing the corresponding
+        environment variable after the first event was processed is not, as
+        the value of this option is cached. This option has been added in
         wxWidgets 3.3.0.
     @endFlagTable
 
@@ -100,6 +103,21 @@
     @endFlagTable
 
 
+    @section sysopt_unix Unix
+
+    @beginFlagTable
+    @flag{unix.fdio-dispatcher}
+        Selects the mechanism used for waiting for IO on file descriptors by
+        the console event loop and wxSocket. Supported values are
+        @c "io_uring", @c "epoll" and @c "select". By default, epoll() is used
+        under Linux and select() elsewhere. If the requested mechanism is not
+        available, the default one is used instead. This option must be set
+        before the first event loop is created, e.g. by setting the
+        @c wx_unix_fdio_dispatcher environment variable, and has been added in
+        wxWidgets 3.3.0.
+    @endFlagTable
+
+
     @section sysopt_gtk GTK+
 
     @beginFlagTable
@@ -0,0 +1,202 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     interface of wxThreadPool and wxCancellationToken
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxCancellationToken
+
+    Object used to request cancellation of the tasks running in wxThreadPool.
+
+    All copies of the token share the same state, so a copy of it can be
+    captured by the tasks, which should check IsCancelled() periodically and
+    return as soon as possible if it returns @true, while the original one is
+    used to Cancel() them from another thread.
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool
+*/
+class wxCancellationToken
+{
+public:
+    /**
+        Create a new token which is not cancelled.
+    */
+    wxCancellationToken();
+
+    /**
+        Request cancellation of all the tasks using this token.
+
+        This function can be called from any thread.
+    */
+    void Cancel();
+
+    /**
+        Return @true if Cancel() had been called for this token or any of its
+        copies.
+    */
+    bool IsCancelled() const;
+};
+
+/**
+    @class wxThreadPool
+
+    Thread pool executes tasks using a fixed number of worker threads.
+
+    Each worker thread has its own queue of tasks and idle workers steal tasks
+    from the queues of the busy ones, which keeps all of them busy without
+    contending on a single shared queue. Tasks posted from a worker thread are
+    added to its own queue, so tasks can create sub-tasks efficiently.
+
+    Most applications should use the global pool returned by Get() rather
+    than creating their own ones, to avoid creating more threads than there
+    are CPUs. Example of using it:
+    @code
+    // Compute the result in background and use it in the main thread.
+    wxThreadPool::Get().Submit
+        (
+            [path]() { return ComputeChecksum(path); },
+            this,
+            [this](std::future<wxString>& result)
+            {
+                m_checksum->SetLabel(result.get());
+            }
+        );
+
+    // Process all items using all available CPUs.
+    wxThreadPool::Get().ParallelFor(0, items.size(),
+                                    [&items](size_t n) { items[n].Update(); });
+    @endcode
+
+    Note that the tasks are executed in the worker threads and so can't use
+    any GUI functions, as usual. Use the Submit() overload taking
+    wxEvtHandler to get back to the main thread once the task completes.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThread, wxCancellationToken, wxEvtHandler::CallAfter()
+*/
+class wxThreadPool
+{
+public:
+    /**
+        Create the pool with the given number of threads.
+
+        @param numThreads
+            Number of worker threads to create. By default, i.e. if this
+            parameter is negative, as many threads as wxThread::GetCPUCount()
+            returns are created. If it is 0, the tasks are executed
+            synchronously by Post().
+    */
+    explicit wxThreadPool(int numThreads = -1);
+
+    /**
+        Destructor waits until all the queued tasks complete and stops all
+        worker threads.
+
+        It must not be called from one of the worker threads of this pool.
+    */
+    ~wxThreadPool();
+
+    /**
+        Return the global thread pool.
+
+        The pool is created on first use and destroyed when the library is
+        shut down.
+    */
+    static wxThreadPool& Get();
+
+    /**
+        Return the number of worker threads in this pool.
+    */
+    int GetThreadCount() const;
+
+    /**
+        Return @true if this function is called from one of the worker
+        threads of this pool.
+    */
+    bool IsWorkerThread() const;
+
+    /**
+        Queue the task for execution by one of the worker threads.
+
+        This function can be called from any thread, including the worker
+        threads of this pool themselves.
+
+        If the task throws an exception, wxApp::OnUnhandledException() is
+        called in the worker thread, so it's usually better to use Submit()
+        for the tasks which can throw.
+    */
+    void Post(const std::function<void ()>& task);
+
+    /**
+        Queue the given function for execution and return the future for its
+        result.
+
+        The returned future can be used to wait for the function to complete
+        and to retrieve its return value or the exception thrown by it.
+
+        Note that waiting for the future in a task executing in this pool
+        itself may result in a deadlock if all worker threads do the same.
+    */
+    template <typename F>
+    std::future<R> Submit(F func);
+
+    /**
+        Queue the given function for execution and call another one in the
+        main thread when it completes.
+
+        The @a onCompletion function is called with the ready @c
+        std::future<R> object containing the result of @a func (or the
+        exception thrown by it) as argument using @a handler CallAfter(), so
+        the handler must remain alive until it is called.
+    */
+    template <typename F, typename C>
+    void Submit(F func, wxEvtHandler* handler, C onCompletion);
+
+    /**
+        Call the given function for all indices in the given range in
+        parallel.
+
+        The range is split into chunks which are processed by both the worker
+        threads and the calling thread, and this function only returns once
+        all of them have been processed. It can be called from the worker
+        threads of this pool too, i.e. nested parallel loops are supported.
+
+        If @a func throws an exception, the remaining indices are skipped and
+        the exception is rethrown from this function.
+
+        @param from
+            The first index to process.
+        @param to
+            One past the last index to process.
+        @param func
+            The function called with each index. It may be called from
+            several threads simultaneously.
+    */
+    void ParallelFor(size_t from, size_t to,
+                     const std::function<void (size_t)>& func);
+
+    /**
+        Call the given function for all indices in the given range in
+        parallel unless cancelled.
+
+        This overload is the same as the one above, but stops calling @a func
+        as soon as @a cancel is cancelled. Note that this function still
+        waits for all already running calls of @a func to complete.
+    */
+    void ParallelFor(size_t from, size_t to,
+                     const std::function<void (size_t)>& func,
+                     const wxCancellationToken& cancel);
+};
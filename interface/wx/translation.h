@@ -434,6 +434,11 @@ public:
     /**
         Creates catalog loaded from a MO file.
 
+        The file is mapped into memory, if possible, instead of being read
+        into it, and the translations are converted to wxString only when
+        they are looked up for the first time, so loading even big catalogs
+        is fast.
+
         @param filename  Path to the MO file to load.
         @param domain    Catalog's domain. This typically matches
                          the @a filename.
@@ -446,6 +451,10 @@ public:
     /**
         Creates catalog from MO file data in memory buffer.
 
+        If @a data is a non-owned buffer, the data is copied, so it doesn't
+        need to remain valid after this function returns. Use the other
+        overload to avoid copying it.
+
         @param data      Data in MO file format.
         @param domain    Catalog's domain. This typically matches
                          the @a filename.
@@ -454,6 +463,26 @@ public:
      */
     static wxMsgCatalog *CreateFromData(const wxScopedCharBuffer& data,
                                         const wxString& domain);
+
+    /**
+        Creates catalog from MO file data in memory without copying it.
+
+        The catalog uses the data directly, so the memory it refers to must
+        remain valid and unchanged for as long as the catalog exists. This is
+        typically used with static data or data embedded into the program
+        resources.
+
+        @param data      Pointer to the data in MO file format.
+        @param size      Size of the data in bytes.
+        @param domain    Catalog's domain.
+
+        @return Successfully loaded catalog or @NULL on failure.
+
+        @since 3.3.0
+     */
+    static wxMsgCatalog *CreateFromData(const void* data,
+                                        size_t size,
+                                        const wxString& domain);
 };
 
 
@@ -638,9 +667,60 @@ const wxString& wxGetTranslation(const wxString& string,
 
     This macro is thread-safe.
 
+    If @c wxCACHE_TRANSLATIONS symbol is predefined before including wx
+    headers and the compiler supports C++14, this macro is the same as
+    wxGETTEXT_CACHED().
+
     @header{wx/intl.h}
 */
 #define _(string)
 
+/**
+    Macro translating a string literal and caching the translation.
+
+    This macro is similar to _(), but each of its occurrences in the code
+    keeps the translation of its string once it has been looked up, so that
+    subsequent uses of it just return the cached translation without looking
+    it up again, as long as the translations don't change, i.e. until
+    wxTranslations::Set() is called, the language is changed or a new message
+    catalog is loaded. The hash of the string used for searching it in the
+    message catalog is also computed at compile-time. This makes this macro
+    much faster than _() when the same string is translated repeatedly, e.g.
+    in a wxEVT_PAINT handler.
+
+    Rather than using this macro explicitly, you may also predefine @c
+    wxCACHE_TRANSLATIONS to make _() and wxGETTEXT_IN_CONTEXT() use caching
+    for all strings. This can't be done if @c wxNO_REQUIRE_LITERAL_MSGIDS is
+    defined, as the argument of this macro must be a @em string @em literal.
+
+    Caching is only available when using C++14 or later, otherwise this macro
+    is the same as _(). wxHAS_CACHED_TRANSLATIONS symbol is defined if caching
+    is supported.
+
+    Notice that xgettext must be invoked with @c --keyword=wxGETTEXT_CACHED
+    option to extract the strings passed to this macro from the sources.
+
+    @since 3.3.0
+
+    @header{wx/intl.h}
+*/
+#define wxGETTEXT_CACHED(string)
+
+/**
+    Similar to wxGETTEXT_CACHED() but translates the string in the given
+    context, like wxGETTEXT_IN_CONTEXT().
+
+    The arguments must be @em string @em literals.
+
+    Notice that xgettext must be invoked with @c
+    --keyword=wxGETTEXT_IN_CONTEXT_CACHED:1c,2 option to extract the strings
+    passed to this macro from the sources.
+
+    @since 3.3.0
+
+    @header{wx/intl.h}
+*/
+#define wxGETTEXT_IN_CONTEXT_CACHED(context, string)
+
 ///@}
 
@@ -36,6 +36,7 @@
 #include "wx/confbase.h"
 #include "wx/evtloop.h"
 #include "wx/filename.h"
+#include "wx/logasync.h"
 #include "wx/msgout.h"
 #include "wx/scopedptr.h"
 #include "wx/sysopt.h"
@@ -508,14 +509,21 @@ void wxAppConsoleBase::RemovePendingEventHandler(wxEvtHandler* toRemove)
     wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
 }
 
-void wxAppConsoleBase::AppendPendingEventHandler(wxEvtHandler* toAppend)
+bool wxAppConsoleBase::AppendPendingEventHandler(wxEvtHandler* toAppend)
 {
     wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
 
     if ( m_handlersWithPendingEvents.Index(toAppend) == wxNOT_FOUND )
         m_handlersWithPendingEvents.Add(toAppend);
 
+    // The event loop only needs to be woken up once until it processes the
+    // pending events, whichever handler they were queued for.
+    const bool wakeUp = !m_wakeUpRequested;
+    m_wakeUpRequested = true;
+
     wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
+
+    return wakeUp;
 }
 
 bool wxAppConsoleBase::HasPendingEvents() const
@@ -537,6 +545,11 @@ void wxAppConsoleBase::SuspendProcessingOfPendingEvents()
 void wxAppConsoleBase::ResumeProcessingOfPendingEvents()
 {
     m_bDoPendingEventProcessing = true;
+
+    // Events queued while processing was suspended didn't necessarily wake
+    // up the event loop, so do it now to ensure they're processed soon.
+    if ( HasPendingEvents() )
+        WakeUpIdle();
 }
 
 void wxAppConsoleBase::ProcessPendingEvents()
@@ -548,6 +561,10 @@ void wxAppConsoleBase::ProcessPendingEvents()
         wxCHECK_RET( m_handlersWithPendingDelayedEvents.IsEmpty(),
                      "this helper list should be empty" );
 
+        // any events queued from now on, including those queued while we're
+        // processing the events below, need to wake up the loop again
+        m_wakeUpRequested = false;
+
         // iterate until the list becomes empty: the handlers remove themselves
         // from it when they don't have any more pending events
         while (!m_handlersWithPendingEvents.IsEmpty())
@@ -573,13 +590,22 @@ void wxAppConsoleBase::ProcessPendingEvents()
         // because of a selective wxYield call in progress.
         // Now we need to move them back to wxHandlersWithPendingEvents so the next
         // call to this function has the chance of processing them:
+        bool wakeUp = false;
         if (!m_handlersWithPendingDelayedEvents.IsEmpty())
         {
             WX_APPEND_ARRAY(m_handlersWithPendingEvents, m_handlersWithPendingDelayedEvents);
             m_handlersWithPendingDelayedEvents.Clear();
+
+            // and ensure that this call does happen, as nothing else may wake
+            // up the loop if no new events are queued
+            wakeUp = !m_wakeUpRequested;
+            m_wakeUpRequested = true;
         }
 
         wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
+
+        if ( wakeUp )
+            WakeUpIdle();
     }
 }
 
@@ -1125,6 +1151,12 @@ bool wxAssertIsEqual(int x, int y)
 
 void wxAbort()
 {
+#if wxUSE_LOG && wxUSE_THREADS
+    // Don't lose the messages logged asynchronously, they may explain why we
+    // are aborting.
+    wxLogAsync::FlushAll();
+#endif // wxUSE_LOG && wxUSE_THREADS
+
     abort();
 }
 
@@ -43,6 +43,10 @@
 #include "wx/thread.h"
 
 #include <ctype.h>
+#include <limits.h>
+
+#include <memory>
+#include <vector>
 
 #ifdef __WINDOWS__
     #include <winnls.h>
@@ -52,6 +56,7 @@
 #include "wx/datetime.h"
 #include "wx/time.h"
 #include "wx/uilocale.h"
+#include "wx/private/uilocale.h"
 
 // ============================================================================
 // implementation of wxDateTime
@@ -96,11 +101,22 @@ bool GetNumericToken(size_t len,
                      unsigned long *number,
                      size_t *numScannedDigits = nullptr)
 {
+    // accumulate the value directly instead of collecting the digits in a
+    // temporary string, this function is called for every numeric field
     size_t n = 1;
-    wxString s;
+    bool found = false,
+         ok = true;
+    unsigned long value = 0;
     while ( p != end && wxIsdigit(*p) )
     {
-        s += *p++;
+        const wxChar ch = *p++;
+        const unsigned digit = static_cast<unsigned>(ch - wxT('0'));
+        if ( digit > 9 || value > (ULONG_MAX - digit) / 10 )
+            ok = false;
+        else
+            value = value*10 + digit;
+
+        found = true;
 
         if ( len && ++n > len )
             break;
@@ -111,7 +127,11 @@ bool GetNumericToken(size_t len,
         *numScannedDigits = n - 1;
     }
 
-    return !s.empty() && s.ToULong(number);
+    if ( !found || !ok )
+        return false;
+
+    *number = value;
+    return true;
 }
 
 // scans all alphabetic characters and returns the resulting string
@@ -274,1458 +294,2652 @@ GetWeekDayFromName(wxString::const_iterator& p,
     return wd;
 }
 
-// parses string starting at given iterator using the specified format and,
-// optionally, a fall back format (and optionally another one... but it stops
-// there, really)
-//
-// if unsuccessful, returns invalid wxDateTime without changing p; otherwise
-// advance p to the end of the match and returns wxDateTime containing the
-// results of the parsing
-wxDateTime
-ParseFormatAt(wxString::const_iterator& p,
-              const wxString::const_iterator& end,
-              const wxString& fmt,
-              const wxString& fmtAlt = wxString())
+// the fields found when parsing the date and their values
+struct ParsedDateTime
 {
-    const wxString str(p, end);
-    wxString::const_iterator endParse;
-    wxDateTime dt;
-
-    // Use a default date outside of the DST period to avoid problems with
-    // parsing the time differently depending on the today's date (which is used
-    // as the fall back date if none is explicitly specified).
-    static const wxDateTime dtDef(1, wxDateTime::Jan, 2012);
-
-    if ( dt.ParseFormat(str, fmt, dtDef, &endParse) ||
-            (!fmtAlt.empty() && dt.ParseFormat(str, fmtAlt, dtDef, &endParse)) )
+    ParsedDateTime()
     {
-        p += endParse - str.begin();
+        haveWDay =
+        haveYDay =
+        haveDay =
+        haveMon =
+        haveYear =
+        haveHour =
+        haveMin =
+        haveSec =
+        haveMsec = false;
+
+        hourIsIn12hFormat = false;  // or in 24h one?
+        isPM = false;               // AM by default
+
+        haveTimeZone = false;
+
+        // init the values too to get rid of warnings
+        msec =
+        sec =
+        min =
+        hour = 0;
+        wday = wxDateTime::Inv_WeekDay;
+        yday =
+        mday = 0;
+        mon = wxDateTime::Inv_Month;
+        year = 0;
+        timeZone = 0;
     }
-    //else: all formats failed
-
-    return dt;
-}
-
-} // anonymous namespace
 
-// ----------------------------------------------------------------------------
-// wxDateTime to/from text representations
-// ----------------------------------------------------------------------------
+    // combine the fields found with the default date, which is dateDef if
+    // it's valid or dtOrig if it is or today otherwise, into tm
+    //
+    // returns false if the fields are inconsistent
+    bool GetTm(wxDateTime::Tm& tm,
+               const wxDateTime& dateDef,
+               const wxDateTime& dtOrig) const
+    {
+        const wxDateTime& dtDef = dateDef.IsValid() ? dateDef : dtOrig;
 
-wxString wxDateTime::Format(const wxString& formatp, const TimeZone& tz) const
-{
-    wxCHECK_MSG( !formatp.empty(), wxEmptyString,
-                 wxT("null format in wxDateTime::Format") );
+        if ( haveYear && haveMon && haveDay &&
+                haveHour && haveMin && haveSec )
+        {
+            // avoid the relatively expensive conversion of the default date
+            // to broken down time when only milliseconds are taken from it
+            tm.year = year;
+            tm.mon = mon;
+            tm.mday = mday;
+            if ( haveMsec )
+                tm.msec = msec;
+            else if ( !dtDef.IsValid() )
+                tm.msec = 0;        // Today() is used and it has no msec
+            else if ( dtDef.GetTicks() != (time_t)-1 )
+                tm.msec = (wxDateTime::wxDateTime_t)(dtDef.GetValue() % 1000).ToLong();
+            else
+                tm.msec = dtDef.GetTm().msec;
+        }
+        else
+        {
+            tm = dtDef.IsValid() ? dtDef.GetTm() : wxDateTime::Today().GetTm();
 
-    wxString format = formatp;
-#ifdef __WXOSX__
-#if wxUSE_INTL
-    if ( format.Contains("%c") )
-        format.Replace("%c", wxUILocale::GetCurrent().GetInfo(wxLOCALE_DATE_TIME_FMT));
-    if ( format.Contains("%x") )
-        format.Replace("%x", wxUILocale::GetCurrent().GetInfo(wxLOCALE_SHORT_DATE_FMT));
-    if ( format.Contains("%X") )
-        format.Replace("%X", wxUILocale::GetCurrent().GetInfo(wxLOCALE_TIME_FMT));
-#endif // wxUSE_INTL
-#endif // __WXOSX__
-    // we have to use our own implementation if the date is out of range of
-    // strftime()
-#ifdef wxHAS_STRFTIME
-    time_t time = GetTicks();
+            // set the date
+            if ( haveMon )
+                tm.mon = mon;
 
-    bool canUseStrftime = time != (time_t)-1;
-    bool isPercent = false;
+            if ( haveYear )
+                tm.year = year;
 
-    // We also can't use strftime() if we use non standard specifier: either
-    // our own extension "%l" or one of C99/POSIX specifiers not supported when
-    // using MinGW, see https://sourceforge.net/p/mingw-w64/bugs/793/
-    for ( wxString::const_iterator p = format.begin();
-          canUseStrftime && p != format.end();
-          ++p )
-    {
-        if (!isPercent)
-        {
-            isPercent = *p == '%';
-            continue;
+            if ( haveMsec )
+                tm.msec = msec;
         }
-        isPercent = false;
 
-        // set the default format
-        switch ( (*p).GetValue() )
+        // TODO we don't check here that the values are consistent, if both year
+        //      day and month/day were found, we just ignore the year day and we
+        //      also always ignore the week day
+        if ( haveDay )
         {
-            case 'l':
-#ifdef __MINGW32__
-            case 'F':
-            case 'g':
-            case 'G':
-            case 'V':
-            case 'z':
-#endif // __MINGW32__
-                canUseStrftime = false;
-                break;
-        }
-    }
+            if ( mday > wxDateTime::GetNumberOfDays(tm.mon, tm.year) )
+                return false;
 
-    if ( canUseStrftime )
-    {
-        // Try using strftime()
-        struct tm tmstruct;
-        if ( const tm* tm = wxTryGetTm(tmstruct, time, tz) )
-        {
-            return wxCallStrftime(format, tm);
+            tm.mday = mday;
         }
-    }
-    //else: use generic code below
-#endif // wxHAS_STRFTIME
+        else if ( haveYDay )
+        {
+            if ( yday > wxDateTime::GetNumberOfDays(tm.year) )
+                return false;
 
-    // we only parse ANSI C format specifications here, no POSIX 2
-    // complications, no GNU extensions but we do add support for a "%l" format
-    // specifier allowing to get the number of milliseconds
-    Tm tm = GetTm(tz);
+            wxDateTime::Tm tm2 = wxDateTime(1, wxDateTime::Jan, tm.year).
+                                    SetToYearDay(yday).GetTm();
 
-    // used for calls to strftime() when we only deal with time
-    struct tm tmTimeOnly;
-    memset(&tmTimeOnly, 0, sizeof(tmTimeOnly));
-    tmTimeOnly.tm_hour = tm.hour;
-    tmTimeOnly.tm_min = tm.min;
-    tmTimeOnly.tm_sec = tm.sec;
-    tmTimeOnly.tm_mday = 1;         // any date will do, use 1976-01-01
-    tmTimeOnly.tm_mon = 0;
-    tmTimeOnly.tm_year = 76;
-    tmTimeOnly.tm_isdst = 0;        // no DST, we adjust for tz ourselves
+            tm.mon = tm2.mon;
+            tm.mday = tm2.mday;
+        }
 
-    wxString res, fmt;
-    for ( wxString::const_iterator p = format.begin(); p != format.end(); ++p )
-    {
-        if ( *p != wxT('%') )
+        // set the time
+        if ( haveHour )
         {
-            // copy as is
-            res += *p;
+            tm.hour = hour;
 
-            continue;
+            // deal with AM/PM
+            if ( hourIsIn12hFormat && isPM )
+            {
+                // translate to 24hour format
+                tm.hour += 12;
+            }
+            //else: either already in 24h format or no translation needed
         }
 
-        // set the default format
-        switch ( (*++p).GetValue() )
-        {
-            case wxT('Y'):               // year has 4 digits
-            case wxT('G'):               // (and ISO week year too)
-            case wxT('z'):               // time zone as well
-                fmt = wxT("%04d");
-                break;
+        if ( haveMin )
+            tm.min = min;
 
-            case wxT('j'):               // day of year has 3 digits
-            case wxT('l'):               // milliseconds have 3 digits
-                fmt = wxT("%03d");
-                break;
+        if ( haveSec )
+            tm.sec = sec;
 
-            case wxT('w'):               // week day as number has only one
-                fmt = wxT("%d");
-                break;
+        return true;
+    }
 
-            default:
-                // it's either another valid format specifier in which case
-                // the format is "%02d" (for all the rest) or we have the
-                // field width preceding the format in which case it will
-                // override the default format anyhow
-                fmt = wxT("%02d");
-        }
+    // what fields have we found?
+    bool haveWDay,
+         haveYDay,
+         haveDay,
+         haveMon,
+         haveYear,
+         haveHour,
+         haveMin,
+         haveSec,
+         haveMsec;
+
+    bool hourIsIn12hFormat,
+         isPM;
+
+    bool haveTimeZone;
+
+    // and the value of the items we have
+    wxDateTime::wxDateTime_t msec,
+                             sec,
+                             min,
+                             hour;
+    wxDateTime::WeekDay wday;
+    wxDateTime::wxDateTime_t yday,
+                             mday;
+    wxDateTime::Month mon;
+    int year;
+    long timeZone;  // time zone in seconds as expected in Tm structure
+};
 
-        bool restart = true;
-        while ( restart )
-        {
-            restart = false;
+} // anonymous namespace
 
-            // start of the format specification
-            switch ( (*p).GetValue() )
-            {
-                case wxT('a'):       // a weekday name
-                case wxT('A'):
-                    // second parameter should be true for abbreviated names
-                    res += GetWeekDayName(tm.GetWeekDay(),
-                                          *p == wxT('a') ? Name_Abbr : Name_Full);
-                    break;
+// ----------------------------------------------------------------------------
+// compiled formats
+// ----------------------------------------------------------------------------
 
-                case wxT('b'):       // a month name
-                case wxT('B'):
-                    res += GetMonthName(tm.mon,
-                                        *p == wxT('b') ? Name_Abbr : Name_Full);
-                    break;
+// wxDateTime::Format() and ParseFormat() and wxDateTimeFormatter all work by
+// compiling the format into a program consisting of simple steps and then
+// running it. wxDateTimeFormatter keeps the compiled programs and the data for
+// the last used day, while wxDateTime functions use a small per-thread cache
+// of the programs for the recently used formats.
 
-                case wxT('c'):       // locale default date and time  representation
-                case wxT('x'):       // locale default date representation
-#ifdef wxHAS_STRFTIME
-                    //
-                    // the problem: there is no way to know what do these format
-                    // specifications correspond to for the current locale.
-                    //
-                    // the solution: use a hack and still use strftime(): first
-                    // find the YEAR which is a year in the strftime() range (1970
-                    // - 2038) whose Jan 1 falls on the same week day as the Jan 1
-                    // of the real year. Then make a copy of the format and
-                    // replace all occurrences of YEAR in it with some unique
-                    // string not appearing anywhere else in it, then use
-                    // strftime() to format the date in year YEAR and then replace
-                    // YEAR back by the real year and the unique replacement
-                    // string back with YEAR. Notice that "all occurrences of YEAR"
-                    // means all occurrences of 4 digit as well as 2 digit form!
-                    //
-                    // the bugs: we assume that neither of %c nor %x contains any
-                    // fields which may change between the YEAR and real year. For
-                    // example, the week number (%U, %W) and the day number (%j)
-                    // will change if one of these years is leap and the other one
-                    // is not!
-                    {
-                        // find the YEAR: normally, for any year X, Jan 1 of the
-                        // year X + 28 is the same weekday as Jan 1 of X (because
-                        // the weekday advances by 1 for each normal X and by 2
-                        // for each leap X, hence by 5 every 4 years or by 35
-                        // which is 0 mod 7 every 28 years) but this rule breaks
-                        // down if there are years between X and Y which are
-                        // divisible by 4 but not leap (i.e. divisible by 100 but
-                        // not 400), hence the correction.
-
-                        int yearReal = GetYear(tz);
-                        int mod28 = yearReal % 28;
-
-                        // be careful to not go too far - we risk to leave the
-                        // supported range
-                        int year;
-                        if ( mod28 < 10 )
-                        {
-                            year = 1988 + mod28;      // 1988 == 0 (mod 28)
-                        }
-                        else
-                        {
-                            year = 1970 + mod28 - 10; // 1970 == 10 (mod 28)
-                        }
+namespace
+{
 
-                        int nCentury = year / 100,
-                            nCenturyReal = yearReal / 100;
+// flags and width of a numeric field, as in "%02d" printf() format
+struct NumFormat
+{
+    NumFormat(int width_ = 2, bool zeroPad_ = true)
+    {
+        width = width_;
+        zeroPad = zeroPad_;
+        leftAlign =
+        plus =
+        space = false;
+    }
 
-                        // need to adjust for the years divisble by 400 which are
-                        // not leap but are counted like leap ones if we just take
-                        // the number of centuries in between for nLostWeekDays
-                        int nLostWeekDays = (nCentury - nCenturyReal) -
-                                            (nCentury / 4 - nCenturyReal / 4);
+    int width;
+    bool zeroPad,
+         leftAlign,
+         plus,
+         space;
+};
 
-                        // we have to gain back the "lost" weekdays: note that the
-                        // effect of this loop is to not do anything to
-                        // nLostWeekDays (which we won't use any more), but to
-                        // (indirectly) set the year correctly
-                        while ( (nLostWeekDays % 7) != 0 )
-                        {
-                            nLostWeekDays += (year++ % 4) ? 1 : 2;
-                        }
+// parse the flags and width of a field of the generic format into fmt, return
+// false if they're not of the form supported by NumFormat
+bool ParseNumFormat(const wxString& spec, NumFormat& fmt)
+{
+    fmt = NumFormat(0, false);
 
-                        // finally move the year below 2000 so that the 2-digit
-                        // year number can never match the month or day of the
-                        // month when we do the replacements below
-                        if ( year >= 2000 )
-                            year -= 28;
-
-                        wxASSERT_MSG( year >= 1970 && year < 2000,
-                                      wxT("logic error in wxDateTime::Format") );
-
-
-                        // use strftime() to format the same date but in supported
-                        // year
-                        //
-                        // NB: we assume that strftime() doesn't check for the
-                        //     date validity and will happily format the date
-                        //     corresponding to Feb 29 of a non leap year (which
-                        //     may happen if yearReal was leap and year is not)
-                        struct tm tmAdjusted;
-                        wxInitTm(tmAdjusted);
-                        tmAdjusted.tm_hour = tm.hour;
-                        tmAdjusted.tm_min = tm.min;
-                        tmAdjusted.tm_sec = tm.sec;
-                        tmAdjusted.tm_wday = tm.GetWeekDay();
-                        tmAdjusted.tm_yday = GetDayOfYear();
-                        tmAdjusted.tm_mday = tm.mday;
-                        tmAdjusted.tm_mon = tm.mon;
-                        tmAdjusted.tm_year = year - 1900;
-                        tmAdjusted.tm_isdst = 0; // no DST, already adjusted
-                        wxString str = wxCallStrftime(*p == wxT('c') ? wxT("%c")
-                                                                  : wxT("%x"),
-                                                    &tmAdjusted);
-
-                        // now replace the replacement year with the real year:
-                        // notice that we have to replace the 4 digit year with
-                        // a unique string not appearing in strftime() output
-                        // first to prevent the 2 digit year from matching any
-                        // substring of the 4 digit year (but any day, month,
-                        // hours or minutes components should be safe because
-                        // they are never in 70-99 range)
-                        wxString replacement("|");
-                        while ( str.find(replacement) != wxString::npos )
-                            replacement += '|';
-
-                        str.Replace(wxString::Format("%d", year),
-                                    replacement);
-                        str.Replace(wxString::Format("%d", year % 100),
-                                    wxString::Format("%d", yearReal % 100));
-                        str.Replace(replacement,
-                                    wxString::Format("%d", yearReal));
-
-                        res += str;
-                    }
-#else // !wxHAS_STRFTIME
-                    // Use "%m/%d/%y %H:%M:%S" format instead
-                    res += wxString::Format(wxT("%02d/%02d/%04d %02d:%02d:%02d"),
-                            tm.mon+1,tm.mday, tm.year, tm.hour, tm.min, tm.sec);
-#endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
-                    break;
+    wxString::const_iterator p = spec.begin();
+    for ( ; p != spec.end(); ++p )
+    {
+        if ( *p == '-' )
+            fmt.leftAlign = true;
+        else if ( *p == '+' )
+            fmt.plus = true;
+        else if ( *p == ' ' )
+            fmt.space = true;
+        else if ( *p == '0' )
+            fmt.zeroPad = true;
+        else
+            break;
+    }
 
-                case wxT('d'):       // day of a month (01-31)
-                    res += wxString::Format(fmt, tm.mday);
-                    break;
+    for ( ; p != spec.end(); ++p )
+    {
+        if ( *p < '0' || *p > '9' || fmt.width > 999 )
+            return false;
 
-                case wxT('F'):      // ISO 8601 date
-                    res += wxString::Format(wxT("%04d-%02d-%02d"), tm.year, tm.mon + 1, tm.mday);
-                    break;
+        fmt.width = fmt.width*10 + (*p - '0');
+    }
 
-                case wxT('g'):      // 2-digit week-based year
-                    res += wxString::Format(fmt, GetWeekBasedYear() % 100);
-                    break;
+    return true;
+}
 
-                case wxT('G'):       // week-based year with century
-                    res += wxString::Format(fmt, GetWeekBasedYear());
-                    break;
+// append the number formatted in the same way as printf("%d") would do it
+// with the given flags and width
+void AppendNumber(wxString& str, long value, const NumFormat& fmt)
+{
+    wxChar buf[32];
+    wxChar* const bufEnd = buf + WXSIZEOF(buf);
+    wxChar* p = bufEnd;
 
-                case wxT('H'):       // hour in 24h format (00-23)
-                    res += wxString::Format(fmt, tm.hour);
-                    break;
+    unsigned long absValue = value < 0 ? 0ul - static_cast<unsigned long>(value)
+                                       : static_cast<unsigned long>(value);
+    do
+    {
+        *--p = static_cast<wxChar>(wxT('0') + absValue % 10);
+        absValue /= 10;
+    } while ( absValue );
 
-                case wxT('I'):       // hour in 12h format (01-12)
-                    {
-                        // 24h -> 12h, 0h -> 12h too
-                        int hour12 = tm.hour > 12 ? tm.hour - 12
-                                                  : tm.hour ? tm.hour : 12;
-                        res += wxString::Format(fmt, hour12);
-                    }
-                    break;
+    wxChar sign = 0;
+    if ( value < 0 )
+        sign = wxT('-');
+    else if ( fmt.plus )
+        sign = wxT('+');
+    else if ( fmt.space )
+        sign = wxT(' ');
 
-                case wxT('j'):       // day of the year
-                    res += wxString::Format(fmt, GetDayOfYear(tz));
-                    break;
+    const int numDigits = static_cast<int>(bufEnd - p);
+    const int len = numDigits + (sign ? 1 : 0);
+    const int pad = fmt.width > len ? fmt.width - len : 0;
 
-                case wxT('l'):       // milliseconds (NOT STANDARD)
-                    res += wxString::Format(fmt, GetMillisecond(tz));
-                    break;
+    if ( !fmt.leftAlign && !fmt.zeroPad )
+        str.append(pad, wxT(' '));
 
-                case wxT('m'):       // month as a number (01-12)
-                    res += wxString::Format(fmt, tm.mon + 1);
-                    break;
+    if ( sign )
+        str += sign;
 
-                case wxT('M'):       // minute as a decimal number (00-59)
-                    res += wxString::Format(fmt, tm.min);
-                    break;
+    if ( fmt.zeroPad && !fmt.leftAlign )
+        str.append(pad, wxT('0'));
 
-                case wxT('p'):       // AM or PM string
-#ifdef wxHAS_STRFTIME
-                    res += wxCallStrftime(wxS("%p"), &tmTimeOnly);
-#else // !wxHAS_STRFTIME
-                    res += (tmTimeOnly.tm_hour > 12) ? wxT("pm") : wxT("am");
-#endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
-                    break;
+    str.append(p, numDigits);
 
-                case wxT('S'):       // second as a decimal number (00-61)
-                    res += wxString::Format(fmt, tm.sec);
-                    break;
+    if ( fmt.leftAlign )
+        str.append(pad, wxT(' '));
+}
 
-                case wxT('U'):       // week number in the year (Sunday 1st week day)
-                    res += wxString::Format(fmt, GetWeekOfYear(Sunday_First, tz));
-                    break;
+// used for calls to strftime() when we only deal with time: any date will do,
+// use 1976-01-01, and don't use DST as we adjust for the time zone ourselves
+void InitTmTimeOnly(struct tm& tmTimeOnly, int hour, int min, int sec)
+{
+    memset(&tmTimeOnly, 0, sizeof(tmTimeOnly));
+    tmTimeOnly.tm_hour = hour;
+    tmTimeOnly.tm_min = min;
+    tmTimeOnly.tm_sec = sec;
+    tmTimeOnly.tm_mday = 1;
+    tmTimeOnly.tm_mon = 0;
+    tmTimeOnly.tm_year = 76;
+    tmTimeOnly.tm_isdst = 0;
+}
 
-                case wxT('V'):       // ISO week number
-                case wxT('W'):       // week number in the year (Monday 1st week day)
-                    res += wxString::Format(fmt, GetWeekOfYear(Monday_First, tz));
-                    break;
+#ifdef wxHAS_STRFTIME
 
-                case wxT('w'):       // weekday as a number (0-6), Sunday = 0
-                    res += wxString::Format(fmt, tm.GetWeekDay());
-                    break;
+// call strftime() for a single conversion, unlike wxCallStrftime() this
+// doesn't assert if the result is empty as it may be the case for e.g. "%Z"
+wxString DoStrftime(const wxString& spec, const tm* tm)
+{
+    wxChar buf[256];
+    if ( !wxStrftime(buf, WXSIZEOF(buf), spec, tm) )
+        return wxString();
 
-                // case wxT('x'): -- handled with "%c"
+    return buf;
+}
 
-                case wxT('X'):       // locale default time representation
-                    // just use strftime() to format the time for us
-#ifdef wxHAS_STRFTIME
-                    res += wxCallStrftime(wxS("%X"), &tmTimeOnly);
-#else // !wxHAS_STRFTIME
-                    res += wxString::Format(wxT("%02d:%02d:%02d"),tm.hour, tm.min, tm.sec);
-#endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
-                    break;
+// format the locale default date and time ("%c") or date ("%x")
+// representation of a date which may be out of strftime() range
+wxString
+FormatLocaleDateTime(const wxUniChar& conv,
+                     const wxDateTime& dt,
+                     wxDateTime::Tm& tm,
+                     const wxDateTime::TimeZone& tz)
+{
+    // the problem: there is no way to know what do these format
+    // specifications correspond to for the current locale.
+    //
+    // the solution: use a hack and still use strftime(): first
+    // find the YEAR which is a year in the strftime() range (1970
+    // - 2038) whose Jan 1 falls on the same week day as the Jan 1
+    // of the real year. Then make a copy of the format and
+    // replace all occurrences of YEAR in it with some unique
+    // string not appearing anywhere else in it, then use
+    // strftime() to format the date in year YEAR and then replace
+    // YEAR back by the real year and the unique replacement
+    // string back with YEAR. Notice that "all occurrences of YEAR"
+    // means all occurrences of 4 digit as well as 2 digit form!
+    //
+    // the bugs: we assume that neither of %c nor %x contains any
+    // fields which may change between the YEAR and real year. For
+    // example, the week number (%U, %W) and the day number (%j)
+    // will change if one of these years is leap and the other one
+    // is not!
+
+    // find the YEAR: normally, for any year X, Jan 1 of the
+    // year X + 28 is the same weekday as Jan 1 of X (because
+    // the weekday advances by 1 for each normal X and by 2
+    // for each leap X, hence by 5 every 4 years or by 35
+    // which is 0 mod 7 every 28 years) but this rule breaks
+    // down if there are years between X and Y which are
+    // divisible by 4 but not leap (i.e. divisible by 100 but
+    // not 400), hence the correction.
+
+    int yearReal = dt.GetYear(tz);
+    int mod28 = yearReal % 28;
+
+    // be careful to not go too far - we risk to leave the
+    // supported range
+    int year;
+    if ( mod28 < 10 )
+    {
+        year = 1988 + mod28;      // 1988 == 0 (mod 28)
+    }
+    else
+    {
+        year = 1970 + mod28 - 10; // 1970 == 10 (mod 28)
+    }
 
-                case wxT('y'):       // year without century (00-99)
-                    res += wxString::Format(fmt, tm.year % 100);
-                    break;
+    int nCentury = year / 100,
+        nCenturyReal = yearReal / 100;
 
-                case wxT('Y'):       // year with century
-                    res += wxString::Format(fmt, tm.year);
-                    break;
+    // need to adjust for the years divisble by 400 which are
+    // not leap but are counted like leap ones if we just take
+    // the number of centuries in between for nLostWeekDays
+    int nLostWeekDays = (nCentury - nCenturyReal) -
+                        (nCentury / 4 - nCenturyReal / 4);
 
-                case wxT('z'):       // time zone as [-+]HHMM
-                    {
-                        int ofs = tz.GetOffset();
+    // we have to gain back the "lost" weekdays: note that the
+    // effect of this loop is to not do anything to
+    // nLostWeekDays (which we won't use any more), but to
+    // (indirectly) set the year correctly
+    while ( (nLostWeekDays % 7) != 0 )
+    {
+        nLostWeekDays += (year++ % 4) ? 1 : 2;
+    }
 
-                        // The time zone offset does not include the DST, but
-                        // we do need to take it into account when showing the
-                        // time in the local time zone to the user.
-                        if ( ofs == -wxGetTimeZone() && IsDST() == 1 )
-                        {
-                            ofs += DST_OFFSET;
-                        }
+    // finally move the year below 2000 so that the 2-digit
+    // year number can never match the month or day of the
+    // month when we do the replacements below
+    if ( year >= 2000 )
+        year -= 28;
 
-                        if ( ofs < 0 )
-                        {
-                            res += '-';
-                            ofs = -ofs;
-                        }
-                        else
-                        {
-                            res += '+';
-                        }
+    wxASSERT_MSG( year >= 1970 && year < 2000,
+                  wxT("logic error in wxDateTime::Format") );
 
-                        // Converts seconds to HHMM representation.
-                        res += wxString::Format(fmt,
-                                                100*(ofs/3600) + (ofs/60)%60);
-                    }
-                    break;
 
-                case wxT('Z'):       // timezone name
-#ifdef wxHAS_STRFTIME
-                    res += wxCallStrftime(wxS("%Z"), &tmTimeOnly);
-#endif
-                    break;
+    // use strftime() to format the same date but in supported
+    // year
+    //
+    // NB: we assume that strftime() doesn't check for the
+    //     date validity and will happily format the date
+    //     corresponding to Feb 29 of a non leap year (which
+    //     may happen if yearReal was leap and year is not)
+    struct tm tmAdjusted;
+    wxInitTm(tmAdjusted);
+    tmAdjusted.tm_hour = tm.hour;
+    tmAdjusted.tm_min = tm.min;
+    tmAdjusted.tm_sec = tm.sec;
+    tmAdjusted.tm_wday = tm.GetWeekDay();
+    tmAdjusted.tm_yday = dt.GetDayOfYear();
+    tmAdjusted.tm_mday = tm.mday;
+    tmAdjusted.tm_mon = tm.mon;
+    tmAdjusted.tm_year = year - 1900;
+    tmAdjusted.tm_isdst = 0; // no DST, already adjusted
+    wxString str = wxCallStrftime(conv == wxT('c') ? wxT("%c")
+                                                   : wxT("%x"),
+                                  &tmAdjusted);
+
+    // now replace the replacement year with the real year:
+    // notice that we have to replace the 4 digit year with
+    // a unique string not appearing in strftime() output
+    // first to prevent the 2 digit year from matching any
+    // substring of the 4 digit year (but any day, month,
+    // hours or minutes components should be safe because
+    // they are never in 70-99 range)
+    wxString replacement("|");
+    while ( str.find(replacement) != wxString::npos )
+        replacement += '|';
+
+    str.Replace(wxString::Format("%d", year),
+                replacement);
+    str.Replace(wxString::Format("%d", year % 100),
+                wxString::Format("%d", yearReal % 100));
+    str.Replace(replacement,
+                wxString::Format("%d", yearReal));
 
-                default:
-                    // is it the format width?
-                    for ( fmt.clear();
-                          *p == wxT('-') || *p == wxT('+') ||
-                            *p == wxT(' ') || wxIsdigit(*p);
-                          ++p )
-                    {
-                        fmt += *p;
-                    }
+    return str;
+}
 
-                    if ( !fmt.empty() )
-                    {
-                        // we've only got the flags and width so far in fmt
-                        fmt.Prepend(wxT('%'));
-                        fmt.Append(wxT('d'));
+#endif // wxHAS_STRFTIME
 
-                        restart = true;
+// return the value of a numeric field of the broken down time
+long GetNumericField(const wxUniChar& conv, const wxDateTime::Tm& tm)
+{
+    switch ( conv.GetValue() )
+    {
+        case wxT('d'):
+            return tm.mday;
 
-                        break;
-                    }
+        case wxT('H'):
+            return tm.hour;
 
-                    // no, it wasn't the width
-                    wxFAIL_MSG(wxT("unknown format specifier"));
+        case wxT('I'):
+            // 24h -> 12h, 0h -> 12h too
+            return tm.hour > 12 ? tm.hour - 12 : tm.hour ? tm.hour : 12;
 
-                    wxFALLTHROUGH;
+        case wxT('l'):
+            return tm.msec;
 
-                case wxT('%'):       // a percent sign
-                    res += *p;
-                    break;
+        case wxT('m'):
+            return tm.mon + 1;
 
-                case 0:             // the end of string
-                    wxFAIL_MSG(wxT("missing format at the end of string"));
+        case wxT('M'):
+            return tm.min;
 
-                    // just put the '%' which was the last char in format
-                    res += wxT('%');
-                    break;
-            }
-        }
+        case wxT('S'):
+            return tm.sec;
+
+        case wxT('y'):
+            return tm.year % 100;
+
+        case wxT('Y'):
+            return tm.year;
     }
 
-    return res;
+    wxFAIL_MSG( "unexpected numeric field" );
+
+    return 0;
 }
 
-bool
-wxDateTime::ParseRFC822TimeZone(wxString::const_iterator *iterator,
-                                const wxString::const_iterator &pEnd)
+// append a field which is not supported by strftime() or is out of its range:
+// we only handle ANSI C format specifications here, no POSIX 2 complications,
+// no GNU extensions, but we do add support for a "%l" format specifier
+// allowing to get the number of milliseconds
+void
+AppendGenericField(wxString& str,
+                   const wxUniChar& conv,
+                   const NumFormat& fmt,
+                   const wxDateTime& dt,
+                   wxDateTime::Tm& tm,
+                   const wxDateTime::TimeZone& tz)
 {
-    wxString::const_iterator& p = *iterator;
-    int offset = 0; // just to suppress warnings
-    if ( *p == '-' || *p == '+' )
+    switch ( conv.GetValue() )
     {
-        // the explicit offset given: it has the form of hhmm
-        bool plus = *p++ == '+';
+        case wxT('a'):       // a weekday name
+        case wxT('A'):
+            str += wxDateTime::GetWeekDayName(tm.GetWeekDay(),
+                                              conv == wxT('a')
+                                                ? wxDateTime::Name_Abbr
+                                                : wxDateTime::Name_Full);
+            break;
 
-        if ( p == pEnd || !wxIsdigit(*p) ||
-             p + 1 == pEnd || !wxIsdigit(*(p + 1)) )
-            return false;
+        case wxT('b'):       // a month name
+        case wxT('B'):
+            str += wxDateTime::GetMonthName(tm.mon,
+                                            conv == wxT('b')
+                                                ? wxDateTime::Name_Abbr
+                                                : wxDateTime::Name_Full);
+            break;
 
+        case wxT('c'):       // locale default date and time representation
+        case wxT('x'):       // locale default date representation
+#ifdef wxHAS_STRFTIME
+            str += FormatLocaleDateTime(conv, dt, tm, tz);
+#else // !wxHAS_STRFTIME
+            // Use "%m/%d/%y %H:%M:%S" format instead
+            str += wxString::Format(wxT("%02d/%02d/%04d %02d:%02d:%02d"),
+                    tm.mon+1,tm.mday, tm.year, tm.hour, tm.min, tm.sec);
+#endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
+            break;
 
-        // hours
-        offset = MIN_PER_HOUR*(10*(*p - '0') + (*(p + 1) - '0'));
+        case wxT('F'):       // ISO 8601 date
+            AppendNumber(str, tm.year, NumFormat(4));
+            str += wxT('-');
+            AppendNumber(str, tm.mon + 1, NumFormat());
+            str += wxT('-');
+            AppendNumber(str, tm.mday, NumFormat());
+            break;
 
-        p += 2;
+        case wxT('g'):       // 2-digit week-based year
+            AppendNumber(str, dt.GetWeekBasedYear() % 100, fmt);
+            break;
 
-        if ( p == pEnd || !wxIsdigit(*p) ||
-             p + 1 == pEnd || !wxIsdigit(*(p + 1)) )
-            return false;
+        case wxT('G'):       // week-based year with century
+            AppendNumber(str, dt.GetWeekBasedYear(), fmt);
+            break;
 
-        // minutes
-        offset += 10*(*p - '0') + (*(p + 1) - '0');
+        case wxT('j'):       // day of the year
+            AppendNumber(str, dt.GetDayOfYear(tz), fmt);
+            break;
 
-        if ( !plus )
-            offset = -offset;
+#ifndef wxHAS_STRFTIME
+        case wxT('p'):       // AM or PM string
+            str += tm.hour > 12 ? wxT("pm") : wxT("am");
+            break;
+#endif // !wxHAS_STRFTIME
 
-        p += 2;
-    }
-    else // not numeric
-    {
-        // the symbolic timezone given: may be either military timezone or one
-        // of standard abbreviations
-        if ( p + 1 == pEnd )
-        {
-            // military: Z = UTC, J unused, A = -1, ..., Y = +12
-            static const int offsets[26] =
-            {
-                //A  B   C   D   E   F   G   H   I    J    K    L    M
-                -1, -2, -3, -4, -5, -6, -7, -8, -9,   0, -10, -11, -12,
-                //N  O   P   R   Q   S   T   U   V    W    Z    Y    Z
-                +1, +2, +3, +4, +5, +6, +7, +8, +9, +10, +11, +12, 0
-            };
+        case wxT('U'):       // week number in the year (Sunday 1st week day)
+            AppendNumber(str, dt.GetWeekOfYear(wxDateTime::Sunday_First, tz), fmt);
+            break;
 
-            if ( *p < wxT('A') || *p > wxT('Z') || *p == wxT('J') )
-                return false;
+        case wxT('V'):       // ISO week number
+        case wxT('W'):       // week number in the year (Monday 1st week day)
+            AppendNumber(str, dt.GetWeekOfYear(wxDateTime::Monday_First, tz), fmt);
+            break;
 
-            offset = offsets[*p++ - 'A'];
-        }
-        else
-        {
-            // TZ is max 3 characters long; we do not want to consume
-            // characters beyond that.
-            wxString::const_iterator pPlusMax3 = pEnd;
-            if ( p != pEnd && p + 1 != pEnd && p + 2 != pEnd && p + 3 != pEnd )
-                pPlusMax3 = p + 3;
-            // abbreviation
-            const wxString tz(p, pPlusMax3);
-            if ( tz == wxT("UT") || tz == wxT("UTC") || tz == wxT("GMT") )
-                offset = 0;
-            else if ( tz == wxT("AST") )
-                offset = AST - GMT0;
-            else if ( tz == wxT("ADT") )
-                offset = ADT - GMT0;
-            else if ( tz == wxT("EST") )
-                offset = EST - GMT0;
-            else if ( tz == wxT("EDT") )
-                offset = EDT - GMT0;
-            else if ( tz == wxT("CST") )
-                offset = CST - GMT0;
-            else if ( tz == wxT("CDT") )
-                offset = CDT - GMT0;
-            else if ( tz == wxT("MST") )
-                offset = MST - GMT0;
-            else if ( tz == wxT("MDT") )
-                offset = MDT - GMT0;
-            else if ( tz == wxT("PST") )
-                offset = PST - GMT0;
-            else if ( tz == wxT("PDT") )
-                offset = PDT - GMT0;
-            else
-                return false;
+        case wxT('w'):       // weekday as a number (0-6), Sunday = 0
+            AppendNumber(str, tm.GetWeekDay(), fmt);
+            break;
 
-            p += tz.length();
-        }
+#ifndef wxHAS_STRFTIME
+        case wxT('X'):       // locale default time representation
+            str += wxString::Format(wxT("%02d:%02d:%02d"),
+                                    tm.hour, tm.min, tm.sec);
+            break;
+#endif // !wxHAS_STRFTIME
 
-        // make it minutes
-        offset *= MIN_PER_HOUR;
-    }
+        case wxT('z'):       // time zone as [-+]HHMM
+            {
+                long ofs = tz.GetOffset();
 
-    // As always, dealing with the time zone is the most interesting part: we
-    // can't just use MakeFromTimeZone() here because it wouldn't handle the
-    // DST correctly because the TZ specified in the string is DST-invariant
-    // and so we have to manually shift to the UTC first and then convert to
-    // the local TZ.
-    *this -= wxTimeSpan::Minutes(offset);
-    MakeFromUTC();
+                // The time zone offset does not include the DST, but
+                // we do need to take it into account when showing the
+                // time in the local time zone to the user.
+                if ( ofs == -wxGetTimeZone() && dt.IsDST() == 1 )
+                    ofs += wxDateTime::DST_OFFSET;
 
-    return true;
-}
+                if ( ofs < 0 )
+                {
+                    str += wxT('-');
+                    ofs = -ofs;
+                }
+                else
+                {
+                    str += wxT('+');
+                }
 
-// this function parses a string in (strict) RFC 822 format: see the section 5
-// of the RFC for the detailed description, but briefly it's something of the
-// form "Sat, 18 Dec 1999 00:48:30 +0100"
-//
-// this function is "strict" by design - it must reject anything except true
-// RFC822 time specs.
-bool
-wxDateTime::ParseRfc822Date(const wxString& originalDate, wxString::const_iterator *end)
-{
-    // This implementation implicitly relies on the assumption that the
-    // input never ends prematurely (all dereferencing of *p assumes that).
-    // To avoid iterating beyond the end of buffer, let us append 32 zero bytes
-    // to the date string (32 being the length of a typical RFC822 timestamp).
-    const wxString date(originalDate + wxString(32, '\0'));
+                // Converts seconds to HHMM representation.
+                AppendNumber(str, 100*(ofs/3600) + (ofs/60)%60, fmt);
+            }
+            break;
 
-    const wxString::const_iterator pEnd = date.begin() + originalDate.length();
-    wxString::const_iterator p = date.begin();
+        default:
+            AppendNumber(str, GetNumericField(conv, tm), fmt);
+    }
+}
 
-    // 1. week day (optional)
-    // if there is a week day present, it must be separated
-    // by a comma at position [3].
-    if ( date.length() > 3 && date[3] == ',' )
-    {
-        const wxDateTime::WeekDay
-            wd = GetWeekDayFromName(p, pEnd, Name_Abbr, DateLang_English);
-        if ( wd == Inv_WeekDay )
-            return false;
-        //else: ignore week day for now, we could also check that it really
-        //      corresponds to the specified date
+// return the number of days between the Unix epoch and the given date
+time_t GetDaysSinceEpoch(int year, wxDateTime::Month mon, int mday)
+{
+    // this uses the well-known algorithm counting the years from March, so
+    // that the leap day is the last day of the year
+    const int y = mon < wxDateTime::Mar ? year - 1 : year;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const int yoe = y - era*400;
+    const int m = mon + 1;
+    const int doy = (153*(m > 2 ? m - 3 : m + 9) + 2)/5 + mday - 1;
+    const int doe = yoe*365 + yoe/4 - yoe/100 + doy;
+
+    return static_cast<time_t>(era)*146097 + doe - 719468;
+}
 
-        // 2. separating comma
-        if ( *p++ != ',' || *p++ != ' ' )
-            return false;
-    }
+// ----------------------------------------------------------------------------
+// formatting
+// ----------------------------------------------------------------------------
 
-    // 3. day number
-    if ( !wxIsdigit(*p) )
-        return false;
+// the kinds of steps of the compiled format used for formatting
+enum FormatStepKind
+{
+    FormatStep_Text,            // literal text
+    FormatStep_DayText,         // text cached for the current day
+    FormatStep_Number,          // numeric field of the broken down time
+    FormatStep_AmPm,            // AM or PM string
+    FormatStep_Strftime,        // strftime() called for each date
+    FormatStep_StrftimeTimeOnly,// the same but for the time only
+    FormatStep_Generic          // generic code called for each date
+};
 
-    wxDateTime_t day = (wxDateTime_t)(*p++ - '0');
-    if ( wxIsdigit(*p) )
+struct FormatStep
+{
+    FormatStep()
     {
-        day *= 10;
-        day = (wxDateTime_t)(day + (*p++ - '0'));
+        kind = FormatStep_Text;
+        index = 0;
+        localOnly = false;
     }
 
-    if ( *p++ != ' ' )
-        return false;
+    FormatStepKind kind;
 
-    // 4. month name
-    const Month mon = GetMonthFromName(p, pEnd, Name_Abbr, DateLang_English);
-    if ( mon == Inv_Month )
-        return false;
+    // literal text for FormatStep_Text or the spec for strftime(): this is
+    // also used for FormatStep_DayText steps computed using strftime(), while
+    // it's empty for those computed by the generic code
+    wxString text;
 
-    if ( *p++ != ' ' )
-        return false;
+    // the conversion character for the numeric fields and the generic code
+    wxUniChar conv;
 
-    // 5. year
-    if ( !wxIsdigit(*p) )
-        return false;
+    // the format of the numeric fields
+    NumFormat numFmt;
 
-    int year = *p++ - '0';
-    if ( !wxIsdigit(*p) ) // should have at least 2 digits in the year
-        return false;
+    // index in the day texts for FormatStep_DayText
+    size_t index;
 
-    year *= 10;
-    year += *p++ - '0';
+    // true for FormatStep_DayText steps computed by the generic code which
+    // use the local time zone, whatever the time zone used for formatting
+    // is, so they may change during the day in another time zone
+    bool localOnly;
+};
 
-    // is it a 2 digit year (as per original RFC 822) or a 4 digit one?
-    if ( wxIsdigit(*p) )
+// the steps of the compiled format and the information about them
+struct FormatSteps
+{
+    FormatSteps()
     {
-        year *= 10;
-        year += *p++ - '0';
+        numDayTexts = 0;
+        hasAmPm = false;
+    }
 
-        if ( !wxIsdigit(*p) )
-        {
-            // no 3 digit years please
-            return false;
-        }
+    std::vector<FormatStep> steps;
+    size_t numDayTexts;
+    bool hasAmPm;
+};
 
-        year *= 10;
-        year += *p++ - '0';
-    }
-    else // a 2-digit year
+// helper used to fill FormatSteps when compiling the format
+class FormatStepsBuilder
+{
+public:
+    explicit FormatStepsBuilder(FormatSteps& steps)
+        : m_steps(steps)
     {
-        // RFC 822 allows 2-digit years, stating that year is
-        // "any numeric year 1900 or later".
-        // So how do we interpret e.g. the year '95'? Does it mean:
-        // a) 1995
-        // b) 2095
-        // c) literally 95 AD, two millennia ago?
-        // NOTE! wx traditionally implemented option c!
-        // However, the most sensible interpretation for 95 is
-        // probably 1995, so we shall now use that.
-        // Years 00..29 are considered to mean 20xx.
-        if ( year >= 30 )
-        {
-            year += 1900;
-        }
-        else
-        {
-            year += 2000;
-        }
+        m_steps = FormatSteps();
     }
 
-    if ( *p++ != ' ' )
-        return false;
-
-    // 6. time in hh:mm:ss format with seconds being optional
-    if ( !wxIsdigit(*p) )
-        return false;
+    void AddText(const wxString& text) { m_text += text; }
 
-    wxDateTime_t hour = (wxDateTime_t)(*p++ - '0');
+    void AddStep(FormatStep step)
+    {
+        FlushText();
 
-    if ( !wxIsdigit(*p) )
-        return false;
+        if ( step.kind == FormatStep_DayText )
+            step.index = m_steps.numDayTexts++;
+        else if ( step.kind == FormatStep_AmPm )
+            m_steps.hasAmPm = true;
 
-    hour *= 10;
-    hour = (wxDateTime_t)(hour + (*p++ - '0'));
+        m_steps.steps.push_back(step);
+    }
 
-    if ( *p++ != ':' )
-        return false;
+    // must be called after adding all the steps
+    void FlushText()
+    {
+        if ( m_text.empty() )
+            return;
 
-    if ( !wxIsdigit(*p) )
-        return false;
+        FormatStep step;
+        step.text = m_text;
+        m_steps.steps.push_back(step);
 
-    wxDateTime_t min = (wxDateTime_t)(*p++ - '0');
+        m_text.clear();
+    }
 
-    if ( !wxIsdigit(*p) )
-        return false;
+private:
+    FormatSteps& m_steps;
+    wxString m_text;
 
-    min *= 10;
-    min += (wxDateTime_t)(*p++ - '0');
+    wxDECLARE_NO_COPY_CLASS(FormatStepsBuilder);
+};
 
-    wxDateTime_t sec = 0;
-    if ( *p == ':' )
+// the compiled format used for formatting dates
+class FormatProgram
+{
+public:
+    FormatProgram()
     {
-        ++p;
-        if ( !wxIsdigit(*p) )
-            return false;
-
-        sec = (wxDateTime_t)(*p++ - '0');
+        m_useStrftime =
+        m_genericCompiled = false;
+    }
 
-        if ( !wxIsdigit(*p) )
-            return false;
+    void Compile(const wxString& format);
 
-        sec *= 10;
-        sec += (wxDateTime_t)(*p++ - '0');
+    // the steps to use for the dates which can be converted to broken down
+    // time by the standard library functions
+    const FormatSteps& GetSteps()
+    {
+        return m_useStrftime ? m_strftime : GetGenericSteps();
     }
 
-    if ( *p++ != ' ' )
-        return false;
+    // the steps to use for all the other dates, this can't be used with
+    // FormatDay as they don't use strftime() even if GetSteps() do
+    const FormatSteps& GetGenericSteps()
+    {
+        if ( !m_genericCompiled )
+        {
+            CompileGeneric();
+            m_genericCompiled = true;
+        }
 
-    // the spec was correct, construct the date from the values we found
-    Set(day, mon, year, hour, min, sec);
+        return m_generic;
+    }
 
-    // 7. now the interesting part: the timezone
+private:
+#ifdef wxHAS_STRFTIME
+    void CompileStrftime();
+#endif // wxHAS_STRFTIME
+    void CompileGeneric();
 
-    if ( !ParseRFC822TimeZone(&p, pEnd) )
-        return false;
+    // the format after replacing the platform-specific specifiers, if any
+    wxString m_format;
 
-    if ( end )
-        *end = originalDate.begin() + (p - date.begin());
+    bool m_useStrftime;
+    FormatSteps m_strftime;
 
-    return true;
-}
+    // these steps are only compiled when needed as they are only used for the
+    // dates out of the standard functions range if m_useStrftime is true
+    bool m_genericCompiled;
+    FormatSteps m_generic;
+};
 
-const char* wxDateTime::ParseRfc822Date(const char* date)
+void FormatProgram::Compile(const wxString& format)
 {
-    wxString::const_iterator end;
-    wxString dateStr(date);
-    if ( !ParseRfc822Date(dateStr, &end) )
-        return nullptr;
-
-    return date + dateStr.IterOffsetInMBStr(end);
-}
+    m_format = format;
+#ifdef __WXOSX__
+#if wxUSE_INTL
+    if ( m_format.Contains("%c") )
+        m_format.Replace("%c", wxUILocale::GetCurrent().GetInfo(wxLOCALE_DATE_TIME_FMT));
+    if ( m_format.Contains("%x") )
+        m_format.Replace("%x", wxUILocale::GetCurrent().GetInfo(wxLOCALE_SHORT_DATE_FMT));
+    if ( m_format.Contains("%X") )
+        m_format.Replace("%X", wxUILocale::GetCurrent().GetInfo(wxLOCALE_TIME_FMT));
+#endif // wxUSE_INTL
+#endif // __WXOSX__
 
-const wchar_t* wxDateTime::ParseRfc822Date(const wchar_t* date)
-{
-    wxString::const_iterator end;
-    wxString dateStr(date);
-    if ( !ParseRfc822Date(dateStr, &end) )
-        return nullptr;
+    m_useStrftime =
+    m_genericCompiled = false;
 
-    return date + (end - dateStr.begin());
-}
+    // we have to use our own implementation if the date is out of range of
+    // strftime()
+#ifdef wxHAS_STRFTIME
+    m_useStrftime = true;
+    bool isPercent = false;
 
-bool
-wxDateTime::ParseFormat(const wxString& date,
-                        const wxString& format,
-                        const wxDateTime& dateDef,
-                        wxString::const_iterator *endParse)
-{
-    wxCHECK_MSG( !format.empty(), false, "format can't be empty" );
-    wxCHECK_MSG( endParse, false, "end iterator pointer must be specified" );
+    // We also can't use strftime() if we use non standard specifier: either
+    // our own extension "%l" or one of C99/POSIX specifiers not supported when
+    // using MinGW, see https://sourceforge.net/p/mingw-w64/bugs/793/
+    for ( wxString::const_iterator p = m_format.begin();
+          m_useStrftime && p != m_format.end();
+          ++p )
+    {
+        if (!isPercent)
+        {
+            isPercent = *p == '%';
+            continue;
+        }
+        isPercent = false;
 
-    unsigned long num;
+        switch ( (*p).GetValue() )
+        {
+            case 'l':
+#ifdef __MINGW32__
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'V':
+            case 'z':
+#endif // __MINGW32__
+                m_useStrftime = false;
+                break;
+        }
+    }
 
-    // what fields have we found?
-    bool haveWDay = false,
-         haveYDay = false,
-         haveDay = false,
-         haveMon = false,
-         haveYear = false,
-         haveHour = false,
-         haveMin = false,
-         haveSec = false,
-         haveMsec = false;
+    if ( m_useStrftime )
+    {
+        CompileStrftime();
+        return;
+    }
+#endif // wxHAS_STRFTIME
 
-    bool hourIsIn12hFormat = false, // or in 24h one?
-         isPM = false;              // AM by default
+    GetGenericSteps();
+}
 
-    bool haveTimeZone = false;
+#ifdef wxHAS_STRFTIME
 
-    // and the value of the items we have (init them to get rid of warnings)
-    wxDateTime_t msec = 0,
-                 sec = 0,
-                 min = 0,
-                 hour = 0;
-    WeekDay wday = Inv_WeekDay;
-    wxDateTime_t yday = 0,
-                 mday = 0;
-    wxDateTime::Month mon = Inv_Month;
-    int year = 0;
-    long timeZone = 0;  // time zone in seconds as expected in Tm structure
+void FormatProgram::CompileStrftime()
+{
+    FormatStepsBuilder builder(m_strftime);
 
-    wxString::const_iterator input = date.begin();
-    const wxString::const_iterator end = date.end();
-    for ( wxString::const_iterator fmt = format.begin(); fmt != format.end(); ++fmt )
+    for ( wxString::const_iterator p = m_format.begin(); p != m_format.end(); ++p )
     {
-        if ( *fmt != wxT('%') )
+        if ( *p != wxT('%') )
         {
-            if ( wxIsspace(*fmt) )
-            {
-                // a white space in the format string matches 0 or more white
-                // spaces in the input
-                while ( input != end && wxIsspace(*input) )
-                {
-                    ++input;
-                }
-            }
-            else // !space
-            {
-                // any other character (not whitespace, not '%') must be
-                // matched by itself in the input
-                if ( input == end || *input++ != *fmt )
-                {
-                    // no match
-                    return false;
-                }
-            }
-
-            // done with this format char
+            builder.AddText(*p);
             continue;
         }
 
-        // start of a format specification
-        ++fmt;
-
-        // skip the optional character specifying the padding: this is a GNU
-        // extension which we need to support as this is used in the default
-        // date formats for some locales (but luckily this is simple to do)
-        if ( *fmt == '-' || *fmt == '_' || *fmt == '0' )
-            ++fmt;
-
-        // parse the optional width
-        size_t width = 0;
-        while ( wxIsdigit(*fmt) )
+        const wxString::const_iterator specStart = p;
+
+        // parse the optional flags, width and modifier in the same way as GNU
+        // strftime() does
+        while ( ++p != m_format.end() &&
+                (*p == '_' || *p == '-' || *p == '0' ||
+                    *p == '^' || *p == '#' || *p == '+') )
+            ;
+        while ( p != m_format.end() && *p >= '0' && *p <= '9' )
+            ++p;
+        if ( p != m_format.end() && (*p == 'E' || *p == 'O') )
+            ++p;
+
+        FormatStep step;
+        if ( p == m_format.end() )
         {
-            width *= 10;
-            width += *fmt++ - '0';
+            // let strftime() deal with the incomplete specification
+            step.kind = FormatStep_Strftime;
+            step.text = wxString(specStart, p);
+            builder.AddStep(step);
+            break;
         }
 
-        // the default widths for the various fields
-        if ( !width )
+        step.text = wxString(specStart, p + 1);
+        const bool plain = p == specStart + 1;
+
+        switch ( (*p).GetValue() )
         {
-            switch ( (*fmt).GetValue() )
-            {
-                case wxT('Y'):               // year has 4 digits
-                    width = 4;
+            // the numeric fields are locale-independent unless modifiers
+            // are used, so format them ourselves
+            case 'd':
+            case 'm':
+            case 'y':
+            case 'Y':
+                if ( !plain )
+                {
+                    step.kind = FormatStep_DayText;
                     break;
+                }
+                wxFALLTHROUGH;
 
-                case wxT('j'):               // day of year has 3 digits
-                case wxT('l'):               // milliseconds have 3 digits
-                    width = 3;
+            case 'H':
+            case 'I':
+            case 'M':
+            case 'S':
+                if ( !plain )
+                {
+                    step.kind = FormatStep_Strftime;
                     break;
+                }
 
-                case wxT('w'):               // week day as number has only one
-                    width = 1;
-                    break;
+                step.kind = FormatStep_Number;
+                step.conv = *p;
+                step.numFmt = *p == 'Y' ? NumFormat(0, false) : NumFormat();
+                break;
 
-                default:
-                    // default for all other fields
-                    width = 2;
-            }
-        }
+            case 'p':
+                step.kind = plain ? FormatStep_AmPm : FormatStep_Strftime;
+                break;
 
-        // then the format itself
-        switch ( (*fmt).GetValue() )
-        {
-            case wxT('a'):       // a weekday name
-            case wxT('A'):
+            case 'n':
+            case 't':
+            case '%':
+                if ( plain )
                 {
-                    wday = GetWeekDayFromName
-                           (
-                            input, end,
-                            *fmt == 'a' ? Name_Abbr : Name_Full,
-                            DateLang_Local
-                           );
-                    if ( wday == Inv_WeekDay )
-                    {
-                        // no match
-                        return false;
-                    }
+                    builder.AddText(*p == 'n' ? wxT('\n')
+                                              : *p == 't' ? wxT('\t')
+                                                          : wxT('%'));
+                    continue;
                 }
-                haveWDay = true;
+
+                step.kind = FormatStep_Strftime;
                 break;
 
-            case wxT('b'):       // a month name
-            case wxT('B'):
-                {
-                    mon = GetMonthFromName
-                          (
-                            input, end,
-                            *fmt == 'b' ? Name_Abbr : Name_Full,
-                            DateLang_Local
-                          );
-                    if ( mon == Inv_Month )
-                    {
-                        // no match
-                        return false;
-                    }
-                }
-                haveMon = true;
+            // all these fields only depend on the date and the time zone
+            // which don't change during the day
+            case 'a':
+            case 'A':
+            case 'b':
+            case 'B':
+            case 'C':
+            case 'D':
+            case 'e':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'h':
+            case 'j':
+            case 'u':
+            case 'U':
+            case 'V':
+            case 'w':
+            case 'W':
+            case 'x':
+            case 'z':
+            case 'Z':
+                step.kind = FormatStep_DayText;
                 break;
 
-            case wxT('c'):       // locale default date and time  representation
-                {
-                    wxDateTime dt;
+            default:
+                step.kind = FormatStep_Strftime;
+        }
 
-#if wxUSE_INTL
-                    const wxString
-                        fmtDateTime = wxUILocale::GetCurrent().GetInfo(wxLOCALE_DATE_TIME_FMT);
-                    if ( !fmtDateTime.empty() )
-                        dt = ParseFormatAt(input, end, fmtDateTime);
-#endif // wxUSE_INTL
-                    if ( !dt.IsValid() )
-                    {
-                        // also try the format which corresponds to ctime()
-                        // output (i.e. the "C" locale default)
-                        dt = ParseFormatAt(input, end, wxS("%a %b %d %H:%M:%S %Y"));
-                    }
+        builder.AddStep(step);
+    }
 
-                    if ( !dt.IsValid() )
-                    {
-                        // and finally also the two generic date/time formats
-                        dt = ParseFormatAt(input, end, wxS("%x %X"), wxS("%X %x"));
-                    }
+    builder.FlushText();
+}
 
-                    if ( !dt.IsValid() )
-                        return false;
+#endif // wxHAS_STRFTIME
+
+void FormatProgram::CompileGeneric()
+{
+    FormatStepsBuilder builder(m_generic);
 
-                    const Tm tm = dt.GetTm();
+    for ( wxString::const_iterator p = m_format.begin(); p != m_format.end(); ++p )
+    {
+        if ( *p != wxT('%') )
+        {
+            builder.AddText(*p);
+            continue;
+        }
 
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+        if ( ++p == m_format.end() )
+        {
+            wxFAIL_MSG(wxT("missing format at the end of string"));
 
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+            // just put the '%' which was the last char in format
+            builder.AddText(wxT('%'));
+            break;
+        }
 
-                    haveDay = haveMon = haveYear =
-                    haveHour = haveMin = haveSec = true;
-                }
+        // set the default format
+        FormatStep step;
+        switch ( (*p).GetValue() )
+        {
+            case wxT('Y'):               // year has 4 digits
+            case wxT('G'):               // (and ISO week year too)
+            case wxT('z'):               // time zone as well
+                step.numFmt = NumFormat(4);
                 break;
 
-            case wxT('d'):       // day of a month (01-31)
-            case 'e':           // day of a month (1-31) (GNU extension)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (num > 31) || (num < 1) )
-                {
-                    // no match
-                    return false;
-                }
+            case wxT('j'):               // day of year has 3 digits
+            case wxT('l'):               // milliseconds have 3 digits
+                step.numFmt = NumFormat(3);
+                break;
 
-                // we can't check whether the day range is correct yet, will
-                // do it later - assume ok for now
-                haveDay = true;
-                mday = (wxDateTime_t)num;
+            case wxT('w'):               // week day as number has only one
+                step.numFmt = NumFormat(0, false);
                 break;
 
-            case wxT('F'):       // ISO 8601 date
-                {
-                    wxDateTime dt = ParseFormatAt(input, end, wxS("%Y-%m-%d"));
-                    if ( !dt.IsValid() )
-                        return false;
+            default:
+                // it's either another valid format specifier in which case
+                // the format is "%02d" (for all the rest) or we have the
+                // field width preceding the format in which case it will
+                // override the default format anyhow
+                step.numFmt = NumFormat();
+        }
 
-                    const Tm tm = dt.GetTm();
+        // is it the format width?
+        const wxString::const_iterator widthStart = p;
+        while ( p != m_format.end() &&
+                (*p == wxT('-') || *p == wxT('+') ||
+                    *p == wxT(' ') || wxIsdigit(*p)) )
+        {
+            ++p;
+        }
 
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+        if ( p == m_format.end() )
+        {
+            wxFAIL_MSG(wxT("missing format at the end of string"));
 
-                    haveDay = haveMon = haveYear = true;
-                }
-                break;
+            builder.AddText(wxT('%'));
+            break;
+        }
 
-            case wxT('H'):       // hour in 24h format (00-23)
-                if ( !GetNumericToken(width, input, end, &num) || (num > 23) )
-                {
-                    // no match
-                    return false;
-                }
+        if ( p != widthStart &&
+                !ParseNumFormat(wxString(widthStart, p), step.numFmt) )
+        {
+            wxFAIL_MSG(wxT("unsupported format width"));
+        }
 
-                haveHour = true;
-                hour = (wxDateTime_t)num;
+        step.conv = *p;
+        switch ( step.conv.GetValue() )
+        {
+            case wxT('d'):
+            case wxT('H'):
+            case wxT('I'):
+            case wxT('l'):
+            case wxT('m'):
+            case wxT('M'):
+            case wxT('S'):
+            case wxT('y'):
+            case wxT('Y'):
+                step.kind = FormatStep_Number;
                 break;
 
-            case wxT('I'):       // hour in 12h format (01-12)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        !num || (num > 12) )
-                {
-                    // no match
-                    return false;
-                }
+            case wxT('%'):       // a percent sign
+                builder.AddText(wxT('%'));
+                continue;
 
-                haveHour = true;
-                hourIsIn12hFormat = true;
-                hour = (wxDateTime_t)(num % 12);        // 12 should be 0
+            case wxT('c'):
+                step.kind = FormatStep_Generic;
                 break;
 
-            case wxT('j'):       // day of the year
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        !num || (num > 366) )
-                {
-                    // no match
-                    return false;
-                }
+#ifdef wxHAS_STRFTIME
+            case wxT('p'):
+                step.kind = FormatStep_AmPm;
+                break;
 
-                haveYDay = true;
-                yday = (wxDateTime_t)num;
+            case wxT('X'):
+            case wxT('Z'):
+                // just use strftime() to format the time for us
+                step.kind = FormatStep_StrftimeTimeOnly;
+                step.text << wxT('%') << step.conv;
+                break;
+#else // !wxHAS_STRFTIME
+            case wxT('p'):
+            case wxT('X'):
+                step.kind = FormatStep_Generic;
                 break;
 
-            case wxT('l'):       // milliseconds (0-999)
-                if ( !GetNumericToken(width, input, end, &num) )
-                    return false;
+            case wxT('Z'):
+                continue;
+#endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
 
-                haveMsec = true;
-                msec = (wxDateTime_t)num;
+            case wxT('g'):
+            case wxT('G'):
+            case wxT('U'):
+            case wxT('V'):
+            case wxT('W'):
+            case wxT('x'):
+            case wxT('z'):
+                step.kind = FormatStep_DayText;
+                step.localOnly = true;
                 break;
 
-            case wxT('m'):       // month as a number (01-12)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        !num || (num > 12) )
-                {
-                    // no match
-                    return false;
-                }
-
-                haveMon = true;
-                mon = (Month)(num - 1);
+            case wxT('a'):
+            case wxT('A'):
+            case wxT('b'):
+            case wxT('B'):
+            case wxT('F'):
+            case wxT('j'):
+            case wxT('w'):
+                step.kind = FormatStep_DayText;
                 break;
 
-            case wxT('M'):       // minute as a decimal number (00-59)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (num > 59) )
-                {
-                    // no match
-                    return false;
-                }
+            default:
+                wxFAIL_MSG(wxT("unknown format specifier"));
 
-                haveMin = true;
-                min = (wxDateTime_t)num;
-                break;
+                builder.AddText(*p);
+                continue;
+        }
 
-            case wxT('p'):       // AM or PM string
-                {
-                    wxString am, pm;
-                    GetAmPmStrings(&am, &pm);
+        builder.AddStep(step);
+    }
 
-                    // we can never match %p in locales which don't use AM/PM
-                    if ( am.empty() || pm.empty() )
-                        return false;
+    builder.FlushText();
+}
 
-                    const size_t pos = input - date.begin();
-                    if ( date.compare(pos, pm.length(), pm) == 0 )
-                    {
-                        isPM = true;
-                        input += pm.length();
-                    }
-                    else if ( date.compare(pos, am.length(), am) == 0 )
-                    {
-                        input += am.length();
-                    }
-                    else // no match
-                    {
-                        return false;
-                    }
-                }
-                break;
+// the data which remains the same during an interval of time with the same
+// date and UTC offset, which is normally the entire day
+class FormatDay
+{
+public:
+    FormatDay() { Invalidate(); }
 
-            case wxT('r'):       // time as %I:%M:%S %p
-                {
-                    wxDateTime dt;
-                    if ( !dt.ParseFormat(wxString(input, end),
-                                         wxS("%I:%M:%S %p"), &input) )
-                        return false;
+    void Invalidate()
+    {
+        m_start =
+        m_end = 0;
+    }
 
-                    haveHour = haveMin = haveSec = true;
+    // update the data to correspond to the interval containing the given
+    // time, which is, if possible, the entire day or at least the current
+    // hour of it if wholeDay is true, or just the current second otherwise
+    //
+    // returns false if the time can't be converted to broken down time using
+    // the standard functions
+    bool Update(const FormatSteps& steps,
+                const wxDateTime& dt,
+                time_t t,
+                const wxDateTime::TimeZone& tz,
+                bool wholeDay);
+
+    // get the broken down time for the given time inside the interval
+    void GetTm(const wxDateTime& dt,
+               time_t t,
+               wxDateTime::Tm& tm,
+               struct tm& tmNow) const
+    {
+        const long sec = m_sec + static_cast<long>(t - m_start);
+
+        tm = m_tm;
+        tm.hour = static_cast<wxDateTime::wxDateTime_t>(sec / 3600);
+        tm.min = static_cast<wxDateTime::wxDateTime_t>((sec / 60) % 60);
+        tm.sec = static_cast<wxDateTime::wxDateTime_t>(sec % 60);
+        tm.msec = static_cast<wxDateTime::wxDateTime_t>
+                    ((dt.GetValue() % 1000).ToLong());
+
+        tmNow = m_tmStart;
+        tmNow.tm_hour = tm.hour;
+        tmNow.tm_min = tm.min;
+        tmNow.tm_sec = tm.sec;
+    }
 
-                    const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
-                }
-                break;
+    const wxString& GetText(size_t index) const { return m_texts[index]; }
 
-            case wxT('R'):       // time as %H:%M
-                {
-                    const wxDateTime
-                        dt = ParseFormatAt(input, end, wxS("%H:%M"));
-                    if ( !dt.IsValid() )
-                        return false;
+    const wxString& GetAmPm(int hour) const { return hour < 12 ? m_am : m_pm; }
 
-                    haveHour =
-                    haveMin = true;
+private:
+    // check if the given time is in the same day as m_tmStart, with the same
+    // UTC offset, and corresponds to the given number of seconds since its
+    // midnight
+    bool IsSameDay(time_t t, long sec, const wxDateTime::TimeZone& tz) const;
 
-                    const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                }
-                break;
+    // the interval: m_start corresponds to m_sec seconds since midnight and
+    // m_tmStart and m_tm are the broken down time at its beginning
+    time_t m_start,
+           m_end;
+    long m_sec;
+    struct tm m_tmStart;
+    wxDateTime::Tm m_tm;
 
-            case wxT('S'):       // second as a decimal number (00-61)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (num > 61) )
-                {
-                    // no match
-                    return false;
-                }
+    std::vector<wxString> m_texts;
+    wxString m_am,
+             m_pm;
+};
 
-                haveSec = true;
-                sec = (wxDateTime_t)num;
-                break;
+bool
+FormatDay::IsSameDay(time_t t, long sec, const wxDateTime::TimeZone& tz) const
+{
+    struct tm tmstruct;
+    const tm* const tm = wxTryGetTm(tmstruct, t, tz);
+
+    return tm &&
+            tm->tm_mday == m_tmStart.tm_mday &&
+            tm->tm_mon == m_tmStart.tm_mon &&
+            tm->tm_year == m_tmStart.tm_year &&
+            tm->tm_isdst == m_tmStart.tm_isdst &&
+            3600l*tm->tm_hour + 60l*tm->tm_min + tm->tm_sec == sec;
+}
 
-            case wxT('T'):       // time as %H:%M:%S
-                {
-                    const wxDateTime
-                        dt = ParseFormatAt(input, end, wxS("%H:%M:%S"));
-                    if ( !dt.IsValid() )
-                        return false;
+bool FormatDay::Update(const FormatSteps& steps,
+                       const wxDateTime& dt,
+                       time_t t,
+                       const wxDateTime::TimeZone& tz,
+                       bool wholeDay)
+{
+    if ( t >= m_start && t < m_end )
+        return true;
 
-                    haveHour =
-                    haveMin =
-                    haveSec = true;
+    struct tm tmstruct;
+    const tm* const tmNow = wxTryGetTm(tmstruct, t, tz);
+    if ( !tmNow )
+        return false;
 
-                    const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
-                }
-                break;
+    m_tmStart = *tmNow;
+    const long sec = 3600l*m_tmStart.tm_hour + 60l*m_tmStart.tm_min +
+                        m_tmStart.tm_sec;
 
+    // try the entire day first, then fall back to the current hour for the
+    // days with DST transitions and, finally, just the current second
+    const long secHour = 3600l*m_tmStart.tm_hour;
+    if ( wholeDay &&
+            IsSameDay(t - sec, 0, tz) && IsSameDay(t - sec + 86399, 86399, tz) )
+    {
+        m_start = t - sec;
+        m_end = m_start + 86400;
+        m_sec = 0;
+    }
+    else if ( wholeDay &&
+                IsSameDay(t - (sec - secHour), secHour, tz) &&
+                IsSameDay(t - (sec - secHour) + 3599, secHour + 3599, tz) )
+    {
+        m_start = t - (sec - secHour);
+        m_end = m_start + 3600;
+        m_sec = secHour;
+    }
+    else
+    {
+        m_start = t;
+        m_end = t + 1;
+        m_sec = sec;
+    }
+
+    m_tmStart.tm_hour = static_cast<int>(m_sec / 3600);
+    m_tmStart.tm_min = static_cast<int>((m_sec / 60) % 60);
+    m_tmStart.tm_sec = static_cast<int>(m_sec % 60);
+    m_tm = wxDateTime::Tm(m_tmStart, tz);
+
+    m_texts.resize(steps.numDayTexts);
+
+    for ( size_t n = 0; n < steps.steps.size(); ++n )
+    {
+        const FormatStep& step = steps.steps[n];
+        if ( step.kind != FormatStep_DayText )
+            continue;
+
+        wxString& text = m_texts[step.index];
+        text.clear();
+
+#ifdef wxHAS_STRFTIME
+        if ( !step.text.empty() )
+        {
+            text = DoStrftime(step.text, &m_tmStart);
+            continue;
+        }
+#endif // wxHAS_STRFTIME
+
+        // these fields are computed for each date
+        if ( step.localOnly && !tz.IsLocal() )
+            continue;
+
+        wxDateTime::Tm tm = m_tm;
+        AppendGenericField(text, step.conv, step.numFmt, dt, tm, tz);
+    }
+
+#ifdef wxHAS_STRFTIME
+    if ( steps.hasAmPm )
+    {
+        struct tm tmAmPm;
+        InitTmTimeOnly(tmAmPm, 0, 0, 0);
+        m_am = DoStrftime(wxS("%p"), &tmAmPm);
+        tmAmPm.tm_hour = 13;
+        m_pm = DoStrftime(wxS("%p"), &tmAmPm);
+    }
+#endif // wxHAS_STRFTIME
+
+    return true;
+}
+
+// run the format steps for the given date: day is null and tmNow is unused if
+// the date is out of range of the standard functions
+void RunFormat(const FormatSteps& steps,
+               wxString& str,
+               const wxDateTime& dt,
+               const wxDateTime::TimeZone& tz,
+               wxDateTime::Tm& tm,
+               const struct tm& tmNow,
+               const FormatDay* day)
+{
+    for ( size_t n = 0; n < steps.steps.size(); ++n )
+    {
+        const FormatStep& step = steps.steps[n];
+        switch ( step.kind )
+        {
+            case FormatStep_Text:
+                str += step.text;
+                break;
+
+            case FormatStep_DayText:
+                if ( day && (!step.localOnly || tz.IsLocal()) )
+                {
+                    str += day->GetText(step.index);
+                    break;
+                }
+
+                AppendGenericField(str, step.conv, step.numFmt, dt, tm, tz);
+                break;
+
+            case FormatStep_Number:
+                AppendNumber(str, GetNumericField(step.conv, tm), step.numFmt);
+                break;
+
+#ifdef wxHAS_STRFTIME
+            case FormatStep_AmPm:
+                if ( day )
+                {
+                    str += day->GetAmPm(tm.hour);
+                }
+                else
+                {
+                    struct tm tmTimeOnly;
+                    InitTmTimeOnly(tmTimeOnly, tm.hour, tm.min, tm.sec);
+                    str += DoStrftime(wxS("%p"), &tmTimeOnly);
+                }
+                break;
+
+            case FormatStep_Strftime:
+                str += DoStrftime(step.text, &tmNow);
+                break;
+
+            case FormatStep_StrftimeTimeOnly:
+                {
+                    struct tm tmTimeOnly;
+                    InitTmTimeOnly(tmTimeOnly, tm.hour, tm.min, tm.sec);
+                    str += DoStrftime(step.text, &tmTimeOnly);
+                }
+                break;
+#else // !wxHAS_STRFTIME
+            case FormatStep_AmPm:
+            case FormatStep_Strftime:
+            case FormatStep_StrftimeTimeOnly:
+                wxFAIL_MSG( "unreachable" );
+                break;
+#endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
+
+            case FormatStep_Generic:
+                AppendGenericField(str, step.conv, step.numFmt, dt, tm, tz);
+                break;
+        }
+    }
+}
+
+// append the date formatted using the given program to str, using and
+// updating the data cached in day
+void DoFormat(FormatProgram& program,
+              FormatDay& day,
+              wxString& str,
+              const wxDateTime& dt,
+              const wxDateTime::TimeZone& tz,
+              bool wholeDay)
+{
+    const FormatSteps& steps = program.GetSteps();
+
+    const time_t t = dt.GetTicks();
+    if ( t != (time_t)-1 && day.Update(steps, dt, t, tz, wholeDay) )
+    {
+        wxDateTime::Tm tm;
+        struct tm tmNow;
+        day.GetTm(dt, t, tm, tmNow);
+
+        RunFormat(steps, str, dt, tz, tm, tmNow, &day);
+    }
+    else
+    {
+        wxDateTime::Tm tm = dt.GetTm(tz);
+
+        struct tm tmNow;
+        InitTmTimeOnly(tmNow, tm.hour, tm.min, tm.sec);
+
+        RunFormat(program.GetGenericSteps(), str, dt, tz, tm, tmNow, nullptr);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// parsing
+// ----------------------------------------------------------------------------
+
+// the kinds of steps of the compiled format used for parsing
+enum ParseStepKind
+{
+    ParseStep_Space,            // skip any white space
+    ParseStep_Char,             // match the given character
+    ParseStep_Number,           // numeric field
+    ParseStep_WeekDay,          // week day name
+    ParseStep_Month,            // month name
+    ParseStep_AmPm,             // AM or PM string
+    ParseStep_TimeZone,         // time zone offset
+    ParseStep_TimeZoneName,     // skip the time zone name
+    ParseStep_CheckDay,         // check the day parsed as part of "%F"
+    ParseStep_NormalizeTime,    // normalize the time parsed as part of "%T"
+    ParseStep_SubDate,          // date or time parsed using another format
+    ParseStep_Fail              // something which can never match
+};
+
+struct ParseStep
+{
+    ParseStep()
+    {
+        kind = ParseStep_Fail;
+        width = 0;
+    }
+
+    ParseStepKind kind;
+
+    // the character to match or the field conversion character
+    wxUniChar ch;
+
+    // the maximal number of digits for ParseStep_Number or name flags
+    size_t width;
+
+    // the indices of the formats to try, in order, for ParseStep_SubDate
+    std::vector<size_t> alternatives;
+};
+
+// advance p past the given string if the input starts with it
+bool
+SkipString(wxString::const_iterator& p,
+           const wxString::const_iterator& end,
+           const wxString& s)
+{
+    wxString::const_iterator q = p;
+    for ( wxString::const_iterator i = s.begin(); i != s.end(); ++i, ++q )
+    {
+        if ( q == end || *q != *i )
+            return false;
+    }
+
+    p = q;
+    return true;
+}
+
+// parse the time zone offset in ISO 8601 format
+bool
+ParseTimeZoneOffset(wxString::const_iterator& input,
+                    const wxString::const_iterator& end,
+                    ParsedDateTime& parsed)
+{
+    // check that we have something here at all
+    if ( input == end )
+        return false;
+
+    if ( *input == wxS('Z') )
+    {
+        // Time is in UTC.
+        ++input;
+        parsed.haveTimeZone = true;
+        return true;
+    }
+
+    // Check if there's either a plus, hyphen-minus, or
+    // minus sign.
+    bool minusFound;
+    if ( *input == wxS('+') )
+        minusFound = false;
+    else if
+    (
+        *input == wxS('-')
+        || *input == wxString::FromUTF8("\xe2\x88\x92")
+    )
+        minusFound = true;
+    else
+        return false;   // no match
+
+    ++input;
+
+    // Here should follow exactly 2 digits for hours (HH).
+    const size_t numRequiredDigits = 2;
+    size_t numScannedDigits;
+
+    unsigned long hours;
+    if ( !GetNumericToken(numRequiredDigits, input, end,
+                          &hours, &numScannedDigits)
+         || numScannedDigits != numRequiredDigits)
+    {
+        return false; // No match.
+    }
+
+    // Optionally followed by a colon separator.
+    bool mustHaveMinutes = false;
+    if ( input != end && *input == wxS(':') )
+    {
+        mustHaveMinutes = true;
+        ++input;
+    }
+
+    // Optionally followed by exactly 2 digits for minutes (MM).
+    unsigned long minutes = 0;
+    if ( !GetNumericToken(numRequiredDigits, input, end,
+                          &minutes, &numScannedDigits)
+         || numScannedDigits != numRequiredDigits)
+    {
+        if (mustHaveMinutes || numScannedDigits)
+        {
+            // No match if we must have minutes, or digits
+            // for minutes were specified but not exactly 2.
+            return false;
+        }
+    }
+
+    /*
+    Contemporary offset limits are -12:00 and +14:00.
+    However historically offsets of over +/- 15 hours
+    existed so be a bit more flexible. Info retrieved
+    from Time Zone Database at
+    https://www.iana.org/time-zones.
+    */
+    if ( hours > 15 || minutes > 59 )
+        return false;   // bad format
+
+    parsed.timeZone = 3600*hours + 60*minutes;
+    if ( minusFound )
+        parsed.timeZone = -parsed.timeZone;
+
+    parsed.haveTimeZone = true;
+
+    return true;
+}
+
+// the data used when parsing which can be reused by the subsequent calls
+class ParseState
+{
+public:
+    ParseState()
+    {
+        m_amPmOk =
+        m_dayOk = false;
+    }
+
+    // discard the cached locale-dependent data
+    void Invalidate() { m_amPmOk = false; }
+
+    const wxString& GetAm() { UpdateAmPm(); return m_am; }
+    const wxString& GetPm() { UpdateAmPm(); return m_pm; }
+
+    // get the time corresponding to the given broken down local time using
+    // the cached start of its day, if the day doesn't have DST transitions
+    bool GetDayStart(const wxDateTime::Tm& tm, time_t* t);
+
+private:
+    void UpdateAmPm()
+    {
+        if ( !m_amPmOk )
+        {
+            wxDateTime::GetAmPmStrings(&m_am, &m_pm);
+            m_amPmOk = true;
+        }
+    }
+
+    bool m_amPmOk;
+    wxString m_am,
+             m_pm;
+
+    // the start of the last day used by GetDayStart() if m_dayOk
+    bool m_dayOk;
+    int m_dayYear;
+    wxDateTime::Month m_dayMon;
+    wxDateTime::wxDateTime_t m_dayMday;
+    time_t m_dayStart;
+};
+
+bool ParseState::GetDayStart(const wxDateTime::Tm& tm, time_t* t)
+{
+    if ( !m_dayOk ||
+            tm.year != m_dayYear ||
+            tm.mon != m_dayMon ||
+            tm.mday != m_dayMday )
+    {
+        m_dayOk = false;
+
+        // find the start of the day without using mktime() as its results
+        // for the ambiguous times depend on its previous calls: first find
+        // the UTC offset at the UTC midnight and then check that it's the
+        // same during the entire local day
+        const time_t midnightUTC = GetDaysSinceEpoch(tm.year, tm.mon, tm.mday)
+                                    * 86400;
+
+        struct tm tmstruct;
+        const struct tm* tmLocal = wxLocaltime_r(&midnightUTC, &tmstruct);
+        if ( !tmLocal )
+            return false;
+
+        const time_t start = midnightUTC -
+            (GetDaysSinceEpoch(tmLocal->tm_year + 1900,
+                               static_cast<wxDateTime::Month>(tmLocal->tm_mon),
+                               tmLocal->tm_mday) * 86400 +
+             3600l*tmLocal->tm_hour + 60l*tmLocal->tm_min + tmLocal->tm_sec -
+             midnightUTC);
+
+        // only use the cached value for the days without DST transitions,
+        // when all times of the day are just offsets from its start
+        const struct tm* tmStart = wxLocaltime_r(&start, &tmstruct);
+        if ( !tmStart ||
+                tmStart->tm_year != tm.year - 1900 ||
+                tmStart->tm_mon != tm.mon ||
+                tmStart->tm_mday != tm.mday ||
+                tmStart->tm_hour || tmStart->tm_min || tmStart->tm_sec )
+            return false;
+
+        const int isdst = tmStart->tm_isdst;
+
+        const time_t last = start + 86399;
+        const struct tm* tmEnd = wxLocaltime_r(&last, &tmstruct);
+        if ( !tmEnd ||
+                tmEnd->tm_mday != tm.mday ||
+                tmEnd->tm_hour != 23 ||
+                tmEnd->tm_min != 59 ||
+                tmEnd->tm_sec != 59 ||
+                tmEnd->tm_isdst != isdst )
+            return false;
+
+        m_dayOk = true;
+        m_dayYear = tm.year;
+        m_dayMon = tm.mon;
+        m_dayMday = tm.mday;
+        m_dayStart = start;
+    }
+
+    *t = m_dayStart + 3600l*tm.hour + 60l*tm.min + tm.sec;
+
+    return true;
+}
+
+// the compiled format used for parsing dates
+class ParseProgram
+{
+public:
+    void Compile(const wxString& format)
+    {
+        m_formats.clear();
+        DoCompile(format, 0);
+    }
+
+    // parse the date starting at input and advance it to the end of the match
+    // if successful; if cacheDay is true, the start of the day cached in the
+    // state is used to avoid calling mktime() for each date
+    bool Run(wxString::const_iterator& input,
+             const wxString::const_iterator& end,
+             wxDateTime* dt,
+             const wxDateTime& dateDef,
+             ParseState& state,
+             bool cacheDay) const
+    {
+        return DoRun(0, input, end, dt, dateDef, state, cacheDay);
+    }
+
+private:
+    // compile the format and return its index in m_formats
+    size_t DoCompile(const wxString& format, int depth);
+
+    // add the step parsing a part of the date using one of the given formats
+    void AddSubDate(std::vector<ParseStep>& steps,
+                    const wxUniChar& ch,
+                    const std::vector<wxString>& formats,
+                    int depth);
+
+    bool DoRun(size_t index,
+               wxString::const_iterator& input,
+               const wxString::const_iterator& end,
+               wxDateTime* dt,
+               const wxDateTime& dateDef,
+               ParseState& state,
+               bool cacheDay) const;
+
+    // the main format is the first one, the others are used by the
+    // ParseStep_SubDate steps
+    std::vector< std::vector<ParseStep> > m_formats;
+};
+
+void
+ParseProgram::AddSubDate(std::vector<ParseStep>& steps,
+                         const wxUniChar& ch,
+                         const std::vector<wxString>& formats,
+                         int depth)
+{
+    ParseStep step;
+
+    // the locale formats are not supposed to use "%c" or "%x" themselves, but
+    // avoid infinite recursion if they do
+    if ( depth < 3 )
+    {
+        step.kind = ParseStep_SubDate;
+        step.ch = ch;
+        for ( size_t n = 0; n < formats.size(); ++n )
+            step.alternatives.push_back(DoCompile(formats[n], depth + 1));
+    }
+
+    steps.push_back(step);
+}
+
+size_t ParseProgram::DoCompile(const wxString& format, int depth)
+{
+    const size_t index = m_formats.size();
+    m_formats.push_back(std::vector<ParseStep>());
+
+    std::vector<ParseStep> steps;
+    ParseStep step;
+
+    const auto addStep = [&](ParseStepKind kind, const wxUniChar& ch)
+    {
+        step.kind = kind;
+        step.ch = ch;
+        steps.push_back(step);
+    };
+
+    // add the field with its default width
+    const auto addNumber = [&](const wxUniChar& ch, size_t width)
+    {
+        step.width = width;
+        addStep(ParseStep_Number, ch);
+    };
+
+    for ( wxString::const_iterator fmt = format.begin(); fmt != format.end(); ++fmt )
+    {
+        if ( *fmt != wxT('%') )
+        {
+            // a white space in the format string matches 0 or more white
+            // spaces in the input while any other character (not whitespace,
+            // not '%') must be matched by itself
+            if ( wxIsspace(*fmt) )
+                addStep(ParseStep_Space, 0);
+            else
+                addStep(ParseStep_Char, *fmt);
+
+            continue;
+        }
+
+        // skip the optional character specifying the padding: this is a GNU
+        // extension which we need to support as this is used in the default
+        // date formats for some locales (but luckily this is simple to do)
+        if ( ++fmt != format.end() &&
+                (*fmt == '-' || *fmt == '_' || *fmt == '0') )
+            ++fmt;
+
+        // parse the optional width
+        size_t width = 0;
+        while ( fmt != format.end() && wxIsdigit(*fmt) )
+        {
+            width *= 10;
+            width += *fmt++ - '0';
+        }
+
+        if ( fmt == format.end() )
+        {
+            wxFAIL_MSG(wxT("unexpected format end"));
+
+            addStep(ParseStep_Fail, 0);
+            break;
+        }
+
+        const wxUniChar ch = *fmt;
+
+        // the default widths for the various fields
+        if ( !width )
+        {
+            switch ( ch.GetValue() )
+            {
+                case wxT('Y'):               // year has 4 digits
+                    width = 4;
+                    break;
+
+                case wxT('j'):               // day of year has 3 digits
+                case wxT('l'):               // milliseconds have 3 digits
+                    width = 3;
+                    break;
+
+                case wxT('w'):               // week day as number has only one
+                    width = 1;
+                    break;
+
+                default:
+                    // default for all other fields
+                    width = 2;
+            }
+        }
+
+        step.width = width;
+        switch ( ch.GetValue() )
+        {
+            case wxT('a'):       // a weekday name
+            case wxT('b'):       // a month name
+                step.width = wxDateTime::Name_Abbr;
+                addStep(ch == 'a' ? ParseStep_WeekDay : ParseStep_Month, ch);
+                break;
+
+            case wxT('A'):
+            case wxT('B'):
+                step.width = wxDateTime::Name_Full;
+                addStep(ch == 'A' ? ParseStep_WeekDay : ParseStep_Month, ch);
+                break;
+
+            case wxT('c'):       // locale default date and time  representation
+                {
+                    std::vector<wxString> formats;
+
+#if wxUSE_INTL
+                    const wxString
+                        fmtDateTime = wxUILocale::GetCurrent().GetInfo(wxLOCALE_DATE_TIME_FMT);
+                    if ( !fmtDateTime.empty() )
+                        formats.push_back(fmtDateTime);
+#endif // wxUSE_INTL
+
+                    // also try the format which corresponds to ctime()
+                    // output (i.e. the "C" locale default)
+                    formats.push_back(wxS("%a %b %d %H:%M:%S %Y"));
+
+                    // and finally also the two generic date/time formats
+                    formats.push_back(wxS("%x %X"));
+                    formats.push_back(wxS("%X %x"));
+
+                    AddSubDate(steps, ch, formats, depth);
+                }
+                break;
+
+            case wxT('d'):       // day of a month (01-31)
+            case wxT('e'):       // day of a month (1-31) (GNU extension)
+            case wxT('H'):       // hour in 24h format (00-23)
+            case wxT('I'):       // hour in 12h format (01-12)
+            case wxT('j'):       // day of the year
+            case wxT('l'):       // milliseconds (0-999)
+            case wxT('m'):       // month as a number (01-12)
+            case wxT('M'):       // minute as a decimal number (00-59)
+            case wxT('S'):       // second as a decimal number (00-61)
             case wxT('w'):       // weekday as a number (0-6), Sunday = 0
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (wday > 6) )
+            case wxT('y'):       // year without century (00-99)
+            case wxT('Y'):       // year with century
+                addStep(ParseStep_Number, ch);
+                break;
+
+            case wxT('F'):       // ISO 8601 date
+                addNumber('Y', 4);
+                addStep(ParseStep_Char, '-');
+                addNumber('m', 2);
+                addStep(ParseStep_Char, '-');
+                addNumber('d', 2);
+                addStep(ParseStep_CheckDay, 0);
+                break;
+
+            case wxT('p'):       // AM or PM string
+                addStep(ParseStep_AmPm, ch);
+                break;
+
+            case wxT('r'):       // time as %I:%M:%S %p
+                AddSubDate(steps, ch,
+                           std::vector<wxString>(1, wxS("%I:%M:%S %p")),
+                           depth);
+                break;
+
+            case wxT('R'):       // time as %H:%M
+            case wxT('T'):       // time as %H:%M:%S
+                addNumber('H', 2);
+                addStep(ParseStep_Char, ':');
+                addNumber('M', 2);
+                if ( ch == 'T' )
+                {
+                    addStep(ParseStep_Char, ':');
+                    addNumber('S', 2);
+                    addStep(ParseStep_NormalizeTime, ch);
+                }
+                break;
+
+            case wxT('x'):       // locale default date representation
+                {
+#if wxUSE_INTL
+                    wxString
+                        fmtDate = wxUILocale::GetCurrent().GetInfo(wxLOCALE_SHORT_DATE_FMT),
+                        fmtDateAlt = wxUILocale::GetCurrent().GetInfo(wxLOCALE_LONG_DATE_FMT);
+#else // !wxUSE_INTL
+                    wxString fmtDate, fmtDateAlt;
+#endif // wxUSE_INTL/!wxUSE_INTL
+                    if ( fmtDate.empty() )
+                    {
+                        if ( wxDateTime::IsWestEuropeanCountry(wxDateTime::GetCountry()) ||
+                             wxDateTime::GetCountry() == wxDateTime::Russia )
+                        {
+                            fmtDate = wxS("%d/%m/%Y");
+                            fmtDateAlt = wxS("%m/%d/%Y");
+                        }
+                        else // assume USA
+                        {
+                            fmtDate = wxS("%m/%d/%Y");
+                            fmtDateAlt = wxS("%d/%m/%Y");
+                        }
+                    }
+
+                    std::vector<wxString> formats;
+                    formats.push_back(fmtDate);
+                    if ( !fmtDateAlt.empty() )
+                        formats.push_back(fmtDateAlt);
+
+                    // try with short years too
+                    if ( fmtDate.Replace("%Y", "%y") )
+                        formats.push_back(fmtDate);
+                    if ( fmtDateAlt.Replace("%Y", "%y") )
+                        formats.push_back(fmtDateAlt);
+
+                    AddSubDate(steps, ch, formats, depth);
+                }
+                break;
+
+            case wxT('X'):       // locale default time representation
+                {
+#if wxUSE_INTL
+                    const wxString
+                        fmtTime = wxUILocale::GetCurrent().GetInfo(wxLOCALE_TIME_FMT);
+#else // !wxUSE_INTL
+                    const wxString fmtTime;
+#endif // wxUSE_INTL/!wxUSE_INTL
+
+                    std::vector<wxString> formats;
+                    if ( !fmtTime.empty() )
+                    {
+                        formats.push_back(fmtTime);
+                    }
+                    else
+                    {
+                        // try to parse what follows as "%H:%M:%S" and, if this
+                        // fails, as "%I:%M:%S %p" - this should catch the most
+                        // common cases
+                        formats.push_back(wxS("%T"));
+                        formats.push_back(wxS("%r"));
+                    }
+
+                    AddSubDate(steps, ch, formats, depth);
+                }
+                break;
+
+            case wxT('z'):
+                addStep(ParseStep_TimeZone, ch);
+                break;
+
+            case wxT('Z'):       // timezone name
+                addStep(ParseStep_TimeZoneName, ch);
+                break;
+
+            case wxT('%'):       // a percent sign
+                addStep(ParseStep_Char, ch);
+                break;
+
+            default:            // not a known format spec
+                addStep(ParseStep_Fail, ch);
+        }
+    }
+
+    m_formats[index].swap(steps);
+
+    return index;
+}
+
+bool
+ParseProgram::DoRun(size_t index,
+                    wxString::const_iterator& input,
+                    const wxString::const_iterator& end,
+                    wxDateTime* dt,
+                    const wxDateTime& dateDef,
+                    ParseState& state,
+                    bool cacheDay) const
+{
+    const std::vector<ParseStep>& steps = m_formats[index];
+
+    unsigned long num;
+
+    // what fields have we found and their values
+    ParsedDateTime parsed;
+
+    for ( size_t n = 0; n < steps.size(); ++n )
+    {
+        const ParseStep& step = steps[n];
+        switch ( step.kind )
+        {
+            case ParseStep_Space:
+                while ( input != end && wxIsspace(*input) )
+                    ++input;
+                break;
+
+            case ParseStep_Char:
+                if ( input == end || *input++ != step.ch )
+                    return false;
+                break;
+
+            case ParseStep_Number:
+                if ( !GetNumericToken(step.width, input, end, &num) )
+                    return false;
+
+                switch ( step.ch.GetValue() )
+                {
+                    case wxT('d'):
+                    case wxT('e'):
+                        if ( num > 31 || num < 1 )
+                            return false;
+
+                        // we can't check whether the day range is correct
+                        // yet, will do it later - assume ok for now
+                        parsed.haveDay = true;
+                        parsed.mday = (wxDateTime::wxDateTime_t)num;
+                        break;
+
+                    case wxT('H'):
+                        if ( num > 23 )
+                            return false;
+
+                        parsed.haveHour = true;
+                        parsed.hour = (wxDateTime::wxDateTime_t)num;
+                        break;
+
+                    case wxT('I'):
+                        if ( !num || num > 12 )
+                            return false;
+
+                        parsed.haveHour = true;
+                        parsed.hourIsIn12hFormat = true;
+                        parsed.hour = (wxDateTime::wxDateTime_t)(num % 12); // 12 should be 0
+                        break;
+
+                    case wxT('j'):
+                        if ( !num || num > 366 )
+                            return false;
+
+                        parsed.haveYDay = true;
+                        parsed.yday = (wxDateTime::wxDateTime_t)num;
+                        break;
+
+                    case wxT('l'):
+                        parsed.haveMsec = true;
+                        parsed.msec = (wxDateTime::wxDateTime_t)num;
+                        break;
+
+                    case wxT('m'):
+                        if ( !num || num > 12 )
+                            return false;
+
+                        parsed.haveMon = true;
+                        parsed.mon = (wxDateTime::Month)(num - 1);
+                        break;
+
+                    case wxT('M'):
+                        if ( num > 59 )
+                            return false;
+
+                        parsed.haveMin = true;
+                        parsed.min = (wxDateTime::wxDateTime_t)num;
+                        break;
+
+                    case wxT('S'):
+                        if ( num > 61 )
+                            return false;
+
+                        parsed.haveSec = true;
+                        parsed.sec = (wxDateTime::wxDateTime_t)num;
+                        break;
+
+                    case wxT('w'):
+                        if ( num > 6 )
+                            return false;
+
+                        parsed.haveWDay = true;
+                        parsed.wday = (wxDateTime::WeekDay)num;
+                        break;
+
+                    case wxT('y'):
+                        if ( num > 99 )
+                            return false;
+
+                        parsed.haveYear = true;
+
+                        // TODO should have an option for roll over date
+                        //      instead of hard coding it here
+                        parsed.year = (num > 30 ? 1900 : 2000) +
+                                        (wxDateTime::wxDateTime_t)num;
+                        break;
+
+                    case wxT('Y'):
+                        parsed.haveYear = true;
+                        parsed.year = (wxDateTime::wxDateTime_t)num;
+                        break;
+                }
+                break;
+
+            case ParseStep_WeekDay:
+                parsed.wday = GetWeekDayFromName(input, end,
+                                                 static_cast<int>(step.width),
+                                                 DateLang_Local);
+                if ( parsed.wday == wxDateTime::Inv_WeekDay )
+                    return false;
+
+                parsed.haveWDay = true;
+                break;
+
+            case ParseStep_Month:
+                parsed.mon = GetMonthFromName(input, end,
+                                              static_cast<int>(step.width),
+                                              DateLang_Local);
+                if ( parsed.mon == wxDateTime::Inv_Month )
+                    return false;
+
+                parsed.haveMon = true;
+                break;
+
+            case ParseStep_AmPm:
+                {
+                    const wxString& am = state.GetAm();
+                    const wxString& pm = state.GetPm();
+
+                    // we can never match %p in locales which don't use AM/PM
+                    if ( am.empty() || pm.empty() )
+                        return false;
+
+                    if ( SkipString(input, end, pm) )
+                        parsed.isPM = true;
+                    else if ( !SkipString(input, end, am) )
+                        return false;
+                }
+                break;
+
+            case ParseStep_TimeZone:
+                if ( !ParseTimeZoneOffset(input, end, parsed) )
+                    return false;
+                break;
+
+            case ParseStep_TimeZoneName:
+                // FIXME: currently we just ignore everything that looks like a
+                //        time zone here
+                GetAlphaToken(input, end);
+                break;
+
+            case ParseStep_CheckDay:
+                if ( parsed.mday > wxDateTime::GetNumberOfDays(parsed.mon,
+                                                               parsed.year) )
+                    return false;
+                break;
+
+            case ParseStep_NormalizeTime:
+                // the leap seconds are carried over to the next minute
+                if ( parsed.sec > 59 )
                 {
-                    // no match
-                    return false;
-                }
+                    const long sec = (3600l*parsed.hour + 60l*parsed.min +
+                                        parsed.sec) % 86400;
 
-                haveWDay = true;
-                wday = (WeekDay)num;
+                    parsed.hour = (wxDateTime::wxDateTime_t)(sec / 3600);
+                    parsed.min = (wxDateTime::wxDateTime_t)((sec / 60) % 60);
+                    parsed.sec = (wxDateTime::wxDateTime_t)(sec % 60);
+                }
                 break;
 
-            case wxT('x'):       // locale default date representation
+            case ParseStep_SubDate:
                 {
-#if wxUSE_INTL
-                    wxString
-                        fmtDate = wxUILocale::GetCurrent().GetInfo(wxLOCALE_SHORT_DATE_FMT),
-                        fmtDateAlt = wxUILocale::GetCurrent().GetInfo(wxLOCALE_LONG_DATE_FMT);
-#else // !wxUSE_INTL
-                    wxString fmtDate, fmtDateAlt;
-#endif // wxUSE_INTL/!wxUSE_INTL
-                    if ( fmtDate.empty() )
+                    // parse the string starting at the current position as a
+                    // separate date using one of the alternative formats
+                    //
+                    // Use a default date outside of the DST period to avoid
+                    // problems with parsing the time differently depending on
+                    // the today's date (which is used as the fall back date if
+                    // none is explicitly specified).
+                    static const wxDateTime dtDef(1, wxDateTime::Jan, 2012);
+
+                    wxDateTime dtSub;
+                    bool ok = false;
+                    for ( size_t i = 0; !ok && i < step.alternatives.size(); ++i )
                     {
-                        if ( IsWestEuropeanCountry(GetCountry()) ||
-                             GetCountry() == Russia )
-                        {
-                            fmtDate = wxS("%d/%m/%Y");
-                            fmtDateAlt = wxS("%m/%d/%Y");
-                         }
-                        else // assume USA
+                        wxString::const_iterator p = input;
+                        if ( DoRun(step.alternatives[i], p, end,
+                                   &dtSub, dtDef, state, false) )
                         {
-                            fmtDate = wxS("%m/%d/%Y");
-                            fmtDateAlt = wxS("%d/%m/%Y");
+                            input = p;
+                            ok = true;
                         }
                     }
 
-                    wxDateTime
-                        dt = ParseFormatAt(input, end, fmtDate, fmtDateAlt);
+                    if ( !ok )
+                        return false;
+
+                    const wxDateTime::Tm tm = dtSub.GetTm();
 
-                    if ( !dt.IsValid() )
+                    if ( step.ch == 'c' || step.ch == 'x' )
                     {
-                        // try with short years too
-                        fmtDate.Replace("%Y","%y");
-                        fmtDateAlt.Replace("%Y","%y");
-                        dt = ParseFormatAt(input, end, fmtDate, fmtDateAlt);
+                        parsed.haveDay =
+                        parsed.haveMon =
+                        parsed.haveYear = true;
 
-                        if ( !dt.IsValid() )
-                            return false;
+                        parsed.year = tm.year;
+                        parsed.mon = tm.mon;
+                        parsed.mday = tm.mday;
                     }
 
-                    const Tm tm = dt.GetTm();
-
-                    haveDay =
-                    haveMon =
-                    haveYear = true;
+                    if ( step.ch != 'x' )
+                    {
+                        parsed.haveHour =
+                        parsed.haveMin =
+                        parsed.haveSec = true;
 
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+                        parsed.hour = tm.hour;
+                        parsed.min = tm.min;
+                        parsed.sec = tm.sec;
+                    }
                 }
-
                 break;
 
-            case wxT('X'):       // locale default time representation
-                {
-#if wxUSE_INTL
-                    wxString fmtTime = wxUILocale::GetCurrent().GetInfo(wxLOCALE_TIME_FMT),
-                             fmtTimeAlt;
-#else // !wxUSE_INTL
-                    wxString fmtTime, fmtTimeAlt;
-#endif // wxUSE_INTL/!wxUSE_INTL
-                    if ( fmtTime.empty() )
-                    {
-                        // try to parse what follows as "%H:%M:%S" and, if this
-                        // fails, as "%I:%M:%S %p" - this should catch the most
-                        // common cases
-                        fmtTime = "%T";
-                        fmtTimeAlt = "%r";
-                    }
+            case ParseStep_Fail:
+                return false;
+        }
+    }
 
-                    const wxDateTime
-                        dt = ParseFormatAt(input, end, fmtTime, fmtTimeAlt);
-                    if ( !dt.IsValid() )
-                        return false;
+    // format matched, try to construct a date from what we have now
+    wxDateTime::Tm tm;
+    if ( !parsed.GetTm(tm, dateDef, *dt) )
+        return false;
+
+    // use the cached start of the day to avoid calling mktime() for each
+    // date if possible, i.e. if the day doesn't contain any ambiguous times
+    time_t t;
+    if ( cacheDay && !parsed.haveTimeZone &&
+            tm.year >= 1970 && tm.year <= 2037 &&
+            tm.mday <= wxDateTime::GetNumberOfDays(tm.mon, tm.year) &&
+            tm.hour < 24 && tm.min < 60 && tm.sec < 60 && tm.msec < 1000 &&
+            state.GetDayStart(tm, &t) )
+    {
+        *dt = wxDateTime(t) + wxTimeSpan::Milliseconds(tm.msec);
+    }
+    else
+    {
+        dt->Set(tm);
+
+        if ( parsed.haveTimeZone )
+            dt->MakeFromTimezone(parsed.timeZone);
+    }
+
+    // finally check that the week day is consistent -- if we had it
+    if ( parsed.haveWDay && dt->GetWeekDay() != parsed.wday )
+        return false;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// compiled formats cache
+// ----------------------------------------------------------------------------
+
+// the format together with the programs for formatting and parsing dates
+// using it, which are only compiled when needed and discarded if the UI
+// locale changes
+class CompiledDateFormat
+{
+public:
+    explicit CompiledDateFormat(const wxString& format = wxString())
+        : m_format(format)
+    {
+        m_generation = wxGetUILocaleGeneration();
+        m_formatCompiled =
+        m_parseCompiled = false;
+    }
+
+    void SetFormat(const wxString& format)
+    {
+        m_format = format;
+        m_formatCompiled =
+        m_parseCompiled = false;
+    }
+
+    const wxString& GetFormat() const { return m_format; }
+
+    // discard the programs compiled for the previously used UI locale, if it
+    // changed, and return false in this case
+    bool CheckLocale()
+    {
+        const unsigned generation = wxGetUILocaleGeneration();
+        if ( generation == m_generation )
+            return true;
+
+        m_generation = generation;
+        m_formatCompiled =
+        m_parseCompiled = false;
+
+        return false;
+    }
+
+    FormatProgram& GetFormatProgram()
+    {
+        if ( !m_formatCompiled )
+        {
+            m_formatProgram.Compile(m_format);
+            m_formatCompiled = true;
+        }
+
+        return m_formatProgram;
+    }
+
+    const ParseProgram& GetParseProgram()
+    {
+        if ( !m_parseCompiled )
+        {
+            m_parseProgram.Compile(m_format);
+            m_parseCompiled = true;
+        }
+
+        return m_parseProgram;
+    }
+
+private:
+    wxString m_format;
+
+    // the UI locale generation the programs were compiled for
+    unsigned m_generation;
+
+    bool m_formatCompiled;
+    FormatProgram m_formatProgram;
+
+    bool m_parseCompiled;
+    ParseProgram m_parseProgram;
+
+    wxDECLARE_NO_COPY_CLASS(CompiledDateFormat);
+};
+
+// The number of the formats cached by GetCachedDateFormat() in each thread.
+const size_t DATE_FORMAT_CACHE_SIZE = 4;
+
+// Return the compiled format from the per-thread cache of the recently used
+// formats, replacing the oldest one with it if it's not there yet.
+//
+// Notice that shared pointers are used to keep the returned object alive even
+// if it's replaced in the cache by a reentrant call.
+std::shared_ptr<CompiledDateFormat> GetCachedDateFormat(const wxString& format)
+{
+    thread_local std::shared_ptr<CompiledDateFormat> s_cache[DATE_FORMAT_CACHE_SIZE];
+    thread_local size_t s_next = 0;
+
+    for ( size_t n = 0; n < DATE_FORMAT_CACHE_SIZE; ++n )
+    {
+        if ( s_cache[n] && s_cache[n]->GetFormat() == format )
+            return s_cache[n];
+    }
+
+    std::shared_ptr<CompiledDateFormat>& entry = s_cache[s_next];
+    s_next = (s_next + 1) % DATE_FORMAT_CACHE_SIZE;
+
+    entry = std::make_shared<CompiledDateFormat>(format);
+
+    return entry;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxDateTime to/from text representations
+// ----------------------------------------------------------------------------
+
+wxString wxDateTime::Format(const wxString& format, const TimeZone& tz) const
+{
+    wxCHECK_MSG( !format.empty(), wxEmptyString,
+                 wxT("null format in wxDateTime::Format") );
+
+    const std::shared_ptr<CompiledDateFormat> compiled = GetCachedDateFormat(format);
+    compiled->CheckLocale();
+
+    // nothing is reused between the calls, so don't waste time on finding
+    // the entire day containing this date
+    FormatDay day;
+
+    wxString str;
+    DoFormat(compiled->GetFormatProgram(), day, str, *this, tz, false);
+
+    return str;
+}
+
+bool
+wxDateTime::ParseRFC822TimeZone(wxString::const_iterator *iterator,
+                                const wxString::const_iterator &pEnd)
+{
+    wxString::const_iterator& p = *iterator;
+    int offset = 0; // just to suppress warnings
+    if ( *p == '-' || *p == '+' )
+    {
+        // the explicit offset given: it has the form of hhmm
+        bool plus = *p++ == '+';
+
+        if ( p == pEnd || !wxIsdigit(*p) ||
+             p + 1 == pEnd || !wxIsdigit(*(p + 1)) )
+            return false;
+
+
+        // hours
+        offset = MIN_PER_HOUR*(10*(*p - '0') + (*(p + 1) - '0'));
+
+        p += 2;
+
+        if ( p == pEnd || !wxIsdigit(*p) ||
+             p + 1 == pEnd || !wxIsdigit(*(p + 1)) )
+            return false;
+
+        // minutes
+        offset += 10*(*p - '0') + (*(p + 1) - '0');
+
+        if ( !plus )
+            offset = -offset;
+
+        p += 2;
+    }
+    else // not numeric
+    {
+        // the symbolic timezone given: may be either military timezone or one
+        // of standard abbreviations
+        if ( p + 1 == pEnd )
+        {
+            // military: Z = UTC, J unused, A = -1, ..., Y = +12
+            static const int offsets[26] =
+            {
+                //A  B   C   D   E   F   G   H   I    J    K    L    M
+                -1, -2, -3, -4, -5, -6, -7, -8, -9,   0, -10, -11, -12,
+                //N  O   P   R   Q   S   T   U   V    W    Z    Y    Z
+                +1, +2, +3, +4, +5, +6, +7, +8, +9, +10, +11, +12, 0
+            };
+
+            if ( *p < wxT('A') || *p > wxT('Z') || *p == wxT('J') )
+                return false;
+
+            offset = offsets[*p++ - 'A'];
+        }
+        else
+        {
+            // TZ is max 3 characters long; we do not want to consume
+            // characters beyond that.
+            wxString::const_iterator pPlusMax3 = pEnd;
+            if ( p != pEnd && p + 1 != pEnd && p + 2 != pEnd && p + 3 != pEnd )
+                pPlusMax3 = p + 3;
+            // abbreviation
+            const wxString tz(p, pPlusMax3);
+            if ( tz == wxT("UT") || tz == wxT("UTC") || tz == wxT("GMT") )
+                offset = 0;
+            else if ( tz == wxT("AST") )
+                offset = AST - GMT0;
+            else if ( tz == wxT("ADT") )
+                offset = ADT - GMT0;
+            else if ( tz == wxT("EST") )
+                offset = EST - GMT0;
+            else if ( tz == wxT("EDT") )
+                offset = EDT - GMT0;
+            else if ( tz == wxT("CST") )
+                offset = CST - GMT0;
+            else if ( tz == wxT("CDT") )
+                offset = CDT - GMT0;
+            else if ( tz == wxT("MST") )
+                offset = MST - GMT0;
+            else if ( tz == wxT("MDT") )
+                offset = MDT - GMT0;
+            else if ( tz == wxT("PST") )
+                offset = PST - GMT0;
+            else if ( tz == wxT("PDT") )
+                offset = PDT - GMT0;
+            else
+                return false;
+
+            p += tz.length();
+        }
+
+        // make it minutes
+        offset *= MIN_PER_HOUR;
+    }
+
+    // As always, dealing with the time zone is the most interesting part: we
+    // can't just use MakeFromTimeZone() here because it wouldn't handle the
+    // DST correctly because the TZ specified in the string is DST-invariant
+    // and so we have to manually shift to the UTC first and then convert to
+    // the local TZ.
+    *this -= wxTimeSpan::Minutes(offset);
+    MakeFromUTC();
+
+    return true;
+}
+
+// this function parses a string in (strict) RFC 822 format: see the section 5
+// of the RFC for the detailed description, but briefly it's something of the
+// form "Sat, 18 Dec 1999 00:48:30 +0100"
+//
+// this function is "strict" by design - it must reject anything except true
+// RFC822 time specs.
+bool
+wxDateTime::ParseRfc822Date(const wxString& originalDate, wxString::const_iterator *end)
+{
+    // This implementation implicitly relies on the assumption that the
+    // input never ends prematurely (all dereferencing of *p assumes that).
+    // To avoid iterating beyond the end of buffer, let us append 32 zero bytes
+    // to the date string (32 being the length of a typical RFC822 timestamp).
+    const wxString date(originalDate + wxString(32, '\0'));
+
+    const wxString::const_iterator pEnd = date.begin() + originalDate.length();
+    wxString::const_iterator p = date.begin();
+
+    // 1. week day (optional)
+    // if there is a week day present, it must be separated
+    // by a comma at position [3].
+    if ( date.length() > 3 && date[3] == ',' )
+    {
+        const wxDateTime::WeekDay
+            wd = GetWeekDayFromName(p, pEnd, Name_Abbr, DateLang_English);
+        if ( wd == Inv_WeekDay )
+            return false;
+        //else: ignore week day for now, we could also check that it really
+        //      corresponds to the specified date
+
+        // 2. separating comma
+        if ( *p++ != ',' || *p++ != ' ' )
+            return false;
+    }
 
-                    haveHour =
-                    haveMin =
-                    haveSec = true;
+    // 3. day number
+    if ( !wxIsdigit(*p) )
+        return false;
 
-                    const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
-                }
-                break;
+    wxDateTime_t day = (wxDateTime_t)(*p++ - '0');
+    if ( wxIsdigit(*p) )
+    {
+        day *= 10;
+        day = (wxDateTime_t)(day + (*p++ - '0'));
+    }
 
-            case wxT('y'):       // year without century (00-99)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (num > 99) )
-                {
-                    // no match
-                    return false;
-                }
+    if ( *p++ != ' ' )
+        return false;
 
-                haveYear = true;
+    // 4. month name
+    const Month mon = GetMonthFromName(p, pEnd, Name_Abbr, DateLang_English);
+    if ( mon == Inv_Month )
+        return false;
 
-                // TODO should have an option for roll over date instead of
-                //      hard coding it here
-                year = (num > 30 ? 1900 : 2000) + (wxDateTime_t)num;
-                break;
+    if ( *p++ != ' ' )
+        return false;
 
-            case wxT('Y'):       // year with century
-                if ( !GetNumericToken(width, input, end, &num) )
-                {
-                    // no match
-                    return false;
-                }
+    // 5. year
+    if ( !wxIsdigit(*p) )
+        return false;
 
-                haveYear = true;
-                year = (wxDateTime_t)num;
-                break;
+    int year = *p++ - '0';
+    if ( !wxIsdigit(*p) ) // should have at least 2 digits in the year
+        return false;
 
-            case wxT('z'):
-                {
-                    // check that we have something here at all
-                    if ( input == end )
-                        return false;
+    year *= 10;
+    year += *p++ - '0';
 
-                    if ( *input == wxS('Z') )
-                    {
-                        // Time is in UTC.
-                        ++input;
-                        haveTimeZone = true;
-                        break;
-                    }
+    // is it a 2 digit year (as per original RFC 822) or a 4 digit one?
+    if ( wxIsdigit(*p) )
+    {
+        year *= 10;
+        year += *p++ - '0';
 
-                    // Check if there's either a plus, hyphen-minus, or
-                    // minus sign.
-                    bool minusFound;
-                    if ( *input == wxS('+') )
-                        minusFound = false;
-                    else if
-                    (
-                        *input == wxS('-')
-                        || *input == wxString::FromUTF8("\xe2\x88\x92")
-                    )
-                        minusFound = true;
-                    else
-                        return false;   // no match
+        if ( !wxIsdigit(*p) )
+        {
+            // no 3 digit years please
+            return false;
+        }
 
-                    ++input;
+        year *= 10;
+        year += *p++ - '0';
+    }
+    else // a 2-digit year
+    {
+        // RFC 822 allows 2-digit years, stating that year is
+        // "any numeric year 1900 or later".
+        // So how do we interpret e.g. the year '95'? Does it mean:
+        // a) 1995
+        // b) 2095
+        // c) literally 95 AD, two millennia ago?
+        // NOTE! wx traditionally implemented option c!
+        // However, the most sensible interpretation for 95 is
+        // probably 1995, so we shall now use that.
+        // Years 00..29 are considered to mean 20xx.
+        if ( year >= 30 )
+        {
+            year += 1900;
+        }
+        else
+        {
+            year += 2000;
+        }
+    }
 
-                    // Here should follow exactly 2 digits for hours (HH).
-                    const size_t numRequiredDigits = 2;
-                    size_t numScannedDigits;
+    if ( *p++ != ' ' )
+        return false;
 
-                    unsigned long hours;
-                    if ( !GetNumericToken(numRequiredDigits, input, end,
-                                          &hours, &numScannedDigits)
-                         || numScannedDigits != numRequiredDigits)
-                    {
-                        return false; // No match.
-                    }
+    // 6. time in hh:mm:ss format with seconds being optional
+    if ( !wxIsdigit(*p) )
+        return false;
 
-                    // Optionally followed by a colon separator.
-                    bool mustHaveMinutes = false;
-                    if ( input != end && *input == wxS(':') )
-                    {
-                        mustHaveMinutes = true;
-                        ++input;
-                    }
+    wxDateTime_t hour = (wxDateTime_t)(*p++ - '0');
 
-                    // Optionally followed by exactly 2 digits for minutes (MM).
-                    unsigned long minutes = 0;
-                    if ( !GetNumericToken(numRequiredDigits, input, end,
-                                          &minutes, &numScannedDigits)
-                         || numScannedDigits != numRequiredDigits)
-                    {
-                        if (mustHaveMinutes || numScannedDigits)
-                        {
-                            // No match if we must have minutes, or digits
-                            // for minutes were specified but not exactly 2.
-                            return false;
-                        }
-                    }
+    if ( !wxIsdigit(*p) )
+        return false;
 
-                    /*
-                    Contemporary offset limits are -12:00 and +14:00.
-                    However historically offsets of over +/- 15 hours
-                    existed so be a bit more flexible. Info retrieved
-                    from Time Zone Database at
-                    https://www.iana.org/time-zones.
-                    */
-                    if ( hours > 15 || minutes > 59 )
-                        return false;   // bad format
-
-                    timeZone = 3600*hours + 60*minutes;
-                    if ( minusFound )
-                        timeZone = -timeZone;
-
-                    haveTimeZone = true;
-                }
-                break;
+    hour *= 10;
+    hour = (wxDateTime_t)(hour + (*p++ - '0'));
 
-            case wxT('Z'):       // timezone name
-                // FIXME: currently we just ignore everything that looks like a
-                //        time zone here
-                GetAlphaToken(input, end);
-                break;
+    if ( *p++ != ':' )
+        return false;
 
-            case wxT('%'):       // a percent sign
-                if ( input == end || *input++ != wxT('%') )
-                {
-                    // no match
-                    return false;
-                }
-                break;
+    if ( !wxIsdigit(*p) )
+        return false;
 
-            case 0:             // the end of string
-                wxFAIL_MSG(wxT("unexpected format end"));
+    wxDateTime_t min = (wxDateTime_t)(*p++ - '0');
 
-                wxFALLTHROUGH;
+    if ( !wxIsdigit(*p) )
+        return false;
 
-            default:            // not a known format spec
-                return false;
-        }
-    }
+    min *= 10;
+    min += (wxDateTime_t)(*p++ - '0');
 
-    // format matched, try to construct a date from what we have now
-    Tm tmDef;
-    if ( dateDef.IsValid() )
-    {
-        // take this date as default
-        tmDef = dateDef.GetTm();
-    }
-    else if ( IsValid() )
-    {
-        // if this date is valid, don't change it
-        tmDef = GetTm();
-    }
-    else
+    wxDateTime_t sec = 0;
+    if ( *p == ':' )
     {
-        // no default and this date is invalid - fall back to Today()
-        tmDef = Today().GetTm();
-    }
+        ++p;
+        if ( !wxIsdigit(*p) )
+            return false;
 
-    Tm tm = tmDef;
+        sec = (wxDateTime_t)(*p++ - '0');
 
-    // set the date
-    if ( haveMon )
-    {
-        tm.mon = mon;
-    }
+        if ( !wxIsdigit(*p) )
+            return false;
 
-    if ( haveYear )
-    {
-        tm.year = year;
+        sec *= 10;
+        sec += (wxDateTime_t)(*p++ - '0');
     }
 
-    // TODO we don't check here that the values are consistent, if both year
-    //      day and month/day were found, we just ignore the year day and we
-    //      also always ignore the week day
-    if ( haveDay )
-    {
-        if ( mday > GetNumberOfDays(tm.mon, tm.year) )
-            return false;
+    if ( *p++ != ' ' )
+        return false;
 
-        tm.mday = mday;
-    }
-    else if ( haveYDay )
-    {
-        if ( yday > GetNumberOfDays(tm.year) )
-            return false;
+    // the spec was correct, construct the date from the values we found
+    Set(day, mon, year, hour, min, sec);
 
-        Tm tm2 = wxDateTime(1, Jan, tm.year).SetToYearDay(yday).GetTm();
+    // 7. now the interesting part: the timezone
 
-        tm.mon = tm2.mon;
-        tm.mday = tm2.mday;
-    }
+    if ( !ParseRFC822TimeZone(&p, pEnd) )
+        return false;
 
-    // deal with AM/PM
-    if ( haveHour && hourIsIn12hFormat && isPM )
-    {
-        // translate to 24hour format
-        hour += 12;
-    }
-    //else: either already in 24h format or no translation needed
+    if ( end )
+        *end = originalDate.begin() + (p - date.begin());
 
-    // set the time
-    if ( haveHour )
-    {
-        tm.hour = hour;
-    }
+    return true;
+}
 
-    if ( haveMin )
-    {
-        tm.min = min;
-    }
+const char* wxDateTime::ParseRfc822Date(const char* date)
+{
+    wxString::const_iterator end;
+    wxString dateStr(date);
+    if ( !ParseRfc822Date(dateStr, &end) )
+        return nullptr;
 
-    if ( haveSec )
-    {
-        tm.sec = sec;
-    }
+    return date + dateStr.IterOffsetInMBStr(end);
+}
+
+const wchar_t* wxDateTime::ParseRfc822Date(const wchar_t* date)
+{
+    wxString::const_iterator end;
+    wxString dateStr(date);
+    if ( !ParseRfc822Date(dateStr, &end) )
+        return nullptr;
+
+    return date + (end - dateStr.begin());
+}
 
-    if ( haveMsec )
-        tm.msec = msec;
+bool
+wxDateTime::ParseFormat(const wxString& date,
+                        const wxString& format,
+                        const wxDateTime& dateDef,
+                        wxString::const_iterator *endParse)
+{
+    wxCHECK_MSG( !format.empty(), false, "format can't be empty" );
+    wxCHECK_MSG( endParse, false, "end iterator pointer must be specified" );
 
-    Set(tm);
+    const std::shared_ptr<CompiledDateFormat> compiled = GetCachedDateFormat(format);
+    compiled->CheckLocale();
 
-    if ( haveTimeZone )
-        MakeFromTimezone(timeZone);
+    ParseState state;
 
-    // finally check that the week day is consistent -- if we had it
-    if ( haveWDay && GetWeekDay() != wday )
+    wxString::const_iterator input = date.begin();
+    if ( !compiled->GetParseProgram().Run(input, date.end(), this, dateDef,
+                                          state, false) )
         return false;
 
     *endParse = input;
@@ -2318,6 +3532,115 @@ bool wxDateTime::IsWorkDay(Country WXUNUSED(country)) const
     return !wxDateTimeHolidayAuthority::IsHoliday(*this);
 }
 
+// ============================================================================
+// wxDateTimeFormatter
+// ============================================================================
+
+struct wxDateTimeFormatter::Impl
+{
+    Impl(const wxString& format, const wxDateTime::TimeZone& tz)
+        : m_format(format),
+          m_tz(tz)
+    {
+    }
+
+    // discard the data cached for the previously used UI locale, if it changed
+    void Update()
+    {
+        if ( !m_format.CheckLocale() )
+        {
+            m_day.Invalidate();
+            m_state.Invalidate();
+        }
+    }
+
+    CompiledDateFormat m_format;
+    wxDateTime::TimeZone m_tz;
+
+    // the buffer returned by Format()
+    wxString m_buffer;
+
+    // the data for the last formatted and parsed dates
+    FormatDay m_day;
+    ParseState m_state;
+};
+
+wxDateTimeFormatter::wxDateTimeFormatter(const wxString& format,
+                                         const wxDateTime::TimeZone& tz)
+    : m_impl(new Impl(format, tz))
+{
+}
+
+wxDateTimeFormatter::~wxDateTimeFormatter()
+{
+    delete m_impl;
+}
+
+void wxDateTimeFormatter::SetFormat(const wxString& format)
+{
+    m_impl->m_format.SetFormat(format);
+    m_impl->m_day.Invalidate();
+}
+
+const wxString& wxDateTimeFormatter::GetFormat() const
+{
+    return m_impl->m_format.GetFormat();
+}
+
+void wxDateTimeFormatter::SetTimeZone(const wxDateTime::TimeZone& tz)
+{
+    m_impl->m_tz = tz;
+    m_impl->m_day.Invalidate();
+}
+
+const wxDateTime::TimeZone& wxDateTimeFormatter::GetTimeZone() const
+{
+    return m_impl->m_tz;
+}
+
+const wxString& wxDateTimeFormatter::Format(const wxDateTime& dt)
+{
+    m_impl->m_buffer.clear();
+    AppendFormat(m_impl->m_buffer, dt);
+
+    return m_impl->m_buffer;
+}
+
+void wxDateTimeFormatter::AppendFormat(wxString& str, const wxDateTime& dt)
+{
+    wxCHECK_RET( dt.IsValid(), "invalid wxDateTime" );
+    wxCHECK_RET( !m_impl->m_format.GetFormat().empty(),
+                 "null format in wxDateTimeFormatter" );
+
+    m_impl->Update();
+
+    DoFormat(m_impl->m_format.GetFormatProgram(), m_impl->m_day,
+             str, dt, m_impl->m_tz, true);
+}
+
+bool wxDateTimeFormatter::Parse(const wxString& date,
+                                wxDateTime* dt,
+                                wxString::const_iterator* end,
+                                const wxDateTime& dateDef)
+{
+    wxCHECK_MSG( dt, false, "date pointer must be specified" );
+    wxCHECK_MSG( end, false, "end iterator pointer must be specified" );
+    wxCHECK_MSG( !m_impl->m_format.GetFormat().empty(), false,
+                 "format can't be empty" );
+
+    m_impl->Update();
+
+    wxString::const_iterator input = date.begin();
+    if ( !m_impl->m_format.GetParseProgram().Run(input, date.end(), dt,
+                                                 dateDef, m_impl->m_state,
+                                                 true) )
+        return false;
+
+    *end = input;
+
+    return true;
+}
+
 // ============================================================================
 // wxDateSpan
 // ============================================================================
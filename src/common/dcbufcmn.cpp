@@ -25,6 +25,18 @@
     #include "wx/module.h"
 #endif
 
+#include <atomic>
+#include <unordered_map>
+
+namespace
+{
+
+// Total number of pixels blitted by all wxBufferedDCs, this is atomic as
+// wxBufferedDC can be used with wxMemoryDC in any thread.
+std::atomic<wxUint64> gs_pixelsBlitted(0);
+
+} // anonymous namespace
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -42,7 +54,12 @@ public:
     wxSharedDCBufferManager() { }
 
     virtual bool OnInit() override { return true; }
-    virtual void OnExit() override { wxDELETE(ms_buffer); }
+    virtual void OnExit() override
+    {
+        wxDELETE(ms_buffer);
+
+        ms_windowBuffers.clear();
+    }
 
     static wxBitmap* GetBuffer(wxDC* dc, int w, int h)
     {
@@ -54,6 +71,16 @@ public:
                 h > ms_buffer->GetLogicalHeight() ||
                 (dc && dc->GetContentScaleFactor() != ms_buffer->GetScaleFactor()) )
         {
+            // Don't shrink the buffer in the other direction when it's only
+            // too small in one of them, otherwise painting windows with e.g.
+            // a tall and a wide shape alternately would recreate it each time.
+            if ( ms_buffer &&
+                    (!dc || dc->GetContentScaleFactor() == ms_buffer->GetScaleFactor()) )
+            {
+                w = wxMax(w, ms_buffer->GetLogicalWidth());
+                h = wxMax(h, ms_buffer->GetLogicalHeight());
+            }
+
             delete ms_buffer;
 
             ms_buffer = DoCreateBuffer(dc, w, h);
@@ -76,6 +103,43 @@ public:
         }
     }
 
+    static wxBitmap* GetWindowBuffer(wxWindow* window, wxDC* dc,
+                                     const wxSize& size, bool* isNew)
+    {
+        const auto it = ms_windowBuffers.find(window);
+        if ( it == ms_windowBuffers.end() )
+        {
+            // Forget the buffer when the window is destroyed.
+            window->Bind(wxEVT_DESTROY, [window](wxWindowDestroyEvent& event)
+                {
+                    event.Skip();
+
+                    if ( event.GetEventObject() == window )
+                        ms_windowBuffers.erase(window);
+                });
+        }
+        else
+        {
+            const wxBitmap& buffer = it->second;
+            if ( buffer.GetLogicalSize() == size &&
+                    (!dc || dc->GetContentScaleFactor() == buffer.GetScaleFactor()) )
+            {
+                *isNew = false;
+                return &it->second;
+            }
+        }
+
+        // Either there was no buffer yet or it has a wrong size: (re)create it
+        // now, deleting the existing one, if any.
+        wxBitmap* const buffer = DoCreateBuffer(dc, size.x, size.y);
+        wxBitmap& windowBuffer = ms_windowBuffers[window];
+        windowBuffer = *buffer;
+        delete buffer;
+
+        *isNew = true;
+        return &windowBuffer;
+    }
+
 private:
     static wxBitmap* DoCreateBuffer(wxDC* dc, int w, int h)
     {
@@ -92,11 +156,15 @@ private:
     static wxBitmap *ms_buffer;
     static bool ms_usingSharedBuffer;
 
+    // Buffers used by wxBufferedPaintDC with wxBUFFER_PERSISTENT style.
+    static std::unordered_map<wxWindow*, wxBitmap> ms_windowBuffers;
+
     wxDECLARE_DYNAMIC_CLASS(wxSharedDCBufferManager);
 };
 
 wxBitmap* wxSharedDCBufferManager::ms_buffer = nullptr;
 bool wxSharedDCBufferManager::ms_usingSharedBuffer = false;
+std::unordered_map<wxWindow*, wxBitmap> wxSharedDCBufferManager::ms_windowBuffers;
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxSharedDCBufferManager, wxModule);
 
@@ -128,6 +196,17 @@ void wxBufferedDC::UseBuffer(wxCoord w, wxCoord h)
         CopyAttributes(*m_dc);
 }
 
+void wxBufferedDC::SetUpdateArea(const wxRect& rect)
+{
+    if ( rect.IsEmpty() )
+        return;
+
+    m_updateArea = rect;
+
+    if ( m_style & wxBUFFER_UPDATE_AREA_ONLY )
+        SetClippingRegion(rect);
+}
+
 void wxBufferedDC::UnMask()
 {
     wxCHECK_RET( m_dc, wxT("no underlying wxDC?") );
@@ -159,10 +238,48 @@ void wxBufferedDC::UnMask()
         height = wxMin(height, heightDC);
     }
 
-    const wxPoint origin = GetLogicalOrigin();
-    m_dc->Blit(-origin.x, -origin.y, width, height, this, -x, -y);
+    // And only blit the part which was actually updated, if we know it.
+    wxRect rect(0, 0, width, height);
+    if ( !m_updateArea.IsEmpty() )
+        rect.Intersect(m_updateArea);
+
+    if ( !rect.IsEmpty() )
+    {
+        const wxPoint origin = GetLogicalOrigin();
+        m_dc->Blit(rect.x - origin.x, rect.y - origin.y,
+                   rect.width, rect.height,
+                   this, rect.x - x, rect.y - y);
+
+        gs_pixelsBlitted.fetch_add(wxUint64(rect.width)*rect.height,
+                                   std::memory_order_relaxed);
+    }
+
     m_dc = nullptr;
 
     if ( m_style & wxBUFFER_USES_SHARED_BUFFER )
         wxSharedDCBufferManager::ReleaseBuffer(m_buffer);
 }
+
+/* static */
+wxUint64 wxBufferedDC::GetPixelsBlitted()
+{
+    return gs_pixelsBlitted.load(std::memory_order_relaxed);
+}
+
+/* static */
+void wxBufferedDC::ResetPixelsBlitted()
+{
+    gs_pixelsBlitted.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// wxBufferedPaintDC
+// ============================================================================
+
+/* static */
+wxBitmap*
+wxBufferedPaintDC::GetPersistentBuffer(wxWindow* window, wxDC* dc,
+                                       const wxSize& size, bool* isNew)
+{
+    return wxSharedDCBufferManager::GetWindowBuffer(window, dc, size, isNew);
+}
@@ -28,6 +28,10 @@
 #include "wx/display.h"
 #include "wx/private/rescale.h"
 
+#if wxUSE_ZLIB
+    #include "wx/zstream.h"
+#endif
+
 #if wxUSE_MARKUP
     #include "wx/private/markupparser.h"
 #endif
@@ -41,6 +45,52 @@ namespace
 
 static const wxSize SVG_DPI(96, 96);
 
+// Size of the buffer used for the output stream.
+static const size_t SVG_BUFFER_SIZE = 64*1024;
+
+// Maximal length of the data of a single path element combining several
+// elements, to avoid creating unreasonably long elements.
+static const size_t SVG_MAX_PATH_DATA = 4096;
+
+// Append the decimal representation of the given number to the string: this
+// is used instead of wxString::Format() for the most common elements, as it
+// avoids creating temporary strings.
+void AppendInt(wxString& s, int n)
+{
+    wxChar buf[16];
+    wxChar* const end = buf + WXSIZEOF(buf);
+    wxChar* p = end;
+
+    unsigned u = n < 0 ? 0u - static_cast<unsigned>(n) : static_cast<unsigned>(n);
+    do
+    {
+        *--p = static_cast<wxChar>(wxS('0') + u % 10);
+        u /= 10;
+    } while ( u );
+
+    if ( n < 0 )
+        *--p = wxS('-');
+
+    s.append(p, end - p);
+}
+
+// Append a path command with the given coordinates, e.g. "M1 2".
+void AppendPathPoint(wxString& s, wxChar cmd, int x, int y)
+{
+    s += cmd;
+    AppendInt(s, x);
+    s += wxS(' ');
+    AppendInt(s, y);
+}
+
+// Append an integer attribute, e.g. ' width="10"'.
+void AppendIntAttr(wxString& s, const wxChar* name, int value)
+{
+    s << wxS(' ') << name << wxS("=\"");
+    AppendInt(s, value);
+    s += wxS('"');
+}
+
 // This function returns a string representation of a floating point number in
 // C locale (i.e. always using "." for the decimal separator) and with the
 // fixed precision (which is 2 for some unknown reason but this is what it was
@@ -506,6 +556,11 @@ void wxSVGFileDC::SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode)
     ((wxSVGFileDCImpl*)GetImpl())->SetShapeRenderingMode(renderingMode);
 }
 
+void wxSVGFileDC::EnableStyleClasses(bool enable)
+{
+    ((wxSVGFileDCImpl*)GetImpl())->EnableStyleClasses(enable);
+}
+
 // ----------------------------------------------------------
 // wxSVGFileDCImpl
 // ----------------------------------------------------------
@@ -516,11 +571,47 @@ wxSVGFileDCImpl::wxSVGFileDCImpl(wxSVGFileDC* owner, const wxString& filename,
                                  int width, int height, double dpi, const wxString& title)
     : wxDCImpl(owner)
 {
-    Init(filename, width, height, dpi, title);
+    m_filename = filename;
+
+    if ( !m_filename.empty() )
+    {
+        m_outfile.reset(new wxFileOutputStream(m_filename));
+
+#if wxUSE_ZLIB
+        // Compress the output if the file has the standard extension for the
+        // compressed SVG files.
+        if ( wxFileName(m_filename).GetExt().IsSameAs(wxS("svgz"), false) )
+        {
+            m_zstream.reset(new wxZlibOutputStream(*m_outfile, -1, wxZLIB_GZIP));
+            InitStream(*m_zstream);
+        }
+        else
+#endif // wxUSE_ZLIB
+        {
+            InitStream(*m_outfile);
+        }
+    }
+
+    Init(width, height, dpi, title);
 }
 
-void wxSVGFileDCImpl::Init(const wxString& filename, int width, int height,
-                           double dpi, const wxString& title)
+wxSVGFileDCImpl::wxSVGFileDCImpl(wxSVGFileDC* owner, wxOutputStream& stream,
+                                 int width, int height, double dpi, const wxString& title)
+    : wxDCImpl(owner)
+{
+    InitStream(stream);
+
+    Init(width, height, dpi, title);
+}
+
+void wxSVGFileDCImpl::InitStream(wxOutputStream& stream)
+{
+    // Writing each element directly to the file would be very slow, so
+    // always buffer the output.
+    m_stream.reset(new wxBufferedOutputStream(stream, SVG_BUFFER_SIZE));
+}
+
+void wxSVGFileDCImpl::Init(int width, int height, double dpi, const wxString& title)
 {
     m_width = width;
     m_height = height;
@@ -545,20 +636,14 @@ void wxSVGFileDCImpl::Init(const wxString& filename, int width, int height,
     m_font = *wxNORMAL_FONT;
     m_brush = *wxWHITE_BRUSH;
 
-    m_filename = filename;
     m_graphics_changed = true;
 
     m_renderingMode = wxSVG_SHAPE_RENDERING_AUTO;
 
-    ////////////////////code here
+    m_pathKind = Path_Line;
 
     m_bmp_handler.reset();
 
-    if ( m_filename.empty() )
-        m_outfile.reset();
-    else
-        m_outfile.reset(new wxFileOutputStream(m_filename));
-
     const wxSize dpiSize = FromDIP(wxSize(m_width, m_height));
 
     wxString s;
@@ -569,8 +654,9 @@ void wxSVGFileDCImpl::Init(const wxString& filename, int width, int height,
                           NumStr(m_width / dpi * 2.54), NumStr(m_height / dpi * 2.54), dpiSize.GetWidth(), dpiSize.GetHeight());
     s += wxString::Format(wxS("<title>%s</title>\n"), title);
     s += wxString(wxS("<desc>Picture generated by wxSVG ")) + wxSVGVersion + wxS("</desc>\n\n");
-    s += wxS("<g style=\"fill:black; stroke:black; stroke-width:1\">\n");
-    write(s);
+
+    // Don't write the header immediately, see WriteHeader().
+    m_header = s;
 }
 
 wxSVGFileDCImpl::~wxSVGFileDCImpl()
@@ -583,6 +669,27 @@ wxSVGFileDCImpl::~wxSVGFileDCImpl()
 
     s += wxS("</g>\n</svg>\n");
     write(s);
+
+    // If the body was buffered, we can now write the header with all the
+    // style definitions followed by it.
+    if ( m_body )
+    {
+        WriteHeader();
+
+        if ( m_OK )
+        {
+            wxMemoryInputStream body(*m_body);
+            m_stream->Write(body);
+        }
+
+        m_body.reset();
+    }
+
+    // Flush the buffered data and finish the compressed stream, if any, before
+    // closing the file.
+    m_stream.reset();
+    m_zstream.reset();
+    m_outfile.reset();
 }
 
 void wxSVGFileDCImpl::DoGetSizeMM(int* width, int* height) const
@@ -627,11 +734,11 @@ void wxSVGFileDCImpl::DoDrawLine(wxCoord x1, wxCoord y1, wxCoord x2, wxCoord y2)
 {
     NewGraphicsIfNeeded();
 
-    wxString s;
-    s = wxString::Format(wxS("  <path d=\"M%d %d L%d %d\" %s %s/>\n"),
-        x1, y1, x2, y2, GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
-
-    write(s);
+    wxString& d = StartPathData(Path_Line);
+    AppendPathPoint(d, wxS('M'), x1, y1);
+    d += wxS(' ');
+    AppendPathPoint(d, wxS('L'), x2, y2);
+    EndPathData();
 
     CalcBoundingBox(x1, y1, x2, y2);
 }
@@ -641,23 +748,21 @@ void wxSVGFileDCImpl::DoDrawLines(int n, const wxPoint points[], wxCoord xoffset
     if (n > 1)
     {
         NewGraphicsIfNeeded();
-        wxString s;
 
-        s = wxString::Format(wxS("  <path d=\"M%d %d"),
-            (points[0].x + xoffset), (points[0].y + yoffset));
+        wxString& d = StartPathData(Path_Stroke);
+
+        AppendPathPoint(d, wxS('M'), points[0].x + xoffset, points[0].y + yoffset);
 
         CalcBoundingBox(points[0].x + xoffset, points[0].y + yoffset);
 
         for (int i = 1; i < n; ++i)
         {
-            s += wxString::Format(wxS(" L%d %d"), (points[i].x + xoffset), (points[i].y + yoffset));
+            d += wxS(' ');
+            AppendPathPoint(d, wxS('L'), points[i].x + xoffset, points[i].y + yoffset);
             CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
         }
 
-        s += wxString::Format(wxS("\" style=\"fill:none\" %s %s/>\n"),
-            GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
-
-        write(s);
+        EndPathData();
     }
 }
 
@@ -855,13 +960,51 @@ void wxSVGFileDCImpl::DoDrawRectangle(wxCoord x, wxCoord y, wxCoord width, wxCoo
 void wxSVGFileDCImpl::DoDrawRoundedRectangle(wxCoord x, wxCoord y, wxCoord width, wxCoord height, double radius)
 {
     NewGraphicsIfNeeded();
-    wxString s;
 
-    s = wxString::Format(wxS("  <rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" rx=\"%s\" %s %s %s/>\n"),
-        x, y, width, height, NumStr(radius),
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen), GetBrushPattern(m_brush));
+    // Simple rectangles can be combined with the other elements drawn with the
+    // same attributes, either if they're not filled or if they don't have any
+    // outline (and are drawn in the same direction, so that the default
+    // nonzero fill rule results in filling their union).
+    bool combine = false;
+    PathKind kind = Path_Stroke;
+    if ( radius == 0 && width > 0 && height > 0 )
+    {
+        if ( m_brush.IsTransparent() )
+        {
+            combine = true;
+        }
+        else if ( CanCombineFill() )
+        {
+            combine = true;
+            kind = Path_Fill;
+        }
+    }
 
-    write(s);
+    if ( combine )
+    {
+        wxString& d = StartPathData(kind);
+        AppendPathPoint(d, wxS('M'), x, y);
+        d += wxS(" h");
+        AppendInt(d, width);
+        d += wxS(" v");
+        AppendInt(d, height);
+        d += wxS(" h");
+        AppendInt(d, -width);
+        d += wxS(" z");
+        EndPathData();
+    }
+    else
+    {
+        wxString s(wxS("  <rect"));
+        AppendIntAttr(s, wxS("x"), x);
+        AppendIntAttr(s, wxS("y"), y);
+        AppendIntAttr(s, wxS("width"), width);
+        AppendIntAttr(s, wxS("height"), height);
+        s << wxS(" rx=\"") << NumStr(radius) << wxS("\" ")
+          << GetPenAttrs() << wxS(' ') << GetBrushPattern(m_brush) << wxS("/>\n");
+
+        write(s);
+    }
 
     CalcBoundingBox(wxPoint(x, y), wxSize(width, height));
 }
@@ -872,19 +1015,44 @@ void wxSVGFileDCImpl::DoDrawPolygon(int n, const wxPoint points[],
 {
     NewGraphicsIfNeeded();
 
+    // Unfilled polygons can be combined with the other unfilled elements, but
+    // filled ones can't, as their fill rule could affect the other elements.
+    if ( m_brush.IsTransparent() && n > 1 )
+    {
+        wxString& d = StartPathData(Path_Stroke);
+
+        for (int i = 0; i < n; i++)
+        {
+            if ( i )
+                d += wxS(' ');
+            AppendPathPoint(d, i ? wxS('L') : wxS('M'),
+                            points[i].x + xoffset, points[i].y + yoffset);
+            CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
+        }
+
+        d += wxS(" z");
+
+        EndPathData();
+        return;
+    }
+
     wxString s;
 
     s = wxS("  <polygon points=\"");
 
     for (int i = 0; i < n; i++)
     {
-        s += wxString::Format(wxS("%d %d "), points[i].x + xoffset, points[i].y + yoffset);
+        AppendInt(s, points[i].x + xoffset);
+        s += wxS(' ');
+        AppendInt(s, points[i].y + yoffset);
+        s += wxS(' ');
         CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
     }
 
-    s += wxString::Format(wxS("\" %s %s %s style=\"fill-rule:%s;\"/>\n"),
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen), GetBrushPattern(m_brush),
-        fillStyle == wxODDEVEN_RULE ? wxS("evenodd") : wxS("nonzero"));
+    s << wxS("\" ") << GetPenAttrs() << wxS(' ') << GetBrushPattern(m_brush)
+      << wxS(" style=\"fill-rule:")
+      << (fillStyle == wxODDEVEN_RULE ? wxS("evenodd") : wxS("nonzero"))
+      << wxS(";\"/>\n");
 
     write(s);
 }
@@ -939,10 +1107,11 @@ void wxSVGFileDCImpl::DoDrawEllipse(wxCoord x, wxCoord y, wxCoord width, wxCoord
     const double rw = width / 2.0;
 
     wxString s;
-    s = wxString::Format(wxS("  <ellipse cx=\"%s\" cy=\"%s\" rx=\"%s\" ry=\"%s\" %s %s"),
-        NumStr(x + rw), NumStr(y + rh), NumStr(rw), NumStr(rh),
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
-    s += wxS("/>\n");
+    s << wxS("  <ellipse cx=\"") << NumStr(x + rw)
+      << wxS("\" cy=\"") << NumStr(y + rh)
+      << wxS("\" rx=\"") << NumStr(rw)
+      << wxS("\" ry=\"") << NumStr(rh)
+      << wxS("\" ") << GetPenAttrs() << wxS("/>\n");
 
     write(s);
 
@@ -1325,11 +1494,33 @@ void wxSVGFileDCImpl::SetBitmapHandler(wxSVGBitmapHandler* handler)
 
 void wxSVGFileDCImpl::SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode)
 {
+    // The pending path must use the attributes for the old mode.
+    FlushPath();
+
     m_renderingMode = renderingMode;
+    m_penAttrs.clear();
+}
+
+void wxSVGFileDCImpl::EnableStyleClasses(bool enable)
+{
+    // As the style definitions are written in the header, they can't be
+    // enabled or disabled once anything was written.
+    wxCHECK_RET( !m_header.empty() && (!m_body || m_body->GetLength() == 0),
+                 "must be called before drawing anything" );
+
+    if ( enable == (m_body != nullptr) )
+        return;
+
+    if ( enable )
+        m_body.reset(new wxMemoryOutputStream());
+    else
+        m_body.reset();
 }
 
 void wxSVGFileDCImpl::SetBrush(const wxBrush& brush)
 {
+    FlushPath();
+
     m_brush = brush;
 
     m_graphics_changed = true;
@@ -1345,7 +1536,11 @@ void wxSVGFileDCImpl::SetBrush(const wxBrush& brush)
 
 void wxSVGFileDCImpl::SetPen(const wxPen& pen)
 {
+    // The pending path must use the attributes for the old pen.
+    FlushPath();
+
     m_pen = pen;
+    m_penAttrs.clear();
 
     m_graphics_changed = true;
 }
@@ -1364,16 +1559,42 @@ void wxSVGFileDCImpl::NewGraphicsIfNeeded()
 
 void wxSVGFileDCImpl::DoStartNewGraphics()
 {
-    wxString s;
+    wxString style;
+    style << GetPenStyle(m_pen) << wxS(' ')
+          << GetBrushFill(m_brush.GetColour(), m_brush.GetStyle()) << wxS(' ')
+          << GetPenStroke(m_pen.GetColour(), m_pen.GetStyle());
 
-    s = wxString::Format(wxS("<g style=\"%s %s %s\" transform=\"translate(%d %d) scale(%s %s)\">\n"),
-        GetPenStyle(m_pen),
-        GetBrushFill(m_brush.GetColour(), m_brush.GetStyle()),
-        GetPenStroke(m_pen.GetColour(), m_pen.GetStyle()),
-        (m_deviceOriginX - m_logicalOriginX) * m_signX,
-        (m_deviceOriginY - m_logicalOriginY) * m_signY,
-        NumStr(m_scaleX * m_signX),
-        NumStr(m_scaleY * m_signY));
+    wxString s(wxS("<g "));
+
+    if ( m_body )
+    {
+        // Define the class for this style when it's used for the first time
+        // and just refer to it later.
+        const auto
+            res = m_styleClasses.insert(std::make_pair(style, m_styleClasses.size()));
+        const size_t id = res.first->second;
+        if ( res.second )
+        {
+            m_styleDefs << wxS(".g");
+            AppendInt(m_styleDefs, static_cast<int>(id));
+            m_styleDefs << wxS(" { ") << style << wxS(" }\n");
+        }
+
+        s << wxS("class=\"g");
+        AppendInt(s, static_cast<int>(id));
+        s << wxS('"');
+    }
+    else
+    {
+        s << wxS("style=\"") << style << wxS('"');
+    }
+
+    s << wxS(" transform=\"translate(");
+    AppendInt(s, (m_deviceOriginX - m_logicalOriginX) * m_signX);
+    s << wxS(' ');
+    AppendInt(s, (m_deviceOriginY - m_logicalOriginY) * m_signY);
+    s << wxS(") scale(") << NumStr(m_scaleX * m_signX) << wxS(' ')
+      << NumStr(m_scaleY * m_signY) << wxS(")\">\n");
 
     write(s);
 }
@@ -1425,27 +1646,158 @@ void wxSVGFileDCImpl::DoDrawBitmap(const wxBitmap& bmp, wxCoord x, wxCoord y,
 {
     NewGraphicsIfNeeded();
 
-    // If we don't have any bitmap handler yet, use the default one.
+    // If we don't have any bitmap handler yet, use the default one: this is
+    // the file handler, unless we don't have any file name, as is the case
+    // when writing to a stream, in which case we have to embed the bitmaps.
     if ( !m_bmp_handler )
-        m_bmp_handler.reset(new wxSVGBitmapFileHandler(m_filename));
+    {
+#if wxUSE_BASE64
+        if ( m_filename.empty() )
+            m_bmp_handler.reset(new wxSVGBitmapEmbedHandler());
+        else
+#endif // wxUSE_BASE64
+            m_bmp_handler.reset(new wxSVGBitmapFileHandler(m_filename));
+    }
 
-    m_OK = m_outfile && m_outfile->IsOk();
+    FlushPath();
+
+    m_OK = m_stream && m_stream->IsOk();
     if (!m_OK)
         return;
 
-    m_bmp_handler->ProcessBitmap(bmp, x, y, *m_outfile);
-    m_OK = m_outfile->IsOk();
+    wxOutputStream& out = PrepareOutput();
+    m_bmp_handler->ProcessBitmap(bmp, x, y, out);
+    m_OK = out.IsOk() && m_stream->IsOk();
 }
 
 void wxSVGFileDCImpl::write(const wxString& s)
 {
-    m_OK = m_outfile && m_outfile->IsOk();
+    // Anything written now must come after the lines drawn before.
+    FlushPath();
+
+    DoWrite(s);
+}
+
+void wxSVGFileDCImpl::DoWrite(const wxString& s)
+{
+    m_OK = m_stream && m_stream->IsOk();
     if (!m_OK)
         return;
 
-    const wxCharBuffer buf = s.utf8_str();
-    m_outfile->Write(buf, strlen((const char*)buf));
-    m_OK = m_outfile->IsOk();
+    wxOutputStream& out = PrepareOutput();
+    WriteUTF8(out, s);
+    m_OK = out.IsOk() && m_stream->IsOk();
+}
+
+wxOutputStream& wxSVGFileDCImpl::PrepareOutput()
+{
+    // When using style classes, the header is only written at the very end,
+    // once all the styles are known.
+    if ( m_body )
+        return *m_body;
+
+    if ( !m_header.empty() )
+        WriteHeader();
+
+    return *m_stream;
+}
+
+void wxSVGFileDCImpl::WriteHeader()
+{
+    wxString s;
+    s.swap(m_header);
+
+    if ( !m_styleDefs.empty() )
+    {
+        s << wxS("<defs>\n<style type=\"text/css\">\n")
+          << m_styleDefs
+          << wxS("</style>\n</defs>\n");
+    }
+
+    s += wxS("<g style=\"fill:black; stroke:black; stroke-width:1\">\n");
+
+    m_OK = m_stream && m_stream->IsOk();
+    if (!m_OK)
+        return;
+
+    WriteUTF8(*m_stream, s);
+    m_OK = m_stream->IsOk();
+}
+
+void wxSVGFileDCImpl::WriteUTF8(wxOutputStream& stream, const wxString& s)
+{
+#if wxUSE_UNICODE_UTF8
+    stream.Write(s.wx_str(), s.utf8_length());
+#else // wxUSE_UNICODE_WCHAR
+    // Convert into the buffer reused for all the output to avoid allocating
+    // memory every time: each wchar_t can take at most 4 bytes in UTF-8.
+    const size_t maxLen = 4*s.length();
+    char* const buf = static_cast<char*>(m_utf8Buf.GetWriteBuf(maxLen));
+
+    const size_t len = wxConvUTF8.FromWChar(buf, maxLen, s.wc_str(), s.length());
+    if ( len != wxCONV_FAILED )
+        stream.Write(buf, len);
+#endif // wxUSE_UNICODE_UTF8/wxUSE_UNICODE_WCHAR
+}
+
+wxString& wxSVGFileDCImpl::StartPathData(PathKind kind)
+{
+    if ( !m_pathData.empty() &&
+            (kind != m_pathKind || m_pathData.length() > SVG_MAX_PATH_DATA) )
+    {
+        FlushPath();
+    }
+
+    if ( !m_pathData.empty() )
+        m_pathData += wxS(' ');
+
+    m_pathKind = kind;
+
+    return m_pathData;
+}
+
+void wxSVGFileDCImpl::EndPathData()
+{
+    // Lines drawn with a translucent pen can't be combined into a single path
+    // because the overlapping parts would then be drawn only once. Filled
+    // shapes are only combined if CanCombineFill() returned true, and so have
+    // no outline and an opaque fill.
+    if ( m_pathKind != Path_Fill && m_pen.GetColour().Alpha() != wxALPHA_OPAQUE )
+        FlushPath();
+}
+
+bool wxSVGFileDCImpl::CanCombineFill() const
+{
+    return m_pen.IsTransparent() &&
+            m_brush.GetStyle() == wxBRUSHSTYLE_SOLID &&
+                m_brush.GetColour().Alpha() == wxALPHA_OPAQUE;
+}
+
+void wxSVGFileDCImpl::FlushPath()
+{
+    if ( m_pathData.empty() )
+        return;
+
+    wxString s(wxS("  <path d=\""));
+    s << m_pathData << wxS("\" ");
+    if ( m_pathKind == Path_Stroke )
+        s << wxS("style=\"fill:none\" ");
+    s << GetPenAttrs() << wxS("/>\n");
+
+    m_pathData.clear();
+
+    DoWrite(s);
+}
+
+const wxString& wxSVGFileDCImpl::GetPenAttrs()
+{
+    if ( m_penAttrs.empty() )
+    {
+        m_penAttrs << GetRenderMode(m_renderingMode) << wxS(' ')
+                   << GetPenPattern(m_pen);
+    }
+
+    return m_penAttrs;
 }
 
 #endif // wxUSE_SVG
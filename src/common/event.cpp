@@ -43,10 +43,13 @@
 
 #include "wx/thread.h"
 
+#include "wx/private/evtprofiler.h"
 #include "wx/private/safecall.h"
 
 #if wxUSE_BASE
     #include <memory>
+    #include <unordered_map>
+    #include <vector>
 #endif // wxUSE_BASE
 
 #if wxUSE_GUI
@@ -372,6 +375,8 @@ wxEvent::wxEvent(int theId, wxEventType commandType)
     m_isCommandEvent = false;
     m_propagationLevel = wxEVENT_PROPAGATE_NONE;
     m_propagatedFrom = nullptr;
+    m_coalescingKey = 0;
+    m_queuePriority = wxEVENT_QUEUE_PRIORITY_NORMAL;
     m_wasProcessed = false;
     m_willBeProcessedAgain = false;
 }
@@ -386,6 +391,8 @@ wxEvent::wxEvent(const wxEvent& src)
     , m_handlerToProcessOnlyIn(nullptr)
     , m_propagationLevel(src.m_propagationLevel)
     , m_propagatedFrom(nullptr)
+    , m_coalescingKey(src.m_coalescingKey)
+    , m_queuePriority(src.m_queuePriority)
     , m_skipped(src.m_skipped)
     , m_isCommandEvent(src.m_isCommandEvent)
     , m_wasProcessed(false)
@@ -405,6 +412,8 @@ wxEvent& wxEvent::operator=(const wxEvent& src)
     m_handlerToProcessOnlyIn = nullptr;
     m_propagationLevel = src.m_propagationLevel;
     m_propagatedFrom = nullptr;
+    m_coalescingKey = src.m_coalescingKey;
+    m_queuePriority = src.m_queuePriority;
     m_skipped = src.m_skipped;
     m_isCommandEvent = src.m_isCommandEvent;
 
@@ -1181,6 +1190,198 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxEvtHandler::PendingEvents
+// ----------------------------------------------------------------------------
+
+// This is a queue of events which, unlike wxList previously used for pending
+// events, doesn't allocate memory for each event added to it, but reuses the
+// same storage: the events are removed from the front of the vector by just
+// advancing the index of the first one and the vector is emptied, without
+// freeing its memory, when no more events remain.
+//
+// Events can also be inserted into and erased from the middle of the queue,
+// which is less efficient, but only needed for the events with non-default
+// priority or when processing only some events while yielding.
+
+namespace
+{
+
+// Maximal capacity of the pending events vector kept when it becomes empty.
+const size_t wxPENDING_EVENTS_MAX_RETAINED = 1024;
+
+} // anonymous namespace
+
+class wxEvtHandler::PendingEvents
+{
+public:
+    PendingEvents() = default;
+
+    ~PendingEvents()
+    {
+        for ( size_t n = m_first; n != m_events.size(); n++ )
+            delete m_events[n];
+    }
+
+    bool IsEmpty() const { return m_first == m_events.size(); }
+
+    // Return the index of the first pending event and one past the last one.
+    size_t GetFirst() const { return m_first; }
+    size_t GetEnd() const { return m_events.size(); }
+
+    wxEvent* Get(size_t n) const { return m_events[n]; }
+    void Set(size_t n, wxEvent* event) { m_events[n] = event; }
+
+    // Insert the event before the one at the given index, which may be equal
+    // to GetEnd() to append it.
+    void Insert(size_t n, wxEvent* event)
+    {
+        if ( n == m_events.size() )
+        {
+            // Discard the unused slots at the front if they take more than
+            // half of the vector, as otherwise it would grow indefinitely if
+            // the events were added to it faster than they are processed.
+            if ( m_first && m_first >= m_events.size() / 2 )
+            {
+                m_events.erase(m_events.begin(), m_events.begin() + m_first);
+                m_first = 0;
+            }
+
+            m_events.push_back(event);
+        }
+        else if ( n == m_first && m_first )
+        {
+            // Reuse the unused slot before the first event.
+            m_events[--m_first] = event;
+        }
+        else
+        {
+            m_events.insert(m_events.begin() + n, event);
+        }
+    }
+
+    // Remove the event at the given index from the queue, without deleting it.
+    void Erase(size_t n)
+    {
+        if ( n == m_first )
+        {
+            if ( ++m_first == m_events.size() )
+            {
+                // Don't keep too much memory after processing a burst of events.
+                if ( m_events.capacity() > wxPENDING_EVENTS_MAX_RETAINED )
+                    std::vector<wxEvent*>().swap(m_events);
+                else
+                    m_events.clear();
+
+                m_first = 0;
+            }
+        }
+        else
+        {
+            m_events.erase(m_events.begin() + n);
+        }
+    }
+
+private:
+    std::vector<wxEvent*> m_events;
+
+    // Index of the first pending event in m_events.
+    size_t m_first = 0;
+
+    wxDECLARE_NO_COPY_CLASS(PendingEvents);
+};
+
+// ----------------------------------------------------------------------------
+// wxEvtHandler::DynamicEventsIndex
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The index is only created when the number of dynamic event handlers reaches
+// this value: below it, just iterating over all of them is fast enough and
+// avoiding the index saves memory for the typical case of a handler with only
+// a few dynamically bound events.
+const size_t wxDYNAMIC_EVENTS_INDEX_THRESHOLD = 16;
+
+// Remove the null entries corresponding to the unbound event handlers.
+void PruneDeletedDynamicEntries(wxVector<wxDynamicEventTableEntry*>& entries)
+{
+    size_t nNew = 0;
+    for ( size_t n = 0; n != entries.size(); n++ )
+    {
+        if ( entries[n] )
+            entries[nNew++] = entries[n];
+    }
+
+    entries.resize(nNew);
+}
+
+} // anonymous namespace
+
+// This class maps event types to the entries of m_dynamicEvents for this type,
+// in the same order as they appear in m_dynamicEvents, i.e. in the order in
+// which they were bound. Just as m_dynamicEvents itself, the vectors of the
+// entries contain null pointers for the entries which were unbound, as they
+// may be being iterated over when this happens, and are only compacted after
+// dispatching an event.
+class wxEvtHandler::DynamicEventsIndex
+{
+public:
+    DynamicEventsIndex() = default;
+
+    void Add(wxDynamicEventTableEntry* entry)
+    {
+        m_entries[entry->m_eventType].push_back(entry);
+    }
+
+    void Remove(wxDynamicEventTableEntry* entry)
+    {
+        DynamicEvents* const entries = Find(entry->m_eventType);
+        wxCHECK_RET( entries, "unbound entry must be in the index" );
+
+        // Don't change the size of the vector here, as we could be iterating
+        // over it in SearchDynamicEventTable() right now: this would make its
+        // loop access invalid elements or, if new entries were appended later,
+        // call the handlers bound while the event was being dispatched.
+        for ( size_t n = entries->size(); n; n-- )
+        {
+            if ( (*entries)[n - 1] == entry )
+            {
+                (*entries)[n - 1] = nullptr;
+                break;
+            }
+        }
+
+        m_hasDeleted = true;
+    }
+
+    DynamicEvents* Find(wxEventType eventType)
+    {
+        const auto it = m_entries.find(eventType);
+        return it == m_entries.end() ? nullptr : &it->second;
+    }
+
+    // As m_dynamicEvents is not iterated over when using the index, it must
+    // be pruned by calling this function after dispatching an event to
+    // prevent it from growing indefinitely.
+    void PruneDeleted(DynamicEvents& all)
+    {
+        if ( m_hasDeleted )
+        {
+            PruneDeletedDynamicEntries(all);
+            m_hasDeleted = false;
+        }
+    }
+
+private:
+    std::unordered_map<wxEventType, DynamicEvents> m_entries;
+
+    bool m_hasDeleted = false;
+
+    wxDECLARE_NO_COPY_CLASS(DynamicEventsIndex);
+};
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
@@ -1191,6 +1392,7 @@ wxEvtHandler::wxEvtHandler()
     m_previousHandler = nullptr;
     m_enabled = true;
     m_dynamicEvents = nullptr;
+    m_dynamicEventsIndex = nullptr;
     m_pendingEvents = nullptr;
 
     // no client data (yet)
@@ -1227,6 +1429,7 @@ wxEvtHandler::~wxEvtHandler()
             delete entry;
         }
         delete m_dynamicEvents;
+        delete m_dynamicEventsIndex;
     }
 
     // Remove us from the list of the pending events if necessary.
@@ -1330,18 +1533,68 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
         return;
     }
 
+    // the event replaced by this one, if any: it's only deleted after
+    // leaving the critical section below, as its dtor could run arbitrary code
+    std::unique_ptr<wxEvent> coalesced;
+
     // 1) Add this event to our list of pending events
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
     if ( !m_pendingEvents )
-        m_pendingEvents = new wxList;
+        m_pendingEvents = new PendingEvents;
+
+    const wxEventQueuePriority priority = event->GetQueuePriority();
 
-    m_pendingEvents->Append(event);
+    bool queued = false;
+    if ( const wxUIntPtr key = event->GetCoalescingKey() )
+    {
+        for ( size_t n = m_pendingEvents->GetFirst();
+              n != m_pendingEvents->GetEnd();
+              n++ )
+        {
+            wxEvent* const pending = m_pendingEvents->Get(n);
+            if ( pending->GetCoalescingKey() != key ||
+                    pending->GetEventType() != event->GetEventType() )
+                continue;
+
+            coalesced.reset(pending);
+
+            // if the priority is the same, just take the place of the event
+            // being replaced, otherwise insert the new one as usual below
+            if ( pending->GetQueuePriority() == priority )
+            {
+                m_pendingEvents->Set(n, event);
+                queued = true;
+            }
+            else
+            {
+                m_pendingEvents->Erase(n);
+            }
+
+            // there can be at most one pending event with the same key
+            break;
+        }
+    }
+
+    if ( !queued )
+    {
+        // find the last event with the same or higher priority: in the common
+        // case of all events having the same priority, this is just the last
+        // one and the new event is simply appended to the queue
+        size_t n = m_pendingEvents->GetEnd();
+        while ( n != m_pendingEvents->GetFirst() &&
+                m_pendingEvents->Get(n - 1)->GetQueuePriority() < priority )
+        {
+            n--;
+        }
+
+        m_pendingEvents->Insert(n, event);
+    }
 
     // 2) Add this event handler to list of event handlers that
     //    have pending events.
 
-    wxTheApp->AppendPendingEventHandler(this);
+    const bool wakeUp = wxTheApp->AppendPendingEventHandler(this);
 
     // only release m_pendingEventsLock now because otherwise there is a race
     // condition as described in the ticket #9093: we could process the event
@@ -1353,13 +1606,17 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
 
     // 3) Inform the system that new pending events are somewhere,
     //    and that these should be processed in idle time.
-    wxWakeUpIdle();
+    //
+    //    This only needs to be done once until the pending events are
+    //    processed: if the loop had been already woken up, it will process
+    //    this event too, so there is no need to pay for waking it up again,
+    //    which can be relatively expensive, for each and every event.
+    if ( wakeUp )
+        wxWakeUpIdle();
 }
 
 void wxEvtHandler::DeletePendingEvents()
 {
-    if (m_pendingEvents)
-        m_pendingEvents->DeleteContents(true);
     wxDELETE(m_pendingEvents);
 }
 
@@ -1384,20 +1641,19 @@ void wxEvtHandler::ProcessPendingEvents()
     wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
                  "should have pending events if called" );
 
-    wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
-    wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
+    size_t n = m_pendingEvents->GetFirst();
 
     // find the first event which can be processed now:
     wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
     if (evtLoop && evtLoop->IsYielding())
     {
-        while (node && pEvent && !evtLoop->IsEventAllowedInsideYield(pEvent->GetEventCategory()))
+        while ( n != m_pendingEvents->GetEnd() &&
+                !evtLoop->IsEventAllowedInsideYield(m_pendingEvents->Get(n)->GetEventCategory()) )
         {
-            node = node->GetNext();
-            pEvent = node ? static_cast<wxEvent *>(node->GetData()) : nullptr;
+            n++;
         }
 
-        if (!node)
+        if ( n == m_pendingEvents->GetEnd() )
         {
             // all our events are NOT processable now... signal this:
             wxTheApp->DelayPendingEventHandler(this);
@@ -1411,12 +1667,15 @@ void wxEvtHandler::ProcessPendingEvents()
         }
     }
 
-    std::unique_ptr<wxEvent> event(pEvent);
+    if ( wxEventProfiler::IsEnabled() )
+        wxEventProfilerSamplePending(m_pendingEvents->GetEnd() - m_pendingEvents->GetFirst());
+
+    std::unique_ptr<wxEvent> event(m_pendingEvents->Get(n));
 
     // it's important we remove event from list before processing it, else a
     // nested event loop, for example from a modal dialog, might process the
     // same event again.
-    m_pendingEvents->Erase(node);
+    m_pendingEvents->Erase(n);
 
     if ( m_pendingEvents->IsEmpty() )
     {
@@ -1457,6 +1716,8 @@ bool wxEvtHandler::ProcessEventIfMatchesId(const wxEventTableEntryBase& entry,
         event.Skip(false);
         event.m_callbackUserData = entry.m_callbackUserData;
 
+        wxEventProfilerHandlerCall profile(*entry.m_fn, handler, event);
+
 #if wxUSE_EXCEPTIONS
         if ( wxTheApp )
         {
@@ -1788,6 +2049,20 @@ void wxEvtHandler::DoBind(int id,
     // than inserting the element at the front.
     m_dynamicEvents->push_back(entry);
 
+    if ( m_dynamicEventsIndex )
+    {
+        m_dynamicEventsIndex->Add(entry);
+    }
+    else if ( m_dynamicEvents->size() >= wxDYNAMIC_EVENTS_INDEX_THRESHOLD )
+    {
+        m_dynamicEventsIndex = new DynamicEventsIndex;
+        for ( wxDynamicEventTableEntry* const e : *m_dynamicEvents )
+        {
+            if ( e )
+                m_dynamicEventsIndex->Add(e);
+        }
+    }
+
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
     if ( eventSink && eventSink != this )
@@ -1842,6 +2117,9 @@ wxEvtHandler::DoUnbind(int id,
             // this implementation detail.
             (*m_dynamicEvents)[cookie] = nullptr;
 
+            if ( m_dynamicEventsIndex )
+                m_dynamicEventsIndex->Remove(entry);
+
             delete entry;
             return true;
         }
@@ -1882,7 +2160,21 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     wxCHECK_MSG( m_dynamicEvents, false,
                  wxT("caller should check that we have dynamic events") );
 
-    DynamicEvents& dynamicEvents = *m_dynamicEvents;
+    // If we have the index, only iterate over the entries for this event
+    // type: as they're in the same order as in m_dynamicEvents, the result is
+    // exactly the same as when iterating over all of them below.
+    DynamicEvents* entries = m_dynamicEvents;
+    if ( m_dynamicEventsIndex )
+    {
+        entries = m_dynamicEventsIndex->Find(event.GetEventType());
+        if ( !entries )
+        {
+            m_dynamicEventsIndex->PruneDeleted(*m_dynamicEvents);
+            return false;
+        }
+    }
+
+    DynamicEvents& dynamicEvents = *entries;
 
     bool needToPruneDeleted = false;
 
@@ -1929,17 +2221,10 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     }
 
     if ( needToPruneDeleted )
-    {
-        size_t nNew = 0;
-        for ( size_t n = 0; n != dynamicEvents.size(); n++ )
-        {
-            if ( dynamicEvents[n] )
-                dynamicEvents[nNew++] = dynamicEvents[n];
-        }
+        PruneDeletedDynamicEntries(dynamicEvents);
 
-        wxASSERT( nNew != dynamicEvents.size() );
-        dynamicEvents.resize(nNew);
-    }
+    if ( m_dynamicEventsIndex )
+        m_dynamicEventsIndex->PruneDeleted(*m_dynamicEvents);
 
     return false;
 }
@@ -2014,6 +2299,9 @@ void wxEvtHandler::OnSinkDestroyed( wxEvtHandler *sink )
     {
         if ( entry->m_fn->GetEvtHandler() == sink )
         {
+            if ( m_dynamicEventsIndex )
+                m_dynamicEventsIndex->Remove(entry);
+
             delete entry->m_callbackUserData;
             delete entry;
 
@@ -21,6 +21,7 @@
 #include "wx/scopeguard.h"
 #include "wx/apptrait.h"
 #include "wx/private/eventloopsourcesmanager.h"
+#include "wx/private/evtprofiler.h"
 #include "wx/private/safecall.h"
 
 // Counts currently existing event loops.
@@ -102,6 +103,8 @@ void wxEventLoopBase::OnExit()
 
 bool wxEventLoopBase::ProcessIdle()
 {
+    wxEventProfilerTimer profile(wxEventProfilerTimer::Idle);
+
     return wxTheApp && wxTheApp->ProcessIdle();
 }
 
@@ -223,7 +226,11 @@ bool wxEventLoopManual::ProcessEvents()
     // executed)
     if ( wxTheApp )
     {
-        wxTheApp->ProcessPendingEvents();
+        {
+            wxEventProfilerTimer profile(wxEventProfilerTimer::Pending);
+
+            wxTheApp->ProcessPendingEvents();
+        }
 
         // One of the pending event handlers could have decided to exit the
         // loop so check for the flag before trying to dispatch more events
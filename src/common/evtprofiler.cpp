@@ -0,0 +1,620 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/evtprofiler.cpp
+// Purpose:     wxEventProfiler implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/string.h"
+#endif // WX_PRECOMP
+
+#include "wx/private/evtprofiler.h"
+
+#include "wx/ffile.h"
+#include "wx/thread.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#ifndef wxNO_RTTI
+    #include <typeinfo>
+#endif
+
+#ifdef HAVE_CXA_DEMANGLE
+    #include <cxxabi.h>
+#endif // HAVE_CXA_DEMANGLE
+
+// ----------------------------------------------------------------------------
+// private types and globals
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Default values of the parameters which can be changed by the user.
+const size_t wxEVTPROF_DEFAULT_MAX_TRACE_RECORDS = 100000;
+const size_t wxEVTPROF_DEFAULT_SLOWEST_COUNT = 20;
+
+// Everything we remember about a single handler call or event loop
+// operation: notice that we only store the pointers to static strings here to
+// make recording cheap.
+struct TraceRecord
+{
+    enum Kind
+    {
+        Kind_Handler,
+        Kind_Idle,
+        Kind_Pending,
+        Kind_Sample
+    };
+
+    Kind kind;
+    int thread;
+    wxLongLong start;
+    wxLongLong duration;
+
+    // only for Kind_Handler
+    wxEventType type;
+    const wxChar* eventClass;
+    const wxChar* handlerClass;
+    const char* handlerType;
+    const char* functorType;
+
+    // only for Kind_Sample
+    size_t events;
+};
+
+struct TypeStats
+{
+    const wxChar* eventClass = nullptr;
+    unsigned long count = 0;
+    wxLongLong totalTime;
+    wxLongLong maxTime;
+};
+
+// Comparator for keeping the slowest handler calls in a min-heap.
+bool IsFaster(const TraceRecord& r1, const TraceRecord& r2)
+{
+    return r1.duration > r2.duration;
+}
+
+// All the profiler data, protected by its critical section.
+struct ProfilerData
+{
+    ProfilerData()
+    {
+        maxTraceRecords = wxEVTPROF_DEFAULT_MAX_TRACE_RECORDS;
+        slowestCount = wxEVTPROF_DEFAULT_SLOWEST_COUNT;
+    }
+
+    void Reset()
+    {
+        origin = wxGetUTCTimeUSec();
+        records.clear();
+        droppedRecords = 0;
+        typeStats.clear();
+        slowest.clear();
+        idle = wxEventProfiler::IdleStats();
+        pending.clear();
+#if wxUSE_THREADS
+        threads.clear();
+#endif // wxUSE_THREADS
+    }
+
+    // Return the small integer identifying the current thread in the trace.
+    int GetCurrentThread()
+    {
+#if wxUSE_THREADS
+        const auto res = threads.emplace(wxThread::GetCurrentId(),
+                                         static_cast<int>(threads.size()) + 1);
+        return res.first->second;
+#else // !wxUSE_THREADS
+        return 1;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+    }
+
+    void AddRecord(const TraceRecord& record)
+    {
+        if ( records.size() < maxTraceRecords )
+            records.push_back(record);
+        else
+            droppedRecords++;
+    }
+
+    wxCriticalSection cs;
+
+    wxLongLong origin;
+
+    size_t maxTraceRecords;
+    std::vector<TraceRecord> records;
+    unsigned long droppedRecords = 0;
+
+    std::unordered_map<wxEventType, TypeStats> typeStats;
+
+    size_t slowestCount;
+    std::vector<TraceRecord> slowest;
+
+    wxEventProfiler::IdleStats idle;
+
+    std::vector<wxEventProfiler::PendingSample> pending;
+
+#if wxUSE_THREADS
+    std::unordered_map<wxThreadIdType, int> threads;
+#endif // wxUSE_THREADS
+};
+
+ProfilerData& GetData()
+{
+    static ProfilerData s_data;
+    return s_data;
+}
+
+// Return the demangled type name, caching the results as demangling is slow.
+wxString GetTypeName(const char* mangled)
+{
+    if ( !mangled )
+        return wxString();
+
+    static std::unordered_map<const char*, wxString> s_names;
+
+    wxString& name = s_names[mangled];
+    if ( name.empty() )
+    {
+#ifdef HAVE_CXA_DEMANGLE
+        int rc = -1;
+        char* const demangled = __cxxabiv1::__cxa_demangle(mangled,
+                                                           nullptr,
+                                                           nullptr,
+                                                           &rc);
+        if ( rc == 0 )
+            name = wxString::FromAscii(demangled);
+
+        free(demangled);
+
+        if ( name.empty() )
+#endif // HAVE_CXA_DEMANGLE
+            name = wxString::FromAscii(mangled);
+    }
+
+    return name;
+}
+
+wxString GetHandlerName(const TraceRecord& record)
+{
+    wxString name = GetTypeName(record.handlerType);
+    if ( name.empty() )
+        name = record.handlerClass;
+
+    return name;
+}
+
+// Return the string quoted and escaped as needed for JSON.
+wxString QuoteJSON(const wxString& s)
+{
+    wxString quoted;
+    quoted.reserve(s.length() + 2);
+
+    quoted += '"';
+    for ( wxString::const_iterator it = s.begin(); it != s.end(); ++it )
+    {
+        const wxUniChar ch = *it;
+        switch ( ch.GetValue() )
+        {
+            case '"':
+            case '\\':
+                quoted += '\\';
+                quoted += ch;
+                break;
+
+            default:
+                if ( ch < 0x20 )
+                    quoted += wxString::Format("\\u%04x", static_cast<int>(ch.GetValue()));
+                else
+                    quoted += ch;
+        }
+    }
+    quoted += '"';
+
+    return quoted;
+}
+
+// The total time spent in the idle events handlers in the current thread,
+// used by the idle timer to exclude everything else from idle processing time.
+thread_local wxLongLong gs_idleHandlersTime;
+
+// The nesting level of the idle events handlers calls and of the idle timers
+// in the current thread: only the outermost ones are taken into account.
+thread_local int gs_idleHandlersDepth = 0;
+thread_local int gs_idleTimersDepth = 0;
+
+} // anonymous namespace
+
+// ============================================================================
+// wxEventProfiler implementation
+// ============================================================================
+
+std::atomic<bool> wxEventProfiler::ms_enabled(false);
+
+/* static */
+void wxEventProfiler::Enable(bool enable)
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    if ( enable && !ms_enabled.load() )
+        data.Reset();
+
+    ms_enabled.store(enable);
+}
+
+/* static */
+void wxEventProfiler::Reset()
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    data.Reset();
+}
+
+/* static */
+void wxEventProfiler::SetMaxTraceRecords(size_t count)
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    data.maxTraceRecords = count;
+}
+
+/* static */
+void wxEventProfiler::SetSlowestHandlersCount(size_t count)
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    data.slowestCount = count;
+
+    // keep the slowest ones if we have too many of them now
+    if ( data.slowest.size() > count )
+    {
+        std::sort(data.slowest.begin(), data.slowest.end(), IsFaster);
+        data.slowest.resize(count);
+        std::make_heap(data.slowest.begin(), data.slowest.end(), IsFaster);
+    }
+}
+
+/* static */
+std::vector<wxEventProfiler::EventTypeStats> wxEventProfiler::GetEventTypeStats()
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    std::vector<EventTypeStats> stats;
+    stats.reserve(data.typeStats.size());
+    for ( const auto& kv : data.typeStats )
+    {
+        EventTypeStats s;
+        s.type = kv.first;
+        s.eventClass = kv.second.eventClass;
+        s.count = kv.second.count;
+        s.totalTime = kv.second.totalTime;
+        s.maxTime = kv.second.maxTime;
+
+        stats.push_back(s);
+    }
+
+    std::sort(stats.begin(), stats.end(),
+              [](const EventTypeStats& s1, const EventTypeStats& s2)
+              {
+                  return s1.totalTime > s2.totalTime;
+              });
+
+    return stats;
+}
+
+/* static */
+std::vector<wxEventProfiler::HandlerCall> wxEventProfiler::GetSlowestHandlers()
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    std::vector<TraceRecord> slowest(data.slowest);
+    std::sort(slowest.begin(), slowest.end(), IsFaster);
+
+    std::vector<HandlerCall> calls;
+    calls.reserve(slowest.size());
+    for ( const TraceRecord& record : slowest )
+    {
+        HandlerCall call;
+        call.type = record.type;
+        call.eventClass = record.eventClass;
+        call.handlerClass = GetHandlerName(record);
+        call.functorClass = GetTypeName(record.functorType);
+        call.start = record.start;
+        call.duration = record.duration;
+
+        calls.push_back(call);
+    }
+
+    return calls;
+}
+
+/* static */
+wxEventProfiler::IdleStats wxEventProfiler::GetIdleStats()
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    return data.idle;
+}
+
+/* static */
+std::vector<wxEventProfiler::PendingSample> wxEventProfiler::GetPendingSamples()
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    return data.pending;
+}
+
+/* static */
+wxString wxEventProfiler::GetChromeTrace()
+{
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    wxString trace;
+    trace.reserve(data.records.size()*160);
+
+    trace += "{\"traceEvents\":[";
+
+    bool first = true;
+    for ( const TraceRecord& record : data.records )
+    {
+        if ( first )
+            first = false;
+        else
+            trace += ',';
+
+        trace += "\n{";
+
+        switch ( record.kind )
+        {
+            case TraceRecord::Kind_Handler:
+                trace += "\"name\":";
+                trace += QuoteJSON(record.eventClass);
+                trace += ",\"cat\":\"event\",\"ph\":\"X\"";
+                break;
+
+            case TraceRecord::Kind_Idle:
+                trace += "\"name\":\"idle\",\"cat\":\"loop\",\"ph\":\"X\"";
+                break;
+
+            case TraceRecord::Kind_Pending:
+                trace += "\"name\":\"pending events\",\"cat\":\"loop\",\"ph\":\"X\"";
+                break;
+
+            case TraceRecord::Kind_Sample:
+                trace += "\"name\":\"pending queue\",\"cat\":\"loop\",\"ph\":\"C\"";
+                break;
+        }
+
+        trace += wxString::Format(",\"pid\":1,\"tid\":%d,\"ts\":%s",
+                                  record.thread,
+                                  record.start.ToString());
+
+        switch ( record.kind )
+        {
+            case TraceRecord::Kind_Handler:
+                trace += wxString::Format(",\"dur\":%s,\"args\":{\"type\":%d",
+                                          record.duration.ToString(),
+                                          record.type);
+                trace += ",\"handler\":";
+                trace += QuoteJSON(GetHandlerName(record));
+                if ( record.functorType )
+                {
+                    trace += ",\"functor\":";
+                    trace += QuoteJSON(GetTypeName(record.functorType));
+                }
+                trace += '}';
+                break;
+
+            case TraceRecord::Kind_Idle:
+            case TraceRecord::Kind_Pending:
+                trace += ",\"dur\":";
+                trace += record.duration.ToString();
+                break;
+
+            case TraceRecord::Kind_Sample:
+                trace += wxString::Format(",\"args\":{\"events\":%lu}",
+                                          static_cast<unsigned long>(record.events));
+                break;
+        }
+
+        trace += '}';
+    }
+
+    trace += wxString::Format("\n],\"displayTimeUnit\":\"ms\","
+                              "\"otherData\":{\"droppedRecords\":%lu}}\n",
+                              data.droppedRecords);
+
+    return trace;
+}
+
+/* static */
+bool wxEventProfiler::SaveChromeTrace(const wxString& filename)
+{
+    wxFFile file(filename, "w");
+    if ( !file.IsOpened() )
+        return false;
+
+    return file.Write(GetChromeTrace(), wxConvUTF8) && file.Close();
+}
+
+// ============================================================================
+// helpers for collecting the data
+// ============================================================================
+
+void wxEventProfilerHandlerCall::Start(const wxEventFunctor& functor,
+                                       const wxEvtHandler* handler,
+                                       const wxEvent& event)
+{
+    m_type = event.GetEventType();
+    m_eventClass = event.GetClassInfo()->GetClassName();
+    m_handlerClass = handler->GetClassInfo()->GetClassName();
+
+#ifndef wxNO_RTTI
+    m_handlerType = typeid(*handler).name();
+    m_functorType = typeid(functor).name();
+#else // wxNO_RTTI
+    wxUnusedVar(functor);
+
+    m_handlerType =
+    m_functorType = nullptr;
+#endif // !wxNO_RTTI/wxNO_RTTI
+
+    if ( m_type == wxEVT_IDLE )
+        gs_idleHandlersDepth++;
+
+    m_start = wxGetUTCTimeUSec();
+}
+
+void wxEventProfilerHandlerCall::End()
+{
+    const wxLongLong end = wxGetUTCTimeUSec();
+
+    if ( m_type == wxEVT_IDLE && --gs_idleHandlersDepth == 0 )
+        gs_idleHandlersTime += end - m_start;
+
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    TraceRecord record;
+    record.kind = TraceRecord::Kind_Handler;
+    record.thread = data.GetCurrentThread();
+    record.start = m_start - data.origin;
+    record.duration = end - m_start;
+    record.type = m_type;
+    record.eventClass = m_eventClass;
+    record.handlerClass = m_handlerClass;
+    record.handlerType = m_handlerType;
+    record.functorType = m_functorType;
+    record.events = 0;
+
+    data.AddRecord(record);
+
+    TypeStats& stats = data.typeStats[m_type];
+    stats.eventClass = m_eventClass;
+    stats.count++;
+    stats.totalTime += record.duration;
+    if ( record.duration > stats.maxTime )
+        stats.maxTime = record.duration;
+
+    if ( data.slowest.size() < data.slowestCount )
+    {
+        data.slowest.push_back(record);
+        std::push_heap(data.slowest.begin(), data.slowest.end(), IsFaster);
+    }
+    else if ( !data.slowest.empty() &&
+                record.duration > data.slowest.front().duration )
+    {
+        std::pop_heap(data.slowest.begin(), data.slowest.end(), IsFaster);
+        data.slowest.back() = record;
+        std::push_heap(data.slowest.begin(), data.slowest.end(), IsFaster);
+    }
+}
+
+bool wxEventProfilerTimer::Start()
+{
+    if ( m_kind == Idle )
+    {
+        // Idle processing may be timed both by the port-specific code and by
+        // wxEventLoopBase::ProcessIdle() called from it, don't count it twice.
+        if ( gs_idleTimersDepth++ )
+        {
+            gs_idleTimersDepth--;
+            return false;
+        }
+
+        m_idleHandlersTime = gs_idleHandlersTime;
+    }
+
+    m_start = wxGetUTCTimeUSec();
+
+    return true;
+}
+
+void wxEventProfilerTimer::End()
+{
+    const wxLongLong end = wxGetUTCTimeUSec();
+
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    TraceRecord record = TraceRecord();
+    record.kind = m_kind == Idle ? TraceRecord::Kind_Idle
+                                 : TraceRecord::Kind_Pending;
+    record.thread = data.GetCurrentThread();
+    record.start = m_start - data.origin;
+
+    if ( m_kind == Idle )
+    {
+        // Pending events processed, log messages flushed and objects deleted
+        // during idle processing are not part of it, only the idle events
+        // handlers are.
+        gs_idleTimersDepth--;
+        record.duration = gs_idleHandlersTime - m_idleHandlersTime;
+    }
+    else
+    {
+        record.duration = end - m_start;
+    }
+
+    data.AddRecord(record);
+
+    if ( m_kind == Idle )
+    {
+        data.idle.count++;
+        data.idle.totalTime += record.duration;
+        if ( record.duration > data.idle.maxTime )
+            data.idle.maxTime = record.duration;
+    }
+}
+
+void wxEventProfilerSamplePending(size_t events)
+{
+    if ( !wxEventProfiler::IsEnabled() )
+        return;
+
+    ProfilerData& data = GetData();
+    wxCriticalSectionLocker lock(data.cs);
+
+    wxEventProfiler::PendingSample sample;
+    sample.time = wxGetUTCTimeUSec() - data.origin;
+    sample.events = events;
+
+    if ( data.pending.size() < data.maxTraceRecords )
+        data.pending.push_back(sample);
+
+    TraceRecord record = TraceRecord();
+    record.kind = TraceRecord::Kind_Sample;
+    record.thread = data.GetCurrentThread();
+    record.start = sample.time;
+    record.events = events;
+
+    data.AddRecord(record);
+}
@@ -23,11 +23,14 @@
     #include "wx/module.h"
 #endif //WX_PRECOMP
 
+#include "wx/sysopt.h"
+
 #include "wx/private/fdiodispatcher.h"
 
 #include "wx/private/selectdispatcher.h"
 #ifdef __UNIX__
     #include "wx/unix/private/epolldispatcher.h"
+    #include "wx/unix/private/iouringdispatcher.h"
 #endif
 
 static
@@ -47,10 +50,25 @@ wxFDIODispatcher *wxFDIODispatcher::Get()
     if ( !gs_dispatcher )
     {
 #if wxUSE_EPOLL_DISPATCHER
-        gs_dispatcher = wxEpollDispatcher::Create();
-        if ( !gs_dispatcher )
+        // allow selecting the dispatcher to use at run-time, falling back to
+        // the next best one if the requested one is not available
+#if wxUSE_SYSTEM_OPTIONS
+        const wxString kind = wxSystemOptions::GetOption("unix.fdio-dispatcher");
+#else
+        const wxString kind;
+#endif // wxUSE_SYSTEM_OPTIONS
+
+#ifdef wxHAS_IO_URING
+        if ( kind == "io_uring" )
+            gs_dispatcher = wxIOUringDispatcher::Create();
+#endif // wxHAS_IO_URING
+
+        if ( !gs_dispatcher && kind != "select" )
+            gs_dispatcher = wxEpollDispatcher::Create();
 #endif // wxUSE_EPOLL_DISPATCHER
+
 #if wxUSE_SELECT_DISPATCHER
+        if ( !gs_dispatcher )
             gs_dispatcher = new wxSelectDispatcher();
 #endif // wxUSE_SELECT_DISPATCHER
     }
@@ -49,6 +49,11 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include <vector>
+
 #if defined(__WINDOWS__)
     // This header includes <windows.h> and declares wxMSWFormatMessage().
     #include "wx/msw/private.h"
@@ -162,6 +167,307 @@ inline ComponentLevelsMap& GetComponentLevels()
     return s_componentLevels;
 }
 
+// ----------------------------------------------------------------------------
+// lock-free snapshots of the component levels and trace masks
+// ----------------------------------------------------------------------------
+
+// Checking whether logging is enabled is done for every wxLogXXX() call, even
+// when nothing ends up being logged, so it must be cheap and, in particular,
+// can't lock anything nor allocate memory. To allow this, the data used by
+// these checks is copied into immutable snapshots replaced as a whole whenever
+// the data changes, which can be used without locking.
+
+// FNV-1a hash of a component name or a trace mask, which must be the same for
+// the same ASCII string stored as either char or wchar_t.
+template <typename T>
+wxUint32 HashLogName(const T* s, size_t len)
+{
+    wxUint32 hash = 2166136261u;
+    for ( size_t n = 0; n < len; n++ )
+    {
+        hash ^= static_cast<typename std::make_unsigned<T>::type>(s[n]);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// Component name or trace mask together with its hash.
+class LogName
+{
+public:
+    explicit LogName(const wxString& name)
+        : m_name(name),
+          m_len(std::char_traits<wxStringCharType>::length(m_name.wx_str())),
+          m_hash(HashLogName(m_name.wx_str(), m_len))
+    {
+    }
+
+    template <typename T>
+    bool Matches(const T* s, size_t len, wxUint32 hash) const
+    {
+        if ( hash != m_hash || len != m_len )
+            return false;
+
+        const wxStringCharType* const name = m_name.wx_str();
+        for ( size_t n = 0; n < len; n++ )
+        {
+            if ( static_cast<typename std::make_unsigned<T>::type>(s[n]) !=
+                    static_cast<std::make_unsigned<wxStringCharType>::type>(name[n]) )
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    const wxString m_name;
+    const size_t m_len;
+    const wxUint32 m_hash;
+};
+
+struct ComponentLevel
+{
+    ComponentLevel(const wxString& component_, wxLogLevel level_)
+        : component(component_), level(level_)
+    {
+    }
+
+    LogName component;
+    wxLogLevel level;
+};
+
+using ComponentLevelsData = std::vector<ComponentLevel>;
+using TraceMasksData = std::vector<LogName>;
+
+// The current snapshot of some data, which is null if the data is empty.
+//
+// Publish() must be called while holding the lock protecting the data being
+// changed. The data can only be accessed using a Reader object, which can be
+// used without locking. Each thread announces the snapshot it is reading in
+// its own slot, so that readers in different threads never write to the same
+// memory, and the previous snapshots are destroyed by Publish() as soon as
+// no slot refers to them any longer.
+//
+// Notice that there can be at most one Reader for the given snapshot in any
+// thread at any time.
+template <typename T>
+class LogSnapshot
+{
+    struct ThreadSlot;
+
+public:
+    LogSnapshot() : m_current(nullptr) { }
+
+    ~LogSnapshot()
+    {
+        delete m_current.exchange(nullptr);
+
+        for ( const T* data : m_retired )
+            delete data;
+    }
+
+    // Can be used to check whether the data is empty without a Reader, but
+    // the returned pointer must not be dereferenced.
+    bool IsEmpty() const
+    {
+        return !m_current.load(std::memory_order_relaxed);
+    }
+
+    class Reader
+    {
+    public:
+        explicit Reader(LogSnapshot& snapshot)
+            : m_slot(GetThreadSlot())
+        {
+            // Announce the snapshot we're going to use and check that it is
+            // still current after doing it: if it is, Publish() is going to
+            // see it in our slot and won't destroy it. Note that the default
+            // sequentially consistent ordering is required for this.
+            m_data = snapshot.m_current.load();
+            for ( ;; )
+            {
+                m_slot.data.store(m_data);
+
+                const T* const data = snapshot.m_current.load();
+                if ( data == m_data )
+                    break;
+
+                m_data = data;
+            }
+        }
+
+        ~Reader()
+        {
+            m_slot.data.store(nullptr, std::memory_order_release);
+        }
+
+        const T* Get() const { return m_data; }
+
+    private:
+        ThreadSlot& m_slot;
+        const T* m_data;
+
+        wxDECLARE_NO_COPY_CLASS(Reader);
+    };
+
+    // Takes ownership of the data, which may be null.
+    void Publish(T* data)
+    {
+        const T* const old = m_current.exchange(data);
+        if ( old )
+            m_retired.push_back(old);
+
+        // Any reader which started after this point will use the new data, so
+        // only the snapshots still announced by the existing readers can be
+        // in use. The other ones will be destroyed by one of the next calls to
+        // this function, or on program termination.
+        SlotsRegistry& registry = GetSlotsRegistry();
+        wxCriticalSectionLocker lock(registry.cs);
+
+        for ( size_t n = 0; n < m_retired.size(); )
+        {
+            bool inUse = false;
+            for ( const ThreadSlot* slot : registry.slots )
+            {
+                if ( slot->data.load() == m_retired[n] )
+                {
+                    inUse = true;
+                    break;
+                }
+            }
+
+            if ( inUse )
+            {
+                n++;
+                continue;
+            }
+
+            delete m_retired[n];
+            m_retired[n] = m_retired.back();
+            m_retired.pop_back();
+        }
+    }
+
+private:
+    // The snapshot currently used by the Reader in the given thread, if any.
+    struct ThreadSlot
+    {
+        ThreadSlot() : data(nullptr)
+        {
+            SlotsRegistry& registry = GetSlotsRegistry();
+            wxCriticalSectionLocker lock(registry.cs);
+            registry.slots.push_back(this);
+        }
+
+        ~ThreadSlot()
+        {
+            SlotsRegistry& registry = GetSlotsRegistry();
+            wxCriticalSectionLocker lock(registry.cs);
+            registry.slots.erase(std::find(registry.slots.begin(),
+                                           registry.slots.end(),
+                                           this));
+        }
+
+        std::atomic<const T*> data;
+
+        wxDECLARE_NO_COPY_CLASS(ThreadSlot);
+    };
+
+    // All the existing slots, which are only added and removed when the
+    // threads using Reader are started and terminated.
+    struct SlotsRegistry
+    {
+        wxCriticalSection cs;
+        std::vector<const ThreadSlot*> slots;
+    };
+
+    static ThreadSlot& GetThreadSlot()
+    {
+        thread_local ThreadSlot s_slot;
+        return s_slot;
+    }
+
+    static SlotsRegistry& GetSlotsRegistry()
+    {
+        static SlotsRegistry s_registry;
+        return s_registry;
+    }
+
+    std::atomic<const T*> m_current;
+
+    // The previous snapshots which may still be in use by the readers.
+    std::vector<const T*> m_retired;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS(LogSnapshot, T);
+};
+
+inline LogSnapshot<ComponentLevelsData>& GetComponentLevelsSnapshot()
+{
+    static LogSnapshot<ComponentLevelsData> s_componentLevelsSnapshot;
+    return s_componentLevelsSnapshot;
+}
+
+inline LogSnapshot<TraceMasksData>& GetTraceMasksSnapshot()
+{
+    static LogSnapshot<TraceMasksData> s_traceMasksSnapshot;
+    return s_traceMasksSnapshot;
+}
+
+template <typename T>
+wxLogLevel DoGetComponentLevel(const T* component, size_t len)
+{
+    // Avoid even creating the reader in the common case of no levels.
+    LogSnapshot<ComponentLevelsData>& snapshot = GetComponentLevelsSnapshot();
+    if ( snapshot.IsEmpty() )
+        return wxLog::GetLogLevel();
+
+    LogSnapshot<ComponentLevelsData>::Reader reader(snapshot);
+
+    const ComponentLevelsData* const levels = reader.Get();
+    if ( levels )
+    {
+        while ( len )
+        {
+            const wxUint32 hash = HashLogName(component, len);
+            for ( const auto& cl : *levels )
+            {
+                if ( cl.component.Matches(component, len, hash) )
+                    return cl.level;
+            }
+
+            // Fall back to the parent component, if any.
+            while ( --len && component[len] != '/' )
+                ;
+        }
+    }
+
+    return wxLog::GetLogLevel();
+}
+
+template <typename T>
+bool DoIsAllowedTraceMask(const T* mask, size_t len)
+{
+    LogSnapshot<TraceMasksData>& snapshot = GetTraceMasksSnapshot();
+    if ( snapshot.IsEmpty() )
+        return false;
+
+    LogSnapshot<TraceMasksData>::Reader reader(snapshot);
+
+    const TraceMasksData* const masks = reader.Get();
+    if ( !masks )
+        return false;
+
+    const wxUint32 hash = HashLogName(mask, len);
+    for ( const auto& m : *masks )
+    {
+        if ( m.Matches(mask, len, hash) )
+            return true;
+    }
+
+    return false;
+}
+
 } // anonymous namespace
 
 // ============================================================================
@@ -371,7 +677,14 @@ wxLog::OnLog(wxLogLevel level,
         logger = wxPerThreadLogger;
         if ( !logger )
         {
-            if ( ms_pLogger )
+            wxLog * const mainLogger = ms_pLogger;
+            if ( mainLogger && mainLogger->CanLogFromAnyThread() )
+            {
+                // the main logger is thread-safe, but repetition counting
+                // isn't, so bypass it
+                mainLogger->DoLogWithExtras(level, msg, info);
+            }
+            else if ( mainLogger )
             {
                 // buffer the messages until they can be shown from the main
                 // thread
@@ -425,6 +738,14 @@ wxLog::CallDoLogNow(wxLogLevel level,
         gs_prevLog.info = info;
     }
 
+    DoLogWithExtras(level, msg, info);
+}
+
+void
+wxLog::DoLogWithExtras(wxLogLevel level,
+                       const wxString& msg,
+                       const wxLogRecordInfo& info)
+{
     // handle extra data which may be passed to us by wxLogXXX()
     wxString prefix, suffix;
     wxUIntPtr num = 0;
@@ -588,29 +909,44 @@ void wxLog::SetComponentLevel(const wxString& component, wxLogLevel level)
     {
         wxCRIT_SECT_LOCKER(lock, GetLevelsCS());
 
-        GetComponentLevels()[component] = level;
+        auto& componentLevels = GetComponentLevels();
+        componentLevels[component] = level;
+
+        ComponentLevelsData* const data = new ComponentLevelsData;
+        data->reserve(componentLevels.size());
+        for ( const auto& kv : componentLevels )
+            data->emplace_back(kv.first, kv.second);
+
+        GetComponentLevelsSnapshot().Publish(data);
     }
 }
 
 /* static */
-wxLogLevel wxLog::GetComponentLevel(const wxString& componentOrig)
+wxLogLevel wxLog::GetComponentLevel(const wxString& component)
 {
-    wxCRIT_SECT_LOCKER(lock, GetLevelsCS());
+    const wxStringCharType* const str = component.wx_str();
 
-    // Make a copy before modifying it in the loop.
-    wxString component = componentOrig;
+    return DoGetComponentLevel(str,
+                               std::char_traits<wxStringCharType>::length(str));
+}
 
-    const auto& componentLevels = GetComponentLevels();
-    while ( !component.empty() )
-    {
-        const auto it = componentLevels.find(component);
-        if ( it != componentLevels.end() )
-            return it->second;
+/* static */
+wxLogLevel wxLog::GetComponentLevel(const char* component)
+{
+    // Don't bother computing the length in the common case of no levels.
+    if ( !component || GetComponentLevelsSnapshot().IsEmpty() )
+        return GetLogLevel();
 
-        component = component.BeforeLast('/');
+    size_t len = 0;
+    for ( ; component[len]; len++ )
+    {
+        // Non-ASCII components need to be converted using the current locale
+        // encoding, as it would have been done when creating a wxString.
+        if ( static_cast<unsigned char>(component[len]) >= 0x80 )
+            return GetComponentLevel(wxString(component));
     }
 
-    return GetLogLevel();
+    return DoGetComponentLevel(component, len);
 }
 
 // ----------------------------------------------------------------------------
@@ -646,11 +982,35 @@ wxArrayString& TraceMasks()
     return TraceMasks();
 }
 
+namespace
+{
+
+// must be called with GetTraceMaskCS() locked after changing TraceMasks()
+void PublishTraceMasks()
+{
+    const wxArrayString& masks = TraceMasks();
+
+    TraceMasksData* data = nullptr;
+    if ( !masks.empty() )
+    {
+        data = new TraceMasksData;
+        data->reserve(masks.size());
+        for ( const auto& mask : masks )
+            data->emplace_back(mask);
+    }
+
+    GetTraceMasksSnapshot().Publish(data);
+}
+
+} // anonymous namespace
+
 void wxLog::AddTraceMask(const wxString& str)
 {
     wxCRIT_SECT_LOCKER(lock, GetTraceMaskCS());
 
     TraceMasks().push_back(str);
+
+    PublishTraceMasks();
 }
 
 void wxLog::RemoveTraceMask(const wxString& str)
@@ -659,31 +1019,49 @@ void wxLog::RemoveTraceMask(const wxString& str)
 
     int index = TraceMasks().Index(str);
     if ( index != wxNOT_FOUND )
+    {
         TraceMasks().RemoveAt((size_t)index);
+
+        PublishTraceMasks();
+    }
 }
 
 void wxLog::ClearTraceMasks()
 {
     wxCRIT_SECT_LOCKER(lock, GetTraceMaskCS());
 
-    TraceMasks().Clear();
+    if ( !TraceMasks().empty() )
+    {
+        TraceMasks().Clear();
+
+        PublishTraceMasks();
+    }
 }
 
 /*static*/ bool wxLog::IsAllowedTraceMask(const wxString& mask)
 {
-    wxCRIT_SECT_LOCKER(lock, GetTraceMaskCS());
+    const wxStringCharType* const str = mask.wx_str();
+
+    return DoIsAllowedTraceMask(str,
+                                std::char_traits<wxStringCharType>::length(str));
+}
 
-    const wxArrayString& masks = GetTraceMasks();
-    for ( wxArrayString::const_iterator it = masks.begin(),
-                                        en = masks.end();
-          it != en;
-          ++it )
+/*static*/ bool wxLog::IsAllowedTraceMask(const char* mask)
+{
+    // Don't bother computing the length in the common case of no masks.
+    if ( GetTraceMasksSnapshot().IsEmpty() )
+        return false;
+
+    size_t len = 0;
+    for ( ; mask[len]; len++ )
     {
-        if ( *it == mask)
-            return true;
+        // Non-ASCII masks need to be converted using the current locale
+        // encoding, as it would have been done when creating a wxString.
+        if ( static_cast<unsigned char>(mask[len]) >= 0x80 )
+            return IsAllowedTraceMask(wxString(mask));
     }
 
-    return false;
+    return DoIsAllowedTraceMask(mask, len);
 }
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,632 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/logasync.cpp
+// Purpose:     wxLogAsync implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#include "wx/logasync.h"
+
+#if wxUSE_LOG && wxUSE_THREADS
+
+#ifndef WX_PRECOMP
+    #include "wx/module.h"
+    #include "wx/thread.h"
+#endif // WX_PRECOMP
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// The queue used by a single thread to pass its records to the writer thread.
+typedef wxBoundedMessageQueue<wxLogRecord, wxMSGQUEUE_SPSC> wxLogAsyncQueue;
+
+// The queue used by the current thread for the wxLogAsync object with the
+// given ID: the IDs are used instead of pointers to the objects because they
+// are never reused, unlike the addresses of the objects.
+struct CurrentThreadQueue
+{
+    wxUint64 loggerId = 0;
+    std::shared_ptr<wxLogAsyncQueue> queue;
+};
+
+thread_local CurrentThreadQueue wxCurrentLogAsyncQueue;
+
+std::atomic<wxUint64> gs_lastLoggerId{0};
+
+// The object whose writer thread is the current thread, if any.
+thread_local wxLogAsyncImpl* wxCurrentLogAsyncWriter = nullptr;
+
+// All the existing objects, used by FlushAll().
+struct AllLoggers
+{
+    wxCriticalSection cs;
+    std::vector<wxLogAsyncImpl*> impls;
+};
+
+AllLoggers& GetAllLoggers()
+{
+    static AllLoggers s_allLoggers;
+    return s_allLoggers;
+}
+
+void FlushAllLogAsyncAtExit()
+{
+    wxLogAsync::FlushAll();
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxLogAsyncImpl: the queues and the writer thread
+// ----------------------------------------------------------------------------
+
+class wxLogAsyncImpl
+{
+public:
+    wxLogAsyncImpl(wxLogAsync& log,
+                   FILE* fp,
+                   size_t queueSize,
+                   wxMessageQueueOverflow overflow,
+                   const wxMBConv& conv);
+
+    // Start the writer thread, falling back to writing the records
+    // synchronously if it can't be done.
+    void Start();
+
+    // Write all the pending records and wait for the writer thread to exit,
+    // any records logged after this are written synchronously.
+    void Stop();
+
+    // Called by the logging threads.
+    void Post(const wxLogRecord& record);
+
+    // Make the writer thread write all the pending records.
+    void WakeUp() { m_wakeUp.Post(); }
+
+    // Wait until the writer thread writes all the records posted by this
+    // thread before calling this function.
+    void FlushAndWait();
+
+    // Called by wxLogAsync::DoLogTextAtLevel().
+    void WriteText(const wxString& text);
+
+    size_t GetDroppedCount() const;
+
+    // The writer thread function.
+    void WriteUntilStopped();
+
+private:
+    // Return the queue of the current thread, creating it if necessary.
+    wxLogAsyncQueue& GetCurrentThreadQueue();
+
+    // Wake up the writer thread if it's waiting for the records.
+    void WakeUpWriter()
+    {
+        // This fence pairs with the one in WriteUntilStopped(): either the writer sees
+        // the record we've just posted or we see that it's waiting.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if ( m_writerWaiting.load(std::memory_order_relaxed) &&
+                m_writerWaiting.exchange(false) )
+            m_wakeUp.Post();
+    }
+
+    // Wait until there is space in the (full) queue to post the record to it.
+    void WaitForSpace(wxLogAsyncQueue& queue, const wxLogRecord& record);
+
+    // Format and write all the records currently in the queues, return false
+    // if there were none.
+    bool WriteQueued();
+
+    // Return the number of messages dropped by the given queue.
+    size_t GetDroppedCount(const wxLogAsyncQueue& queue) const
+    {
+        const wxMessageQueueStats stats = queue.GetStats();
+        switch ( m_overflow )
+        {
+            case wxMSGQUEUE_OVERFLOW_BLOCK:
+                break;
+
+            case wxMSGQUEUE_OVERFLOW_DROP_OLDEST:
+                return stats.dropped;
+
+            case wxMSGQUEUE_OVERFLOW_FAIL:
+                return stats.rejected;
+        }
+
+        return 0;
+    }
+
+
+    wxLogAsync& m_log;
+    FILE* const m_fp;
+    const wxMBConv& m_conv;
+    const size_t m_queueSize;
+    const wxMessageQueueOverflow m_overflow;
+    const wxUint64 m_id;
+
+    // The queues of all the threads which have used this object, protected by
+    // m_queuesCS, and the number of messages dropped by the queues which were
+    // already destroyed.
+    mutable wxCriticalSection m_queuesCS;
+    std::vector<std::shared_ptr<wxLogAsyncQueue>> m_queues;
+    size_t m_droppedByRemoved = 0;
+
+    // Used only by the writer thread: the records taken from the queues and
+    // their formatted text waiting to be written.
+    std::vector<wxLogRecord> m_records;
+    std::string m_text;
+
+    // Posted to wake up the writer thread when it's waiting.
+    wxSemaphore m_wakeUp;
+    std::atomic<bool> m_writerWaiting{false};
+    std::atomic<bool> m_stop{false};
+
+    // Used for waiting for the space in the queues with
+    // wxMSGQUEUE_OVERFLOW_BLOCK, which is implemented here rather than by the
+    // queue itself to wake up the writer thread before blocking.
+    wxMutex m_spaceMutex;
+    wxCondition m_spaceCondition;
+    std::atomic<int> m_spaceWaiters{0};
+
+    // The last flush request number and the last one completed by the writer
+    // thread, the latter protected by m_flushMutex.
+    std::atomic<wxUint64> m_flushRequested{0};
+    wxUint64 m_flushDone = 0;
+    wxMutex m_flushMutex;
+    wxCondition m_flushCondition;
+
+    // The writer thread, only non-null while it's running.
+    wxThread* m_writer = nullptr;
+
+    // Used to write synchronously if the writer thread couldn't be started
+    // or was already stopped.
+    std::atomic<bool> m_synchronous{false};
+    wxCriticalSection m_synchronousCS;
+
+    // Protects m_fp, which is written to by the writer thread and also by
+    // any thread calling WriteText() directly.
+    wxCriticalSection m_writeCS;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncImpl);
+};
+
+// ----------------------------------------------------------------------------
+// wxLogAsyncWriter: the thread writing the records
+// ----------------------------------------------------------------------------
+
+class wxLogAsyncWriter : public wxThread
+{
+public:
+    explicit wxLogAsyncWriter(wxLogAsyncImpl& impl)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_impl(impl)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_impl.WriteUntilStopped();
+
+        return nullptr;
+    }
+
+private:
+    wxLogAsyncImpl& m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncWriter);
+};
+
+// ============================================================================
+// wxLogAsyncImpl implementation
+// ============================================================================
+
+wxLogAsyncImpl::wxLogAsyncImpl(wxLogAsync& log,
+                               FILE* fp,
+                               size_t queueSize,
+                               wxMessageQueueOverflow overflow,
+                               const wxMBConv& conv)
+    : m_log(log),
+      m_fp(fp ? fp : stderr),
+      m_conv(conv),
+      m_queueSize(queueSize),
+      m_overflow(overflow),
+      m_id(++gs_lastLoggerId),
+      m_spaceCondition(m_spaceMutex),
+      m_flushCondition(m_flushMutex)
+{
+}
+
+void wxLogAsyncImpl::Start()
+{
+    m_writer = new wxLogAsyncWriter(*this);
+    if ( m_writer->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete m_writer;
+        m_writer = nullptr;
+
+        m_synchronous = true;
+        return;
+    }
+
+    AllLoggers& all = GetAllLoggers();
+
+    wxCriticalSectionLocker lock(all.cs);
+
+    static bool s_atexitRegistered = false;
+    if ( !s_atexitRegistered )
+    {
+        s_atexitRegistered = true;
+        atexit(FlushAllLogAsyncAtExit);
+    }
+
+    all.impls.push_back(this);
+}
+
+void wxLogAsyncImpl::Stop()
+{
+    if ( m_synchronous )
+        return;
+
+    {
+        AllLoggers& all = GetAllLoggers();
+
+        wxCriticalSectionLocker lock(all.cs);
+
+        for ( auto it = all.impls.begin(); it != all.impls.end(); ++it )
+        {
+            if ( *it == this )
+            {
+                all.impls.erase(it);
+                break;
+            }
+        }
+    }
+
+    m_stop = true;
+    m_wakeUp.Post();
+
+    m_writer->Wait();
+
+    delete m_writer;
+    m_writer = nullptr;
+
+    m_synchronous = true;
+
+    // Write the records which could have been posted after the writer thread
+    // checked the queues for the last time.
+    wxCriticalSectionLocker lock(m_synchronousCS);
+    WriteQueued();
+}
+
+wxLogAsyncQueue& wxLogAsyncImpl::GetCurrentThreadQueue()
+{
+    CurrentThreadQueue& current = wxCurrentLogAsyncQueue;
+    if ( current.loggerId != m_id )
+    {
+        const wxMessageQueueOverflow overflow =
+            m_overflow == wxMSGQUEUE_OVERFLOW_BLOCK ? wxMSGQUEUE_OVERFLOW_FAIL
+                                                    : m_overflow;
+        std::shared_ptr<wxLogAsyncQueue>
+            queue = std::make_shared<wxLogAsyncQueue>(m_queueSize, overflow);
+
+        {
+            wxCriticalSectionLocker lock(m_queuesCS);
+            m_queues.push_back(queue);
+        }
+
+        // If this thread used another object before, its queue will be
+        // removed by it once it notices that it's not used any more.
+        current.loggerId = m_id;
+        current.queue = queue;
+    }
+
+    return *current.queue;
+}
+
+void wxLogAsyncImpl::Post(const wxLogRecord& record)
+{
+    // The messages logged by the writer thread itself, e.g. from a custom
+    // formatter, can't be queued as it could block forever waiting for the
+    // space in its own queue, so write them immediately.
+    if ( m_synchronous || wxCurrentLogAsyncWriter == this )
+    {
+        wxCriticalSectionLocker lock(m_synchronousCS);
+
+        m_log.FormatRecord(record.level, record.msg, record.info);
+        return;
+    }
+
+    wxLogAsyncQueue& queue = GetCurrentThreadQueue();
+    if ( queue.Post(record) == wxMSGQUEUE_FULL &&
+            m_overflow == wxMSGQUEUE_OVERFLOW_BLOCK )
+    {
+        WaitForSpace(queue, record);
+    }
+
+    WakeUpWriter();
+}
+
+void wxLogAsyncImpl::WaitForSpace(wxLogAsyncQueue& queue,
+                                  const wxLogRecord& record)
+{
+    m_spaceWaiters++;
+
+    // The writer must be woken up as it could be waiting, but this must be
+    // done after incrementing m_spaceWaiters to ensure that it notifies us.
+    WakeUpWriter();
+
+    {
+        wxMutexLocker lock(m_spaceMutex);
+        while ( queue.Post(record) == wxMSGQUEUE_FULL )
+            m_spaceCondition.Wait();
+    }
+
+    m_spaceWaiters--;
+}
+
+void wxLogAsyncImpl::FlushAndWait()
+{
+    if ( m_synchronous || wxCurrentLogAsyncWriter == this )
+        return;
+
+    wxMutexLocker lock(m_flushMutex);
+
+    const wxUint64 request = ++m_flushRequested;
+    m_wakeUp.Post();
+
+    while ( m_flushDone < request )
+        m_flushCondition.Wait();
+}
+
+void wxLogAsyncImpl::WriteText(const wxString& text)
+{
+    const wxScopedCharBuffer buf(text.mb_str(m_conv));
+
+    if ( wxCurrentLogAsyncWriter == this )
+    {
+        m_text.append(buf.data(), buf.length());
+        m_text += '\n';
+    }
+    else // Called directly or for a synchronously written record.
+    {
+        wxCriticalSectionLocker lock(m_writeCS);
+
+        fwrite(buf.data(), 1, buf.length(), m_fp);
+        fputc('\n', m_fp);
+        fflush(m_fp);
+    }
+}
+
+size_t wxLogAsyncImpl::GetDroppedCount() const
+{
+    wxCriticalSectionLocker lock(m_queuesCS);
+
+    size_t dropped = m_droppedByRemoved;
+    for ( const auto& queue : m_queues )
+        dropped += GetDroppedCount(*queue);
+
+    return dropped;
+}
+
+bool wxLogAsyncImpl::WriteQueued()
+{
+    {
+        wxCriticalSectionLocker lock(m_queuesCS);
+
+        for ( auto it = m_queues.begin(); it != m_queues.end(); )
+        {
+            // If we hold the only reference to the queue, the thread using
+            // it doesn't exist any more or uses another object, so no more
+            // records can be added to it and it can be removed once the
+            // records already in it are taken.
+            const bool unused = it->use_count() == 1;
+
+            (*it)->ReceiveAllTimeout(0, m_records);
+
+            if ( unused )
+            {
+                m_droppedByRemoved += GetDroppedCount(**it);
+                it = m_queues.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    if ( m_records.empty() )
+        return false;
+
+    // Let the threads waiting for the space in the queues continue before
+    // formatting the records.
+    if ( m_spaceWaiters.load() )
+    {
+        wxMutexLocker lock(m_spaceMutex);
+        m_spaceCondition.Broadcast();
+    }
+
+    for ( const auto& record : m_records )
+        m_log.FormatRecord(record.level, record.msg, record.info);
+
+    m_records.clear();
+
+    {
+        wxCriticalSectionLocker lock(m_writeCS);
+
+        fwrite(m_text.data(), 1, m_text.size(), m_fp);
+        fflush(m_fp);
+    }
+
+    m_text.clear();
+
+    return true;
+}
+
+void wxLogAsyncImpl::WriteUntilStopped()
+{
+    wxCurrentLogAsyncWriter = this;
+
+    for ( ;; )
+    {
+        m_writerWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Read these flags before checking the queues to ensure that all the
+        // records posted before they were set are written.
+        const wxUint64 flushRequested = m_flushRequested.load();
+        const bool stop = m_stop.load();
+
+        const bool written = WriteQueued();
+
+        if ( flushRequested != m_flushDone )
+        {
+            wxMutexLocker lock(m_flushMutex);
+
+            m_flushDone = flushRequested;
+            m_flushCondition.Broadcast();
+        }
+
+        if ( stop )
+            break;
+
+        if ( written )
+        {
+            // Don't make the other threads wake us up while we're busy.
+            m_writerWaiting.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        m_wakeUp.Wait();
+    }
+
+    wxCurrentLogAsyncWriter = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+// wxLogAsyncModule: stops the writer threads on library shutdown
+// ----------------------------------------------------------------------------
+
+// The writer threads must be stopped before wxThreadModule tries to delete
+// them, as they don't check for TestDestroy(), and the log target itself is
+// only deleted after the modules cleanup.
+class wxLogAsyncModule : public wxModule
+{
+public:
+    wxLogAsyncModule()
+    {
+        AddDependency("wxThreadModule");
+    }
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override
+    {
+        std::vector<wxLogAsyncImpl*> impls;
+        {
+            AllLoggers& all = GetAllLoggers();
+
+            wxCriticalSectionLocker lock(all.cs);
+            impls = all.impls;
+        }
+
+        for ( auto impl : impls )
+            impl->Stop();
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxLogAsyncModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxLogAsyncModule, wxModule);
+
+// ============================================================================
+// wxLogAsync implementation
+// ============================================================================
+
+wxLogAsync::wxLogAsync(FILE *fp,
+                       size_t queueSize,
+                       wxMessageQueueOverflow overflow,
+                       const wxMBConv& conv)
+    : m_impl(new wxLogAsyncImpl(*this, fp, queueSize, overflow, conv))
+{
+    m_impl->Start();
+}
+
+wxLogAsync::~wxLogAsync()
+{
+    m_impl->Stop();
+
+    delete m_impl;
+}
+
+void wxLogAsync::Flush()
+{
+    wxLog::Flush();
+
+    m_impl->WakeUp();
+}
+
+void wxLogAsync::FlushAndWait()
+{
+    m_impl->FlushAndWait();
+}
+
+/* static */
+void wxLogAsync::FlushAll()
+{
+    AllLoggers& all = GetAllLoggers();
+
+    wxCriticalSectionLocker lock(all.cs);
+
+    for ( auto impl : all.impls )
+        impl->FlushAndWait();
+}
+
+size_t wxLogAsync::GetDroppedCount() const
+{
+    return m_impl->GetDroppedCount();
+}
+
+void wxLogAsync::DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+{
+    m_impl->Post(wxLogRecord(level, msg, info));
+}
+
+void wxLogAsync::DoLogTextAtLevel(wxLogLevel WXUNUSED(level),
+                                  const wxString& msg)
+{
+    m_impl->WriteText(msg);
+}
+
+void wxLogAsync::FormatRecord(wxLogLevel level,
+                              const wxString& msg,
+                              const wxLogRecordInfo& info)
+{
+    wxLog::DoLogRecord(level, msg, info);
+}
+
+#endif // wxUSE_LOG && wxUSE_THREADS
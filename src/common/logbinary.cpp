@@ -0,0 +1,557 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/logbinary.cpp
+// Purpose:     wxLogBinary and wxLogBinaryReader implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_LOG
+
+#include "wx/logbinary.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/intl.h"
+    #include "wx/utils.h"
+    #include "wx/wxcrt.h"
+#endif // WX_PRECOMP
+
+#include "wx/thread.h"
+
+#ifdef __WINDOWS__
+    #include "wx/msw/wrapwin.h"
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+// The file format is very simple: the file starts with the magic string
+// followed by the format version byte, and then contains the records, each
+// starting with its type byte. All numbers are stored in LEB128 format, i.e.
+// using 7 bits per byte with the high bit set in all bytes but the last one.
+//
+// String records contain the string id, which is always 1 more than the id of
+// the previous string, and its length followed by the UTF-8 contents.
+//
+// Log records contain the timestamp, thread id, level, line number, ids of the
+// file, function and component strings (0 if not available), and the message
+// length followed by its UTF-8 contents.
+//
+// As the file is extended by filling it with zeroes, the end of data type
+// record is implicitly present after the last record if the program
+// terminates before truncating the file to its real size.
+
+namespace
+{
+
+const char LOG_BINARY_MAGIC[] = { 'w', 'x', 'L', 'O', 'G', 'B', 'I', 'N' };
+const unsigned char LOG_BINARY_VERSION = 1;
+
+enum RecordType
+{
+    Record_End,
+    Record_String,
+    Record_Log
+};
+
+// The file grows by at least this amount and by at most the other one, unless
+// a single record needs more than that.
+const size_t LOG_BINARY_MIN_GROW = 1024*1024;
+const size_t LOG_BINARY_MAX_GROW = 64*1024*1024;
+
+// Maximal size of a number in LEB128 format.
+const size_t MAX_NUMBER_SIZE = 10;
+
+inline unsigned char* WriteNumber(unsigned char* p, wxULongLong_t value)
+{
+    while ( value >= 0x80 )
+    {
+        *p++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+
+    *p++ = static_cast<unsigned char>(value);
+
+    return p;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxLogBinaryImpl: maps the file and writes records to it
+// ----------------------------------------------------------------------------
+
+class wxLogBinaryImpl
+{
+public:
+    explicit wxLogBinaryImpl(const wxString& filename);
+    ~wxLogBinaryImpl();
+
+    bool IsOk() const { return m_data != nullptr; }
+
+    void Write(wxLogLevel level,
+               const wxString& msg,
+               const wxLogRecordInfo& info);
+
+private:
+    // Map the file after extending it to the given size.
+    bool Map(size_t size);
+
+    // Unmap the file and truncate it to the size actually used if necessary.
+    void Unmap(bool truncate = false);
+
+    // Return the pointer to the unused part of the file, extending it to have
+    // at least the given number of bytes there, or null if this failed.
+    unsigned char* Reserve(size_t size);
+
+    // Return the id of the given string, writing the string to the file if it
+    // hasn't been done yet.
+    wxULongLong_t GetStringId(const char* str);
+
+
+#ifdef __WINDOWS__
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+
+    unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_used = 0;
+
+    // The strings are normally literals, so we look them up by their address
+    // and only compare the contents to check that the address wasn't reused.
+    struct InternedString
+    {
+        wxULongLong_t id;
+        std::string value;
+    };
+
+    std::unordered_map<const char*, InternedString> m_strings;
+    wxULongLong_t m_lastStringId = 0;
+
+#if wxUSE_THREADS
+    wxCriticalSection m_cs;
+#endif // wxUSE_THREADS
+
+    wxDECLARE_NO_COPY_CLASS(wxLogBinaryImpl);
+};
+
+wxLogBinaryImpl::wxLogBinaryImpl(const wxString& filename)
+{
+#ifdef __WINDOWS__
+    m_file = ::CreateFile(filename.t_str(),
+                          GENERIC_READ | GENERIC_WRITE,
+                          FILE_SHARE_READ,
+                          nullptr,
+                          CREATE_ALWAYS,
+                          FILE_ATTRIBUTE_NORMAL,
+                          nullptr);
+    if ( m_file == INVALID_HANDLE_VALUE )
+    {
+        wxLogSysError(_("Failed to create log file \"%s\""), filename);
+        return;
+    }
+#else
+    m_fd = open(filename.fn_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if ( m_fd == -1 )
+    {
+        wxLogSysError(_("Failed to create log file \"%s\""), filename);
+        return;
+    }
+#endif
+
+    if ( !Map(LOG_BINARY_MIN_GROW) )
+    {
+        wxLogSysError(_("Failed to map log file \"%s\" into memory"), filename);
+        return;
+    }
+
+    unsigned char* const p = Reserve(sizeof(LOG_BINARY_MAGIC) + 1);
+    memcpy(p, LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC));
+    p[sizeof(LOG_BINARY_MAGIC)] = LOG_BINARY_VERSION;
+    m_used = sizeof(LOG_BINARY_MAGIC) + 1;
+}
+
+wxLogBinaryImpl::~wxLogBinaryImpl()
+{
+    Unmap(true /* truncate */);
+
+#ifdef __WINDOWS__
+    if ( m_file != INVALID_HANDLE_VALUE )
+        ::CloseHandle(m_file);
+#else
+    if ( m_fd != -1 )
+        close(m_fd);
+#endif
+}
+
+bool wxLogBinaryImpl::Map(size_t size)
+{
+#ifdef __WINDOWS__
+    ULARGE_INTEGER sizeMap;
+    sizeMap.QuadPart = size;
+
+    // Creating the mapping extends the file to the given size.
+    m_mapping = ::CreateFileMapping(m_file, nullptr, PAGE_READWRITE,
+                                    sizeMap.HighPart, sizeMap.LowPart,
+                                    nullptr);
+    if ( !m_mapping )
+        return false;
+
+    void* const data = ::MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, size);
+    if ( !data )
+    {
+        ::CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        return false;
+    }
+#else
+    if ( ftruncate(m_fd, size) != 0 )
+        return false;
+
+    void* const data = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, m_fd, 0);
+    if ( data == MAP_FAILED )
+        return false;
+#endif
+
+    m_data = static_cast<unsigned char*>(data);
+    m_size = size;
+
+    return true;
+}
+
+void wxLogBinaryImpl::Unmap(bool truncate)
+{
+    if ( !m_data )
+        return;
+
+#ifdef __WINDOWS__
+    ::UnmapViewOfFile(m_data);
+    ::CloseHandle(m_mapping);
+    m_mapping = nullptr;
+
+    if ( truncate )
+    {
+        LARGE_INTEGER pos;
+        pos.QuadPart = m_used;
+        if ( ::SetFilePointerEx(m_file, pos, nullptr, FILE_BEGIN) )
+            ::SetEndOfFile(m_file);
+    }
+#else
+    munmap(m_data, m_size);
+
+    if ( truncate )
+    {
+        // There is nothing we can do if this fails, and the file is still
+        // readable anyhow, so just ignore the error.
+        wxUnusedVar( ftruncate(m_fd, m_used) );
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+unsigned char* wxLogBinaryImpl::Reserve(size_t size)
+{
+    if ( !m_data )
+        return nullptr;
+
+    if ( m_size - m_used < size )
+    {
+        size_t grow = wxMin(wxMax(m_size, LOG_BINARY_MIN_GROW),
+                            LOG_BINARY_MAX_GROW);
+        if ( grow < size )
+            grow = size;
+
+        const size_t sizeNew = m_size + grow;
+
+        // Don't log anything here, we're called from inside the log target.
+        Unmap();
+        if ( !Map(sizeNew) )
+            return nullptr;
+    }
+
+    return m_data + m_used;
+}
+
+wxULongLong_t wxLogBinaryImpl::GetStringId(const char* str)
+{
+    if ( !str )
+        return 0;
+
+    InternedString& interned = m_strings[str];
+    if ( interned.id && interned.value == str )
+        return interned.id;
+
+    const size_t len = strlen(str);
+    unsigned char* p = Reserve(1 + 2*MAX_NUMBER_SIZE + len);
+    if ( !p )
+        return 0;
+
+    interned.id = ++m_lastStringId;
+    interned.value.assign(str, len);
+
+    *p++ = Record_String;
+    p = WriteNumber(p, interned.id);
+    p = WriteNumber(p, len);
+    memcpy(p, str, len);
+
+    m_used = p + len - m_data;
+
+    return interned.id;
+}
+
+void
+wxLogBinaryImpl::Write(wxLogLevel level,
+                       const wxString& msg,
+                       const wxLogRecordInfo& info)
+{
+    // Convert the message before locking, this is the most expensive part.
+    const wxScopedCharBuffer buf = msg.utf8_str();
+    const size_t len = buf.length();
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+    if ( !m_data )
+        return;
+
+    const wxULongLong_t fileId = GetStringId(info.filename);
+    const wxULongLong_t funcId = GetStringId(info.func);
+    const wxULongLong_t componentId = GetStringId(info.component);
+
+    unsigned char* p = Reserve(1 + 8*MAX_NUMBER_SIZE + len);
+    if ( !p )
+        return;
+
+    *p++ = Record_Log;
+    p = WriteNumber(p, info.timestampMS);
+#if wxUSE_THREADS
+    p = WriteNumber(p, info.threadId);
+#else
+    p = WriteNumber(p, 0);
+#endif
+    p = WriteNumber(p, level);
+    p = WriteNumber(p, static_cast<unsigned>(info.line));
+    p = WriteNumber(p, fileId);
+    p = WriteNumber(p, funcId);
+    p = WriteNumber(p, componentId);
+    p = WriteNumber(p, len);
+    memcpy(p, buf.data(), len);
+
+    m_used = p + len - m_data;
+}
+
+// ============================================================================
+// wxLogBinary implementation
+// ============================================================================
+
+wxLogBinary::wxLogBinary(const wxString& filename)
+    : m_impl(new wxLogBinaryImpl(filename))
+{
+}
+
+wxLogBinary::~wxLogBinary()
+{
+    delete m_impl;
+}
+
+bool wxLogBinary::IsOk() const
+{
+    return m_impl->IsOk();
+}
+
+void
+wxLogBinary::DoLogRecord(wxLogLevel level,
+                         const wxString& msg,
+                         const wxLogRecordInfo& info)
+{
+    m_impl->Write(level, msg, info);
+}
+
+// ============================================================================
+// wxLogBinaryReader implementation
+// ============================================================================
+
+bool wxLogBinaryReader::Open(const wxString& filename)
+{
+    m_data.clear();
+    m_pos = 0;
+    m_error = false;
+    m_strings.clear();
+
+    FILE* const fp = wxFopen(filename, "rb");
+    if ( !fp )
+    {
+        wxLogSysError(_("Failed to open log file \"%s\""), filename);
+        return false;
+    }
+
+    char buf[65536];
+    size_t count;
+    while ( (count = fread(buf, 1, sizeof(buf), fp)) != 0 )
+        m_data.insert(m_data.end(), buf, buf + count);
+
+    const bool readError = ferror(fp) != 0;
+    fclose(fp);
+
+    if ( readError )
+    {
+        wxLogSysError(_("Failed to read log file \"%s\""), filename);
+        return false;
+    }
+
+    if ( m_data.size() < sizeof(LOG_BINARY_MAGIC) + 1 ||
+            memcmp(m_data.data(), LOG_BINARY_MAGIC,
+                   sizeof(LOG_BINARY_MAGIC)) != 0 )
+    {
+        wxLogError(_("File \"%s\" is not a binary log file."), filename);
+        return false;
+    }
+
+    if ( static_cast<unsigned char>(m_data[sizeof(LOG_BINARY_MAGIC)])
+            != LOG_BINARY_VERSION )
+    {
+        wxLogError(_("Unsupported binary log file \"%s\" version."), filename);
+        return false;
+    }
+
+    m_pos = sizeof(LOG_BINARY_MAGIC) + 1;
+
+    return true;
+}
+
+bool wxLogBinaryReader::ReadNumber(wxULongLong_t& value)
+{
+    value = 0;
+    for ( unsigned shift = 0; shift < 7*MAX_NUMBER_SIZE; shift += 7 )
+    {
+        if ( m_pos == m_data.size() )
+            return false;
+
+        const unsigned char byte = static_cast<unsigned char>(m_data[m_pos++]);
+        value |= static_cast<wxULongLong_t>(byte & 0x7f) << shift;
+        if ( !(byte & 0x80) )
+            return true;
+    }
+
+    return false;
+}
+
+bool wxLogBinaryReader::ReadString(wxString& str)
+{
+    wxULongLong_t len;
+    if ( !ReadNumber(len) || len > m_data.size() - m_pos )
+        return false;
+
+    str = wxString::FromUTF8(&m_data[m_pos], len);
+    m_pos += len;
+
+    return true;
+}
+
+bool wxLogBinaryReader::GetString(wxULongLong_t id, wxString& str) const
+{
+    if ( !id )
+    {
+        str.clear();
+        return true;
+    }
+
+    if ( id > m_strings.size() )
+        return false;
+
+    str = m_strings[id - 1];
+
+    return true;
+}
+
+bool wxLogBinaryReader::GetNext(wxLogBinaryRecord& record)
+{
+    while ( m_pos < m_data.size() && !m_error )
+    {
+        switch ( static_cast<unsigned char>(m_data[m_pos++]) )
+        {
+            case Record_End:
+                m_pos = m_data.size();
+                return false;
+
+            case Record_String:
+                {
+                    wxULongLong_t id;
+                    wxString str;
+                    if ( !ReadNumber(id) || id != m_strings.size() + 1 ||
+                            !ReadString(str) )
+                    {
+                        m_error = true;
+                        break;
+                    }
+
+                    m_strings.push_back(str);
+                }
+                break;
+
+            case Record_Log:
+                {
+                    wxULongLong_t timestamp, threadId, level, line,
+                                  fileId, funcId, componentId;
+                    if ( !ReadNumber(timestamp) ||
+                            !ReadNumber(threadId) ||
+                            !ReadNumber(level) ||
+                            !ReadNumber(line) ||
+                            !ReadNumber(fileId) ||
+                            !ReadNumber(funcId) ||
+                            !ReadNumber(componentId) ||
+                            !GetString(fileId, record.filename) ||
+                            !GetString(funcId, record.func) ||
+                            !GetString(componentId, record.component) ||
+                            !ReadString(record.msg) )
+                    {
+                        m_error = true;
+                        break;
+                    }
+
+                    record.timestampMS = static_cast<wxLongLong_t>(timestamp);
+                    record.threadId = threadId;
+                    record.level = static_cast<wxLogLevel>(level);
+                    record.line = static_cast<int>(line);
+                }
+                return true;
+
+            default:
+                m_error = true;
+        }
+    }
+
+    return false;
+}
+
+#endif // wxUSE_LOG
@@ -17,6 +17,16 @@
 
 #include "wx/numformatter.h"
 #include "wx/uilocale.h"
+#include "wx/wxcrt.h"
+
+#include "wx/private/uilocale.h"
+
+#include <errno.h>
+
+// See the comment in src/common/string.cpp about checking for it.
+#if wxHAS_CXX17_INCLUDE(<charconv>)
+    #include <charconv>
+#endif
 
 // ============================================================================
 // wxNumberFormatter implementation
@@ -26,39 +36,89 @@
 // Locale information accessors
 // ----------------------------------------------------------------------------
 
-wxChar wxNumberFormatter::GetDecimalSeparator()
+namespace
 {
+
+// Number formatting conventions of the current locale.
+//
+// Querying the locale is relatively expensive, so we cache this information
+// and only update it when the current UI locale changes. Each thread has its
+// own copy, so that no locking is needed when accessing it.
+struct NumberFormatInfo
+{
+    wxChar decimalSep = '.';
+
+    // Thousands separator, only valid if useThousandsSep is true.
+    wxChar thousandsSep = 0;
+    bool useThousandsSep = false;
+};
+
 #if wxUSE_INTL
+
+// Return the value of the given locale info if it is a single character.
+bool GetSingleCharInfo(wxLocaleInfo index, wxChar* ch)
+{
     const wxString
-        s = wxUILocale::GetCurrent().GetInfo(wxLOCALE_DECIMAL_POINT, wxLOCALE_CAT_NUMBER);
-    if ( s.length() == 1 )
+        s = wxUILocale::GetCurrent().GetInfo(index, wxLOCALE_CAT_NUMBER);
+    if ( s.length() != 1 )
+        return false;
+
+    *ch = s[0];
+    return true;
+}
+
+#endif // wxUSE_INTL
+
+const NumberFormatInfo& GetNumberFormatInfo()
+{
+#if wxUSE_INTL
+    static thread_local NumberFormatInfo s_info;
+    static thread_local unsigned s_generation = 0;
+    static thread_local bool s_initialized = false;
+
+    const unsigned generation = wxGetUILocaleGeneration();
+    if ( !s_initialized || generation != s_generation )
     {
-        return s[0];
+        NumberFormatInfo info;
+
+        // We really must have something for decimal separator, so fall
+        // back to the C locale default if we can't get it.
+        if ( !GetSingleCharInfo(wxLOCALE_DECIMAL_POINT, &info.decimalSep) )
+            info.decimalSep = '.';
+
+        info.useThousandsSep =
+            GetSingleCharInfo(wxLOCALE_THOUSANDS_SEP, &info.thousandsSep);
+
+        s_info = info;
+        s_generation = generation;
+        s_initialized = true;
     }
 
-    // We really must have something for decimal separator, so fall
-    // back to the C locale default.
-#endif // wxUSE_INTL
+    return s_info;
+#else // !wxUSE_INTL
+    static const NumberFormatInfo s_info;
 
-    return wxT('.');
+    return s_info;
+#endif // wxUSE_INTL/!wxUSE_INTL
+}
+
+} // anonymous namespace
+
+wxChar wxNumberFormatter::GetDecimalSeparator()
+{
+    return GetNumberFormatInfo().decimalSep;
 }
 
 bool wxNumberFormatter::GetThousandsSeparatorIfUsed(wxChar *sep)
 {
-#if wxUSE_INTL
-    const wxString
-        s = wxUILocale::GetCurrent().GetInfo(wxLOCALE_THOUSANDS_SEP, wxLOCALE_CAT_NUMBER);
-    if ( s.length() == 1 )
-    {
-        if ( sep )
-            *sep = s[0];
+    const NumberFormatInfo& info = GetNumberFormatInfo();
+    if ( !info.useThousandsSep )
+        return false;
 
-        return true;
-    }
-#endif // wxUSE_INTL
+    if ( sep )
+        *sep = info.thousandsSep;
 
-    wxUnusedVar(sep);
-    return false;
+    return true;
 }
 
 // ----------------------------------------------------------------------------
@@ -68,63 +128,244 @@ bool wxNumberFormatter::GetThousandsSeparatorIfUsed(wxChar *sep)
 namespace
 {
 
-void ReplaceSeparatorIfNecessary(wxString& s, wxChar sepOld, wxChar sepNew)
+// We currently group digits by 3 independently of the locale. This is not
+// the right thing to do and we should use lconv::grouping (under POSIX)
+// and GetLocaleInfo(LOCALE_SGROUPING) (under MSW) to get information about
+// the correct grouping to use. This is something that needs to be done at
+// wxLocale level first and then used here in the future (TODO).
+const int GROUP_LEN = 3;
+
+// Big enough for any 64-bit integer with the sign and thousands separators.
+const size_t MAX_INT_LEN = 32;
+
+// Format an integer given as its absolute value and sign into the provided
+// buffer, returning the length of the result or 0 if it doesn't fit.
+size_t
+FormatInteger(wxChar* buf, size_t size,
+              wxULongLong_t absval, bool negative,
+              int style)
 {
-    if ( sepNew != sepOld )
+    wxASSERT_MSG( !(style & wxNumberFormatter::Style_NoTrailingZeroes),
+                  "Style_NoTrailingZeroes can't be used with integer values" );
+
+    const NumberFormatInfo& info = GetNumberFormatInfo();
+    const bool group = (style & wxNumberFormatter::Style_WithThousandsSep) &&
+                            info.useThousandsSep;
+
+    // Generate the number backwards, starting from its last digit.
+    wxChar tmp[MAX_INT_LEN];
+    wxChar* p = tmp + MAX_INT_LEN;
+    int digits = 0;
+    do
     {
-        const size_t posSep = s.find(sepOld);
-        if ( posSep != wxString::npos )
-            s[posSep] = sepNew;
+        if ( group && digits && digits % GROUP_LEN == 0 )
+            *--p = info.thousandsSep;
+
+        *--p = wxChar('0' + absval % 10);
+        absval /= 10;
+        ++digits;
+    } while ( absval );
+
+    if ( negative )
+        *--p = '-';
+
+    const size_t len = tmp + MAX_INT_LEN - p;
+    if ( len >= size )
+        return 0;
+
+    wxTmemcpy(buf, p, len);
+    buf[len] = '\0';
+
+    return len;
+}
+
+template <typename T>
+size_t FormatSignedInteger(wxChar* buf, size_t size, T val, int style)
+{
+    // Take care to avoid overflow when negating the smallest value.
+    const bool negative = val < 0;
+    const wxULongLong_t absval = negative
+        ? static_cast<wxULongLong_t>(-(val + 1)) + 1
+        : static_cast<wxULongLong_t>(val);
+
+    return FormatInteger(buf, size, absval, negative, style);
+}
+
+// Length of the buffer used for formatting floating point numbers: this is
+// enough for any number not greater than 1e300 in fixed notation with a
+// reasonable precision.
+const size_t MAX_DOUBLE_LEN = 352;
+
+// Copy the given representation of a floating point number in the C locale
+// to the output buffer, replacing the decimal point with the locale-specific
+// separator, adding thousands separators and removing trailing zeroes if
+// necessary. Returns the length of the result or 0 if it doesn't fit.
+size_t
+CopyDoubleString(wxChar* buf, size_t size,
+                 const char* start, const char* end,
+                 int style)
+{
+    const NumberFormatInfo& info = GetNumberFormatInfo();
+
+    // Find the different parts of the number: optional sign, integer part
+    // and, also optionally, the decimal point followed by the fractional part.
+    const char* const digitsStart = start + (*start == '-');
+    const char* intEnd = digitsStart;
+    while ( intEnd != end && *intEnd >= '0' && *intEnd <= '9' )
+        ++intEnd;
+
+    // Thousands separators and trailing zeroes are not relevant for numbers
+    // in scientific format as they would belong to the exponent.
+    bool scientific = false;
+    for ( const char* p = intEnd; p != end; ++p )
+    {
+        if ( *p == 'e' || *p == 'E' )
+        {
+            scientific = true;
+            break;
+        }
+    }
+
+    const bool group = !scientific &&
+                       (style & wxNumberFormatter::Style_WithThousandsSep) &&
+                            info.useThousandsSep;
+
+    if ( !scientific &&
+            (style & wxNumberFormatter::Style_NoTrailingZeroes) &&
+                intEnd != end && *intEnd == '.' )
+    {
+        while ( end[-1] == '0' )
+            --end;
+
+        // If nothing remains after the decimal point, don't keep it either.
+        if ( end - 1 == intEnd )
+            --end;
+
+        // Also remove the sign from what became just 0.
+        if ( start != digitsStart && end - digitsStart == 1 && *digitsStart == '0' )
+            ++start;
+    }
+
+    const int intDigits = static_cast<int>(intEnd - digitsStart);
+    size_t len = end - start;
+    if ( group && intDigits > GROUP_LEN )
+        len += (intDigits - 1) / GROUP_LEN;
+
+    if ( len >= size )
+        return 0;
+
+    wxChar* out = buf;
+    const char* p = start;
+    for ( ; p != digitsStart; ++p )
+        *out++ = *p;
+
+    for ( int n = intDigits; n > 0; --n )
+    {
+        *out++ = *p++;
+
+        if ( group && n > 1 && (n - 1) % GROUP_LEN == 0 )
+            *out++ = info.thousandsSep;
     }
+
+    for ( ; p != end; ++p )
+        *out++ = *p == '.' ? info.decimalSep : wxChar(*p);
+
+    *out = '\0';
+
+    return len;
 }
 
 } // anonymous namespace
 
-wxString wxNumberFormatter::PostProcessIntString(wxString s, int style)
+size_t
+wxNumberFormatter::ToChars(wxChar* buf, size_t size, long val, int style)
 {
-    if ( style & Style_WithThousandsSep )
-        AddThousandsSeparators(s);
+    return FormatSignedInteger(buf, size, val, style);
+}
 
-    wxASSERT_MSG( !(style & Style_NoTrailingZeroes),
-                  "Style_NoTrailingZeroes can't be used with integer values" );
+#ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
 
-    return s;
+size_t
+wxNumberFormatter::ToChars(wxChar* buf, size_t size, wxLongLong_t val, int style)
+{
+    return FormatSignedInteger(buf, size, val, style);
+}
+
+#endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+
+size_t
+wxNumberFormatter::ToChars(wxChar* buf, size_t size, wxULongLong_t val, int style)
+{
+    return FormatInteger(buf, size, val, false, style);
+}
+
+size_t
+wxNumberFormatter::ToChars(wxChar* buf, size_t size,
+                           double val, int precision, int style)
+{
+    wxCHECK_MSG( precision >= -1, 0, "Invalid negative precision" );
+
+#ifdef __cpp_lib_to_chars
+    char tmp[MAX_DOUBLE_LEN];
+
+    // Use the same format as wxString::FromCDouble() does.
+    std::to_chars_result res;
+    if ( precision == -1 )
+        res = std::to_chars(tmp, tmp + sizeof(tmp), val,
+                            std::chars_format::general, 6);
+    else
+        res = std::to_chars(tmp, tmp + sizeof(tmp), val,
+                            std::chars_format::fixed, precision);
+
+    if ( res.ec != std::errc{} )
+        return 0;
+
+    return CopyDoubleString(buf, size, tmp, res.ptr, style);
+#else // !__cpp_lib_to_chars
+    const wxScopedCharBuffer
+        tmp = wxString::FromCDouble(val, precision).utf8_str();
+
+    return CopyDoubleString(buf, size,
+                            tmp.data(), tmp.data() + tmp.length(),
+                            style);
+#endif // __cpp_lib_to_chars/!__cpp_lib_to_chars
 }
 
 wxString wxNumberFormatter::ToString(long val, int style)
 {
-    return PostProcessIntString(wxString::Format("%ld", val), style);
+    wxChar buf[MAX_INT_LEN];
+    const size_t len = ToChars(buf, WXSIZEOF(buf), val, style);
+
+    return wxString(buf, len);
 }
 
 #ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
 
 wxString wxNumberFormatter::ToString(wxLongLong_t val, int style)
 {
-    return PostProcessIntString(wxString::Format("%" wxLongLongFmtSpec "d", val),
-                                style);
+    wxChar buf[MAX_INT_LEN];
+    const size_t len = ToChars(buf, WXSIZEOF(buf), val, style);
+
+    return wxString(buf, len);
 }
 
 #endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
 
 wxString wxNumberFormatter::ToString(wxULongLong_t val, int style)
 {
-    return PostProcessIntString(wxString::Format("%" wxLongLongFmtSpec "u", val),
-                                style);
+    wxChar buf[MAX_INT_LEN];
+    const size_t len = ToChars(buf, WXSIZEOF(buf), val, style);
+
+    return wxString(buf, len);
 }
 
 wxString wxNumberFormatter::ToString(double val, int precision, int style)
 {
-    wxString s = wxString::FromCDouble(val,precision);
-
-    ReplaceSeparatorIfNecessary(s, '.', GetDecimalSeparator());
-
-    if ( style & Style_WithThousandsSep )
-        AddThousandsSeparators(s);
-
-    if ( style & Style_NoTrailingZeroes )
-        RemoveTrailingZeroes(s);
+    // Thousands separators can make the result longer than the C string.
+    wxChar buf[MAX_DOUBLE_LEN + MAX_DOUBLE_LEN / GROUP_LEN];
+    const size_t len = ToChars(buf, WXSIZEOF(buf), val, precision, style);
 
-    return s;
+    return wxString(buf, len);
 }
 
 wxString wxNumberFormatter::Format(const wxString& format, double val)
@@ -144,119 +385,224 @@ wxString wxNumberFormatter::Format(const wxString& format, double val)
     return s;
 }
 
-void wxNumberFormatter::AddThousandsSeparators(wxString& s)
+// ----------------------------------------------------------------------------
+// Conversion from strings
+// ----------------------------------------------------------------------------
+
+namespace
 {
-    // Thousands separators for numbers in scientific format are not relevant.
-    if ( s.find_first_of("eE") != wxString::npos )
-        return;
 
-    wxChar thousandsSep;
-    if ( !GetThousandsSeparatorIfUsed(&thousandsSep) )
-        return;
+// Longer strings can't represent valid numbers, except for floating point
+// numbers with a lot of insignificant digits which we don't support.
+const size_t MAX_PARSE_LEN = 128;
+
+// Copy the string representation of a number to the provided buffer, removing
+// all thousands separators and replacing the first decimal separator with a
+// period if decimalSep is non-zero.
+//
+// Returns false if the string contains any non-ASCII characters or is too
+// long, as it can't be a valid number in either case.
+template <typename Iterator>
+bool
+CopyNumberString(Iterator it, Iterator end,
+                 char (&buf)[MAX_PARSE_LEN], size_t* len,
+                 wxChar decimalSep)
+{
+    const NumberFormatInfo& info = GetNumberFormatInfo();
 
-    size_t pos = s.find(GetDecimalSeparator());
-    if ( pos == wxString::npos )
+    size_t n = 0;
+    for ( ; it != end; ++it )
     {
-        // Start grouping at the end of an integer number.
-        pos = s.length();
-    }
+        wxChar ch = *it;
+        if ( info.useThousandsSep && ch == info.thousandsSep )
+            continue;
 
-    // End grouping at the beginning of the digits -- there could be at a sign
-    // before their start.
-    const size_t start = s.find_first_of("0123456789");
+        if ( decimalSep && ch == decimalSep )
+        {
+            ch = '.';
+            decimalSep = 0;
+        }
 
-    // We currently group digits by 3 independently of the locale. This is not
-    // the right thing to do and we should use lconv::grouping (under POSIX)
-    // and GetLocaleInfo(LOCALE_SGROUPING) (under MSW) to get information about
-    // the correct grouping to use. This is something that needs to be done at
-    // wxLocale level first and then used here in the future (TODO).
-    const size_t GROUP_LEN = 3;
+        if ( static_cast<unsigned>(ch) >= 0x80 || ch == '\0' )
+            return false;
 
-    while ( pos > start + GROUP_LEN )
-    {
-        pos -= GROUP_LEN;
-        s.insert(pos, thousandsSep);
+        if ( n == MAX_PARSE_LEN - 1 )
+            return false;
+
+        buf[n++] = static_cast<char>(ch);
     }
+
+    buf[n] = '\0';
+    *len = n;
+
+    return true;
 }
 
-void wxNumberFormatter::RemoveTrailingZeroes(wxString& s)
+// Parse the integer in the given NUL-terminated buffer using the provided
+// function, which must be one of strtol() family functions.
+template <typename T>
+bool
+ParseInteger(const char* start,
+             T (*convert)(const char*, char**, int),
+             T* val)
 {
-    // If number is in scientific format, trailing zeroes belong to the exponent and cannot be removed.
-    if ( s.find_first_of("eE") != wxString::npos )
-        return;
+    const int errnoOrig = errno;
+    errno = 0;
 
-    const size_t posDecSep = s.find(GetDecimalSeparator());
-    // No decimal point => removing trailing zeroes irrelevant for integer number.
-    if ( posDecSep == wxString::npos )
-        return;
-    wxCHECK_RET( posDecSep, "Can't start with decimal separator" );
+    char* end;
+    const T res = convert(start, &end, 10);
 
-    // Find the last character to keep.
-    size_t posLastNonZero = s.find_last_not_of("0");
+    const bool ok = end != start && !*end && errno != ERANGE;
 
-    // If it's the decimal separator itself, don't keep it either.
-    if ( posLastNonZero == posDecSep )
-        posLastNonZero--;
+    errno = errnoOrig;
 
-    s.erase(posLastNonZero + 1);
-    // Remove sign from orphaned zero.
-    if ( s.compare("-0") == 0 )
-        s = "0";
-}
+    if ( !ok )
+        return false;
 
-// ----------------------------------------------------------------------------
-// Conversion from strings
-// ----------------------------------------------------------------------------
+    *val = res;
+    return true;
+}
 
-void wxNumberFormatter::RemoveThousandsSeparators(wxString& s)
+bool ParseDouble(const char* start, size_t len, double* val)
 {
-    wxChar thousandsSep;
-    if ( !GetThousandsSeparatorIfUsed(&thousandsSep) )
-        return;
+#ifdef __cpp_lib_to_chars
+    const char* const end = start + len;
+
+    // Behave in the same way as wxString::ToCDouble() and accept leading
+    // spaces and "+" sign, which from_chars() does not accept.
+    while ( wxIsspace(*start) )
+        ++start;
+
+    if ( *start == '+' )
+        ++start;
+
+    std::chars_format flags = std::chars_format::general;
+    if ( end - start > 1 && *start == '0' )
+    {
+        ++start;
+        if ( *start == 'x' || *start == 'X' )
+        {
+            ++start;
+            flags = std::chars_format::hex;
+        }
+    }
+
+    const auto res = std::from_chars(start, end, *val, flags);
 
-    s.Replace(wxString(thousandsSep), wxString());
+    return res.ec == std::errc{} && res.ptr == end;
+#else // !__cpp_lib_to_chars
+    return wxString::FromAscii(start, len).ToCDouble(val);
+#endif // __cpp_lib_to_chars/!__cpp_lib_to_chars
 }
 
-bool wxNumberFormatter::FromString(wxString s, long *val)
+template <typename Iterator>
+bool FromCharsLong(Iterator start, Iterator end, long* val)
 {
-    RemoveThousandsSeparators(s);
-    return s.ToLong(val);
+    wxCHECK_MSG( val, false, "null output pointer" );
+
+    char buf[MAX_PARSE_LEN];
+    size_t len;
+    return CopyNumberString(start, end, buf, &len, 0) &&
+                ParseInteger(buf, wxStrtol, val);
 }
 
 #ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
 
-bool wxNumberFormatter::FromString(wxString s, wxLongLong_t *val)
+template <typename Iterator>
+bool FromCharsLongLong(Iterator start, Iterator end, wxLongLong_t* val)
 {
-    RemoveThousandsSeparators(s);
-    return s.ToLongLong(val);
+    wxCHECK_MSG( val, false, "null output pointer" );
+
+    char buf[MAX_PARSE_LEN];
+    size_t len;
+    return CopyNumberString(start, end, buf, &len, 0) &&
+                ParseInteger(buf, wxStrtoll, val);
 }
 
 #endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
 
-bool wxNumberFormatter::FromString(wxString s, wxULongLong_t *val)
+template <typename Iterator>
+bool FromCharsULongLong(Iterator start, Iterator end, wxULongLong_t* val)
 {
-    RemoveThousandsSeparators(s);
+    wxCHECK_MSG( val, false, "null output pointer" );
 
-    // wxString::ToULongLong() does accept minus sign for unsigned integers,
-    // consistently with the standard functions behaviour, e.g. strtoul() does
-    // the same thing, but here we really want to accept the "true" unsigned
-    // numbers only, so check for leading minus, possibly preceded by some
-    // whitespace.
-    for ( wxString::const_iterator it = s.begin(); it != s.end(); ++it )
+    char buf[MAX_PARSE_LEN];
+    size_t len;
+    if ( !CopyNumberString(start, end, buf, &len, 0) )
+        return false;
+
+    // strtoull() does accept minus sign for unsigned integers, but here we
+    // really want to accept the "true" unsigned numbers only, so check for
+    // leading minus, possibly preceded by some whitespace.
+    for ( const char* p = buf; *p; ++p )
     {
-        if ( *it == '-' )
+        if ( *p == '-' )
             return false;
 
-        if ( *it != ' ' && *it != '\t' )
+        if ( *p != ' ' && *p != '\t' )
             break;
     }
 
-    return s.ToULongLong(val);
+    return ParseInteger(buf, wxStrtoull, val);
+}
+
+template <typename Iterator>
+bool FromCharsDouble(Iterator start, Iterator end, double* val)
+{
+    wxCHECK_MSG( val, false, "null output pointer" );
+
+    char buf[MAX_PARSE_LEN];
+    size_t len;
+    const wxChar decimalSep = GetNumberFormatInfo().decimalSep;
+    return CopyNumberString(start, end, buf, &len,
+                            decimalSep == '.' ? 0 : decimalSep) &&
+                ParseDouble(buf, len, val);
+}
+
+} // anonymous namespace
+
+bool wxNumberFormatter::FromString(const wxString& s, long *val)
+{
+    return FromCharsLong(s.begin(), s.end(), val);
+}
+
+bool wxNumberFormatter::FromChars(const wxChar* s, size_t len, long *val)
+{
+    return FromCharsLong(s, s + len, val);
+}
+
+#ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+
+bool wxNumberFormatter::FromString(const wxString& s, wxLongLong_t *val)
+{
+    return FromCharsLongLong(s.begin(), s.end(), val);
+}
+
+bool
+wxNumberFormatter::FromChars(const wxChar* s, size_t len, wxLongLong_t *val)
+{
+    return FromCharsLongLong(s, s + len, val);
+}
+
+#endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+
+bool wxNumberFormatter::FromString(const wxString& s, wxULongLong_t *val)
+{
+    return FromCharsULongLong(s.begin(), s.end(), val);
+}
+
+bool
+wxNumberFormatter::FromChars(const wxChar* s, size_t len, wxULongLong_t *val)
+{
+    return FromCharsULongLong(s, s + len, val);
+}
+
+bool wxNumberFormatter::FromString(const wxString& s, double *val)
+{
+    return FromCharsDouble(s.begin(), s.end(), val);
 }
 
-bool wxNumberFormatter::FromString(wxString s, double *val)
+bool wxNumberFormatter::FromChars(const wxChar* s, size_t len, double *val)
 {
-    RemoveThousandsSeparators(s);
-    ReplaceSeparatorIfNecessary(s, GetDecimalSeparator(), '.');
-    return s.ToCDouble(val);
+    return FromCharsDouble(s, s + len, val);
 }
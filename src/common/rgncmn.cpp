@@ -24,6 +24,8 @@
     #include "wx/utils.h"
 #endif //WX_PRECOMP
 
+#include <vector>
+
 // ============================================================================
 // wxRegionBase implementation
 // ============================================================================
@@ -68,6 +70,17 @@ wxBitmap wxRegionBase::ConvertToBitmap() const
     return bmp;
 }
 
+bool wxRegionBase::DoUnionWithRects(size_t count, const wxRect* rects)
+{
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( !DoUnionWithRect(rects[n]) )
+            return false;
+    }
+
+    return true;
+}
+
 #if wxUSE_IMAGE
 
 static bool DoRegionUnion(wxRegionBase& region,
@@ -84,7 +97,8 @@ static bool DoRegionUnion(wxRegionBase& region,
     hiB = (unsigned char)wxMin(0xFF, loB + tolerance);
 
     // Loop through the image row by row, pixel by pixel, building up
-    // rectangles to add to the region.
+    // rectangles to add to the region all at once at the end.
+    std::vector<wxRect> rects;
     int width = image.GetWidth();
     int height = image.GetHeight();
     for (int y=0; y < height; y++)
@@ -113,12 +127,12 @@ static bool DoRegionUnion(wxRegionBase& region,
             if (x > x0) {
                 rect.x = x0;
                 rect.width = x - x0;
-                region.Union(rect);
+                rects.push_back(rect);
             }
         }
     }
 
-    return true;
+    return region.Union(rects.size(), rects.data());
 }
 
 
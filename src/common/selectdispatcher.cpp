@@ -23,6 +23,7 @@
 
 #include "wx/private/selectdispatcher.h"
 #include "wx/unix/private.h"
+#include "wx/time.h"
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
@@ -248,18 +249,26 @@ bool wxSelectDispatcher::HasPending() const
 int wxSelectDispatcher::Dispatch(int timeout)
 {
     wxSelectSets sets(m_sets);
-    switch ( DoSelect(sets, timeout) )
+    const int rc = DoSelect(sets, timeout);
+    switch ( rc )
     {
         case -1:
+            UpdateStats(0, 0);
             wxLogSysError(_("Failed to monitor I/O channels"));
             return -1;
 
         case 0:
             // timeout expired without anything happening
+            UpdateStats(0, 0);
             return 0;
 
         default:
-            return ProcessSets(sets);
+            {
+                const wxLongLong start = wxGetUTCTimeUSec();
+                const int numEvents = ProcessSets(sets);
+                UpdateStats(rc, wxGetUTCTimeUSec() - start);
+                return numEvents;
+            }
     }
 }
 
@@ -49,6 +49,14 @@
 
 #include <unordered_map>
 
+// SSE2 is always available for x86-64 and is used to convert ASCII text in
+// blocks of 16 characters in UTF-8 conversions
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxHAS_SSE2_FOR_UTF8
+    #include <emmintrin.h>
+#endif
+
 #define TRACE_STRCONV wxT("strconv")
 
 // WC_UTF16 is defined only if sizeof(wchar_t) == 2, otherwise it's supposed to
@@ -943,6 +951,135 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
+// Convert the ASCII characters at the start of the given UTF-8 string, whose
+// length must be at most len, to wchar_t, return the number of characters
+// converted. If out is null, just count them.
+static size_t DecodeASCII(wchar_t *out, const char *src, size_t len)
+{
+    size_t n = 0;
+
+#ifdef wxHAS_SSE2_FOR_UTF8
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const __m128i
+            bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n));
+
+        // Stop at the first block with any bytes with the high bit set.
+        if ( _mm_movemask_epi8(bytes) )
+            break;
+
+        if ( !out )
+            continue;
+
+        const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+
+        __m128i* const dst = reinterpret_cast<__m128i*>(out + n);
+#ifdef WC_UTF16
+        _mm_storeu_si128(dst, lo);
+        _mm_storeu_si128(dst + 1, hi);
+#else // !WC_UTF16
+        _mm_storeu_si128(dst, _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(hi, zero));
+#endif // WC_UTF16/!WC_UTF16
+    }
+#else // !wxHAS_SSE2_FOR_UTF8
+    // Check 8 bytes at once, the compiler can vectorize the copying loop.
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        wxUint64 bytes;
+        memcpy(&bytes, src + n, sizeof(bytes));
+        if ( bytes & wxULL(0x8080808080808080) )
+            break;
+
+        if ( out )
+        {
+            for ( size_t i = n; i < n + 8; i++ )
+                out[i] = static_cast<unsigned char>(src[i]);
+        }
+    }
+#endif // wxHAS_SSE2_FOR_UTF8/!wxHAS_SSE2_FOR_UTF8
+
+    for ( ; n < len; n++ )
+    {
+        const unsigned char c = src[n];
+        if ( c >= 0x80 )
+            break;
+
+        if ( out )
+            out[n] = c;
+    }
+
+    return n;
+}
+
+// Convert the ASCII characters at the start of the given wide string, whose
+// length must be at most len, to UTF-8, return the number of characters
+// converted. If out is null, just count them.
+static size_t EncodeASCII(char *out, const wchar_t *src, size_t len)
+{
+    size_t n = 0;
+
+#ifdef wxHAS_SSE2_FOR_UTF8
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const __m128i* const p = reinterpret_cast<const __m128i*>(src + n);
+
+#ifdef WC_UTF16
+        const __m128i w0 = _mm_loadu_si128(p);
+        const __m128i w1 = _mm_loadu_si128(p + 1);
+
+        // Stop at the first block containing any non-ASCII characters.
+        const __m128i
+            high = _mm_and_si128(_mm_or_si128(w0, w1), _mm_set1_epi16(-0x80));
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff )
+            break;
+
+        if ( out )
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + n),
+                             _mm_packus_epi16(w0, w1));
+        }
+#else // !WC_UTF16
+        const __m128i w0 = _mm_loadu_si128(p);
+        const __m128i w1 = _mm_loadu_si128(p + 1);
+        const __m128i w2 = _mm_loadu_si128(p + 2);
+        const __m128i w3 = _mm_loadu_si128(p + 3);
+
+        const __m128i all = _mm_or_si128(_mm_or_si128(w0, w1),
+                                         _mm_or_si128(w2, w3));
+        const __m128i high = _mm_and_si128(all, _mm_set1_epi32(-0x80));
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xffff )
+            break;
+
+        if ( out )
+        {
+            // All values are less than 0x80, so saturation never happens.
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + n),
+                             _mm_packus_epi16(_mm_packs_epi32(w0, w1),
+                                              _mm_packs_epi32(w2, w3)));
+        }
+#endif // WC_UTF16/!WC_UTF16
+    }
+#endif // wxHAS_SSE2_FOR_UTF8
+
+    for ( ; n < len; n++ )
+    {
+        const wxUint32 code = src[n];
+        if ( code >= 0x80 )
+            break;
+
+        if ( out )
+            out[n] = static_cast<char>(code);
+    }
+
+    return n;
+}
+
 size_t
 wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
                             const char *src, size_t srcLen) const
@@ -955,6 +1092,23 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
 
     for ( const char *p = src; ; p++ )
     {
+        // convert all ASCII characters preceding the next non-ASCII one at
+        // once, this is much faster than doing it one by one below
+        const size_t lenASCII = DecodeASCII(out, p, out ? wxMin(srcLen, dstLen)
+                                                        : srcLen);
+        if ( lenASCII )
+        {
+            p += lenASCII;
+            srcLen -= lenASCII;
+            written += lenASCII;
+
+            if ( out )
+            {
+                out += lenASCII;
+                dstLen -= lenASCII;
+            }
+        }
+
         if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
         {
             // all done successfully, just add the trailing NUL if we are not
@@ -1065,10 +1219,27 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     char *out = dstLen ? dst : nullptr;
     size_t written = 0;
 
-    const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : src + srcLen;
+    const wchar_t* const end = src + (srcLen == wxNO_LEN ? wxWcslen(src)
+                                                         : srcLen);
     for ( const wchar_t *wp = src; ; )
     {
-        if ( end ? wp == end : !*wp )
+        // convert all ASCII characters at once, as in ToWChar() above
+        const size_t lenASCII = EncodeASCII(out, wp,
+                                            out ? wxMin(size_t(end - wp), dstLen)
+                                                : size_t(end - wp));
+        if ( lenASCII )
+        {
+            wp += lenASCII;
+            written += lenASCII;
+
+            if ( out )
+            {
+                out += lenASCII;
+                dstLen -= lenASCII;
+            }
+        }
+
+        if ( wp == end )
         {
             // all done successfully, just add the trailing NUL if we are not
             // using explicit length
@@ -1095,7 +1266,7 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
         if ( IsSurrogate(code) )
         {
             // Check that we have the second part of the surrogate pair.
-            if ( end ? wp == end : !*wp )
+            if ( wp == end )
                 return wxCONV_FAILED;
 
             code = EncodeSurrogate(code, *wp++);
@@ -1189,8 +1360,33 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
     // The length can be either given explicitly or computed implicitly for the
     // NUL-terminated strings.
     const bool isNulTerminated = srcLen == wxNO_LEN;
-    while ((isNulTerminated ? *psz : srcLen--) && ((!buf) || (len < n)))
+    if ( isNulTerminated )
+        srcLen = strlen(psz);
+
+    // Backslashes must be escaped in octal mode, so we can't convert all
+    // ASCII characters in the same way then.
+    const bool canDecodeASCII = !(m_options & MAP_INVALID_UTF8_TO_OCTAL);
+
+    while (srcLen && ((!buf) || (len < n)))
     {
+        if ( canDecodeASCII )
+        {
+            const size_t lenASCII = DecodeASCII(buf, psz, buf ? wxMin(srcLen, n - len)
+                                                              : srcLen);
+            if ( lenASCII )
+            {
+                psz += lenASCII;
+                srcLen -= lenASCII;
+                len += lenASCII;
+                if ( buf )
+                    buf += lenASCII;
+
+                continue;
+            }
+        }
+
+        srcLen--;
+
         const char *opsz = psz;
         unsigned char cc = *psz++, fc = cc;
         unsigned cnt;
@@ -1228,7 +1424,7 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
                 wxUint32 res = cc & (0x3f >> cnt);
                 while (cnt--)
                 {
-                    if (!isNulTerminated && !srcLen)
+                    if (!srcLen)
                     {
                         // invalid UTF-8 sequence ending before the end of code
                         // point.
@@ -1245,8 +1441,7 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
                     }
 
                     psz++;
-                    if (!isNulTerminated)
-                        srcLen--;
+                    srcLen--;
                     res = (res << 6) | (cc & 0x3f);
                 }
 
@@ -1361,9 +1556,30 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
 
     // The length can be either given explicitly or computed implicitly for the
     // NUL-terminated strings.
-    const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : psz + srcLen;
-    while ((end ? psz < end : *psz) && ((!buf) || (len < n)))
+    const bool isNulTerminated = srcLen == wxNO_LEN;
+    const wchar_t* const end = psz + (isNulTerminated ? wxWcslen(psz) : srcLen);
+
+    // As in ToWChar(), backslashes need special handling in octal mode.
+    const bool canEncodeASCII = !(m_options & MAP_INVALID_UTF8_TO_OCTAL);
+
+    while (psz < end && ((!buf) || (len < n)))
     {
+        if ( canEncodeASCII )
+        {
+            const size_t srcLeft = end - psz;
+            const size_t lenASCII = EncodeASCII(buf, psz, buf ? wxMin(srcLeft, n - len)
+                                                              : srcLeft);
+            if ( lenASCII )
+            {
+                psz += lenASCII;
+                len += lenASCII;
+                if ( buf )
+                    buf += lenASCII;
+
+                continue;
+            }
+        }
+
         wxUint32 cc;
 
 #ifdef WC_UTF16
@@ -1372,7 +1588,7 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
         if ( IsSurrogate(cc) )
         {
             // Check that we have the second part of the surrogate pair.
-            if ( end ? psz == end : !*psz )
+            if ( psz == end )
                 return wxCONV_FAILED;
 
             cc = EncodeSurrogate(cc, *psz++);
@@ -1439,7 +1655,7 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
         }
     }
 
-    if ( !end )
+    if ( isNulTerminated )
     {
         // Add the trailing NUL in this case if we have a large enough buffer.
         if ( buf && (len < n) )
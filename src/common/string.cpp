@@ -26,8 +26,15 @@
 
 #include <errno.h>
 
+#include <locale.h>
+#include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
+#include <wchar.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include "wx/uilocale.h"
 #include "wx/vector.h"
@@ -362,7 +369,7 @@ wxString::SubstrBufFromMB wxString::ConvertStr(const char *psz, size_t nLength,
 {
     // anything to do?
     if ( !psz || nLength == 0 )
-        return SubstrBufFromMB(wxWCharBuffer(L""), 0);
+        return SubstrBufFromMB(wxScopedWCharBuffer::CreateNonOwned(L"", 0), 0);
 
     if ( nLength == npos )
         nLength = wxNO_LEN;
@@ -370,10 +377,55 @@ wxString::SubstrBufFromMB wxString::ConvertStr(const char *psz, size_t nLength,
     size_t wcLen;
     wxScopedWCharBuffer wcBuf(conv.cMB2WC(psz, nLength, &wcLen));
     if ( !wcLen )
-        return SubstrBufFromMB(wxWCharBuffer(L""), 0);
+        return SubstrBufFromMB(wxScopedWCharBuffer::CreateNonOwned(L"", 0), 0);
     else
         return SubstrBufFromMB(wcBuf, wcLen);
 }
+
+void wxString::DoAssignFromMB(const char *psz, size_t nLength,
+                              const wxMBConv& conv)
+{
+    if ( !psz || nLength == 0 )
+    {
+        m_impl.clear();
+        return;
+    }
+
+    // Short strings, such as the literals typically used for labels, are
+    // converted directly into a buffer on the stack, which avoids both the
+    // extra pass over the string to find the length of the result and the
+    // allocation of a temporary buffer for it done by ConvertStr(), so that
+    // the only allocation, if any, is the one done by m_impl itself.
+    //
+    // Notice that the conversions normally don't produce more wide characters
+    // than the number of bytes in their input, but some of them can (e.g.
+    // wxMBConvUTF8 with MAP_INVALID_UTF8_TO_OCTAL) and not all of them fail
+    // if the output buffer is too small, but just return the length they
+    // would need, so check for this explicitly and fall back on ConvertStr()
+    // below if the buffer turns out to be insufficient.
+    static const size_t SHORT_STRING_LEN = 64;
+
+    const size_t lenMB = nLength == npos ? wxStrnlen(psz, SHORT_STRING_LEN)
+                                         : nLength;
+    if ( lenMB < SHORT_STRING_LEN )
+    {
+        wchar_t buf[SHORT_STRING_LEN + 1];
+        size_t lenWC = conv.ToWChar(buf, WXSIZEOF(buf), psz,
+                                    nLength == npos ? wxNO_LEN : nLength);
+        if ( lenWC != wxCONV_FAILED && lenWC < WXSIZEOF(buf) )
+        {
+            // Don't count the trailing NUL for NUL-terminated input.
+            if ( nLength == npos )
+                lenWC--;
+
+            m_impl.assign(buf, lenWC);
+            return;
+        }
+    }
+
+    SubstrBufFromMB str(ConvertStr(psz, nLength, conv));
+    m_impl.assign(str.data, str.len);
+}
 #endif // wxUSE_UNICODE_WCHAR
 
 #if wxUSE_UNICODE_UTF8
@@ -529,6 +581,37 @@ const char *wxString::AsChar(const wxMBConv& conv) const
     return m_convertedToChar.m_str;
 }
 
+#if wxUSE_UNICODE_WCHAR
+
+wxScopedCharBuffer wxString::AsUTF8Buf() const
+{
+    // Short strings, such as labels, which are often converted to UTF-8, are
+    // converted directly into a buffer on the stack, which avoids the extra
+    // pass over the string done by mb_str() to find the length of the result.
+    // As each wchar_t can't take more than 4 bytes in UTF-8, this buffer is
+    // always big enough. Notice that the result is still copied into a new
+    // buffer owned by the returned object, so that it remains valid even if
+    // this string changes.
+    static const size_t SHORT_STRING_LEN = 64;
+
+    const size_t lenWC = m_impl.length();
+    if ( lenWC < SHORT_STRING_LEN )
+    {
+        char buf[4*SHORT_STRING_LEN + 1];
+        const size_t lenMB = wxMBConvUTF8().FromWChar(buf, WXSIZEOF(buf) - 1,
+                                                      m_impl.c_str(), lenWC);
+        if ( lenMB != wxCONV_FAILED )
+        {
+            buf[lenMB] = '\0';
+            return wxCharTypeBuffer<char>(buf, lenMB);
+        }
+    }
+
+    return mb_str(wxMBConvUTF8());
+}
+
+#endif // wxUSE_UNICODE_WCHAR
+
 // ---------------------------------------------------------------------------
 // data access
 // ---------------------------------------------------------------------------
@@ -1901,6 +1984,796 @@ wxString wxString::FromCDouble(double val, int precision)
 // formatted output
 // ---------------------------------------------------------------------------
 
+#if wxUSE_UNICODE_WCHAR
+
+/*
+    Most format strings used with wxString::Format() and Printf() are literals
+    using only a few common conversion specifiers, so we format them ourselves
+    instead of calling vswprintf(), which needs to parse the format string
+    every time, is slow for wide strings in many implementations and writes
+    into a separate buffer which has to be allocated and then copied.
+
+    Format strings are compiled into a sequence of steps once and kept in a
+    small per-thread cache indexed by their address, which is stable for the
+    strings passed to Format() and Printf() as they're cached by
+    wxFormatString. Anything not supported here, such as positional
+    parameters, "%p" or narrow strings, makes us fall back to the CRT, and so
+    does anything which could be formatted differently by it, such as NaN or
+    infinite numbers, so the result is always the same as when using the CRT.
+*/
+
+namespace
+{
+
+// The maximal width and precision we handle, the CRT is used for bigger ones.
+const int PRINTF_MAX_WIDTH = 65536;
+
+// A conversion specifier preceded by the literal text.
+struct PrintfStep
+{
+    enum
+    {
+        Flag_Left   = 1,
+        Flag_Plus   = 2,
+        Flag_Space  = 4,
+        Flag_Alt    = 8,
+        Flag_Zero   = 16
+    };
+
+    enum Size
+    {
+        Size_Default,
+        Size_Char,
+        Size_Short,
+        Size_Long,
+        Size_LongLong,
+        Size_SizeT,
+        Size_IntMax,
+        Size_PtrDiff
+    };
+
+    // Special values of m_width and m_precision.
+    enum
+    {
+        Value_None = -1,
+        Value_Arg = -2
+    };
+
+    // The literal text preceding the conversion in PrintfProgram::m_text.
+    size_t m_textStart;
+    size_t m_textLen;
+
+    // The conversion character or NUL for the last step containing only the
+    // text following the last conversion.
+    wchar_t m_conv;
+
+    int m_flags;
+    Size m_size;
+
+    int m_width;
+    int m_precision;
+};
+
+// Buffer for the formatted string: short strings are formatted into a fixed
+// size buffer and only the longer ones need to allocate memory.
+class PrintfOutput
+{
+public:
+    PrintfOutput() : m_len(0), m_onHeap(false) { }
+
+    const wchar_t* GetData() const { return m_onHeap ? m_heap.data() : m_buf; }
+    size_t GetLength() const { return m_len; }
+
+    void Append(const wchar_t* s, size_t len)
+    {
+        if ( len )
+            wmemcpy(Extend(len), s, len);
+    }
+
+    void Append(size_t count, wchar_t ch)
+    {
+        if ( count )
+            wmemset(Extend(count), ch, count);
+    }
+
+    void AppendASCII(const char* s, size_t len)
+    {
+        wchar_t* const p = len ? Extend(len) : nullptr;
+        for ( size_t n = 0; n < len; n++ )
+            p[n] = static_cast<unsigned char>(s[n]);
+    }
+
+private:
+    // Return the pointer to the space for len more characters at the end.
+    wchar_t* Extend(size_t len)
+    {
+        if ( !m_onHeap )
+        {
+            if ( m_len + len <= WXSIZEOF(m_buf) )
+            {
+                wchar_t* const p = m_buf + m_len;
+                m_len += len;
+                return p;
+            }
+
+            m_heap.assign(m_buf, m_len);
+            m_onHeap = true;
+        }
+
+        m_heap.resize(m_len + len);
+
+        wchar_t* const p = &m_heap[m_len];
+        m_len += len;
+        return p;
+    }
+
+    wchar_t m_buf[256];
+    std::wstring m_heap;
+    size_t m_len;
+    bool m_onHeap;
+};
+
+// Append the number with the given prefix (sign and/or base indicator),
+// leading zeroes and digits padded to the given width.
+void
+AppendNumber(PrintfOutput& out,
+             const char* prefix, size_t prefixLen,
+             size_t zeroes,
+             const char* digits, size_t numDigits,
+             size_t width, bool left, bool padWithZeroes)
+{
+    const size_t len = prefixLen + zeroes + numDigits;
+    const size_t pad = width > len ? width - len : 0;
+
+    if ( left )
+    {
+        out.AppendASCII(prefix, prefixLen);
+        out.Append(zeroes, wxS('0'));
+        out.AppendASCII(digits, numDigits);
+        out.Append(pad, wxS(' '));
+    }
+    else if ( padWithZeroes )
+    {
+        out.AppendASCII(prefix, prefixLen);
+        out.Append(zeroes + pad, wxS('0'));
+        out.AppendASCII(digits, numDigits);
+    }
+    else
+    {
+        out.Append(pad, wxS(' '));
+        out.AppendASCII(prefix, prefixLen);
+        out.Append(zeroes, wxS('0'));
+        out.AppendASCII(digits, numDigits);
+    }
+}
+
+// Compiled format string.
+class PrintfProgram
+{
+public:
+    // Compile the given format string, return false if it's not supported.
+    bool Compile(const wchar_t* format);
+
+    // Format the arguments into the given buffer, return false if the CRT
+    // needs to be used for them.
+    bool Format(PrintfOutput& out, va_list& argptr) const;
+
+private:
+    static bool ParseConversion(const wchar_t*& p, PrintfStep& step);
+
+    static bool
+    FormatInteger(PrintfOutput& out, const PrintfStep& step,
+                  int width, int precision, bool left, va_list& argptr);
+
+    static bool
+    FormatDouble(PrintfOutput& out, const PrintfStep& step,
+                 int width, int precision, bool left, va_list& argptr);
+
+    // The literal text of all steps, with "%%" already replaced by "%".
+    std::wstring m_text;
+
+    std::vector<PrintfStep> m_steps;
+};
+
+bool PrintfProgram::Compile(const wchar_t* format)
+{
+    m_text.clear();
+    m_steps.clear();
+
+    size_t textStart = 0;
+    for ( const wchar_t* p = format; ; )
+    {
+        const wchar_t* const start = p;
+        while ( *p && *p != wxS('%') )
+            ++p;
+
+        m_text.append(start, p);
+
+        PrintfStep step;
+        step.m_textStart = textStart;
+        step.m_textLen = m_text.length() - textStart;
+
+        if ( !*p )
+        {
+            step.m_conv = 0;
+            m_steps.push_back(step);
+            break;
+        }
+
+        if ( p[1] == wxS('%') )
+        {
+            m_text += wxS('%');
+            p += 2;
+            continue;
+        }
+
+        ++p;
+        if ( !ParseConversion(p, step) )
+            return false;
+
+        m_steps.push_back(step);
+        textStart = m_text.length();
+    }
+
+    return true;
+}
+
+/* static */
+bool PrintfProgram::ParseConversion(const wchar_t*& p, PrintfStep& step)
+{
+    step.m_flags = 0;
+    for ( ;; ++p )
+    {
+        switch ( *p )
+        {
+            case wxS('-'): step.m_flags |= PrintfStep::Flag_Left; continue;
+            case wxS('+'): step.m_flags |= PrintfStep::Flag_Plus; continue;
+            case wxS(' '): step.m_flags |= PrintfStep::Flag_Space; continue;
+            case wxS('#'): step.m_flags |= PrintfStep::Flag_Alt; continue;
+            case wxS('0'): step.m_flags |= PrintfStep::Flag_Zero; continue;
+        }
+
+        break;
+    }
+
+    // Parse width or precision, possibly given by an argument. Note that this
+    // also rejects positional parameters, as '$' is not a valid conversion.
+    const auto parseValue = [&p](int& value) -> bool
+    {
+        if ( *p == wxS('*') )
+        {
+            ++p;
+            value = PrintfStep::Value_Arg;
+            return true;
+        }
+
+        value = 0;
+        for ( ; *p >= wxS('0') && *p <= wxS('9'); ++p )
+        {
+            value = value*10 + (*p - wxS('0'));
+            if ( value > PRINTF_MAX_WIDTH )
+                return false;
+        }
+
+        return true;
+    };
+
+    if ( !parseValue(step.m_width) )
+        return false;
+
+    step.m_precision = PrintfStep::Value_None;
+    if ( *p == wxS('.') )
+    {
+        ++p;
+        if ( !parseValue(step.m_precision) )
+            return false;
+    }
+
+    switch ( *p )
+    {
+        case wxS('h'):
+            if ( *++p == wxS('h') )
+            {
+                ++p;
+                step.m_size = PrintfStep::Size_Char;
+            }
+            else
+            {
+                step.m_size = PrintfStep::Size_Short;
+            }
+            break;
+
+        case wxS('l'):
+            if ( *++p == wxS('l') )
+            {
+                ++p;
+                step.m_size = PrintfStep::Size_LongLong;
+            }
+            else
+            {
+                step.m_size = PrintfStep::Size_Long;
+            }
+            break;
+
+        case wxS('z'):
+            ++p;
+            step.m_size = PrintfStep::Size_SizeT;
+            break;
+
+        case wxS('j'):
+            ++p;
+            step.m_size = PrintfStep::Size_IntMax;
+            break;
+
+        case wxS('t'):
+            ++p;
+            step.m_size = PrintfStep::Size_PtrDiff;
+            break;
+
+        default:
+            step.m_size = PrintfStep::Size_Default;
+    }
+
+    step.m_conv = *p++;
+    switch ( step.m_conv )
+    {
+        case wxS('d'):
+        case wxS('i'):
+        case wxS('o'):
+        case wxS('u'):
+        case wxS('x'):
+        case wxS('X'):
+            return true;
+
+        case wxS('e'):
+        case wxS('E'):
+        case wxS('f'):
+        case wxS('F'):
+        case wxS('g'):
+        case wxS('G'):
+#ifdef __cpp_lib_to_chars
+            // "%lf" is the same as "%f", but "%Lf" is not supported.
+            return (step.m_size == PrintfStep::Size_Default ||
+                        step.m_size == PrintfStep::Size_Long) &&
+                   !(step.m_flags & PrintfStep::Flag_Alt);
+#else
+            // We can't format floating point numbers without std::to_chars().
+            return false;
+#endif
+
+        case wxS('c'):
+            if ( step.m_precision != PrintfStep::Value_None )
+                return false;
+            wxFALLTHROUGH;
+
+        case wxS('s'):
+            // Only wide strings and characters are supported and whether "%s"
+            // and "%c" mean them depends on the CRT, see the comment before
+            // wxPrintfFormatConverterWchar in strvararg.cpp.
+            if ( step.m_size != PrintfStep::Size_Long )
+            {
+#if defined(__WINDOWS__) && \
+    !defined(__CYGWIN__) && \
+    !defined(__MINGW32__)
+                if ( step.m_size != PrintfStep::Size_Default )
+                    return false;
+#else
+                return false;
+#endif
+            }
+
+            // Other flags are not meaningful (and "0" is actually not
+            // handled in the same way by all CRTs).
+            return (step.m_flags & ~PrintfStep::Flag_Left) == 0;
+    }
+
+    return false;
+}
+
+/* static */
+bool
+PrintfProgram::FormatInteger(PrintfOutput& out, const PrintfStep& step,
+                             int width, int precision, bool left,
+                             va_list& argptr)
+{
+    unsigned long long value;
+    char prefix[2];
+    size_t prefixLen = 0;
+
+    const wchar_t conv = step.m_conv;
+    if ( conv == wxS('d') || conv == wxS('i') )
+    {
+        long long n;
+        switch ( step.m_size )
+        {
+            case PrintfStep::Size_Char:
+                n = static_cast<signed char>(va_arg(argptr, int));
+                break;
+            case PrintfStep::Size_Short:
+                n = static_cast<short>(va_arg(argptr, int));
+                break;
+            case PrintfStep::Size_Long:
+                n = va_arg(argptr, long);
+                break;
+            case PrintfStep::Size_LongLong:
+                n = va_arg(argptr, long long);
+                break;
+            case PrintfStep::Size_SizeT:
+                n = va_arg(argptr, std::make_signed<size_t>::type);
+                break;
+            case PrintfStep::Size_IntMax:
+                n = va_arg(argptr, intmax_t);
+                break;
+            case PrintfStep::Size_PtrDiff:
+                n = va_arg(argptr, ptrdiff_t);
+                break;
+            default:
+                n = va_arg(argptr, int);
+        }
+
+        if ( n < 0 )
+        {
+            // Avoid overflow for the minimal value by negating it as unsigned.
+            value = 0ULL - static_cast<unsigned long long>(n);
+            prefix[prefixLen++] = '-';
+        }
+        else
+        {
+            value = n;
+            if ( step.m_flags & PrintfStep::Flag_Plus )
+                prefix[prefixLen++] = '+';
+            else if ( step.m_flags & PrintfStep::Flag_Space )
+                prefix[prefixLen++] = ' ';
+        }
+    }
+    else
+    {
+        switch ( step.m_size )
+        {
+            case PrintfStep::Size_Char:
+                value = static_cast<unsigned char>(va_arg(argptr, unsigned));
+                break;
+            case PrintfStep::Size_Short:
+                value = static_cast<unsigned short>(va_arg(argptr, unsigned));
+                break;
+            case PrintfStep::Size_Long:
+                value = va_arg(argptr, unsigned long);
+                break;
+            case PrintfStep::Size_LongLong:
+                value = va_arg(argptr, unsigned long long);
+                break;
+            case PrintfStep::Size_SizeT:
+                value = va_arg(argptr, size_t);
+                break;
+            case PrintfStep::Size_IntMax:
+                value = va_arg(argptr, uintmax_t);
+                break;
+            case PrintfStep::Size_PtrDiff:
+                value = va_arg(argptr, std::make_unsigned<ptrdiff_t>::type);
+                break;
+            default:
+                value = va_arg(argptr, unsigned);
+        }
+
+        if ( (step.m_flags & PrintfStep::Flag_Alt) &&
+                (conv == wxS('x') || conv == wxS('X')) && value )
+        {
+            prefix[prefixLen++] = '0';
+            prefix[prefixLen++] = static_cast<char>(conv);
+        }
+    }
+
+    const unsigned base = conv == wxS('o') ? 8
+                            : conv == wxS('x') || conv == wxS('X') ? 16
+                                : 10;
+    const char* const
+        digitChars = conv == wxS('X') ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    char digits[32];
+    char* const end = digits + WXSIZEOF(digits);
+    char* start = end;
+
+    // Zero precision means that 0 is not output at all.
+    if ( value || precision != 0 )
+    {
+        do
+        {
+            *--start = digitChars[value % base];
+            value /= base;
+        } while ( value );
+    }
+
+    const size_t numDigits = end - start;
+
+    size_t zeroes = 0;
+    if ( precision > 0 && static_cast<size_t>(precision) > numDigits )
+        zeroes = precision - numDigits;
+
+    // Alternative form of octal numbers always starts with 0.
+    if ( conv == wxS('o') && (step.m_flags & PrintfStep::Flag_Alt) &&
+            !zeroes && (!numDigits || *start != '0') )
+        zeroes = 1;
+
+    AppendNumber(out, prefix, prefixLen, zeroes, start, numDigits, width,
+                 left,
+                 (step.m_flags & PrintfStep::Flag_Zero) &&
+                    precision == PrintfStep::Value_None);
+
+    return true;
+}
+
+/* static */
+bool
+PrintfProgram::FormatDouble(PrintfOutput& out, const PrintfStep& step,
+                            int width, int precision, bool left,
+                            va_list& argptr)
+{
+#ifdef __cpp_lib_to_chars
+    const double value = va_arg(argptr, double);
+
+    // CRTs differ in how they format these special values, so let them do it.
+    if ( !wxFinite(value) )
+        return false;
+
+    std::chars_format fmt;
+    switch ( step.m_conv )
+    {
+        case wxS('e'):
+        case wxS('E'):
+            fmt = std::chars_format::scientific;
+            break;
+
+        case wxS('g'):
+        case wxS('G'):
+            fmt = std::chars_format::general;
+            break;
+
+        default:
+            fmt = std::chars_format::fixed;
+    }
+
+    if ( precision == PrintfStep::Value_None )
+        precision = 6;
+
+    char buf[512];
+    const std::to_chars_result
+        res = std::to_chars(buf, buf + WXSIZEOF(buf), value, fmt, precision);
+    if ( res.ec != std::errc() )
+        return false;
+
+    char prefix[1];
+    size_t prefixLen = 0;
+
+    const char* start = buf;
+    if ( *start == '-' )
+    {
+        prefix[prefixLen++] = '-';
+        ++start;
+    }
+    else if ( step.m_flags & PrintfStep::Flag_Plus )
+    {
+        prefix[prefixLen++] = '+';
+    }
+    else if ( step.m_flags & PrintfStep::Flag_Space )
+    {
+        prefix[prefixLen++] = ' ';
+    }
+
+    // Adjust the result for the current locale decimal point and the case of
+    // the exponent.
+    for ( char* p = buf; p != res.ptr; ++p )
+    {
+        if ( *p == '.' )
+        {
+            const char* const
+                decimalPoint = localeconv()->decimal_point;
+
+            // Only handle a single ASCII character, which is the same in
+            // narrow and wide strings.
+            if ( !decimalPoint || !decimalPoint[0] || decimalPoint[1] ||
+                    static_cast<unsigned char>(decimalPoint[0]) >= 0x80 )
+                return false;
+
+            *p = decimalPoint[0];
+        }
+        else if ( *p == 'e' && (step.m_conv == wxS('E') ||
+                                    step.m_conv == wxS('G')) )
+        {
+            *p = 'E';
+        }
+    }
+
+    AppendNumber(out, prefix, prefixLen, 0, start, res.ptr - start, width,
+                 left, (step.m_flags & PrintfStep::Flag_Zero) != 0);
+
+    return true;
+#else // !__cpp_lib_to_chars
+    // This is never called as such format strings are not compiled at all.
+    wxUnusedVar(out);
+    wxUnusedVar(step);
+    wxUnusedVar(width);
+    wxUnusedVar(precision);
+    wxUnusedVar(left);
+    wxUnusedVar(argptr);
+
+    return false;
+#endif // __cpp_lib_to_chars/!__cpp_lib_to_chars
+}
+
+bool PrintfProgram::Format(PrintfOutput& out, va_list& argptr) const
+{
+    for ( const PrintfStep& step : m_steps )
+    {
+        out.Append(m_text.data() + step.m_textStart, step.m_textLen);
+
+        if ( !step.m_conv )
+            break;
+
+        bool left = (step.m_flags & PrintfStep::Flag_Left) != 0;
+
+        int width = step.m_width;
+        if ( width == PrintfStep::Value_Arg )
+        {
+            // Negative width means left alignment.
+            width = va_arg(argptr, int);
+            if ( width < 0 )
+            {
+                if ( width < -PRINTF_MAX_WIDTH )
+                    return false;
+
+                width = -width;
+                left = true;
+            }
+            else if ( width > PRINTF_MAX_WIDTH )
+            {
+                return false;
+            }
+        }
+
+        int precision = step.m_precision;
+        if ( precision == PrintfStep::Value_Arg )
+        {
+            // Negative precision is the same as not specifying it at all.
+            precision = va_arg(argptr, int);
+            if ( precision < 0 )
+                precision = PrintfStep::Value_None;
+            else if ( precision > PRINTF_MAX_WIDTH )
+                return false;
+        }
+
+        switch ( step.m_conv )
+        {
+            case wxS('s'):
+                {
+                    const wchar_t* const s = va_arg(argptr, const wchar_t*);
+
+                    // CRTs output "(null)" or something else for it.
+                    if ( !s )
+                        return false;
+
+                    size_t len;
+                    if ( precision == PrintfStep::Value_None )
+                    {
+                        len = wcslen(s);
+                    }
+                    else
+                    {
+                        for ( len = 0; len < static_cast<size_t>(precision); ++len )
+                        {
+                            if ( !s[len] )
+                                break;
+                        }
+                    }
+
+                    const size_t pad = static_cast<size_t>(width) > len
+                                        ? width - len : 0;
+                    if ( !left )
+                        out.Append(pad, wxS(' '));
+                    out.Append(s, len);
+                    if ( left )
+                        out.Append(pad, wxS(' '));
+                }
+                break;
+
+            case wxS('c'):
+                {
+                    // Characters are promoted to int when passed via "...".
+                    const wchar_t ch = static_cast<wchar_t>(va_arg(argptr, int));
+
+                    // NUL would be embedded in the output by the CRT, while
+                    // wxString::Printf() would truncate it there.
+                    if ( !ch )
+                        return false;
+
+                    const size_t pad = width > 1 ? width - 1 : 0;
+                    if ( !left )
+                        out.Append(pad, wxS(' '));
+                    out.Append(1, ch);
+                    if ( left )
+                        out.Append(pad, wxS(' '));
+                }
+                break;
+
+            case wxS('e'):
+            case wxS('E'):
+            case wxS('f'):
+            case wxS('F'):
+            case wxS('g'):
+            case wxS('G'):
+                if ( !FormatDouble(out, step, width, precision, left, argptr) )
+                    return false;
+                break;
+
+            default:
+                if ( !FormatInteger(out, step, width, precision, left, argptr) )
+                    return false;
+        }
+    }
+
+    return out.GetLength() <= INT_MAX;
+}
+
+// Entry of the per-thread cache of the compiled format strings.
+struct PrintfCacheEntry
+{
+    PrintfCacheEntry() : m_key(nullptr), m_ok(false) { }
+
+    const wchar_t* m_key;
+    std::wstring m_format;
+    PrintfProgram m_program;
+
+    // False if the format string is not supported by PrintfProgram.
+    bool m_ok;
+};
+
+// Return the compiled format string or nullptr if it's not supported.
+const PrintfProgram* GetPrintfProgram(const wchar_t* format)
+{
+    // The number of entries in the cache, must be a power of 2.
+    static const size_t PRINTF_CACHE_SIZE = 16;
+
+    thread_local PrintfCacheEntry s_cache[PRINTF_CACHE_SIZE];
+
+    const wxUIntPtr key = wxPtrToUInt(format);
+    PrintfCacheEntry& entry = s_cache[(key ^ (key >> 6)) & (PRINTF_CACHE_SIZE - 1)];
+
+    if ( entry.m_key != format || entry.m_format != format )
+    {
+        entry.m_key = format;
+        entry.m_format = format;
+        entry.m_ok = entry.m_program.Compile(format);
+    }
+
+    return entry.m_ok ? &entry.m_program : nullptr;
+}
+
+// Format the string directly if possible or return false if the CRT must be
+// used for it.
+bool DoStringPrintfFast(wxString& str, const wchar_t* format, va_list argptr)
+{
+    const PrintfProgram* const program = GetPrintfProgram(format);
+    if ( !program )
+        return false;
+
+    PrintfOutput out;
+
+    va_list argptrcopy;
+    wxVaCopy(argptrcopy, argptr);
+    const bool ok = program->Format(out, argptrcopy);
+    va_end(argptrcopy);
+
+    if ( !ok )
+        return false;
+
+    str.assign(out.GetData(), out.GetLength());
+
+    return true;
+}
+
+} // anonymous namespace
+
+#endif // wxUSE_UNICODE_WCHAR
+
 /* static */
 wxString wxString::FormatV(const wxString& format, va_list argptr)
 {
@@ -1909,13 +2782,27 @@ wxString wxString::FormatV(const wxString& format, va_list argptr)
     return s;
 }
 
+#if wxUSE_UNICODE_WCHAR
+static int DoStringPrintfV(wxString& str,
+                           const wxString& format, va_list argptr);
+#endif // wxUSE_UNICODE_WCHAR
+
 #if !wxUSE_UTF8_LOCALE_ONLY
 int wxString::DoPrintfWchar(const wxChar *format, ...)
 {
     va_list argptr;
     va_start(argptr, format);
 
+#if wxUSE_UNICODE_WCHAR
+    // Avoid creating a temporary wxString for the format if we can.
+    int iLen;
+    if ( DoStringPrintfFast(*this, format, argptr) )
+        iLen = length();
+    else
+        iLen = DoStringPrintfV(*this, format, argptr);
+#else
     int iLen = PrintfV(format, argptr);
+#endif
 
     va_end(argptr);
 
@@ -2085,6 +2972,9 @@ int wxString::PrintfV(const wxString& format, va_list argptr)
         // wxChar* version
         return DoStringPrintfV<wxStringBuffer>(*this, format, argptr);
     #else
+        if ( DoStringPrintfFast(*this, format.wc_str(), argptr) )
+            return length();
+
         return DoStringPrintfV(*this, format, argptr);
     #endif // UTF8/WCHAR
 #endif
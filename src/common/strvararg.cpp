@@ -24,6 +24,9 @@
 #include "wx/crt.h"
 #include "wx/private/wxprintf.h"
 
+#include <string>
+#include <vector>
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -552,6 +555,125 @@ const wxScopedWCharBuffer wxScanfConvertFormatW(const wchar_t *format)
 #endif // !__WINDOWS__
 
 
+// ----------------------------------------------------------------------------
+// wxFormatString cache
+// ----------------------------------------------------------------------------
+
+// Format strings are almost always literals and the same ones are used over
+// and over again, so we keep the results of converting and parsing them in a
+// small per-thread cache indexed by their address. As the same address can be
+// reused for a different string later, e.g. if the format string was
+// allocated dynamically, the string itself is stored in the cache too and
+// compared with the one being looked up.
+struct wxFormatString::CacheEntry
+{
+    // The format string as passed to wxFormatString and its address.
+    const void* m_key = nullptr;
+    std::string m_char;
+    std::wstring m_wchar;
+
+    // The format string converted by wxFormatConverter or null if not done yet.
+#if !wxUSE_UNICODE_WCHAR
+    wxCharBuffer m_convertedChar;
+#endif
+#if !wxUSE_UTF8_LOCALE_ONLY
+    wxWCharBuffer m_convertedWChar;
+#endif
+
+    // The types of all arguments used by the format string, with Arg_Unknown
+    // for any missing ones, only valid if m_parsed is true.
+    std::vector<int> m_argTypes;
+    bool m_parsed = false;
+};
+
+namespace
+{
+
+// The number of entries in the cache, must be a power of 2.
+const size_t FORMAT_CACHE_SIZE = 16;
+
+template <typename Entry>
+std::string& GetCachedString(Entry& entry, const char*)
+{
+    return entry.m_char;
+}
+
+template <typename Entry>
+std::wstring& GetCachedString(Entry& entry, const wchar_t*)
+{
+    return entry.m_wchar;
+}
+
+// Non-ASCII strings are converted between narrow and wide representations
+// using the current locale encoding, which may change, so we don't cache them,
+// except for the wide strings in wchar_t build, which are never converted.
+bool IsCacheableFormat(const char* format)
+{
+    for ( ; *format; ++format )
+    {
+        if ( static_cast<unsigned char>(*format) >= 0x80 )
+            return false;
+    }
+
+    return true;
+}
+
+bool IsCacheableFormat(const wchar_t* format)
+{
+#if wxUSE_UNICODE_WCHAR
+    wxUnusedVar(format);
+#else
+    for ( ; *format; ++format )
+    {
+        if ( static_cast<wxUint32>(*format) >= 0x80 )
+            return false;
+    }
+#endif
+
+    return true;
+}
+
+template <typename Entry, typename CharType>
+Entry* DoGetCacheEntry(Entry* cache, const CharType* format)
+{
+    const wxUIntPtr key = wxPtrToUInt(format);
+    Entry& entry = cache[(key ^ (key >> 6)) & (FORMAT_CACHE_SIZE - 1)];
+
+    if ( entry.m_key == format && GetCachedString(entry, format) == format )
+        return &entry;
+
+    if ( !IsCacheableFormat(format) )
+        return nullptr;
+
+    // Replace the previous entry using this slot.
+    entry = Entry();
+    entry.m_key = format;
+    GetCachedString(entry, format) = format;
+
+    return &entry;
+}
+
+} // anonymous namespace
+
+wxFormatString::CacheEntry* wxFormatString::GetCacheEntry() const
+{
+    thread_local CacheEntry s_cache[FORMAT_CACHE_SIZE];
+
+    // Note that m_str and m_cstr are checked first because, unlike m_char and
+    // m_wchar, they are never filled in by InputAsXXX() and so always contain
+    // the string passed to the ctor if they're set.
+    if ( m_str )
+        return DoGetCacheEntry(s_cache, m_str->wx_str());
+    if ( m_cstr )
+        return DoGetCacheEntry(s_cache, m_cstr->AsInternal());
+    if ( m_char )
+        return DoGetCacheEntry(s_cache, m_char.data());
+    if ( m_wchar )
+        return DoGetCacheEntry(s_cache, m_wchar.data());
+
+    return nullptr;
+}
+
 // ----------------------------------------------------------------------------
 // wxFormatString
 // ----------------------------------------------------------------------------
@@ -583,7 +705,25 @@ const char* wxFormatString::InputAsChar()
 const char* wxFormatString::AsChar()
 {
     if ( !m_convertedChar )
-        m_convertedChar = wxPrintfFormatConverterUtf8().Convert(InputAsChar());
+    {
+        // Note that converting the string doesn't use the cache, so the entry
+        // can't be invalidated while we do it.
+        CacheEntry* const entry = GetCacheEntry();
+        if ( !entry )
+        {
+            m_convertedChar = wxPrintfFormatConverterUtf8().Convert(InputAsChar());
+        }
+        else
+        {
+            if ( !entry->m_convertedChar )
+            {
+                entry->m_convertedChar =
+                    wxPrintfFormatConverterUtf8().Convert(InputAsChar());
+            }
+
+            m_convertedChar = entry->m_convertedChar;
+        }
+    }
 
     return m_convertedChar.data();
 }
@@ -625,7 +765,24 @@ const wchar_t* wxFormatString::InputAsWChar()
 const wchar_t* wxFormatString::AsWChar()
 {
     if ( !m_convertedWChar )
-        m_convertedWChar = wxPrintfFormatConverterWchar().Convert(InputAsWChar());
+    {
+        // See the comment in AsChar().
+        CacheEntry* const entry = GetCacheEntry();
+        if ( !entry )
+        {
+            m_convertedWChar = wxPrintfFormatConverterWchar().Convert(InputAsWChar());
+        }
+        else
+        {
+            if ( !entry->m_convertedWChar )
+            {
+                entry->m_convertedWChar =
+                    wxPrintfFormatConverterWchar().Convert(InputAsWChar());
+            }
+
+            m_convertedWChar = entry->m_convertedWChar;
+        }
+    }
 
     return m_convertedWChar.data();
 }
@@ -788,10 +945,68 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
 
 #endif // wxDEBUG_LEVEL
 
+template<typename CharType>
+std::vector<int> DoParseArgumentTypes(const CharType* format)
+{
+    wxPrintfConvSpecParser<CharType> parser(format);
+
+    std::vector<int> argTypes(parser.nargs, wxFormatString::Arg_Unknown);
+    for ( unsigned n = 0; n < parser.nargs; ++n )
+    {
+        const wxPrintfConvSpec<CharType>* const pspec = parser.pspec[n];
+        if ( pspec && pspec->m_type != wxPAT_INVALID )
+            argTypes[n] = ArgTypeFromParamType(pspec->m_type);
+    }
+
+    return argTypes;
+}
+
 } // anonymous namespace
 
+const wxFormatString::CacheEntry* wxFormatString::GetParsedCacheEntry() const
+{
+    const CacheEntry* entry = GetCacheEntry();
+    if ( !entry || entry->m_parsed )
+        return entry;
+
+    // Parsing the format string may result in assert failures, which use
+    // format strings themselves and so can modify the cache, so we need to
+    // look up the entry again after doing it.
+    std::vector<int> argTypes;
+    if ( m_str )
+        argTypes = DoParseArgumentTypes(m_str->wx_str());
+    else if ( m_cstr )
+        argTypes = DoParseArgumentTypes(m_cstr->AsInternal());
+    else if ( m_char )
+        argTypes = DoParseArgumentTypes(m_char.data());
+    else if ( m_wchar )
+        argTypes = DoParseArgumentTypes(m_wchar.data());
+
+    CacheEntry* const entryNew = GetCacheEntry();
+    if ( entryNew )
+    {
+        entryNew->m_argTypes.swap(argTypes);
+        entryNew->m_parsed = true;
+    }
+
+    return entryNew;
+}
+
 wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
 {
+    // Use the cached argument type if we have it, otherwise fall back to
+    // parsing the format string, which also gives an error if the argument
+    // is missing.
+    if ( const CacheEntry* const entry = GetParsedCacheEntry() )
+    {
+        const std::vector<int>& argTypes = entry->m_argTypes;
+        if ( n > argTypes.size() )
+            return Arg_Unused;
+
+        if ( n > 0 && argTypes[n - 1] != Arg_Unknown )
+            return static_cast<ArgumentType>(argTypes[n - 1]);
+    }
+
     if ( m_char )
         return DoGetArgumentType(m_char.data(), n);
     else if ( m_wchar )
@@ -809,6 +1024,29 @@ wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
 
 void wxFormatString::Validate(const std::vector<int>& argTypes) const
 {
+    // Check the argument types against the cached ones first and only parse
+    // the format string again if there is a problem, to report it.
+    if ( const CacheEntry* const entry = GetParsedCacheEntry() )
+    {
+        const std::vector<int>& formatTypes = entry->m_argTypes;
+        if ( formatTypes.size() <= argTypes.size() )
+        {
+            bool ok = true;
+            for ( size_t n = 0; n < formatTypes.size(); ++n )
+            {
+                const int ptype = formatTypes[n];
+                if ( ptype == Arg_Unknown || (ptype & argTypes[n]) != ptype )
+                {
+                    ok = false;
+                    break;
+                }
+            }
+
+            if ( ok )
+                return;
+        }
+    }
+
     if ( m_char )
         DoValidateFormat(m_char.data(), argTypes);
     else if ( m_wchar )
@@ -29,6 +29,10 @@
     #include "wx/arrstr.h"
 #endif
 
+#include "wx/private/safecall.h"
+
+#include <atomic>
+
 // ----------------------------------------------------------------------------
 // private globals
 // ----------------------------------------------------------------------------
@@ -36,6 +40,16 @@
 static wxArrayString gs_optionNames,
                      gs_optionValues;
 
+#if wxUSE_EXCEPTIONS
+// Incremented whenever any option changes, to invalidate the cached values.
+static std::atomic<unsigned> gs_optionsGeneration{0};
+
+// Cached result of wxShouldCatchUnhandledExceptions() in the lowest bit, with
+// the second bit set if it is known, and the value of gs_optionsGeneration
+// when it was computed in the remaining bits.
+static std::atomic<unsigned> gs_catchUnhandledExceptions{0};
+#endif // wxUSE_EXCEPTIONS
+
 // ============================================================================
 // wxSystemOptions implementation
 // ============================================================================
@@ -54,6 +68,11 @@ void wxSystemOptions::SetOption(const wxString& name, const wxString& value)
         gs_optionNames[idx] = name;
         gs_optionValues[idx] = value;
     }
+
+#if wxUSE_EXCEPTIONS
+    // The option affecting the cached value could have changed.
+    ++gs_optionsGeneration;
+#endif // wxUSE_EXCEPTIONS
 }
 
 void wxSystemOptions::SetOption(const wxString& name, int value)
@@ -103,4 +122,32 @@ bool wxSystemOptions::HasOption(const wxString& name)
     return !GetOption(name).empty();
 }
 
+// ----------------------------------------------------------------------------
+// Helper for wxSafeCall()
+// ----------------------------------------------------------------------------
+
+#if wxUSE_EXCEPTIONS && wxUSE_SYSTEM_OPTIONS
+
+bool wxShouldCatchUnhandledExceptions()
+{
+    // Note that the generation must be read before the option value: if the
+    // option is changed after this, the cached value will be recomputed the
+    // next time, even if it's overwritten by the value computed here.
+    const unsigned generation = gs_optionsGeneration << 2;
+
+    unsigned cached = gs_catchUnhandledExceptions;
+    if ( (cached & ~1u) != (generation | 2) )
+    {
+        const bool catchExceptions =
+            !wxSystemOptions::IsFalse("catch-unhandled-exceptions");
+
+        cached = generation | 2 | (catchExceptions ? 1 : 0);
+        gs_catchUnhandledExceptions = cached;
+    }
+
+    return (cached & 1) != 0;
+}
+
+#endif // wxUSE_EXCEPTIONS && wxUSE_SYSTEM_OPTIONS
+
 #endif // wxUSE_SYSTEM_OPTIONS
@@ -0,0 +1,495 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_THREADS
+
+#include "wx/threadpool.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/module.h"
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
+#include "wx/private/safecall.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <vector>
+
+typedef std::function<void ()> wxThreadPoolTask;
+
+namespace
+{
+
+// The pool and the index of the worker thread executing the current thread,
+// if any.
+thread_local wxThreadPoolImpl* wxCurrentThreadPool = nullptr;
+thread_local size_t wxCurrentThreadPoolWorker = 0;
+
+// The global pool returned by wxThreadPool::Get(), created on demand.
+wxThreadPool* gs_defaultPool = nullptr;
+wxCriticalSection gs_defaultPoolCS;
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolWorker: worker thread with its own queue of tasks
+// ----------------------------------------------------------------------------
+
+// Each worker takes the tasks from the back of its own queue, which contains
+// the tasks posted by the tasks executed by this worker itself, as they're
+// the most likely to use the same data, and, when it's empty, steals them from
+// the front of the other workers queues.
+class wxThreadPoolWorker : public wxThread
+{
+public:
+    wxThreadPoolWorker(wxThreadPoolImpl& pool, size_t index)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_pool(pool),
+          m_index(index)
+    {
+    }
+
+    void Push(const wxThreadPoolTask& task)
+    {
+        wxCriticalSectionLocker lock(m_tasksCS);
+        m_tasks.push_back(task);
+    }
+
+    bool PopBack(wxThreadPoolTask& task)
+    {
+        wxCriticalSectionLocker lock(m_tasksCS);
+        if ( m_tasks.empty() )
+            return false;
+
+        task = std::move(m_tasks.back());
+        m_tasks.pop_back();
+        return true;
+    }
+
+    bool StealFront(wxThreadPoolTask& task)
+    {
+        wxCriticalSectionLocker lock(m_tasksCS);
+        if ( m_tasks.empty() )
+            return false;
+
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        return true;
+    }
+
+protected:
+    virtual ExitCode Entry() override;
+
+private:
+    wxThreadPoolImpl& m_pool;
+    const size_t m_index;
+
+    wxCriticalSection m_tasksCS;
+    std::deque<wxThreadPoolTask> m_tasks;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolWorker);
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolImpl: the workers and the state shared by them
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolImpl
+{
+public:
+    explicit wxThreadPoolImpl(int numThreads);
+    ~wxThreadPoolImpl();
+
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+    void Post(const wxThreadPoolTask& task);
+
+    // Wait for a task to become available and return it or return false if
+    // the worker with the given index should exit.
+    bool WaitForTask(size_t index, wxThreadPoolTask& task);
+
+    // Must be called after executing each task.
+    void OnTaskDone();
+
+private:
+    bool TakeTask(size_t index, wxThreadPoolTask& task);
+
+    std::vector<wxThreadPoolWorker*> m_workers;
+
+    // The semaphore is posted once for every queued task, and once for every
+    // worker when stopping. This ensures that, after waiting for it, a worker
+    // either finds a task in some queue or stops.
+    wxSemaphore m_semaphore;
+
+    // Index of the worker to give the next task posted from outside the pool.
+    std::atomic<size_t> m_nextWorker{0};
+
+    // Number of tasks queued or being executed.
+    std::atomic<size_t> m_numTasks{0};
+
+    // Set when all tasks were done and no new ones can be posted any more.
+    std::atomic<bool> m_stopping{false};
+
+    // Used to wait until m_numTasks becomes 0.
+    wxMutex m_idleMutex;
+    wxCondition m_idleCondition{m_idleMutex};
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolImpl);
+};
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+wxThread::ExitCode wxThreadPoolWorker::Entry()
+{
+    wxCurrentThreadPool = &m_pool;
+    wxCurrentThreadPoolWorker = m_index;
+
+    wxThreadPoolTask task;
+    while ( m_pool.WaitForTask(m_index, task) )
+    {
+        wxSafeCall(task);
+
+        // Destroy the task before notifying the pool about it being done, as
+        // the pool may be destroyed as soon as the last task is done.
+        task = wxThreadPoolTask();
+
+        m_pool.OnTaskDone();
+    }
+
+    return nullptr;
+}
+
+wxThreadPoolImpl::wxThreadPoolImpl(int numThreads)
+{
+    if ( numThreads < 0 )
+        numThreads = wxMax(wxThread::GetCPUCount(), 1);
+
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        wxThreadPoolWorker* const
+            worker = new wxThreadPoolWorker(*this, m_workers.size());
+
+        // Add the worker to the vector before running it, as it could start
+        // taking tasks from the other workers immediately.
+        m_workers.push_back(worker);
+
+        if ( worker->Run() != wxTHREAD_NO_ERROR )
+        {
+            wxLogDebug("Failed to start thread pool worker thread.");
+
+            m_workers.pop_back();
+            delete worker;
+            break;
+        }
+    }
+}
+
+wxThreadPoolImpl::~wxThreadPoolImpl()
+{
+    wxASSERT_MSG( wxCurrentThreadPool != this,
+                  "thread pool can't be destroyed from its own thread" );
+
+    // Wait until all tasks, including any tasks posted by the other tasks,
+    // are done.
+    {
+        wxMutexLocker lock(m_idleMutex);
+        while ( m_numTasks )
+            m_idleCondition.Wait();
+    }
+
+    m_stopping = true;
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+        m_semaphore.Post();
+
+    for ( wxThreadPoolWorker* const worker : m_workers )
+    {
+        worker->Wait();
+        delete worker;
+    }
+}
+
+void wxThreadPoolImpl::Post(const wxThreadPoolTask& task)
+{
+    wxCHECK_RET( !m_stopping, "can't post tasks to a thread pool being destroyed" );
+
+    if ( m_workers.empty() )
+    {
+        // We couldn't create any threads, so the best we can do is to execute
+        // the task synchronously.
+        wxSafeCall(task);
+        return;
+    }
+
+    m_numTasks++;
+
+    // The tasks posted by a worker are pushed to its own queue, all the others
+    // are distributed among the workers in turn.
+    const size_t index = wxCurrentThreadPool == this
+                            ? wxCurrentThreadPoolWorker
+                            : m_nextWorker++ % m_workers.size();
+    m_workers[index]->Push(task);
+
+    m_semaphore.Post();
+}
+
+bool wxThreadPoolImpl::TakeTask(size_t index, wxThreadPoolTask& task)
+{
+    if ( m_workers[index]->PopBack(task) )
+        return true;
+
+    for ( size_t n = 1; n < m_workers.size(); n++ )
+    {
+        if ( m_workers[(index + n) % m_workers.size()]->StealFront(task) )
+            return true;
+    }
+
+    return false;
+}
+
+bool wxThreadPoolImpl::WaitForTask(size_t index, wxThreadPoolTask& task)
+{
+    m_semaphore.Wait();
+
+    for ( ;; )
+    {
+        if ( TakeTask(index, task) )
+            return true;
+
+        if ( m_stopping )
+            return false;
+
+        // We can only get here if another worker has taken the task we were
+        // woken up for but not yet the one it was woken up for, which must
+        // still be in some queue, so just try again.
+        wxThread::Yield();
+    }
+}
+
+void wxThreadPoolImpl::OnTaskDone()
+{
+    if ( --m_numTasks == 0 )
+    {
+        wxMutexLocker lock(m_idleMutex);
+        m_idleCondition.Broadcast();
+    }
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPool
+// ----------------------------------------------------------------------------
+
+wxThreadPool::wxThreadPool(int numThreads)
+    : m_impl(new wxThreadPoolImpl(numThreads))
+{
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    delete m_impl;
+}
+
+/* static */
+wxThreadPool& wxThreadPool::Get()
+{
+    wxCriticalSectionLocker lock(gs_defaultPoolCS);
+
+    if ( !gs_defaultPool )
+        gs_defaultPool = new wxThreadPool();
+
+    return *gs_defaultPool;
+}
+
+int wxThreadPool::GetThreadCount() const
+{
+    return static_cast<int>(m_impl->GetThreadCount());
+}
+
+bool wxThreadPool::IsWorkerThread() const
+{
+    return wxCurrentThreadPool == m_impl;
+}
+
+void wxThreadPool::Post(const std::function<void ()>& task)
+{
+    m_impl->Post(task);
+}
+
+namespace
+{
+
+// State of ParallelFor() shared between the calling thread and the tasks
+// executing the function in the worker threads.
+//
+// Notice that the tasks can start running after ParallelFor() has already
+// returned, so this object must be kept alive by them, but they don't access
+// the function, which may not exist any longer by then, in this case.
+class wxParallelForState
+{
+public:
+    wxParallelForState(size_t from, size_t to, size_t chunkSize,
+                       const std::function<void (size_t)>& func,
+                       const wxCancellationToken* cancel)
+        : m_next(from),
+          m_remaining(to - from),
+          m_to(to),
+          m_chunkSize(chunkSize),
+          m_func(func),
+          m_cancel(cancel)
+    {
+    }
+
+    // Execute the function for the chunks of indices not taken by any other
+    // thread yet.
+    void Run()
+    {
+        for ( ;; )
+        {
+            const size_t from = m_next.fetch_add(m_chunkSize);
+            if ( from >= m_to )
+                break;
+
+            const size_t to = wxMin(from + m_chunkSize, m_to);
+            for ( size_t n = from; n < to; n++ )
+            {
+                if ( m_failed || (m_cancel && m_cancel->IsCancelled()) )
+                    break;
+
+#if wxUSE_EXCEPTIONS
+                try
+#endif // wxUSE_EXCEPTIONS
+                {
+                    m_func(n);
+                }
+#if wxUSE_EXCEPTIONS
+                catch ( ... )
+                {
+                    wxMutexLocker lock(m_mutex);
+                    if ( !m_exception )
+                        m_exception = std::current_exception();
+                    m_failed = true;
+                }
+#endif // wxUSE_EXCEPTIONS
+            }
+
+            if ( m_remaining.fetch_sub(to - from) == to - from )
+            {
+                wxMutexLocker lock(m_mutex);
+                m_doneCondition.Broadcast();
+            }
+        }
+    }
+
+    // Wait until the function was called for all indices.
+    void Wait()
+    {
+        wxMutexLocker lock(m_mutex);
+        while ( m_remaining )
+            m_doneCondition.Wait();
+
+#if wxUSE_EXCEPTIONS
+        if ( m_exception )
+            std::rethrow_exception(m_exception);
+#endif // wxUSE_EXCEPTIONS
+    }
+
+private:
+    std::atomic<size_t> m_next;
+    std::atomic<size_t> m_remaining;
+    std::atomic<bool> m_failed{false};
+
+    const size_t m_to;
+    const size_t m_chunkSize;
+    const std::function<void (size_t)>& m_func;
+    const wxCancellationToken* const m_cancel;
+
+    wxMutex m_mutex;
+    wxCondition m_doneCondition{m_mutex};
+
+#if wxUSE_EXCEPTIONS
+    std::exception_ptr m_exception;
+#endif // wxUSE_EXCEPTIONS
+
+    wxDECLARE_NO_COPY_CLASS(wxParallelForState);
+};
+
+} // anonymous namespace
+
+void wxThreadPool::DoParallelFor(size_t from, size_t to,
+                                 const std::function<void (size_t)>& func,
+                                 const wxCancellationToken* cancel)
+{
+    if ( from >= to )
+        return;
+
+    // Use several chunks per thread to balance the load if calling the
+    // function takes different time for different indices.
+    const size_t numThreads = m_impl->GetThreadCount() + 1;
+    const size_t chunkSize = wxMax((to - from) / (4*numThreads), 1);
+    const size_t numChunks = (to - from + chunkSize - 1) / chunkSize;
+
+    const auto state = std::make_shared<wxParallelForState>(from, to, chunkSize,
+                                                            func, cancel);
+
+    // Calling thread takes part in the execution too, so it's never blocked
+    // waiting for the workers to start, even if they're all busy (e.g. when
+    // called from a worker thread itself).
+    const size_t numHelpers = wxMin(numThreads - 1, numChunks - 1);
+    for ( size_t n = 0; n < numHelpers; n++ )
+        Post([state]() { state->Run(); });
+
+    state->Run();
+    state->Wait();
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolModule: destroys the global pool
+// ----------------------------------------------------------------------------
+
+// The worker threads of the global pool are joinable threads waiting for the
+// tasks without checking for TestDestroy(), so they must be stopped and
+// joined by the pool destructor before wxThreadModule tries to delete them.
+class wxThreadPoolModule : public wxModule
+{
+public:
+    wxThreadPoolModule()
+    {
+        AddDependency("wxThreadModule");
+    }
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override
+    {
+        wxCriticalSectionLocker lock(gs_defaultPoolCS);
+
+        wxDELETE(gs_defaultPool);
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+#endif // wxUSE_THREADS
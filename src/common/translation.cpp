@@ -43,6 +43,7 @@
 #include "wx/tokenzr.h"
 #include "wx/fontmap.h"
 #include "wx/stdpaths.h"
+#include "wx/thread.h"
 #include "wx/version.h"
 #include "wx/uilocale.h"
 
@@ -51,10 +52,18 @@
     #include "wx/scopedarray.h"
     #include "wx/msw/wrapwin.h"
     #include "wx/msw/missing.h"
+#elif defined(__UNIX__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
 #endif
 
+#include <atomic>
 #include <memory>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // simple types
@@ -791,6 +800,173 @@ wxPluralFormsCalculator* wxPluralFormsCalculator::make(const char* s)
 
 
 
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// wxMsgCatalogMapping: read-only mapping of a message catalog file in memory
+// ----------------------------------------------------------------------------
+
+#if defined(__UNIX__) || defined(__WINDOWS__)
+
+#define wxHAS_MSGCATALOG_MAPPING
+
+class wxMsgCatalogMapping
+{
+public:
+    wxMsgCatalogMapping() = default;
+    ~wxMsgCatalogMapping();
+
+    // map the given file into memory, return false without logging any
+    // errors if this failed
+    bool Map(const wxString& filename);
+
+    const char* GetData() const { return m_data; }
+    size_t GetLength() const { return m_length; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_length = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxMsgCatalogMapping);
+};
+
+#ifdef __WINDOWS__
+
+bool wxMsgCatalogMapping::Map(const wxString& filename)
+{
+    const HANDLE hFile = ::CreateFile(filename.t_str(),
+                                      GENERIC_READ,
+                                      FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                      nullptr,
+                                      OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL,
+                                      nullptr);
+    if ( hFile == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size;
+    HANDLE hMapping = nullptr;
+    if ( ::GetFileSizeEx(hFile, &size) && size.QuadPart > 0 &&
+            static_cast<wxULongLong_t>(size.QuadPart) <= SIZE_MAX )
+    {
+        hMapping = ::CreateFileMapping(hFile, nullptr, PAGE_READONLY,
+                                       0, 0, nullptr);
+    }
+
+    ::CloseHandle(hFile);
+
+    if ( !hMapping )
+        return false;
+
+    // The view keeps the mapping alive, so we don't need its handle any more.
+    const void* const data = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(hMapping);
+
+    if ( !data )
+        return false;
+
+    m_data = static_cast<const char*>(data);
+    m_length = static_cast<size_t>(size.QuadPart);
+
+    return true;
+}
+
+wxMsgCatalogMapping::~wxMsgCatalogMapping()
+{
+    if ( m_data )
+        ::UnmapViewOfFile(m_data);
+}
+
+#else // __UNIX__
+
+bool wxMsgCatalogMapping::Map(const wxString& filename)
+{
+    const int fd = open(filename.fn_str(), O_RDONLY);
+    if ( fd == -1 )
+        return false;
+
+    void* data = MAP_FAILED;
+
+    struct stat st;
+    if ( fstat(fd, &st) == 0 && st.st_size > 0 &&
+            static_cast<wxULongLong_t>(st.st_size) <= SIZE_MAX )
+    {
+        data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    // The mapping remains valid after closing the file.
+    close(fd);
+
+    if ( data == MAP_FAILED )
+        return false;
+
+    m_data = static_cast<const char*>(data);
+    m_length = static_cast<size_t>(st.st_size);
+
+    return true;
+}
+
+wxMsgCatalogMapping::~wxMsgCatalogMapping()
+{
+    if ( m_data )
+        munmap(const_cast<char*>(m_data), m_length);
+}
+
+#endif // __WINDOWS__/__UNIX__
+
+#endif // __UNIX__ || __WINDOWS__
+
+// the hash function used by GNU gettext for the hash table in .mo files
+size_t32 wxMsgCatalogHashString(const char* str, size_t len)
+{
+    size_t32 hval = 0;
+    for ( size_t n = 0; n < len; n++ )
+    {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(str[n]);
+
+        const size_t32 g = hval & (size_t32(0xf) << 28);
+        if ( g )
+        {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+
+    return hval;
+}
+
+// copy the string to the buffer of the given size, starting at the given
+// position, if it contains only ASCII characters and fits into it, return
+// false otherwise
+bool wxMsgCatalogCopyASCII(char* buf, size_t size, size_t& len,
+                           const wxString& str)
+{
+    // notice that in UTF-8 build the string contains at least as many bytes
+    // as characters and the first length() of them are all ASCII only if the
+    // string is, so this works for both builds
+    const size_t strLen = str.length();
+    if ( strLen > size - len )
+        return false;
+
+    const wxStringCharType* const p = str.wx_str();
+    for ( size_t n = 0; n < strLen; n++ )
+    {
+        const wxStringCharType ch = p[n];
+        if ( static_cast<unsigned>(ch) >= 0x80 )
+            return false;
+
+        buf[len + n] = static_cast<char>(ch);
+    }
+
+    len += strLen;
+
+    return true;
+}
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 // wxMsgCatalogFile corresponds to one disk-file message catalog.
 //
@@ -815,12 +991,13 @@ public:
     bool LoadData(const DataBuffer& data,
                   wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
 
-    // fills the hash with string-translation pairs
-    bool FillHash(wxTranslationsHashMap& hash, const wxString& domain) const;
-
-    // return the charset of the strings in this catalog or empty string if
-    // none/unknown
-    wxString GetCharset() const { return m_charset; }
+    // get the translated string in the given plural form: returns nullptr if
+    // not found; if hash is non-null, it's the hash of the key which is used
+    // if the key contains only ASCII characters
+    const wxString *GetString(const wxString& str,
+                              unsigned form,
+                              const wxString& context,
+                              const size_t32* hash = nullptr) const;
 
 private:
     // this implementation is binary compatible with GNU gettext() version 0.10
@@ -844,17 +1021,42 @@ private:
                   ofsHashTable;   //        +18:  offset of hash table start
     };
 
-    // all data is stored here
+    // all plural forms of a translation, converted to wxString when it is
+    // used for the first time
+    typedef std::vector<wxString> Translations;
+
+    // all data is stored here, it's either owned by the buffer or, if the
+    // catalog file was mapped into memory, by m_mapping
     DataBuffer m_data;
 
+#ifdef wxHAS_MSGCATALOG_MAPPING
+    wxMsgCatalogMapping m_mapping;
+#endif // wxHAS_MSGCATALOG_MAPPING
+
     // data description
     size_t32          m_numStrings;   // number of strings in this domain
     const
     wxMsgTableEntry  *m_pOrigTable,   // pointer to original   strings
                      *m_pTransTable;  //            translated
 
+    size_t32          m_nHashSize;    // hash table size or 0 if none
+    const size_t32   *m_pHashTable;   // the hash table itself
+
+    // true if the original strings are sorted, as they should be, which
+    // allows to use binary search if there is no hash table
+    bool              m_isSorted;
+
     wxString m_charset;               // from the message catalog header
 
+    // conversion to use to convert catalog strings to the GUI encoding,
+    // pointing either to m_convCharset or a global conversion object
+    const wxMBConv *m_conv;
+    std::unique_ptr<wxMBConv> m_convCharset;
+    bool m_isUTF8;
+
+    // converted translations indexed by the string index
+    std::unique_ptr<std::atomic<Translations*>[]> m_translations;
+
 
     // swap the 2 halves of 32 bit integer if needed
     size_t32 Swap(size_t32 ui) const
@@ -870,7 +1072,7 @@ private:
 
         // this check could fail for a corrupt message catalog
         size_t32 ofsString = Swap(ent->ofsString);
-        if ( ofsString + Swap(ent->nLen) > m_data.length())
+        if ( static_cast<wxULongLong_t>(ofsString) + Swap(ent->nLen) > m_data.length() )
         {
             return nullptr;
         }
@@ -878,6 +1080,33 @@ private:
         return m_data.data() + ofsString;
     }
 
+    // check that the table with m_numStrings entries of the given size at the
+    // given offset fits into the data
+    bool IsValidTable(size_t32 ofs, size_t32 count, size_t entrySize) const
+    {
+        return ofs + static_cast<wxULongLong_t>(count)*entrySize <= m_data.length();
+    }
+
+    // compare the original string with the given index with the key in the
+    // catalog encoding, returning negative, 0 or positive value like strcmp()
+    int CompareOrigString(size_t32 n, const char* key, size_t len) const;
+
+    // return true if the original string with the given index is the key
+    bool IsOrigString(size_t32 n, const char* key, size_t len) const;
+
+    // return the index of the string with the given key, whose hash may be
+    // provided if already known, or m_numStrings
+    size_t32 FindString(const char* key,
+                        size_t len,
+                        const size_t32* hash = nullptr) const;
+
+    // append the string converted to the catalog encoding to the key, return
+    // false if it can't be represented in this encoding
+    bool AppendToKey(std::string& key, const wxString& str) const;
+
+    // return the translations of the string with the given index
+    const Translations& GetTranslations(size_t32 n) const;
+
     bool m_bSwapped;   // wrong endianness?
 
     wxDECLARE_NO_COPY_CLASS(wxMsgCatalogFile);
@@ -889,42 +1118,64 @@ private:
 
 wxMsgCatalogFile::wxMsgCatalogFile()
 {
+    m_numStrings = 0;
+    m_nHashSize = 0;
+    m_pHashTable = nullptr;
+    m_isSorted = false;
+    m_conv = nullptr;
+    m_isUTF8 = false;
 }
 
 wxMsgCatalogFile::~wxMsgCatalogFile()
 {
+    if ( m_translations )
+    {
+        for ( size_t32 n = 0; n < m_numStrings; n++ )
+            delete m_translations[n].load(std::memory_order_relaxed);
+    }
 }
 
-// open disk file and read in its contents
+// open disk file and map or read its contents
 bool wxMsgCatalogFile::LoadFile(const wxString& filename,
                                 wxPluralFormsCalculatorPtr& rPluralFormsCalculator)
 {
-    wxFile fileMsg(filename);
-    if ( !fileMsg.IsOpened() )
-        return false;
+    DataBuffer data;
 
-    // get the file size (assume it is less than 4GB...)
-    wxFileOffset lenFile = fileMsg.Length();
-    if ( lenFile == wxInvalidOffset )
-        return false;
+#ifdef wxHAS_MSGCATALOG_MAPPING
+    // mapping the file avoids copying the data and only the parts of it
+    // really used will be read from disk
+    if ( m_mapping.Map(filename) )
+    {
+        data = DataBuffer::CreateNonOwned(m_mapping.GetData(),
+                                          m_mapping.GetLength());
+    }
+    else // fall back to reading the file in memory
+#endif // wxHAS_MSGCATALOG_MAPPING
+    {
+        wxFile fileMsg(filename);
+        if ( !fileMsg.IsOpened() )
+            return false;
 
-    size_t nSize = wx_truncate_cast(size_t, lenFile);
-    wxASSERT_MSG( nSize == lenFile + size_t(0), wxS("message catalog bigger than 4GB?") );
+        // get the file size (assume it is less than 4GB...)
+        wxFileOffset lenFile = fileMsg.Length();
+        if ( lenFile == wxInvalidOffset )
+            return false;
 
-    wxMemoryBuffer filedata;
+        size_t nSize = wx_truncate_cast(size_t, lenFile);
+        wxASSERT_MSG( nSize == lenFile + size_t(0), wxS("message catalog bigger than 4GB?") );
 
-    // read the whole file in memory
-    if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
-        return false;
+        wxMemoryBuffer filedata;
 
-    filedata.UngetWriteBuf(nSize);
+        // read the whole file in memory
+        if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
+            return false;
+
+        filedata.UngetWriteBuf(nSize);
+
+        data = DataBuffer::CreateOwned((char*)filedata.release(), nSize);
+    }
 
-    bool ok = LoadData
-              (
-                  DataBuffer::CreateOwned((char*)filedata.release(), nSize),
-                  rPluralFormsCalculator
-              );
-    if ( !ok )
+    if ( !LoadData(data, rPluralFormsCalculator) )
     {
         wxLogWarning(_("'%s' is not a valid message catalog."), filename);
         return false;
@@ -949,20 +1200,61 @@ bool wxMsgCatalogFile::LoadData(const DataBuffer& data,
         bValid = m_bSwapped || pHeader->magic == MSGCATALOG_MAGIC;
     }
 
+    if ( bValid ) {
+        m_data = data;
+
+        // check that the string tables are inside the data and that all
+        // strings are too, so that we don't need to check it later
+        m_numStrings = Swap(pHeader->numStrings);
+
+        const size_t32 ofsOrigTable = Swap(pHeader->ofsOrigTable),
+                       ofsTransTable = Swap(pHeader->ofsTransTable);
+
+        bValid = IsValidTable(ofsOrigTable, m_numStrings, sizeof(wxMsgTableEntry)) &&
+                 IsValidTable(ofsTransTable, m_numStrings, sizeof(wxMsgTableEntry));
+        if ( bValid ) {
+            m_pOrigTable  = reinterpret_cast<const wxMsgTableEntry*>(data.data() +
+                            ofsOrigTable);
+            m_pTransTable = reinterpret_cast<const wxMsgTableEntry*>(data.data() +
+                            ofsTransTable);
+
+            for ( size_t32 i = 0; i < m_numStrings && bValid; i++ ) {
+                bValid = StringAtOfs(m_pOrigTable, i) != nullptr &&
+                         StringAtOfs(m_pTransTable, i) != nullptr;
+            }
+        }
+    }
+
     if ( !bValid ) {
-        // it's either too short or has incorrect magic number
+        // it's either too short or has incorrect magic number or is corrupt
         wxLogWarning(_("Invalid message catalog."));
         return false;
     }
 
-    m_data = data;
+    // use the hash table if there is one, otherwise we can still use binary
+    // search if the original strings are sorted, as they normally are, but
+    // check it as nothing guarantees it for catalogs not created by msgfmt
+    const size_t32 nHashSize = Swap(pHeader->nHashSize),
+                   ofsHashTable = Swap(pHeader->ofsHashTable);
+    if ( nHashSize > 2 && IsValidTable(ofsHashTable, nHashSize, sizeof(size_t32)) )
+    {
+        m_nHashSize = nHashSize;
+        m_pHashTable = reinterpret_cast<const size_t32*>(data.data() +
+                       ofsHashTable);
+    }
+    else
+    {
+        m_isSorted = true;
+        for ( size_t32 i = 1; i < m_numStrings && m_isSorted; i++ )
+        {
+            const char* const prev = StringAtOfs(m_pOrigTable, i - 1);
+            const size_t prevLen = wxStrnlen(prev, Swap(m_pOrigTable[i - 1].nLen));
 
-    // initialize
-    m_numStrings  = Swap(pHeader->numStrings);
-    m_pOrigTable  = reinterpret_cast<const wxMsgTableEntry*>(data.data() +
-                    Swap(pHeader->ofsOrigTable));
-    m_pTransTable = reinterpret_cast<const wxMsgTableEntry*>(data.data() +
-                    Swap(pHeader->ofsTransTable));
+            m_isSorted = CompareOrigString(i, prev, prevLen) > 0;
+        }
+    }
+
+    m_translations.reset(new std::atomic<Translations*>[m_numStrings]());
 
     // now parse catalog's header and try to extract catalog charset and
     // plural forms formula from it:
@@ -1020,73 +1312,225 @@ bool wxMsgCatalogFile::LoadData(const DataBuffer& data,
             rPluralFormsCalculator.reset(wxPluralFormsCalculator::make());
     }
 
+    if ( m_charset.empty() )
+    {
+        // we must somehow convert the narrow strings in the message catalog to
+        // wide strings, so use the default conversion if we have no charset
+        m_conv = wxConvCurrent;
+    }
+    else if ( m_charset.IsSameAs(wxS("UTF-8"), false) ||
+                m_charset.IsSameAs(wxS("UTF8"), false) )
+    {
+        // this is by far the most common case, so handle it specially
+        m_conv = &wxConvUTF8;
+        m_isUTF8 = true;
+    }
+    else
+    {
+        m_convCharset.reset(new wxCSConv(m_charset));
+        m_conv = m_convCharset.get();
+    }
+
     // everything is fine
     return true;
 }
 
-bool wxMsgCatalogFile::FillHash(wxTranslationsHashMap& hash,
-                                const wxString& domain) const
+int wxMsgCatalogFile::CompareOrigString(size_t32 n,
+                                        const char* key,
+                                        size_t len) const
 {
-    wxUnusedVar(domain); // silence warning in Unicode build
+    // the original string of the plural entries contains both the singular
+    // and plural forms separated by NUL, but only the former is the key
+    const char* const str = StringAtOfs(m_pOrigTable, n);
+    const size_t strLen = wxStrnlen(str, Swap(m_pOrigTable[n].nLen));
 
-    // conversion to use to convert catalog strings to the GUI encoding
-    wxMBConv *inputConv = nullptr;
+    const int rc = memcmp(str, key, wxMin(strLen, len));
+    if ( rc )
+        return rc;
 
-    std::unique_ptr<wxMBConv> inputConvPtr; // just to delete inputConv if needed
+    return strLen < len ? -1 : strLen > len ? 1 : 0;
+}
+
+bool wxMsgCatalogFile::IsOrigString(size_t32 n,
+                                    const char* key,
+                                    size_t len) const
+{
+    // this is equivalent to CompareOrigString() == 0, but faster as it
+    // doesn't need to find the length of the string: it's either the same as
+    // the key length or, for the plural entries, the string has NUL after it
+    const size_t strLen = Swap(m_pOrigTable[n].nLen);
+    if ( strLen < len )
+        return false;
+
+    const char* const str = StringAtOfs(m_pOrigTable, n);
+    if ( strLen > len && str[len] != '\0' )
+        return false;
+
+    return memcmp(str, key, len) == 0;
+}
 
-    if ( !m_charset.empty() )
+size_t32 wxMsgCatalogFile::FindString(const char* key,
+                                      size_t len,
+                                      const size_t32* hash) const
+{
+    if ( m_pHashTable )
     {
-        inputConv = new wxCSConv(m_charset);
+        // this is the same algorithm as used by GNU gettext itself
+        const size_t32 hval = hash ? *hash : wxMsgCatalogHashString(key, len);
+        const size_t32 incr = 1 + hval % (m_nHashSize - 2);
+
+        size_t32 idx = hval % m_nHashSize;
+        for ( size_t32 tries = 0; tries < m_nHashSize; tries++ )
+        {
+            const size_t32 nstr = Swap(m_pHashTable[idx]);
+            if ( !nstr )
+                break;
 
-        // As we allocated it ourselves, we need to delete it, so ensure
-        // this happens.
-        inputConvPtr.reset(inputConv);
+            if ( nstr <= m_numStrings && IsOrigString(nstr - 1, key, len) )
+                return nstr - 1;
+
+            if ( idx >= m_nHashSize - incr )
+                idx -= m_nHashSize - incr;
+            else
+                idx += incr;
+        }
     }
-    else // no need to convert the encoding
+    else if ( m_isSorted ) // no hash table, use binary search
     {
-        // we must somehow convert the narrow strings in the message catalog to
-        // wide strings, so use the default conversion if we have no charset
-        inputConv = wxConvCurrent;
+        size_t32 lo = 0,
+                 hi = m_numStrings;
+        while ( lo < hi )
+        {
+            const size_t32 mid = lo + (hi - lo) / 2;
+            const int rc = CompareOrigString(mid, key, len);
+            if ( rc == 0 )
+                return mid;
+
+            if ( rc < 0 )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+    }
+    else // neither hash table nor sorted strings, fall back to linear search
+    {
+        for ( size_t32 n = 0; n < m_numStrings; n++ )
+        {
+            if ( IsOrigString(n, key, len) )
+                return n;
+        }
     }
 
-    for (size_t32 i = 0; i < m_numStrings; i++)
+    return m_numStrings;
+}
+
+bool wxMsgCatalogFile::AppendToKey(std::string& key, const wxString& str) const
+{
+    const wxScopedCharBuffer buf(m_isUTF8 ? str.utf8_str() : str.mb_str(*m_conv));
+    if ( !buf.length() && !str.empty() )
+        return false;
+
+    key.append(buf.data(), buf.length());
+
+    return true;
+}
+
+const wxMsgCatalogFile::Translations&
+wxMsgCatalogFile::GetTranslations(size_t32 n) const
+{
+    Translations* translations = m_translations[n].load(std::memory_order_acquire);
+    if ( translations )
+        return *translations;
+
+    std::unique_ptr<Translations> translationsNew(new Translations);
+
+    const char * const data = StringAtOfs(m_pTransTable, n);
+    const size_t length = Swap(m_pTransTable[n].nLen);
+    size_t offset = 0;
+    while (offset < length)
     {
-        const char *data = StringAtOfs(m_pOrigTable, i);
-        if (!data)
-            return false; // may happen for invalid MO files
+        const char * const str = data + offset;
 
-        wxString msgid;
-        msgid = wxString(data, *inputConv);
-        data = StringAtOfs(m_pTransTable, i);
-        if (!data)
-            return false; // may happen for invalid MO files
+        // IMPORTANT: accesses to the 'data' pointer are valid only for the
+        //            first 'length' bytes, as the final NUL may be missing in
+        //            invalid MO files, so use wxStrnlen() to not access memory
+        //            beyond the valid range
+        const size_t len = wxStrnlen(str, length - offset);
 
-        size_t length = Swap(m_pTransTable[i].nLen);
-        size_t offset = 0;
-        size_t index = 0;
-        while (offset < length)
-        {
-            const char * const str = data + offset;
+        if ( m_isUTF8 )
+            translationsNew->push_back(wxString::FromUTF8(str, len));
+        else
+            translationsNew->push_back(wxString(str, *m_conv, len));
 
-            wxString msgstr;
-            msgstr = wxString(str, *inputConv);
-            if ( !msgstr.empty() )
-            {
-                hash[index == 0 ? msgid : msgid + wxChar(index)] = msgstr;
-            }
+        // skip this string and the NUL after it
+        offset += len + 1;
+    }
+
+    // another thread could have converted the same translation in the
+    // meanwhile, in which case just use its result
+    if ( m_translations[n].compare_exchange_strong(translations,
+                                                   translationsNew.get(),
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire) )
+    {
+        translations = translationsNew.release();
+    }
 
-            // skip this string
-            // IMPORTANT: accesses to the 'data' pointer are valid only for
-            //            the first 'length+1' bytes (GNU specs says that the
-            //            final NUL is not counted in length); using wxStrnlen()
-            //            we make sure we don't access memory beyond the valid range
-            //            (which otherwise may happen for invalid MO files):
-            offset += wxStrnlen(str, length - offset) + 1;
-            ++index;
+    return *translations;
+}
+
+const wxString *wxMsgCatalogFile::GetString(const wxString& str,
+                                            unsigned form,
+                                            const wxString& context,
+                                            const size_t32* hash) const
+{
+    // the key is the string itself or the context and the string separated
+    // by EOT character, as in gettext, in the catalog encoding
+    //
+    // most keys are short ASCII strings which can be used directly without
+    // any conversions or memory allocations
+    char buf[256];
+    size_t len = 0;
+    bool isASCII = true;
+    if ( !context.empty() )
+    {
+        isASCII = wxMsgCatalogCopyASCII(buf, WXSIZEOF(buf) - 1, len, context);
+        if ( isASCII )
+            buf[len++] = '\x04';
+    }
+
+    isASCII = isASCII && wxMsgCatalogCopyASCII(buf, WXSIZEOF(buf), len, str);
+
+    size_t32 n;
+    if ( isASCII )
+    {
+        n = FindString(buf, len, hash);
+    }
+    else
+    {
+        std::string key;
+        if ( !context.empty() )
+        {
+            if ( !AppendToKey(key, context) )
+                return nullptr;
+
+            key += '\x04';
         }
+
+        if ( !AppendToKey(key, str) )
+            return nullptr;
+
+        n = FindString(key.data(), key.length());
     }
 
-    return true;
+    if ( n == m_numStrings )
+        return nullptr;
+
+    const Translations& translations = GetTranslations(n);
+    if ( form >= translations.size() || translations[form].empty() )
+        return nullptr;
+
+    return &translations[form];
 }
 
 
@@ -1107,12 +1551,9 @@ wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
 {
     std::unique_ptr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    cat->m_file.reset(new wxMsgCatalogFile);
 
-    if ( !file.LoadFile(filename, cat->m_pluralFormsCalculator) )
-        return nullptr;
-
-    if ( !file.FillHash(cat->m_messages, domain) )
+    if ( !cat->m_file->LoadFile(filename, cat->m_pluralFormsCalculator) )
         return nullptr;
 
     return cat.release();
@@ -1122,14 +1563,34 @@ wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
 wxMsgCatalog *wxMsgCatalog::CreateFromData(const wxScopedCharBuffer& data,
                                            const wxString& domain)
 {
-    std::unique_ptr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
+    // the catalog uses the data directly, so make a copy of it if it's a
+    // non-owned buffer which could become invalid while the catalog exists
+    // (owned data is just shared, without copying it)
+    return DoCreateFromData(wxCharBuffer(data), domain);
+}
 
-    wxMsgCatalogFile file;
+/* static */
+wxMsgCatalog *wxMsgCatalog::CreateFromData(const void* data,
+                                           size_t size,
+                                           const wxString& domain)
+{
+    return DoCreateFromData
+           (
+                wxScopedCharBuffer::CreateNonOwned(static_cast<const char*>(data),
+                                                   size),
+                domain
+           );
+}
 
-    if ( !file.LoadData(data, cat->m_pluralFormsCalculator) )
-        return nullptr;
+/* static */
+wxMsgCatalog *wxMsgCatalog::DoCreateFromData(const wxScopedCharBuffer& data,
+                                             const wxString& domain)
+{
+    std::unique_ptr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+    cat->m_file.reset(new wxMsgCatalogFile);
+
+    if ( !cat->m_file->LoadData(data, cat->m_pluralFormsCalculator) )
         return nullptr;
 
     return cat.release();
@@ -1142,30 +1603,16 @@ const wxString *wxMsgCatalog::GetString(const wxString& str, unsigned n, const w
     {
         index = m_pluralFormsCalculator->evaluate(n);
     }
-    wxTranslationsHashMap::const_iterator i;
-    if (index != 0)
-    {
-        if (context.IsEmpty())
-            i = m_messages.find(wxString(str) + wxChar(index));   // plural, no context
-        else
-            i = m_messages.find(wxString(context) + wxString('\x04') + wxString(str) + wxChar(index));   // plural, context
-    }
-    else
-    {
-        if (context.IsEmpty())
-            i = m_messages.find(str); // no context
-        else
-            i = m_messages.find(wxString(context) + wxString('\x04') + wxString(str)); // context
-    }
 
-    if ( i != m_messages.end() )
-    {
-        return &i->second;
-    }
-    else
-        return nullptr;
+    return m_file->GetString(str, index > 0 ? index : 0, context);
 }
 
+const wxString *wxMsgCatalog::GetStringWithHash(const wxString& str,
+                                                const wxString& context,
+                                                wxUint32 hash) const
+{
+    return m_file->GetString(str, 0, context, &hash);
+}
 
 // ----------------------------------------------------------------------------
 // wxTranslations
@@ -1179,6 +1626,10 @@ bool gs_translationsOwned = false;
 
 } // anonymous namespace
 
+// start with 1 to ensure that it's never equal to the initial generation of
+// wxCachedTranslation
+std::atomic<unsigned> wxTranslations::ms_generation{1};
+
 
 /*static*/
 wxTranslations *wxTranslations::Get()
@@ -1193,6 +1644,7 @@ void wxTranslations::Set(wxTranslations *t)
         delete gs_translations;
     gs_translations = t;
     gs_translationsOwned = true;
+    IncGeneration();
 }
 
 /*static*/
@@ -1202,6 +1654,7 @@ void wxTranslations::SetNonOwned(wxTranslations *t)
         delete gs_translations;
     gs_translations = t;
     gs_translationsOwned = false;
+    IncGeneration();
 }
 
 
@@ -1224,6 +1677,9 @@ wxTranslations::~wxTranslations()
         m_pMsgCat = m_pMsgCat->m_pNext;
         delete pTmpCat;
     }
+
+    // any cached translations could refer to the catalogs we just deleted
+    IncGeneration();
 }
 
 
@@ -1247,6 +1703,8 @@ void wxTranslations::SetLanguage(wxLanguage lang)
 void wxTranslations::SetLanguage(const wxString& lang)
 {
     m_lang = lang;
+
+    IncGeneration();
 }
 
 
@@ -1357,6 +1815,8 @@ bool wxTranslations::LoadCatalog(const wxString& domain, const wxString& lang)
         m_pMsgCat = cat;
         m_catalogMap[domain] = cat;
 
+        IncGeneration();
+
         return true;
     }
     else
@@ -1514,6 +1974,25 @@ const wxString *wxTranslations::GetTranslatedString(const wxString& origString,
     return trans;
 }
 
+const wxString *wxTranslations::GetCachedTranslation(const wxString& origString,
+                                                     const wxString& context,
+                                                     wxUint32 hash) const
+{
+    if ( origString.empty() )
+        return nullptr;
+
+    for ( wxMsgCatalog* pMsgCat = m_pMsgCat; pMsgCat; pMsgCat = pMsgCat->m_pNext )
+    {
+        const wxString* const trans = pMsgCat->GetStringWithHash(origString,
+                                                                 context,
+                                                                 hash);
+        if ( trans )
+            return trans;
+    }
+
+    return nullptr;
+}
+
 wxString wxTranslations::GetHeaderValue(const wxString& header,
                                         const wxString& domain) const
 {
@@ -1571,6 +2050,37 @@ wxMsgCatalog *wxTranslations::FindCatalog(const wxString& domain) const
     return found == m_catalogMap.end() ? nullptr : found->second;
 }
 
+// ----------------------------------------------------------------------------
+// wxCachedTranslation
+// ----------------------------------------------------------------------------
+
+const wxString& wxCachedTranslation::Update()
+{
+    // serialize the updates and get the generation after locking, so that
+    // the generations stored by them never decrease: otherwise a thread
+    // updating the cache for an older generation could overwrite the
+    // translation after another thread stored the newer generation, and Get()
+    // would return the stale translation even though the generation matches
+    wxCRITICAL_SECTION(cachedTranslationUpdate);
+
+    // get the generation before looking up the translation, so that if it
+    // changes while we do it, the translation will be just looked up again
+    const unsigned generation = wxTranslations::GetGeneration();
+
+    const wxTranslations* const trans = wxTranslations::Get();
+    const wxString* str = trans ? trans->GetCachedTranslation(m_msg,
+                                                              m_context,
+                                                              m_hash)
+                                : nullptr;
+    if ( !str )
+        str = &m_msg;
+
+    m_translation.store(str, std::memory_order_release);
+    m_generation.store(generation, std::memory_order_release);
+
+    return *str;
+}
+
 // ----------------------------------------------------------------------------
 // wxFileTranslationsLoader
 // ----------------------------------------------------------------------------
@@ -1807,9 +2317,9 @@ wxMsgCatalog *wxResourceTranslationsLoader::LoadCatalog(const wxString& domain,
     wxLogTrace(TRACE_I18N,
                "Using catalog from Windows resource \"%s\".", resname);
 
-    wxMsgCatalog *cat = wxMsgCatalog::CreateFromData(
-        wxCharBuffer::CreateNonOwned(static_cast<const char*>(mo_data), mo_size),
-        domain);
+    // the resource data remains valid as long as the module is loaded, so
+    // there is no need to copy it
+    wxMsgCatalog *cat = wxMsgCatalog::CreateFromData(mo_data, mo_size, domain);
 
     if ( !cat )
     {
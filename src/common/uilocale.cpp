@@ -34,6 +34,8 @@
 
 #include "wx/private/uilocale.h"
 
+#include <atomic>
+
 #define TRACE_I18N wxS("i18n")
 
 // ----------------------------------------------------------------------------
@@ -77,10 +79,19 @@ inline bool IsDefaultCLocale(const wxString& locale)
 /* static */
 wxUILocale wxUILocale::ms_current;
 
+// Incremented every time ms_current changes, see wxGetUILocaleGeneration().
+// Unlike ms_current itself, it can be read from any thread.
+static std::atomic<unsigned> gs_currentGeneration{0};
+
 // ============================================================================
 // implementation
 // ============================================================================
 
+unsigned wxGetUILocaleGeneration()
+{
+    return gs_currentGeneration.load(std::memory_order_acquire);
+}
+
 // ----------------------------------------------------------------------------
 // wxLocaleIdent
 // ----------------------------------------------------------------------------
@@ -817,6 +828,7 @@ bool wxUILocale::UseDefault()
 
     impl->Use();
     ms_current = wxUILocale(impl);
+    ++gs_currentGeneration;
 
     return true;
 }
@@ -851,6 +863,7 @@ bool wxUILocale::UseLocaleName(const wxString& localeName)
 
     impl->Use();
     ms_current = wxUILocale(impl);
+    ++gs_currentGeneration;
 
     return true;
 }
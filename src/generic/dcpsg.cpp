@@ -30,6 +30,19 @@
 #include "wx/filename.h"
 #include "wx/stdpaths.h"
 
+#if wxUSE_ZLIB && wxUSE_STREAMS
+    #include "wx/zstream.h"
+
+    // Bitmap data can be compressed using FlateDecode filter, but this
+    // requires PostScript language level 3, so it's only done if this level
+    // is explicitly enabled, see wxPostScriptDC::SetLanguageLevel().
+    #define wxPS_USE_FLATE 1
+#else
+    #define wxPS_USE_FLATE 0
+#endif
+
+#include <string>
+
 #ifdef __WXMSW__
 
 #ifdef DrawText
@@ -210,6 +223,132 @@ static const char *wxPostScriptHeaderStrSplit =
 "    }loop\n"        // [ str-items
 "  ]\n"              // [ str-items ]
 "} def\n";
+//-------------------------------------------------------------------------------
+// helpers for encoding bitmap data
+//-------------------------------------------------------------------------------
+
+namespace
+{
+
+// Encodes binary data using ASCII base-85 encoding understood by the
+// ASCII85Decode filter, which is 20% more compact than hexadecimal encoding
+// used by readhexstring.
+class wxPSASCII85Encoder
+{
+public:
+    explicit wxPSASCII85Encoder(std::string& out)
+        : m_out(out)
+    {
+        m_count = 0;
+        m_lineLen = 0;
+    }
+
+    void Encode(const unsigned char* data, size_t len)
+    {
+        for ( ; len; --len )
+        {
+            m_tuple[m_count++] = *data++;
+            if ( m_count == 4 )
+            {
+                EncodeTuple(4);
+                m_count = 0;
+            }
+        }
+    }
+
+    // Encode the remaining bytes, if any, and append the end of data marker.
+    void Finish()
+    {
+        if ( m_count )
+        {
+            for ( size_t n = m_count; n < 4; n++ )
+                m_tuple[n] = 0;
+
+            EncodeTuple(m_count);
+            m_count = 0;
+        }
+
+        m_out += "~>\n";
+        m_lineLen = 0;
+    }
+
+private:
+    void EncodeTuple(size_t count)
+    {
+        wxUint32 value = (wxUint32(m_tuple[0]) << 24) |
+                         (wxUint32(m_tuple[1]) << 16) |
+                         (wxUint32(m_tuple[2]) << 8) |
+                          wxUint32(m_tuple[3]);
+
+        if ( count == 4 && value == 0 )
+        {
+            Put('z');
+            return;
+        }
+
+        char digits[5];
+        for ( int n = 4; n >= 0; n-- )
+        {
+            digits[n] = static_cast<char>('!' + value % 85);
+            value /= 85;
+        }
+
+        // A partial group of N bytes is encoded as N + 1 characters.
+        for ( size_t n = 0; n <= count; n++ )
+            Put(digits[n]);
+    }
+
+    void Put(char c)
+    {
+        if ( m_lineLen == 0 && c == '%' )
+        {
+            // Avoid lines starting with "%%" which could be taken for DSC
+            // comments by the document managers.
+            m_out += ' ';
+            m_lineLen++;
+        }
+
+        m_out += c;
+
+        if ( ++m_lineLen == 75 )
+        {
+            m_out += '\n';
+            m_lineLen = 0;
+        }
+    }
+
+    std::string& m_out;
+    unsigned char m_tuple[4];
+    size_t m_count;
+    size_t m_lineLen;
+};
+
+#if wxPS_USE_FLATE
+
+// Adaptor allowing to use wxZlibOutputStream with wxPSASCII85Encoder.
+class wxPSASCII85OutputStream : public wxOutputStream
+{
+public:
+    explicit wxPSASCII85OutputStream(wxPSASCII85Encoder& encoder)
+        : m_encoder(encoder)
+    {
+    }
+
+protected:
+    size_t OnSysWrite(const void* buffer, size_t size) override
+    {
+        m_encoder.Encode(static_cast<const unsigned char*>(buffer), size);
+        return size;
+    }
+
+private:
+    wxPSASCII85Encoder& m_encoder;
+};
+
+#endif // wxPS_USE_FLATE
+
+} // anonymous namespace
+
 //-------------------------------------------------------------------------------
 // wxPostScriptDC
 //-------------------------------------------------------------------------------
@@ -227,6 +366,16 @@ wxPostScriptDC::wxPostScriptDC(const wxPrintData& printData)
 {
 }
 
+void wxPostScriptDC::SetLanguageLevel(int level)
+{
+    static_cast<wxPostScriptDCImpl*>(GetImpl())->SetLanguageLevel(level);
+}
+
+int wxPostScriptDC::GetLanguageLevel() const
+{
+    return static_cast<const wxPostScriptDCImpl*>(GetImpl())->GetLanguageLevel();
+}
+
 // we don't want to use only 72 dpi from PS print
 static const int DPI = 600;
 static const double PS2DEV = 600.0 / 72.0;
@@ -290,6 +439,7 @@ wxPostScriptDCImpl::wxPostScriptDCImpl( wxPrinterDC *owner, const wxPrintData& d
 void wxPostScriptDCImpl::Init()
 {
     m_pstream = nullptr;
+    m_outputStream = nullptr;
 
     m_currentRed = 0;
     m_currentGreen = 0;
@@ -302,7 +452,11 @@ void wxPostScriptDCImpl::Init()
     m_underlinePosition = 0.0;
     m_underlineThickness = 0.0;
 
+    InvalidatePSState();
+
     m_isFontChanged = false;
+
+    m_languageLevel = 2;
 }
 
 wxPostScriptDCImpl::~wxPostScriptDCImpl ()
@@ -371,6 +525,10 @@ void wxPostScriptDCImpl::DestroyClippingRegion()
     {
         m_clipping = false;
         PsPrint( "grestore\n" );
+
+        // This restored the graphics state saved when setting the clipping
+        // region, so we don't know the current colour, pen nor font any more.
+        InvalidatePSState();
     }
 
     wxDCImpl::DestroyClippingRegion();
@@ -952,6 +1110,16 @@ void wxPostScriptDCImpl::DoDrawBitmap( const wxBitmap& bitmap, wxCoord x, wxCoor
     double xx = XLOG2DEV(x);
     double yy = YLOG2DEV(y + bitmap.GetHeight());
 
+#if wxPS_USE_FLATE
+    // Compressing the data is only possible with level 3 interpreters.
+    const bool useFlate = m_languageLevel >= 3;
+#endif
+
+    // The image data follows the code below in the output and is read by
+    // "colorimage" via the decoding filter(s). The filters are explicitly
+    // flushed from inside the procedure executed by "exec" to ensure that all
+    // the encoded data, including the end of data marker, is consumed before
+    // the interpreter resumes reading the code from the file.
     wxString buffer;
     buffer.Printf( "/origstate save def\n"
                    "20 dict begin\n"
@@ -961,42 +1129,58 @@ void wxPostScriptDCImpl::DoDrawBitmap( const wxBitmap& bitmap, wxCoord x, wxCoor
                    "/rgbindx 0 def\n"
                    "%f %f translate\n"
                    "%f %f scale\n"
+                   "/a85src currentfile /ASCII85Decode filter def\n",
+            w*3, w, xx, yy, ww, hh );
+    buffer.Replace( ",", "." );
+    PsPrint( buffer );
+
+#if wxPS_USE_FLATE
+    if ( useFlate )
+        PsPrint( "/datasrc a85src /FlateDecode filter def\n" );
+    else
+#endif
+        PsPrint( "/datasrc a85src def\n" );
+
+    buffer.Printf( "{\n"
                    "%d %d 8\n"
                    "[%d 0 0 %d 0 %d]\n"
-                   "{currentfile pix readhexstring pop}\n"
+                   "{datasrc pix readstring pop}\n"
                    "false 3 colorimage\n",
-            w, w, xx, yy, ww, hh, w, h, w, -h, h );
-    buffer.Replace( ",", "." );
+            w, h, w, -h, h );
     PsPrint( buffer );
 
-    unsigned char* data = image.GetData();
-
-    // size of the buffer = width*rgb(3)*hexa(2)+'\n'
-    wxCharBuffer charbuffer(w*6 + 1);
+#if wxPS_USE_FLATE
+    if ( useFlate )
+        PsPrint( "datasrc flushfile\n" );
+#endif
 
-    //rows
-    for (int j = 0; j < h; j++)
-    {
-        char* bufferindex = charbuffer.data();
+    PsPrint( "a85src flushfile\n"
+             "} exec\n" );
 
-        //cols
-        for (int i = 0; i < w*3; i++)
-        {
-            char c1, c2;
-            wxDecToHex(*data, &c1, &c2);
-            *(bufferindex++) = c1;
-            *(bufferindex++) = c2;
+    const unsigned char* const data = image.GetData();
+    const size_t len = 3*size_t(w)*size_t(h);
 
-            data++;
-        }
-        *(bufferindex++) = '\n';
-        *bufferindex = 0;
+    std::string encoded;
+    wxPSASCII85Encoder encoder(encoded);
 
-        if (m_pstream)
-            fwrite( charbuffer, 1, strlen( charbuffer ), m_pstream );
-        else
-            PsPrint( charbuffer );
+#if wxPS_USE_FLATE
+    if ( useFlate )
+    {
+        wxPSASCII85OutputStream a85stream(encoder);
+        wxZlibOutputStream zstream(a85stream, wxZ_BEST_SPEED, wxZLIB_ZLIB);
+        zstream.Write(data, len);
+        zstream.Close();
     }
+    else
+#endif // wxPS_USE_FLATE
+    {
+        encoded.reserve(len + len/4 + len/75 + 3);
+        encoder.Encode(data, len);
+    }
+
+    encoder.Finish();
+
+    PsWrite( encoded.data(), encoded.size() );
 
     PsPrint( "end\n" );
     PsPrint( "origstate restore\n" );
@@ -1021,7 +1205,8 @@ void wxPostScriptDCImpl::SetPSColour(const wxColor& col)
         // setgray here ?
     }
 
-    if (!(red == m_currentRed && green == m_currentGreen && blue == m_currentBlue))
+    if ( !m_psColourValid ||
+            !(red == m_currentRed && green == m_currentGreen && blue == m_currentBlue) )
     {
         double redPS = (double)red / 255.0;
         double bluePS = (double)blue / 255.0;
@@ -1035,6 +1220,7 @@ void wxPostScriptDCImpl::SetPSColour(const wxColor& col)
         m_currentRed = red;
         m_currentBlue = blue;
         m_currentGreen = green;
+        m_psColourValid = true;
     }
 }
 
@@ -1153,13 +1339,7 @@ void wxPostScriptDCImpl::SetPen( const wxPen& pen )
 
     if (!pen.IsOk()) return;
 
-    int oldStyle = m_pen.IsOk() ? m_pen.GetStyle() : wxPENSTYLE_INVALID;
-    wxPenCap oldCap = m_pen.IsOk() ? m_pen.GetCap() : wxCAP_INVALID;
-    wxPenJoin oldJoin = m_pen.IsOk() ? m_pen.GetJoin() : wxJOIN_INVALID;
-
     m_pen = pen;
-    wxPenCap cap = m_pen.IsOk() ? m_pen.GetCap() : wxCAP_INVALID;
-    wxPenJoin join = m_pen.IsOk() ? m_pen.GetJoin() : wxJOIN_INVALID;
 
     double width;
 
@@ -1168,10 +1348,20 @@ void wxPostScriptDCImpl::SetPen( const wxPen& pen )
     else
         width = (double) m_pen.GetWidth();
 
+    width *= DEV2PS * m_scaleX;
+
+    // Only output the parameters which actually changed: SetPen() is called
+    // before drawing each primitive, so doing it unconditionally would
+    // significantly bloat the output.
     wxString buffer;
-    buffer.Printf( "%f setlinewidth\n", width * DEV2PS * m_scaleX );
-    buffer.Replace( ",", "." );
-    PsPrint( buffer );
+    if ( width != m_psLineWidth )
+    {
+        buffer.Printf( "%f setlinewidth\n", width );
+        buffer.Replace( ",", "." );
+        PsPrint( buffer );
+
+        m_psLineWidth = width;
+    }
 
 /*
      Line style - WRONG: 2nd arg is OFFSET
@@ -1190,7 +1380,7 @@ void wxPostScriptDCImpl::SetPen( const wxPen& pen )
     static const char *wxCoord_dashed = "[4 8] 2";
     static const char *dotted_dashed = "[6 6 2 6] 4";
 
-    const char *psdash;
+    wxString psdash;
 
     switch (m_pen.GetStyle())
     {
@@ -1202,14 +1392,12 @@ void wxPostScriptDCImpl::SetPen( const wxPen& pen )
         {
             wxDash *dashes;
             int nDashes = m_pen.GetDashes (&dashes);
-            PsPrint ("[");
+            psdash = "[";
             for (int i = 0; i < nDashes; ++i)
             {
-                buffer.Printf( "%d ", dashes [i] );
-                PsPrint( buffer );
+                psdash << dashes[i] << ' ';
             }
-            PsPrint ("] 0 setdash\n");
-            psdash = nullptr;
+            psdash << "] 0";
         }
         break;
         case wxPENSTYLE_SOLID:
@@ -1217,13 +1405,16 @@ void wxPostScriptDCImpl::SetPen( const wxPen& pen )
         default:              psdash = "[] 0";         break;
     }
 
-    if ( psdash && (oldStyle != m_pen.GetStyle()) )
+    if ( psdash != m_psDash )
     {
         PsPrint( psdash );
         PsPrint( " setdash\n" );
+
+        m_psDash = psdash;
     }
 
-    if ( cap != wxCAP_INVALID && cap != oldCap )
+    const wxPenCap cap = m_pen.GetCap();
+    if ( cap != wxCAP_INVALID && cap != m_psLineCap )
     {
         switch ( cap )
         {
@@ -1237,9 +1428,12 @@ void wxPostScriptDCImpl::SetPen( const wxPen& pen )
         }
         buffer << " setlinecap\n";
         PsPrint( buffer );
+
+        m_psLineCap = cap;
     }
 
-    if ( join != wxJOIN_INVALID && join != oldJoin )
+    const wxPenJoin join = m_pen.GetJoin();
+    if ( join != wxJOIN_INVALID && join != m_psLineJoin )
     {
         switch ( join )
         {
@@ -1250,6 +1444,8 @@ void wxPostScriptDCImpl::SetPen( const wxPen& pen )
         }
         buffer << " setlinejoin\n";
         PsPrint( buffer );
+
+        m_psLineJoin = join;
     }
 
     // Line colour
@@ -1280,31 +1476,37 @@ void wxPostScriptDCImpl::DrawAnyText(const wxWX2MBbuf& textbuf, wxCoord textDesc
         SetPSColour(m_textForegroundColour);
     }
 
-    PsPrint( "(" );
+    // Build the escaped string in a buffer to output it all at once.
+    std::string psstr;
+    psstr.reserve(strlen(textbuf) + 20);
+    psstr += '(';
     for ( const char *p = textbuf; *p != '\0'; p++ )
     {
         int c = (unsigned char)*p;
         if (c == ')' || c == '(' || c == '\\')
         {
             /* Cope with special characters */
-            PsPrint( "\\" );
-            PsPrint( (char) c );
+            psstr += '\\';
+            psstr += (char) c;
         }
         else if ( c >= 128 )
         {
             /* Cope with character codes > 127 */
-            buffer.Printf( "\\%o", c );
-            PsPrint( buffer );
+            psstr += '\\';
+            psstr += (char) ('0' + (c >> 6));
+            psstr += (char) ('0' + ((c >> 3) & 7));
+            psstr += (char) ('0' + (c & 7));
         }
         else
         {
-            PsPrint( (char) c );
+            psstr += (char) c;
         }
     }
-    PsPrint( ")" );
+    psstr += ')';
 
     // Split multiline text and store individual lines in the array.
-    PsPrint( " (\\n) strsplit\n" );
+    psstr += " (\\n) strsplit\n";
+    PsWrite( psstr.data(), psstr.size() );
 
     // Print each line individually by fetching lines from the array
     PsPrint(           "{\n" );
@@ -1501,10 +1703,22 @@ wxCoord wxPostScriptDCImpl::GetCharWidth() const
     return (wxCoord) (GetCharHeight() * 72.0 / 120.0);
 }
 
+void wxPostScriptDCImpl::SetLanguageLevel(int level)
+{
+    wxCHECK_RET( level == 2 || level == 3, "unsupported language level" );
+    wxCHECK_RET( !m_pstream && !m_outputStream,
+                 "must be called before StartDoc()" );
+
+    m_languageLevel = level;
+}
+
 void wxPostScriptDCImpl::SetPrintData(const wxPrintData& data)
 {
     m_printData = data;
 
+    // The stream will be retrieved from the new data when needed.
+    m_outputStream = nullptr;
+
     wxPaperSize id = m_printData.GetPaperId();
     wxPrintPaperType *paper = wxThePrintPaperDatabase->FindPaperType(id);
     if (!paper) paper = wxThePrintPaperDatabase->FindPaperType(wxPAPER_A4);
@@ -1628,16 +1842,25 @@ bool wxPostScriptDCImpl::StartDoc( const wxString& WXUNUSED(message) )
             m_ok = false;
             return false;
         }
+
+        // Use a bigger buffer than the default one as we typically write a
+        // lot of small chunks.
+        setvbuf( m_pstream, nullptr, _IOFBF, 65536 );
     }
 
     m_ok = true;
 
     wxString buffer;
 
-    PsPrint( "%!PS-Adobe-2.0\n" );
+    PsPrint( "%!PS-Adobe-3.0\n" );
 
     PsPrint( "%%Creator: wxWidgets PostScript renderer\n" );
 
+    // The filters used for encoding the bitmaps need level 2 interpreter, or
+    // level 3 one if FlateDecode is used.
+    buffer.Printf( "%%%%LanguageLevel: %d\n", m_languageLevel );
+    PsPrint( buffer );
+
     buffer.Printf( "%%%%CreationDate: %s\n", wxNow() );
     PsPrint( buffer );
 
@@ -1711,6 +1934,8 @@ void wxPostScriptDCImpl::EndDoc ()
         m_pstream = nullptr;
     }
 
+    m_outputStream = nullptr;
+
     // Reset the list of fonts for which PS font registration code was generated.
     m_definedPSFonts.Empty();
 
@@ -1809,6 +2034,10 @@ void wxPostScriptDCImpl::StartPage()
     buffer.Printf( wxT("%%%%Page: %d\n"), m_pageNumber++ );
     PsPrint( buffer );
 
+    // The graphics state is reset by "showpage" at the end of the previous
+    // page and DSC requires pages to be independent anyhow.
+    InvalidatePSState();
+
 #if 0
     wxPostScriptPrintNativeData *data =
         wxDynamicCast(m_printData.GetNativeData(), wxPostScriptPrintNativeData);
@@ -1881,34 +2110,53 @@ wxCoord wxPostScriptDCImpl::GetCharHeight() const
 
 void wxPostScriptDCImpl::PsPrint( const wxString& str )
 {
-    const wxCharBuffer psdata(str.utf8_str());
+    const wxScopedCharBuffer psdata(str.utf8_str());
+
+    PsWrite( psdata.data(), psdata.length() );
+}
 
+void wxPostScriptDCImpl::PsWrite( const char* data, size_t len )
+{
     switch (m_printData.GetPrintMode())
     {
 #if wxUSE_STREAMS
         // append to output stream
         case wxPRINT_MODE_STREAM:
+            if ( !m_outputStream )
             {
                 // Pointer to PrintNativeData not always points to wxPostScriptPrintNativeData,
                 // e.g. under wxGTK it can point to wxGtkPrintNativeData and so calling
                 // wxPostScriptPrintNativeData methods on it crashes.
-                wxPostScriptPrintNativeData *data =
+                wxPostScriptPrintNativeData *nativeData =
                     wxDynamicCast(m_printData.GetNativeData(), wxPostScriptPrintNativeData);
-                wxCHECK_RET( data, wxS("Cannot obtain output stream") );
-                wxOutputStream* outputstream = data->GetOutputStream();
-                wxCHECK_RET( outputstream, wxT("invalid outputstream") );
-                outputstream->Write( psdata, strlen( psdata ) );
+                wxCHECK_RET( nativeData, wxS("Cannot obtain output stream") );
+                m_outputStream = nativeData->GetOutputStream();
+                wxCHECK_RET( m_outputStream, wxT("invalid outputstream") );
             }
+
+            m_outputStream->Write( data, len );
             break;
 #endif // wxUSE_STREAMS
 
         // save data into file
         default:
             wxCHECK_RET( m_pstream, wxT("invalid postscript dc") );
-            fwrite( psdata, 1, strlen( psdata ), m_pstream );
+            fwrite( data, 1, len, m_pstream );
     }
 }
 
+void wxPostScriptDCImpl::InvalidatePSState()
+{
+    m_psColourValid = false;
+    m_psLineWidth = -1.0;
+    m_psDash.clear();
+    m_psLineCap = wxCAP_INVALID;
+    m_psLineJoin = wxJOIN_INVALID;
+
+    // The font is part of the graphics state too.
+    m_isFontChanged = true;
+}
+
 void wxPostScriptDCImpl::DoGetTextExtent(const wxString& string,
                                      wxCoord *x, wxCoord *y,
                                      wxCoord *descent, wxCoord *externalLeading,
@@ -34,11 +34,13 @@ bool wxCairoInit();
     #include "wx/dcmemory.h"
     #include "wx/dcprint.h"
     #include "wx/log.h"
+    #include "wx/module.h"
     #include "wx/window.h"
 #endif
 
 #include "wx/private/graphics.h"
 #include "wx/rawbmp.h"
+#include "wx/thread.h"
 #include "wx/vector.h"
 #include "wx/display.h"
 #ifdef __WXMSW__
@@ -776,13 +778,21 @@ void wxCairoPenBrushBaseData::Apply( wxGraphicsContext* context )
 {
     cairo_t* const ctext = (cairo_t*) context->GetNativeContext();
 
-    if ( m_hatchStyle != wxHATCHSTYLE_INVALID && !m_pattern )
-        InitHatchPattern(ctext);
+    if ( !m_pattern )
+    {
+        if ( m_hatchStyle != wxHATCHSTYLE_INVALID )
+        {
+            InitHatchPattern(ctext);
+        }
+        else
+        {
+            // Create the solid colour pattern once and reuse it instead of
+            // letting cairo_set_source_rgba() create a new one every time.
+            m_pattern = cairo_pattern_create_rgba(m_red, m_green, m_blue, m_alpha);
+        }
+    }
 
-    if ( m_pattern )
-        cairo_set_source(ctext, m_pattern);
-    else
-        cairo_set_source_rgba(ctext, m_red, m_green, m_blue, m_alpha);
+    cairo_set_source(ctext, m_pattern);
 }
 
 void wxCairoPenBrushBaseData::AddGradientStops(const wxGraphicsGradientStops& stops)
@@ -3291,6 +3301,154 @@ void wxCairoContext::ReleaseNativeHDC(WXHDC WXUNUSED(hdc))
 };
 #endif // __WXMSW__
 
+//-----------------------------------------------------------------------------
+// wxCairoObjectCache
+//-----------------------------------------------------------------------------
+
+// Key used for caching the pens: only the attributes which can be different
+// for the cacheable pens, see wxCairoRenderer::CreatePen(), are stored here.
+struct wxCairoPenCacheKey
+{
+    wxCairoPenCacheKey() : m_width(0.0), m_style(wxPENSTYLE_INVALID),
+                           m_join(wxJOIN_INVALID), m_cap(wxCAP_INVALID) { }
+
+    explicit wxCairoPenCacheKey(const wxGraphicsPenInfo& info)
+        : m_colour(info.GetColour()),
+          m_width(info.GetWidth()),
+          m_style(info.GetStyle()),
+          m_join(info.GetJoin()),
+          m_cap(info.GetCap())
+    {
+    }
+
+    bool operator==(const wxCairoPenCacheKey& other) const
+    {
+        return m_colour == other.m_colour &&
+               m_width == other.m_width &&
+               m_style == other.m_style &&
+               m_join == other.m_join &&
+               m_cap == other.m_cap;
+    }
+
+    wxColour m_colour;
+    wxDouble m_width;
+    wxPenStyle m_style;
+    wxPenJoin m_join;
+    wxPenCap m_cap;
+};
+
+// Key used for caching the gradient brushes created without any matrix: the
+// gradient geometry and all its stops. Notice that the geometry uses absolute
+// coordinates, as the cairo pattern does, so only the fills of the same
+// rectangle, and not just of the same size, can reuse a cached brush.
+struct wxCairoGradientCacheKey
+{
+    wxCairoGradientCacheKey() : m_radial(false)
+    {
+        for ( size_t n = 0; n < WXSIZEOF(m_coords); n++ )
+            m_coords[n] = 0.0;
+    }
+
+    wxCairoGradientCacheKey(bool radial,
+                            wxDouble x1, wxDouble y1,
+                            wxDouble x2, wxDouble y2,
+                            wxDouble radius,
+                            const wxGraphicsGradientStops& stops)
+        : m_radial(radial)
+    {
+        m_coords[0] = x1;
+        m_coords[1] = y1;
+        m_coords[2] = x2;
+        m_coords[3] = y2;
+        m_coords[4] = radius;
+
+        const size_t count = stops.GetCount();
+        m_stops.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+            m_stops.push_back(stops.Item(n));
+    }
+
+    bool operator==(const wxCairoGradientCacheKey& other) const
+    {
+        if ( m_radial != other.m_radial ||
+                m_stops.size() != other.m_stops.size() )
+            return false;
+
+        for ( size_t n = 0; n < WXSIZEOF(m_coords); n++ )
+        {
+            if ( m_coords[n] != other.m_coords[n] )
+                return false;
+        }
+
+        for ( size_t n = 0; n < m_stops.size(); n++ )
+        {
+            if ( m_stops[n].GetPosition() != other.m_stops[n].GetPosition() ||
+                    m_stops[n].GetColour() != other.m_stops[n].GetColour() )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool m_radial;
+    wxDouble m_coords[5];
+    wxVector<wxGraphicsGradientStop> m_stops;
+};
+
+// Small cache of the graphics objects (pens or brushes) created recently.
+//
+// wxGCDC converts its wxPen and wxBrush to the graphics objects every time
+// they're set and typical drawing code keeps switching between just a few of
+// them, so reusing the objects created before avoids allocating new Cairo
+// patterns and dash arrays for every change. The cache is tiny and uses
+// round-robin replacement, as the lookup must remain cheaper than creating a
+// new object.
+template <typename K, typename V>
+class wxCairoObjectCache
+{
+public:
+    wxCairoObjectCache() : m_next(0) { }
+
+    // Return the cached object for the given key or a null object.
+    V Find(const K& key) const
+    {
+        for ( size_t n = 0; n < SIZE; n++ )
+        {
+            if ( !m_values[n].IsNull() && m_keys[n] == key )
+                return m_values[n];
+        }
+
+        return V();
+    }
+
+    void Add(const K& key, const V& value)
+    {
+        m_keys[m_next] = key;
+        m_values[m_next] = value;
+        m_next = (m_next + 1) % SIZE;
+    }
+
+    void Clear()
+    {
+        for ( size_t n = 0; n < SIZE; n++ )
+        {
+            m_keys[n] = K();
+            m_values[n] = V();
+        }
+
+        m_next = 0;
+    }
+
+private:
+    enum { SIZE = 8 };
+
+    K m_keys[SIZE];
+    V m_values[SIZE];
+    size_t m_next;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS_2(wxCairoObjectCache, K, V);
+};
+
 //-----------------------------------------------------------------------------
 // wxCairoRenderer declaration
 //-----------------------------------------------------------------------------
@@ -3383,6 +3541,37 @@ public :
     virtual wxString GetName() const override;
     virtual void GetVersion(int *major, int *minor, int *micro) const override;
 
+    // Release all the cached objects, called on library shutdown.
+    void ClearCaches()
+    {
+        m_penCache.Clear();
+        m_brushCache.Clear();
+        m_gradientCache.Clear();
+    }
+
+private:
+    // Return the gradient brush for the given key, creating it if necessary,
+    // or a null brush if it can't be cached.
+    wxGraphicsBrush
+    FindCachedGradientBrush(const wxCairoGradientCacheKey& key,
+                            const wxGraphicsMatrix& matrix,
+                            bool* cacheable) const
+    {
+        *cacheable = matrix.IsNull() && wxIsMainThread();
+
+        return *cacheable ? m_gradientCache.Find(key) : wxGraphicsBrush();
+    }
+
+    // Caches of the simple pens and brushes, only used from the main thread
+    // as the graphics objects are not safe to share between threads.
+    wxCairoObjectCache<wxCairoPenCacheKey, wxGraphicsPen> m_penCache;
+    wxCairoObjectCache<wxColour, wxGraphicsBrush> m_brushCache;
+
+    // Cache of the gradient brushes, as wxGCDC::GradientFillLinear() and
+    // GradientFillConcentric() create the same ones over and over again when
+    // the same rectangles are redrawn.
+    wxCairoObjectCache<wxCairoGradientCacheKey, wxGraphicsBrush> m_gradientCache;
+
     wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxCairoRenderer);
 } ;
 
@@ -3527,7 +3716,39 @@ wxGraphicsPen wxCairoRenderer::CreatePen(const wxGraphicsPenInfo& info)
     ENSURE_LOADED_OR_RETURN(p);
     if (info.GetStyle() != wxPENSTYLE_TRANSPARENT)
     {
-        p.SetRefData(new wxCairoPenData( this, info ));
+        // Only cache the pens which don't use any patterns depending on the
+        // context they're used with or any data which is expensive to compare.
+        bool cacheable = false;
+        switch ( info.GetStyle() )
+        {
+            case wxPENSTYLE_SOLID:
+            case wxPENSTYLE_DOT:
+            case wxPENSTYLE_LONG_DASH:
+            case wxPENSTYLE_SHORT_DASH:
+            case wxPENSTYLE_DOT_DASH:
+                cacheable = info.GetGradientType() == wxGRADIENT_NONE &&
+                                info.GetColour().IsSolid() &&
+                                    wxIsMainThread();
+                break;
+
+            default:
+                break;
+        }
+
+        if ( cacheable )
+        {
+            const wxCairoPenCacheKey key(info);
+            p = m_penCache.Find(key);
+            if ( p.IsNull() )
+            {
+                p.SetRefData(new wxCairoPenData( this, info ));
+                m_penCache.Add(key, p);
+            }
+        }
+        else
+        {
+            p.SetRefData(new wxCairoPenData( this, info ));
+        }
     }
     return p;
 }
@@ -3538,7 +3759,23 @@ wxGraphicsBrush wxCairoRenderer::CreateBrush(const wxBrush& brush )
     ENSURE_LOADED_OR_RETURN(p);
     if (brush.IsOk() && brush.GetStyle() != wxBRUSHSTYLE_TRANSPARENT)
     {
-        p.SetRefData(new wxCairoBrushData( this, brush ));
+        // As with the pens, only cache the simplest, but also by far the most
+        // common, solid colour brushes.
+        if ( brush.GetStyle() == wxBRUSHSTYLE_SOLID &&
+                brush.GetColour().IsSolid() && wxIsMainThread() )
+        {
+            const wxColour& col = brush.GetColour();
+            p = m_brushCache.Find(col);
+            if ( p.IsNull() )
+            {
+                p.SetRefData(new wxCairoBrushData( this, brush ));
+                m_brushCache.Add(col, p);
+            }
+        }
+        else
+        {
+            p.SetRefData(new wxCairoBrushData( this, brush ));
+        }
     }
     return p;
 }
@@ -3551,9 +3788,19 @@ wxCairoRenderer::CreateLinearGradientBrush(wxDouble x1, wxDouble y1,
 {
     wxGraphicsBrush p;
     ENSURE_LOADED_OR_RETURN(p);
-    wxCairoBrushData* d = new wxCairoBrushData( this );
-    d->CreateLinearGradientPattern(x1, y1, x2, y2, stops, matrix);
-    p.SetRefData(d);
+
+    const wxCairoGradientCacheKey key(false, x1, y1, x2, y2, 0.0, stops);
+    bool cacheable;
+    p = FindCachedGradientBrush(key, matrix, &cacheable);
+    if ( p.IsNull() )
+    {
+        wxCairoBrushData* d = new wxCairoBrushData( this );
+        d->CreateLinearGradientPattern(x1, y1, x2, y2, stops, matrix);
+        p.SetRefData(d);
+
+        if ( cacheable )
+            m_gradientCache.Add(key, p);
+    }
     return p;
 }
 
@@ -3565,9 +3812,19 @@ wxCairoRenderer::CreateRadialGradientBrush(wxDouble startX, wxDouble startY,
 {
     wxGraphicsBrush p;
     ENSURE_LOADED_OR_RETURN(p);
-    wxCairoBrushData* d = new wxCairoBrushData( this );
-    d->CreateRadialGradientPattern(startX, startY, endX, endY, r, stops, matrix);
-    p.SetRefData(d);
+
+    const wxCairoGradientCacheKey key(true, startX, startY, endX, endY, r, stops);
+    bool cacheable;
+    p = FindCachedGradientBrush(key, matrix, &cacheable);
+    if ( p.IsNull() )
+    {
+        wxCairoBrushData* d = new wxCairoBrushData( this );
+        d->CreateRadialGradientPattern(startX, startY, endX, endY, r, stops, matrix);
+        p.SetRefData(d);
+
+        if ( cacheable )
+            m_gradientCache.Add(key, p);
+    }
     return p;
 }
 
@@ -3728,6 +3985,34 @@ wxGraphicsRenderer* wxGraphicsRenderer::GetCairoRenderer()
     return &gs_cairoGraphicsRenderer;
 }
 
+//-----------------------------------------------------------------------------
+// wxCairoRendererModule
+//-----------------------------------------------------------------------------
+
+// This module is used to release the cached objects before Cairo itself is
+// unloaded.
+class wxCairoRendererModule : public wxModule
+{
+public:
+    wxCairoRendererModule()
+    {
+#ifndef __WXGTK__
+        AddDependency("wxCairoModule");
+#endif
+    }
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override
+    {
+        gs_cairoGraphicsRenderer.ClearCaches();
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxCairoRendererModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxCairoRendererModule, wxModule);
+
 #else // !wxUSE_CAIRO
 
 wxGraphicsRenderer* wxGraphicsRenderer::GetCairoRenderer()
@@ -18,6 +18,9 @@
     #include "wx/utils.h"
 #endif
 
+#include <algorithm>
+#include <vector>
+
 // ========================================================================
 // Classes to interface with X.org code
 // ========================================================================
@@ -83,6 +86,10 @@ public:
         int rx, int ry,
         unsigned int rwidth, unsigned int rheight);
 
+    // Return the first box of the region which is not entirely above the
+    // given y coordinate, i.e. the start of the band containing it, if any.
+    static BoxPtr FindBand(Region region, wxCoord y);
+
 protected:
     static Region XCreateRegion(void);
     static void miSetExtents (
@@ -340,6 +347,50 @@ bool wxRegionGeneric::DoUnionWithRegion(const wxRegion& region)
     return REGION::XUnionRegion(M_REGIONDATA_OF(region),M_REGIONDATA,M_REGIONDATA);
 }
 
+bool wxRegionGeneric::DoUnionWithRects(size_t count, const wxRect* rects)
+{
+    // Adding the rectangles one by one would take quadratic time as each
+    // union is linear in the number of rectangles already in the region, so
+    // merge them pairwise instead, which only takes O(N log N).
+    std::vector<wxRegionGeneric> regions;
+    regions.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( !rects[n].IsEmpty() )
+            regions.push_back(wxRegionGeneric(rects[n]));
+    }
+
+    if ( regions.empty() )
+        return true;
+
+    while ( regions.size() > 1 )
+    {
+        std::vector<wxRegionGeneric> merged;
+        merged.reserve((regions.size() + 1) / 2);
+
+        for ( size_t n = 0; n < regions.size(); n += 2 )
+        {
+            if ( n + 1 < regions.size() )
+                regions[n].Union(regions[n + 1]);
+
+            merged.push_back(regions[n]);
+        }
+
+        // Note that this releases the references to the merged regions, so
+        // that they're not shared and don't need to be copied when modifying
+        // them during the next iteration.
+        regions.swap(merged);
+    }
+
+    if ( !m_refData )
+    {
+        Ref(regions[0]);
+        return true;
+    }
+
+    return DoUnionWithRegion(regions[0]);
+}
+
 bool wxRegionGeneric::DoIntersect(const wxRegion& region)
 {
     AllocExclusive();
@@ -1831,20 +1882,42 @@ bool REGION::XEqualRegion(Region r1, Region r2)
     return true;
 }
 
-bool REGION::XPointInRegion(Region pRegion, int x, int y)
+BoxPtr REGION::FindBand(Region region, wxCoord y)
 {
-    int i;
+    // As the bands don't overlap, the bottom coordinates of all boxes are
+    // sorted, allowing to use binary search instead of a linear scan.
+    return std::upper_bound(region->rects, region->rects + region->numRects, y,
+                            [](wxCoord yy, const Box& box)
+                            {
+                                return yy < box.y2;
+                            });
+}
 
+bool REGION::XPointInRegion(Region pRegion, int x, int y)
+{
     if (pRegion->numRects == 0)
         return false;
     if (!INBOX(pRegion->extents, x, y))
         return false;
-    for (i=0; i<pRegion->numRects; i++)
-    {
-        if (INBOX (pRegion->rects[i], x, y))
-            return true;
-    }
-    return false;
+
+    const BoxPtr pboxEnd = pRegion->rects + pRegion->numRects;
+    BoxPtr pbox = FindBand(pRegion, y);
+    if (pbox == pboxEnd || pbox->y1 > y)
+        return false;           /* the point is between two bands */
+
+    /*
+     * the boxes in a band are sorted by x and don't overlap neither, so find
+     * the first one not entirely to the left of the point, considering all
+     * boxes of the subsequent bands to be to the right of it
+     */
+    const wxCoord bandY1 = pbox->y1;
+    pbox = std::upper_bound(pbox, pboxEnd, x,
+                            [bandY1](wxCoord xx, const Box& box)
+                            {
+                                return box.y1 != bandY1 || xx < box.x2;
+                            });
+
+    return pbox != pboxEnd && pbox->y1 == bandY1 && pbox->x1 <= x;
 }
 
 wxRegionContain REGION::XRectInRegion(Region region,
@@ -1871,7 +1944,7 @@ wxRegionContain REGION::XRectInRegion(Region region,
     partIn = false;
 
     /* can stop when both partOut and partIn are true, or we reach prect->y2 */
-    for (pbox = region->rects, pboxEnd = pbox + region->numRects;
+    for (pbox = FindBand(region, ry), pboxEnd = region->rects + region->numRects;
          pbox < pboxEnd;
          pbox++)
     {
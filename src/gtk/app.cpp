@@ -24,6 +24,7 @@
 #include "wx/fontmap.h"
 #include "wx/msgout.h"
 
+#include "wx/private/evtprofiler.h"
 #include "wx/private/init.h"
 
 #include "wx/gtk/private.h"
@@ -148,8 +149,16 @@ bool wxApp::DoIdle()
         gs_focusChange = 0;
     }
 
-    ProcessPendingEvents();
-    const bool needMore = ProcessIdle();
+    {
+        wxEventProfilerTimer profile(wxEventProfilerTimer::Pending);
+        ProcessPendingEvents();
+    }
+
+    bool needMore;
+    {
+        wxEventProfilerTimer profile(wxEventProfilerTimer::Idle);
+        needMore = ProcessIdle();
+    }
 
     gdk_threads_leave();
 
@@ -23,6 +23,7 @@
 #include "wx/unix/private/epolldispatcher.h"
 #include "wx/unix/private.h"
 #include "wx/stopwatch.h"
+#include "wx/time.h"
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
@@ -35,6 +36,9 @@
 
 #define wxEpollDispatcher_Trace wxT("epolldispatcher")
 
+// default maximal number of events processed by a single Dispatch() call
+static const int wxEPOLL_DEFAULT_MAX_EVENTS = 64;
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -68,9 +72,47 @@ static uint32_t GetEpollMask(int flags, int fd)
                    wxT("Registered fd %d for exceptional events"), fd);
     }
 
+    if ( flags & wxFDIO_EDGE_TRIGGERED )
+    {
+        ep |= EPOLLET;
+        wxLogTrace(wxEpollDispatcher_Trace,
+                   wxT("Registered fd %d in edge-triggered mode"), fd);
+    }
+
     return ep;
 }
 
+// ----------------------------------------------------------------------------
+// wxEpollDispatcher::Batch
+// ----------------------------------------------------------------------------
+
+struct wxEpollDispatcher::Batch
+{
+    Batch(wxEpollDispatcher& dispatcher_, epoll_event* events_, int count_)
+        : dispatcher(dispatcher_),
+          events(events_),
+          count(count_),
+          outer(dispatcher_.m_batch)
+    {
+        current = 0;
+
+        dispatcher.m_batch = this;
+    }
+
+    ~Batch()
+    {
+        dispatcher.m_batch = outer;
+    }
+
+    wxEpollDispatcher& dispatcher;
+    epoll_event* const events;
+    const int count;
+    int current;
+    Batch* const outer;
+
+    wxDECLARE_NO_COPY_CLASS(Batch);
+};
+
 // ----------------------------------------------------------------------------
 // wxEpollDispatcher
 // ----------------------------------------------------------------------------
@@ -94,6 +136,11 @@ wxEpollDispatcher::wxEpollDispatcher(int epollDescriptor)
     wxASSERT_MSG( epollDescriptor != -1, wxT("invalid descriptor") );
 
     m_epollDescriptor = epollDescriptor;
+
+    m_maxEvents = wxEPOLL_DEFAULT_MAX_EVENTS;
+    m_events.reset(new epoll_event[m_maxEvents]);
+
+    m_batch = nullptr;
 }
 
 wxEpollDispatcher::~wxEpollDispatcher()
@@ -104,14 +151,30 @@ wxEpollDispatcher::~wxEpollDispatcher()
     }
 }
 
-bool wxEpollDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
+void wxEpollDispatcher::SetMaxEventsPerDispatch(int maxEvents)
+{
+    wxCHECK_RET( maxEvents > 0, wxT("invalid number of events") );
+    wxCHECK_RET( !m_batch, wxT("can't be changed while dispatching") );
+
+    m_maxEvents = maxEvents;
+    m_events.reset(new epoll_event[m_maxEvents]);
+}
+
+bool wxEpollDispatcher::DoControl(int op, int fd, int flags)
 {
+    // we store the descriptor and not the handler in the event data, as we
+    // need to find the flags it was registered with when dispatching it
     epoll_event ev;
     ev.events = GetEpollMask(flags, fd);
-    ev.data.ptr = handler;
+    ev.data.u64 = 0;
+    ev.data.fd = fd;
+
+    return epoll_ctl(m_epollDescriptor, op, fd, &ev) == 0;
+}
 
-    const int ret = epoll_ctl(m_epollDescriptor, EPOLL_CTL_ADD, fd, &ev);
-    if ( ret != 0 )
+bool wxEpollDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
+{
+    if ( !DoControl(EPOLL_CTL_ADD, fd, flags) )
     {
         wxLogSysError(_("Failed to add descriptor %d to epoll descriptor %d"),
                       fd, m_epollDescriptor);
@@ -121,17 +184,14 @@ bool wxEpollDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
     wxLogTrace(wxEpollDispatcher_Trace,
                wxT("Added fd %d (handler %p) to epoll %d"), fd, handler, m_epollDescriptor);
 
+    m_handlers[fd] = wxFDIOHandlerEntry(handler, flags);
+
     return true;
 }
 
 bool wxEpollDispatcher::ModifyFD(int fd, wxFDIOHandler* handler, int flags)
 {
-    epoll_event ev;
-    ev.events = GetEpollMask(flags, fd);
-    ev.data.ptr = handler;
-
-    const int ret = epoll_ctl(m_epollDescriptor, EPOLL_CTL_MOD, fd, &ev);
-    if ( ret != 0 )
+    if ( !DoControl(EPOLL_CTL_MOD, fd, flags) )
     {
         wxLogSysError(_("Failed to modify descriptor %d in epoll descriptor %d"),
                       fd, m_epollDescriptor);
@@ -141,6 +201,12 @@ bool wxEpollDispatcher::ModifyFD(int fd, wxFDIOHandler* handler, int flags)
 
     wxLogTrace(wxEpollDispatcher_Trace,
                 wxT("Modified fd %d (handler: %p) on epoll %d"), fd, handler, m_epollDescriptor);
+
+    wxFDIOHandlerEntry& entry = m_handlers[fd];
+    if ( entry.handler != handler )
+        ForgetPendingEvents(fd);
+    entry = wxFDIOHandlerEntry(handler, flags);
+
     return true;
 }
 
@@ -157,9 +223,29 @@ bool wxEpollDispatcher::UnregisterFD(int fd)
     }
     wxLogTrace(wxEpollDispatcher_Trace,
                 wxT("removed fd %d from %d"), fd, m_epollDescriptor);
+
+    // the handler is typically destroyed after unregistering it, so we must
+    // not call it even if we have already got the events for it
+    ForgetPendingEvents(fd);
+    m_handlers.erase(fd);
+
     return true;
 }
 
+void wxEpollDispatcher::ForgetPendingEvents(int fd)
+{
+    for ( Batch* batch = m_batch; batch; batch = batch->outer )
+    {
+        // notice that we also reset the current event, if it's for this
+        // descriptor, to prevent calling the handler for its other events
+        for ( int n = batch->current; n < batch->count; n++ )
+        {
+            if ( batch->events[n].data.fd == fd )
+                batch->events[n].data.fd = -1;
+        }
+    }
+}
+
 int
 wxEpollDispatcher::DoPoll(epoll_event *events, int numEvents, int timeout) const
 {
@@ -204,43 +290,81 @@ bool wxEpollDispatcher::HasPending() const
 
 int wxEpollDispatcher::Dispatch(int timeout)
 {
-    epoll_event events[16];
+    // if we're called from a handler, we can't reuse the buffer which is
+    // still being processed by the outer call
+    std::unique_ptr<epoll_event[]> nestedEvents;
+    epoll_event* events = m_events.get();
+    if ( m_batch )
+    {
+        nestedEvents.reset(new epoll_event[m_maxEvents]);
+        events = nestedEvents.get();
+    }
 
-    const int rc = DoPoll(events, WXSIZEOF(events), timeout);
+    const int rc = DoPoll(events, m_maxEvents, timeout);
 
     if ( rc == -1 )
     {
+        UpdateStats(0, 0);
+
         wxLogSysError(_("Waiting for IO on epoll descriptor %d failed"),
                       m_epollDescriptor);
         return -1;
     }
 
+    const wxLongLong start = wxGetUTCTimeUSec();
+
     int numEvents = 0;
-    for ( epoll_event *p = events; p < events + rc; p++ )
+    for ( Batch batch(*this, events, rc); batch.current < rc; batch.current++ )
     {
-        wxFDIOHandler * const handler = (wxFDIOHandler *)(p->data.ptr);
-        if ( !handler )
-        {
-            wxFAIL_MSG( wxT("null handler in epoll_event?") );
+        epoll_event& ev = events[batch.current];
+
+        // the handler may have been unregistered by another handler called
+        // from this loop
+        if ( ev.data.fd == -1 )
             continue;
-        }
+
+        const wxFDIOHandlerMap::const_iterator it = m_handlers.find(ev.data.fd);
+        if ( it == m_handlers.end() )
+            continue;
+
+        // when using edge-triggered mode, we must notify the handler about all
+        // events as we won't get them again, otherwise we process only one of
+        // them now and the rest during the next call
+        //
+        // notice that the returned events never include EPOLLET, so we have
+        // to check the flags used when registering the descriptor
+        wxFDIOHandler * const handler = it->second.handler;
+        const bool notifyAll = (it->second.flags & wxFDIO_EDGE_TRIGGERED) != 0;
 
         // note that for compatibility with wxSelectDispatcher we call
         // OnReadWaiting() on EPOLLHUP as this is what epoll_wait() returns
         // when the write end of a pipe is closed while with select() the
         // remaining pipe end becomes ready for reading when this happens
-        if ( p->events & (EPOLLIN | EPOLLHUP) )
+        bool notified = false;
+        if ( ev.events & (EPOLLIN | EPOLLHUP) )
+        {
             handler->OnReadWaiting();
-        else if ( p->events & EPOLLOUT )
+            notified = true;
+        }
+
+        if ( (ev.events & EPOLLOUT) && (notifyAll || !notified) && ev.data.fd != -1 )
+        {
             handler->OnWriteWaiting();
-        else if ( p->events & EPOLLERR )
+            notified = true;
+        }
+
+        if ( (ev.events & EPOLLERR) && (notifyAll || !notified) && ev.data.fd != -1 )
+        {
             handler->OnExceptionWaiting();
-        else
-            continue;
+            notified = true;
+        }
 
-        numEvents++;
+        if ( notified )
+            numEvents++;
     }
 
+    UpdateStats(rc, wxGetUTCTimeUSec() - start);
+
     return numEvents;
 }
 
@@ -184,7 +184,10 @@ int wxConsoleEventLoop::DispatchTimeout(unsigned long timeout)
     wxUsecClock_t nextTimer;
     if ( wxTimerScheduler::Get().GetNext(&nextTimer) )
     {
-        unsigned long timeUntilNextTimer = wxMilliClockToLong(nextTimer / 1000);
+        // round the time up to avoid waking up repeatedly without waiting
+        // when the timer expires in less than a millisecond
+        unsigned long
+            timeUntilNextTimer = wxMilliClockToLong((nextTimer + 999) / 1000);
         if ( timeUntilNextTimer < timeout )
             timeout = timeUntilNextTimer;
     }
@@ -0,0 +1,644 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/unix/iouringdispatcher.cpp
+// Purpose:     implements dispatcher using io_uring poll requests
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#include "wx/unix/private/iouringdispatcher.h"
+
+#if wxUSE_EPOLL_DISPATCHER && defined(wxHAS_IO_URING)
+
+#include "wx/time.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/intl.h"
+#endif
+
+#include <linux/io_uring.h>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+#define wxIOUringDispatcher_Trace wxT("iouringdispatcher")
+
+// the number of entries in the submission queue, the completion queue is
+// twice as big
+static const unsigned wxIO_URING_QUEUE_SIZE = 256;
+
+// user data of the poll removal requests, whose completions are ignored
+static const __u64 wxIO_URING_CANCEL_DATA = 0;
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+namespace
+{
+
+// io_uring system calls wrappers: they're not provided by glibc and we don't
+// want to depend on liburing just for them
+int wxIOUringSetup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int wxIOUringEnter(int fd, unsigned toSubmit, unsigned minComplete,
+                   unsigned flags, const void* arg, size_t argSize)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit,
+                                    minComplete, flags, arg, argSize));
+}
+
+// the rings indices are shared with the kernel and must be accessed atomically
+inline unsigned LoadAcquire(const unsigned* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+inline void StoreRelease(unsigned* p, unsigned value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+// helper: return POLLxxx mask corresponding to the given flags
+__u32 GetPollMask(int flags)
+{
+    __u32 mask = 0;
+
+    if ( flags & wxFDIO_INPUT )
+        mask |= POLLIN;
+
+    if ( flags & wxFDIO_OUTPUT )
+        mask |= POLLOUT;
+
+    if ( flags & wxFDIO_EXCEPTION )
+        mask |= POLLERR | POLLHUP;
+
+    // wxFDIO_EDGE_TRIGGERED is not supported, as one-shot requests re-armed
+    // after calling the handler behave as level-triggered ones anyhow
+
+    return mask;
+}
+
+// the poll request user data combines the descriptor and its generation
+inline __u64 MakeUserData(int fd, wxUint32 generation)
+{
+    return (static_cast<__u64>(generation) << 32) | static_cast<wxUint32>(fd);
+}
+
+inline int GetFDFromUserData(__u64 data)
+{
+    return static_cast<int>(data & 0xffffffff);
+}
+
+inline wxUint32 GetGenerationFromUserData(__u64 data)
+{
+    return static_cast<wxUint32>(data >> 32);
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxIOUringDispatcher::Ring
+// ----------------------------------------------------------------------------
+
+struct wxIOUringDispatcher::Ring
+{
+    Ring()
+    {
+        fd = -1;
+
+        sqRing =
+        cqRing = MAP_FAILED;
+        sqRingSize =
+        cqRingSize = 0;
+        sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+
+        sqTail =
+        toSubmit = 0;
+    }
+
+    ~Ring()
+    {
+        if ( sqes != MAP_FAILED )
+            munmap(sqes, sqEntries*sizeof(io_uring_sqe));
+        if ( cqRing != MAP_FAILED && cqRing != sqRing )
+            munmap(cqRing, cqRingSize);
+        if ( sqRing != MAP_FAILED )
+            munmap(sqRing, sqRingSize);
+
+        if ( fd != -1 && close(fd) != 0 )
+        {
+            wxLogSysError(_("Error closing io_uring descriptor"));
+        }
+    }
+
+    // create the ring and map its memory, return false on failure
+    bool Init()
+    {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+
+        fd = wxIOUringSetup(wxIO_URING_QUEUE_SIZE, &params);
+        if ( fd == -1 )
+        {
+            wxLogTrace(wxIOUringDispatcher_Trace,
+                       wxT("io_uring_setup() failed (errno %d)"), errno);
+            return false;
+        }
+
+        // we need to be able to wait with a timeout without using an extra
+        // request for it and to never lose any completions
+        const __u32 featuresNeeded = IORING_FEAT_EXT_ARG | IORING_FEAT_NODROP;
+        if ( (params.features & featuresNeeded) != featuresNeeded )
+        {
+            wxLogTrace(wxIOUringDispatcher_Trace,
+                       wxT("io_uring features %#x are insufficient"),
+                       params.features);
+            return false;
+        }
+
+        sqEntries = params.sq_entries;
+
+        sqRingSize = params.sq_off.array + params.sq_entries*sizeof(__u32);
+        cqRingSize = params.cq_off.cqes + params.cq_entries*sizeof(io_uring_cqe);
+
+        const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if ( singleMap )
+        {
+            if ( cqRingSize > sqRingSize )
+                sqRingSize = cqRingSize;
+            cqRingSize = sqRingSize;
+        }
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if ( sqRing == MAP_FAILED )
+        {
+            wxLogSysError(_("Failed to map io_uring submission queue"));
+            return false;
+        }
+
+        if ( singleMap )
+        {
+            cqRing = sqRing;
+        }
+        else
+        {
+            cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if ( cqRing == MAP_FAILED )
+            {
+                wxLogSysError(_("Failed to map io_uring completion queue"));
+                return false;
+            }
+        }
+
+        sqes = static_cast<io_uring_sqe*>(
+                    mmap(nullptr, sqEntries*sizeof(io_uring_sqe),
+                         PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         fd, IORING_OFF_SQES)
+                );
+        if ( sqes == MAP_FAILED )
+        {
+            wxLogSysError(_("Failed to map io_uring submission entries"));
+            return false;
+        }
+
+        char* const sq = static_cast<char*>(sqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTailShared = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqFlags = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+
+        char* const cq = static_cast<char*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        sqTail = *sqTailShared;
+
+        return true;
+    }
+
+    // return a new cleared submission queue entry, submitting the already
+    // queued ones first if the queue is full
+    io_uring_sqe* GetSQE()
+    {
+        if ( sqTail - LoadAcquire(sqHead) == sqEntries )
+        {
+            // this can still fail to submit anything if the completion
+            // queue is overflowing
+            if ( Enter(0, TIMEOUT_INFINITE) == -1 ||
+                    sqTail - LoadAcquire(sqHead) == sqEntries )
+                return nullptr;
+        }
+
+        const unsigned index = sqTail & sqMask;
+        io_uring_sqe* const sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+
+        sqArray[index] = index;
+        sqTail++;
+        toSubmit++;
+
+        return sqe;
+    }
+
+    // submit all queued requests and wait for at least the given number of
+    // completions, for at most the given timeout in milliseconds
+    //
+    // returns -1 on error or 0 on success, including timeout expiration
+    int Enter(unsigned minComplete, int timeout)
+    {
+        // we still need to enter the kernel if the completions which didn't
+        // fit into the queue must be flushed to it
+        const bool overflow = (LoadAcquire(sqFlags) & IORING_SQ_CQ_OVERFLOW) != 0;
+        if ( !toSubmit && !minComplete && !overflow )
+            return 0;
+
+        StoreRelease(sqTailShared, sqTail);
+
+        __kernel_timespec ts;
+        io_uring_getevents_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        arg.sigmask_sz = _NSIG / 8;
+        if ( timeout != TIMEOUT_INFINITE )
+        {
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = (timeout % 1000)*1000000;
+            arg.ts = reinterpret_cast<__u64>(&ts);
+        }
+
+        unsigned flags = IORING_ENTER_EXT_ARG;
+        if ( minComplete || overflow )
+            flags |= IORING_ENTER_GETEVENTS;
+
+        for ( ;; )
+        {
+            const int rc = wxIOUringEnter(fd, toSubmit, minComplete, flags,
+                                          &arg, sizeof(arg));
+            if ( rc >= 0 )
+            {
+                toSubmit -= rc;
+
+                // if not all requests were submitted, we must still wait
+                // for the completions if asked to do it
+                if ( !toSubmit || !minComplete )
+                    return 0;
+
+                continue;
+            }
+
+            switch ( errno )
+            {
+                case ETIME:
+                    return 0;
+
+                case EINTR:
+                    // we can't easily restart with the remaining timeout, so
+                    // just return and let the caller retry, as epoll_wait()
+                    // may also return early
+                    return 0;
+
+                case EAGAIN:
+                case EBUSY:
+                    // the completion queue is overflowing, the caller must
+                    // process the completions before submitting anything
+                    // else: but if it's waiting, we're done already
+                    return 0;
+            }
+
+            return -1;
+        }
+    }
+
+    // return the number of available completions
+    unsigned GetCompletionsCount() const
+    {
+        return LoadAcquire(cqTail) - *cqHead;
+    }
+
+    int fd;
+
+    void* sqRing;
+    void* cqRing;
+    size_t sqRingSize,
+           cqRingSize;
+
+    // submission queue
+    io_uring_sqe* sqes;
+    unsigned* sqHead;
+    unsigned* sqTailShared;
+    unsigned* sqArray;
+    unsigned* sqFlags;
+    unsigned sqMask;
+    unsigned sqEntries;
+
+    // our copy of the tail, only stored in the shared memory when submitting
+    unsigned sqTail;
+
+    // number of entries added since the last submission
+    unsigned toSubmit;
+
+    // completion queue
+    io_uring_cqe* cqes;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned cqMask;
+
+    wxDECLARE_NO_COPY_CLASS(Ring);
+};
+
+// ----------------------------------------------------------------------------
+// wxIOUringDispatcher
+// ----------------------------------------------------------------------------
+
+/* static */
+wxIOUringDispatcher *wxIOUringDispatcher::Create()
+{
+    std::unique_ptr<Ring> ring(new Ring);
+    if ( !ring->Init() )
+        return nullptr;
+
+    wxLogTrace(wxIOUringDispatcher_Trace,
+               wxT("io_uring fd %d created"), ring->fd);
+
+    return new wxIOUringDispatcher(ring.release());
+}
+
+wxIOUringDispatcher::wxIOUringDispatcher(Ring* ring)
+    : m_ring(ring)
+{
+    m_lastGeneration = 0;
+}
+
+wxIOUringDispatcher::~wxIOUringDispatcher()
+{
+    // closing the ring cancels all the pending requests
+}
+
+wxUint32 wxIOUringDispatcher::GetNextGeneration()
+{
+    // skip 0 to never use the user data of the cancel requests
+    if ( !++m_lastGeneration )
+        ++m_lastGeneration;
+
+    return m_lastGeneration;
+}
+
+void wxIOUringDispatcher::QueuePoll(int fd, Entry& entry)
+{
+    io_uring_sqe* const sqe = m_ring->GetSQE();
+    if ( !sqe )
+    {
+        wxLogSysError(_("Failed to submit io_uring requests"));
+        return;
+    }
+
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = GetPollMask(entry.flags);
+    sqe->user_data = MakeUserData(fd, entry.generation);
+
+    entry.armed = true;
+}
+
+void wxIOUringDispatcher::QueueCancel(int fd, Entry& entry)
+{
+    if ( !entry.armed )
+        return;
+
+    io_uring_sqe* const sqe = m_ring->GetSQE();
+    if ( !sqe )
+    {
+        wxLogSysError(_("Failed to submit io_uring requests"));
+        return;
+    }
+
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = MakeUserData(fd, entry.generation);
+    sqe->user_data = wxIO_URING_CANCEL_DATA;
+
+    entry.armed = false;
+}
+
+bool wxIOUringDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
+{
+    wxCHECK_MSG( handler, false, "handler can't be null" );
+    wxCHECK_MSG( m_entries.find(fd) == m_entries.end(), false,
+                 "descriptor already registered" );
+
+    Entry& entry = m_entries[fd];
+    entry.handler = handler;
+    entry.flags = flags;
+    entry.generation = GetNextGeneration();
+    entry.armed = false;
+
+    QueuePoll(fd, entry);
+
+    wxLogTrace(wxIOUringDispatcher_Trace,
+               wxT("Added fd %d (handler %p) to io_uring %d"),
+               fd, handler, m_ring->fd);
+
+    return true;
+}
+
+bool wxIOUringDispatcher::ModifyFD(int fd, wxFDIOHandler* handler, int flags)
+{
+    wxCHECK_MSG( handler, false, "handler can't be null" );
+
+    const EntriesMap::iterator it = m_entries.find(fd);
+    wxCHECK_MSG( it != m_entries.end(), false,
+                 "modifying unregistered descriptor?" );
+
+    Entry& entry = it->second;
+    QueueCancel(fd, entry);
+
+    entry.handler = handler;
+    entry.flags = flags;
+    entry.generation = GetNextGeneration();
+
+    QueuePoll(fd, entry);
+
+    wxLogTrace(wxIOUringDispatcher_Trace,
+               wxT("Modified fd %d (handler: %p) on io_uring %d"),
+               fd, handler, m_ring->fd);
+
+    return true;
+}
+
+bool wxIOUringDispatcher::UnregisterFD(int fd)
+{
+    const EntriesMap::iterator it = m_entries.find(fd);
+    if ( it == m_entries.end() )
+        return false;
+
+    // notice that the completions of the requests for this entry which may
+    // have been already posted are ignored because it's not found any more
+    QueueCancel(fd, it->second);
+    m_entries.erase(it);
+
+    wxLogTrace(wxIOUringDispatcher_Trace,
+               wxT("removed fd %d from %d"), fd, m_ring->fd);
+
+    return true;
+}
+
+bool wxIOUringDispatcher::HasPending() const
+{
+    if ( m_ring->GetCompletionsCount() != 0 ||
+            (LoadAcquire(m_ring->sqFlags) & IORING_SQ_CQ_OVERFLOW) )
+        return true;
+
+    // the requests which were queued but not submitted yet can't have been
+    // completed, but we can't submit them here as this function must not
+    // modify the ring, so check whether their descriptors are ready directly
+    if ( !m_ring->toSubmit )
+        return false;
+
+    std::vector<pollfd> fds;
+    for ( const auto& kv : m_entries )
+    {
+        if ( !kv.second.armed )
+            continue;
+
+        pollfd pfd;
+        pfd.fd = kv.first;
+        pfd.events = static_cast<short>(GetPollMask(kv.second.flags));
+        pfd.revents = 0;
+        fds.push_back(pfd);
+    }
+
+    if ( fds.empty() )
+        return false;
+
+    int rc;
+    do
+    {
+        rc = poll(&fds[0], fds.size(), 0);
+    } while ( rc == -1 && errno == EINTR );
+
+    return rc > 0;
+}
+
+int wxIOUringDispatcher::Dispatch(int timeout)
+{
+    wxCOMPILE_TIME_ASSERT( TIMEOUT_INFINITE == -1, UpdateThisCode );
+
+    const unsigned minComplete = timeout == 0 ||
+                                    m_ring->GetCompletionsCount() ? 0 : 1;
+    if ( m_ring->Enter(minComplete, timeout) == -1 )
+    {
+        UpdateStats(0, 0);
+
+        wxLogSysError(_("Waiting for IO on io_uring descriptor %d failed"),
+                      m_ring->fd);
+        return -1;
+    }
+
+    // copy the completions to free the space in the queue for the new ones
+    // which can be posted by the handlers called below (and also because
+    // this function can be reentered from them)
+    std::vector<io_uring_cqe> completions;
+    completions.reserve(m_ring->GetCompletionsCount());
+
+    unsigned head = *m_ring->cqHead;
+    const unsigned tail = LoadAcquire(m_ring->cqTail);
+    for ( ; head != tail; head++ )
+    {
+        const io_uring_cqe& cqe = m_ring->cqes[head & m_ring->cqMask];
+        if ( cqe.user_data != wxIO_URING_CANCEL_DATA )
+            completions.push_back(cqe);
+    }
+
+    StoreRelease(m_ring->cqHead, head);
+
+    const wxLongLong start = wxGetUTCTimeUSec();
+
+    int numEvents = 0;
+    for ( const io_uring_cqe& cqe : completions )
+    {
+        const int fd = GetFDFromUserData(cqe.user_data);
+        const wxUint32 generation = GetGenerationFromUserData(cqe.user_data);
+
+        // the descriptor could have been unregistered or modified since the
+        // request was queued, possibly by another handler called from this
+        // loop, in which case just ignore it
+        EntriesMap::iterator it = m_entries.find(fd);
+        if ( it == m_entries.end() || it->second.generation != generation )
+            continue;
+
+        it->second.armed = false;
+
+        if ( cqe.res == -ECANCELED )
+            continue;
+
+        wxFDIOHandler * const handler = it->second.handler;
+
+        // note that for compatibility with wxSelectDispatcher we call
+        // OnReadWaiting() on POLLHUP, as wxEpollDispatcher does
+        const int res = cqe.res;
+
+        // notice that the handler may unregister the descriptor, so don't use
+        // the iterator after calling it
+        if ( res < 0 )
+        {
+            // the request failed, e.g. because the descriptor is invalid: let
+            // the handler know about it and re-arm the request below as usual,
+            // as it's up to the handler to unregister the descriptor if it's
+            // not usable any more, just as with the other dispatchers
+            handler->OnExceptionWaiting();
+        }
+        else if ( res & (POLLIN | POLLHUP) )
+            handler->OnReadWaiting();
+        else if ( res & POLLOUT )
+            handler->OnWriteWaiting();
+        else if ( res & POLLERR )
+            handler->OnExceptionWaiting();
+
+        numEvents++;
+
+        // re-arm the one-shot request unless the handler did something with
+        // the descriptor already: the request will be submitted together
+        // with waiting for the next events
+        it = m_entries.find(fd);
+        if ( it != m_entries.end() &&
+                it->second.generation == generation &&
+                    !it->second.armed )
+        {
+            QueuePoll(fd, it->second);
+        }
+    }
+
+    UpdateStats(completions.size(), wxGetUTCTimeUSec() - start);
+
+    return numEvents;
+}
+
+#endif // wxUSE_EPOLL_DISPATCHER && wxHAS_IO_URING
@@ -30,7 +30,6 @@
 #include "wx/apptrait.h"
 #include "wx/longlong.h"
 #include "wx/time.h"
-#include "wx/vector.h"
 
 #include <sys/time.h>
 #include <signal.h>
@@ -46,6 +45,35 @@
 
 wxTimerScheduler *wxTimerScheduler::ms_instance = nullptr;
 
+namespace
+{
+
+// maximal delay allowed for coalescing the timers, in usec
+const wxLongLong_t wxTIMER_MAX_SLACK = 1 << 14;
+
+// return the expiration time of the timer with the given interval (in ms)
+// adjusted to allow notifying the timers expiring at nearly the same time
+// together, instead of waking up for each of them separately
+wxUsecClock_t GetCoalescedExpiration(wxUsecClock_t expiration, int interval)
+{
+    // allow delaying the timer by ~3% of its interval, but by not more than
+    // the maximal slack, and round it down to a power of 2 so that the timers
+    // with different intervals still expire at the same time
+    const wxLongLong_t maxSlack = wxMin(interval*1000LL / 32, wxTIMER_MAX_SLACK);
+
+    wxLongLong_t slack = 1;
+    while ( slack*2 <= maxSlack )
+        slack *= 2;
+
+    if ( slack == 1 )
+        return expiration;
+
+    const wxLongLong_t usec = expiration.GetValue();
+    return wxUsecClock_t(((usec + slack - 1) / slack) * slack);
+}
+
+} // anonymous namespace
+
 void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
     DoAddTimer(wxTimerSchedule(timer, expiration));
@@ -53,40 +81,92 @@ void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration
 
 void wxTimerScheduler::DoAddTimer(const wxTimerSchedule& s)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
-    {
-        wxASSERT_MSG( node->m_timer != s.m_timer,
-                      wxT("adding the same timer twice?") );
+    wxASSERT_MSG( s.m_timer->GetHeapIndex() >= m_timers.size() ||
+                    m_timers[s.m_timer->GetHeapIndex()].m_timer != s.m_timer,
+                  wxT("adding the same timer twice?") );
 
-        if ( node->m_expiration > s.m_expiration )
-            break;
-    }
+    wxTimerSchedule coalesced(s);
+    coalesced.m_expiration = GetCoalescedExpiration(s.m_expiration,
+                                                    s.m_timer->GetInterval());
 
-    m_timers.insert(node, s);
+    m_timers.push_back(coalesced);
+    s.m_timer->SetHeapIndex(m_timers.size() - 1);
+    SiftUp(m_timers.size() - 1);
 
-    wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
+    wxLogTrace(wxTrace_Timer,
+               wxT("Inserted timer %d expiring at %") wxLongLongFmtSpec wxT("d"),
                s.m_timer->GetId(),
-               s.m_expiration.ToString());
+               coalesced.m_expiration.GetValue());
 }
 
 void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
 {
     wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
 
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
+    const size_t index = timer->GetHeapIndex();
+    wxCHECK_RET( index < m_timers.size() && m_timers[index].m_timer == timer,
+                 wxT("removing inexistent timer?") );
+
+    DoRemoveTimer(index);
+}
+
+void wxTimerScheduler::DoRemoveTimer(size_t index)
+{
+    const size_t last = m_timers.size() - 1;
+    if ( index != last )
     {
-        if ( node->m_timer == timer )
-        {
-            m_timers.erase(node);
-            return;
-        }
+        // move the last timer into the freed position and restore the heap
+        // property, which could be violated in either direction
+        SetAt(index, m_timers[last]);
+        m_timers.pop_back();
+
+        SiftUp(index);
+        SiftDown(index);
+    }
+    else
+    {
+        m_timers.pop_back();
     }
+}
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+void wxTimerScheduler::SiftUp(size_t index)
+{
+    const wxTimerSchedule s = m_timers[index];
+    while ( index > 0 )
+    {
+        const size_t parent = (index - 1) / 2;
+        if ( m_timers[parent].m_expiration <= s.m_expiration )
+            break;
+
+        SetAt(index, m_timers[parent]);
+        index = parent;
+    }
+
+    SetAt(index, s);
+}
+
+void wxTimerScheduler::SiftDown(size_t index)
+{
+    const wxTimerSchedule s = m_timers[index];
+    const size_t count = m_timers.size();
+    for ( ;; )
+    {
+        size_t child = 2*index + 1;
+        if ( child >= count )
+            break;
+
+        if ( child + 1 < count &&
+                m_timers[child + 1].m_expiration < m_timers[child].m_expiration )
+            child++;
+
+        if ( s.m_expiration <= m_timers[child].m_expiration )
+            break;
+
+        SetAt(index, m_timers[child]);
+        index = child;
+    }
+
+    SetAt(index, s);
 }
 
 bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
@@ -96,7 +176,7 @@ bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
 
     wxCHECK_MSG( remaining, false, wxT("null pointer") );
 
-    *remaining = m_timers.begin()->m_expiration - wxGetUTCTimeUSec();
+    *remaining = m_timers.front().m_expiration - wxGetUTCTimeUSec();
     if ( *remaining < 0 )
     {
         // timer already expired, don't wait at all before notifying it
@@ -113,28 +193,22 @@ bool wxTimerScheduler::NotifyExpired()
 
     const wxUsecClock_t now = wxGetUTCTimeUSec();
 
-    typedef wxVector<wxUnixTimerImpl *> TimerImpls;
-    TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
-    {
-        wxTimerSchedule s = *cur;
-        if ( s.m_expiration > now )
-        {
-            // as the list is sorted by expiration time, we can skip the rest
-            break;
-        }
-
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
+    // we can't notify the timers while updating the heap as the timer event
+    // handler could modify it (for example, but not only, by stopping this
+    // timer), so collect them first; notice that we can't use m_toNotify
+    // directly as this function can be reentered from the event handlers
+    std::vector<wxUnixTimerImpl *> toNotify;
+    toNotify.swap(m_toNotify);
 
-        m_timers.erase(cur);
+    while ( !m_timers.empty() && m_timers.front().m_expiration <= now )
+    {
+        wxUnixTimerImpl * const timer = m_timers.front().m_timer;
 
         // check whether we need to keep this timer
-        wxUnixTimerImpl * const timer = s.m_timer;
         if ( timer->IsOneShot() )
         {
+            DoRemoveTimer(0);
+
             // the timer needs to be stopped but don't call its Stop() from
             // here as it would attempt to remove the timer from our list and
             // we had already done it, so we just need to reset its state
@@ -146,29 +220,32 @@ bool wxTimerScheduler::NotifyExpired()
             // the current time instead of just offsetting it from the current
             // expiration time because it could happen that we're late and the
             // current expiration time is (far) in the past
-            s.m_expiration = now + timer->GetInterval()*1000;
-            DoAddTimer(s);
+            //
+            // notice that the interval may be 0, but we still need to advance
+            // the expiration time to avoid looping here forever
+            const int interval = wxMax(timer->GetInterval(), 1);
+            m_timers.front().m_expiration =
+                GetCoalescedExpiration(now + interval*1000, interval);
+            SiftDown(0);
         }
 
-        // we can't notify the timer from this loop as the timer event handler
-        // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
-        // loop end
         toNotify.push_back(timer);
     }
 
-    if ( toNotify.empty() )
-        return false;
+    const bool notified = !toNotify.empty();
 
-    for ( TimerImpls::const_iterator i = toNotify.begin(),
-                                     end = toNotify.end();
-          i != end;
-          ++i )
+    for ( size_t n = 0; n < toNotify.size(); n++ )
     {
-        (*i)->Notify();
+        toNotify[n]->Notify();
     }
 
-    return true;
+    // reuse the vector memory the next time, unless the vector was already
+    // replaced during a reentrant call
+    toNotify.clear();
+    if ( m_toNotify.empty() )
+        toNotify.swap(m_toNotify);
+
+    return notified;
 }
 
 // ============================================================================
@@ -179,6 +256,7 @@ wxUnixTimerImpl::wxUnixTimerImpl(wxTimer* timer)
                : wxTimerImpl(timer)
 {
     m_isRunning = false;
+    m_heapIndex = 0;
 }
 
 bool wxUnixTimerImpl::Start(int milliseconds, bool oneShot)
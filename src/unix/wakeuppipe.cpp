@@ -26,6 +26,11 @@
 
 #include <errno.h>
 
+#ifdef wxHAS_EVENTFD
+    #include <sys/eventfd.h>
+    #include <stdint.h>
+#endif // wxHAS_EVENTFD
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -44,6 +49,19 @@ wxWakeUpPipe::wxWakeUpPipe()
 {
     m_pipeIsEmpty = true;
 
+#ifdef wxHAS_EVENTFD
+    m_eventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ( m_eventFD != wxPipe::INVALID_FD )
+    {
+        wxLogTrace(TRACE_EVENTS, wxT("Wake up eventfd %d created"), m_eventFD);
+        return;
+    }
+
+    // This is not supposed to happen, but fall back to using the pipe if
+    // it does.
+    wxLogTrace(TRACE_EVENTS, wxT("Failed to create eventfd (errno=%d)"), errno);
+#endif // wxHAS_EVENTFD
+
     if ( !m_pipe.Create() )
     {
         wxLogError(_("Failed to create wake up pipe used by event loop."));
@@ -61,6 +79,14 @@ wxWakeUpPipe::wxWakeUpPipe()
                m_pipe[wxPipe::Read], m_pipe[wxPipe::Write]);
 }
 
+wxWakeUpPipe::~wxWakeUpPipe()
+{
+#ifdef wxHAS_EVENTFD
+    if ( m_eventFD != wxPipe::INVALID_FD )
+        close(m_eventFD);
+#endif // wxHAS_EVENTFD
+}
+
 // ----------------------------------------------------------------------------
 // wakeup handling
 // ----------------------------------------------------------------------------
@@ -71,6 +97,24 @@ void wxWakeUpPipe::WakeUpNoLock()
     if ( !m_pipeIsEmpty )
       return;
 
+#ifdef wxHAS_EVENTFD
+    if ( m_eventFD != wxPipe::INVALID_FD )
+    {
+        const uint64_t value = 1;
+        if ( write(m_eventFD, &value, sizeof(value)) != sizeof(value) )
+        {
+            // see the comment below
+            perror("write(wake up eventfd)");
+        }
+        else
+        {
+            m_pipeIsEmpty = false;
+        }
+
+        return;
+    }
+#endif // wxHAS_EVENTFD
+
     if ( write(m_pipe[wxPipe::Write], "s", 1) != 1 )
     {
         // don't use wxLog here, we can be in another thread and this could
@@ -89,13 +133,24 @@ void wxWakeUpPipe::OnReadWaiting()
     // got wakeup from child thread, remove the data that provoked it from the
     // pipe
 
+#ifdef wxHAS_EVENTFD
+    // reading from eventfd always returns 8 bytes and resets its counter
+    const bool isEventFD = m_eventFD != wxPipe::INVALID_FD;
+    uint64_t buf[1];
+#else // !wxHAS_EVENTFD
     char buf[4];
+#endif // wxHAS_EVENTFD/!wxHAS_EVENTFD
     for ( ;; )
     {
-        const int size = read(GetReadFd(), buf, WXSIZEOF(buf));
+        const int size = read(GetReadFd(), buf, sizeof(buf));
 
         if ( size > 0 )
         {
+#ifdef wxHAS_EVENTFD
+            if ( isEventFD )
+                break;
+#endif // wxHAS_EVENTFD
+
             wxASSERT_MSG( size == 1, "Too many writes to wake-up pipe?" );
 
             break;
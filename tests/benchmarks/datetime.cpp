@@ -17,3 +17,97 @@ BENCHMARK_FUNC(ParseDate)
     return dt.ParseDate("May 23, 2011") && dt.GetMonth() == wxDateTime::May;
 }
 
+
+// ----------------------------------------------------------------------------
+// Formatting and parsing using wxDateTime and wxDateTimeFormatter
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const char* const formatDateTime = "%Y-%m-%d %H:%M:%S";
+
+// consecutive timestamps, as e.g. when formatting log records
+const wxDateTime dtFormatStart(23, wxDateTime::May, 2011, 12, 34, 56);
+
+const wxString dateToParse("2011-05-23 12:34:56");
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(FormatDateTime)
+{
+    wxDateTime dt = dtFormatStart;
+    for ( int n = 0; n < 100; n++ )
+    {
+        if ( dt.Format(formatDateTime).empty() )
+            return false;
+
+        dt += wxTimeSpan::Milliseconds(1234);
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(FormatDateTimeFormatter)
+{
+    static wxDateTimeFormatter formatter(formatDateTime);
+
+    wxDateTime dt = dtFormatStart;
+    for ( int n = 0; n < 100; n++ )
+    {
+        if ( formatter.Format(dt).empty() )
+            return false;
+
+        dt += wxTimeSpan::Milliseconds(1234);
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(FormatDateTimeMSec)
+{
+    wxDateTime dt = dtFormatStart;
+    for ( int n = 0; n < 100; n++ )
+    {
+        if ( dt.Format("%Y-%m-%d %H:%M:%S.%l").empty() )
+            return false;
+
+        dt += wxTimeSpan::Milliseconds(1234);
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(FormatDateTimeMSecFormatter)
+{
+    static wxDateTimeFormatter formatter("%Y-%m-%d %H:%M:%S.%l");
+
+    wxDateTime dt = dtFormatStart;
+    for ( int n = 0; n < 100; n++ )
+    {
+        if ( formatter.Format(dt).empty() )
+            return false;
+
+        dt += wxTimeSpan::Milliseconds(1234);
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ParseFormat)
+{
+    wxDateTime dt;
+    wxString::const_iterator end;
+    return dt.ParseFormat(dateToParse, formatDateTime, wxDefaultDateTime, &end)
+            && dt.GetMonth() == wxDateTime::May;
+}
+
+BENCHMARK_FUNC(ParseFormatFormatter)
+{
+    static wxDateTimeFormatter formatter(formatDateTime);
+
+    wxDateTime dt;
+    wxString::const_iterator end;
+    return formatter.Parse(dateToParse, &dt, &end)
+            && dt.GetMonth() == wxDateTime::May;
+}
@@ -0,0 +1,175 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Event queuing and processing benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+
+#include <memory>
+#include <vector>
+
+#include "bench.h"
+
+namespace
+{
+
+// Number of events processed by each ProcessEvent benchmark iteration.
+const int NUM_PROCESSED_EVENTS = 1000;
+
+// Handler with the given number of handlers for different event types bound
+// to it, the first bound one being for the type of the returned events.
+class ManyHandlers : public wxEvtHandler
+{
+public:
+    explicit ManyHandlers(long numHandlers)
+    {
+        m_count = 0;
+
+        m_eventType = wxNewEventType();
+        Bind(m_eventType, &ManyHandlers::OnEvent, this);
+
+        for ( long n = 1; n < numHandlers; n++ )
+            Bind(wxNewEventType(), &ManyHandlers::OnEvent, this);
+    }
+
+    wxEventType GetEventType() const { return m_eventType; }
+
+    long GetCount() const { return m_count; }
+
+private:
+    void OnEvent(wxEvent& WXUNUSED(event)) { m_count++; }
+
+    wxEventType m_eventType;
+    long m_count;
+};
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(ProcessEventManyHandlers)
+{
+    static ManyHandlers handler(Bench::GetNumericParameter(200));
+
+    const long countBefore = handler.GetCount();
+
+    wxThreadEvent event(handler.GetEventType());
+    for ( int n = 0; n < NUM_PROCESSED_EVENTS; n++ )
+        handler.ProcessEvent(event);
+
+    return handler.GetCount() == countBefore + NUM_PROCESSED_EVENTS;
+}
+
+BENCHMARK_FUNC(ProcessEventManyHandlersUnhandled)
+{
+    static ManyHandlers handler(Bench::GetNumericParameter(200));
+
+    wxThreadEvent event(wxNewEventType());
+    for ( int n = 0; n < NUM_PROCESSED_EVENTS; n++ )
+    {
+        if ( handler.ProcessEvent(event) )
+            return false;
+    }
+
+    return true;
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+class EventCounter : public wxEvtHandler
+{
+public:
+    EventCounter()
+    {
+        m_count = 0;
+
+        Bind(wxEVT_THREAD, &EventCounter::OnThreadEvent, this);
+    }
+
+    long GetCount() const { return m_count; }
+
+private:
+    void OnThreadEvent(wxThreadEvent& WXUNUSED(event)) { m_count++; }
+
+    long m_count;
+};
+
+class ProducerThread : public wxThread
+{
+public:
+    ProducerThread(wxEvtHandler* handler, long numEvents)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_handler(handler),
+          m_numEvents(numEvents)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( long n = 0; n < m_numEvents; n++ )
+        {
+            wxThreadEvent* const event = new wxThreadEvent();
+            event->SetInt(n);
+            wxQueueEvent(m_handler, event);
+        }
+
+        return nullptr;
+    }
+
+private:
+    wxEvtHandler* const m_handler;
+    const long m_numEvents;
+};
+
+// Queue events from the given number of threads, while processing them in
+// the main one, and return true if all of them were processed.
+bool QueueFromThreads(int numThreads)
+{
+    const long numEventsPerThread = Bench::GetNumericParameter(100000) / numThreads;
+
+    EventCounter handler;
+
+    std::vector<std::unique_ptr<ProducerThread>> threads;
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        threads.emplace_back(new ProducerThread(&handler, numEventsPerThread));
+        if ( threads.back()->Run() != wxTHREAD_NO_ERROR )
+            return false;
+    }
+
+    const long numEvents = numEventsPerThread*numThreads;
+    while ( handler.GetCount() < numEvents )
+        wxTheApp->ProcessPendingEvents();
+
+    for ( const auto& thread : threads )
+        thread->Wait();
+
+    return handler.GetCount() == numEvents;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(QueueEvent1Thread)
+{
+    return QueueFromThreads(1);
+}
+
+BENCHMARK_FUNC(QueueEvent4Threads)
+{
+    return QueueFromThreads(4);
+}
+
+BENCHMARK_FUNC(QueueEvent16Threads)
+{
+    return QueueFromThreads(16);
+}
+
+#endif // wxUSE_THREADS
@@ -0,0 +1,287 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/fdio.cpp
+// Purpose:     wxFDIODispatcher benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#ifdef __UNIX__
+
+#include "wx/private/fdiodispatcher.h"
+#include "wx/unix/private/epolldispatcher.h"
+#include "wx/unix/private/iouringdispatcher.h"
+
+#include <memory>
+#include <vector>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "bench.h"
+
+namespace
+{
+
+// Handler reading everything available from a pipe.
+class PipeReader : public wxFDIOHandler
+{
+public:
+    explicit PipeReader(int fd) : m_fd(fd) { }
+
+    virtual void OnReadWaiting() override
+    {
+        char buf[64];
+        while ( read(m_fd, buf, sizeof(buf)) > 0 )
+            ;
+    }
+
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+private:
+    const int m_fd;
+};
+
+// Contains the given number of pipes, 1000 by default, registered with the
+// global dispatcher using the given flags.
+class ManyPipes
+{
+public:
+    explicit ManyPipes(int flags)
+    {
+        m_dispatcher = wxFDIODispatcher::Get();
+
+        const long count = Bench::GetNumericParameter(1000);
+        for ( long n = 0; n < count; n++ )
+        {
+            int fds[2];
+            if ( pipe(fds) != 0 )
+                break;
+
+            fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+            m_readers.emplace_back(new PipeReader(fds[0]));
+            m_dispatcher->RegisterFD(fds[0], m_readers.back().get(), flags);
+
+            m_readFDs.push_back(fds[0]);
+            m_writeFDs.push_back(fds[1]);
+        }
+    }
+
+    // Notice that we don't unregister the descriptors here because this
+    // object is static and is destroyed after the global dispatcher.
+    ~ManyPipes()
+    {
+        for ( size_t n = 0; n < m_readFDs.size(); n++ )
+        {
+            close(m_readFDs[n]);
+            close(m_writeFDs[n]);
+        }
+    }
+
+    // Make all the pipes readable and dispatch the events until all of them
+    // are processed.
+    bool WriteAndDispatch()
+    {
+        if ( !m_dispatcher )
+            return false;
+
+        for ( int fd : m_writeFDs )
+        {
+            if ( write(fd, "x", 1) != 1 )
+                return false;
+        }
+
+        while ( m_dispatcher->Dispatch(0) > 0 )
+            ;
+
+        return true;
+    }
+
+private:
+    wxFDIODispatcher* m_dispatcher;
+
+    std::vector<std::unique_ptr<PipeReader>> m_readers;
+    std::vector<int> m_readFDs,
+                     m_writeFDs;
+};
+
+#if wxUSE_EPOLL_DISPATCHER
+
+// Size of the data sent over each connection during each benchmark run.
+const size_t LOOPBACK_DATA_SIZE = 16*1024;
+
+// Handler reading everything available from a socket and counting the bytes.
+class SocketReader : public wxFDIOHandler
+{
+public:
+    SocketReader(int fd, size_t& total) : m_fd(fd), m_total(total) { }
+
+    virtual void OnReadWaiting() override
+    {
+        char buf[4096];
+        for ( ;; )
+        {
+            const ssize_t rc = read(m_fd, buf, sizeof(buf));
+            if ( rc <= 0 )
+                break;
+
+            m_total += rc;
+        }
+    }
+
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+private:
+    const int m_fd;
+    size_t& m_total;
+};
+
+// Contains the given number of TCP connections over the loopback interface,
+// 100 by default, with the receiving ends registered with the given
+// dispatcher, which is owned by this object.
+class LoopbackConnections
+{
+public:
+    explicit LoopbackConnections(wxFDIODispatcher* dispatcher)
+        : m_dispatcher(dispatcher),
+          m_data(LOOPBACK_DATA_SIZE, 'x')
+    {
+        m_received = 0;
+
+        if ( !m_dispatcher )
+            return;
+
+        const int listener = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in addr = sockaddr_in();
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addrLen = sizeof(addr);
+        if ( bind(listener, (sockaddr*)&addr, addrLen) != 0 ||
+                listen(listener, SOMAXCONN) != 0 ||
+                    getsockname(listener, (sockaddr*)&addr, &addrLen) != 0 )
+        {
+            close(listener);
+            return;
+        }
+
+        const long count = Bench::GetNumericParameter(100);
+        for ( long n = 0; n < count; n++ )
+        {
+            const int client = socket(AF_INET, SOCK_STREAM, 0);
+            if ( connect(client, (sockaddr*)&addr, addrLen) != 0 )
+            {
+                close(client);
+                break;
+            }
+
+            const int server = accept(listener, nullptr, nullptr);
+            fcntl(server, F_SETFL, O_NONBLOCK);
+
+            m_readers.emplace_back(new SocketReader(server, m_received));
+            m_dispatcher->RegisterFD(server, m_readers.back().get(),
+                                     wxFDIO_INPUT);
+
+            m_clientFDs.push_back(client);
+            m_serverFDs.push_back(server);
+        }
+
+        close(listener);
+    }
+
+    ~LoopbackConnections()
+    {
+        for ( size_t n = 0; n < m_serverFDs.size(); n++ )
+        {
+            m_dispatcher->UnregisterFD(m_serverFDs[n]);
+            close(m_serverFDs[n]);
+            close(m_clientFDs[n]);
+        }
+    }
+
+    // Send the data over all connections and dispatch the events until all
+    // of it is received.
+    bool SendAndReceive()
+    {
+        if ( m_clientFDs.empty() )
+            return false;
+
+        m_received = 0;
+
+        for ( int fd : m_clientFDs )
+        {
+            if ( write(fd, m_data.data(), m_data.size()) != (ssize_t)m_data.size() )
+                return false;
+        }
+
+        const size_t total = m_data.size()*m_clientFDs.size();
+        while ( m_received < total )
+        {
+            if ( m_dispatcher->Dispatch(1000) <= 0 )
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    std::unique_ptr<wxFDIODispatcher> m_dispatcher;
+
+    std::vector<std::unique_ptr<SocketReader>> m_readers;
+    std::vector<int> m_clientFDs,
+                     m_serverFDs;
+
+    const std::vector<char> m_data;
+    size_t m_received;
+};
+
+#endif // wxUSE_EPOLL_DISPATCHER
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(DispatchManyPipes)
+{
+    static ManyPipes pipes(wxFDIO_INPUT);
+
+    return pipes.WriteAndDispatch();
+}
+
+BENCHMARK_FUNC(DispatchManyPipesEdgeTriggered)
+{
+    static ManyPipes pipes(wxFDIO_INPUT | wxFDIO_EDGE_TRIGGERED);
+
+    return pipes.WriteAndDispatch();
+}
+
+#if wxUSE_EPOLL_DISPATCHER
+
+BENCHMARK_FUNC(LoopbackEpoll)
+{
+    static LoopbackConnections connections(wxEpollDispatcher::Create());
+
+    return connections.SendAndReceive();
+}
+
+#ifdef wxHAS_IO_URING
+
+BENCHMARK_FUNC(LoopbackIOUring)
+{
+    static LoopbackConnections connections(wxIOUringDispatcher::Create());
+
+    return connections.SendAndReceive();
+}
+
+#endif // wxHAS_IO_URING
+
+#endif // wxUSE_EPOLL_DISPATCHER
+
+#endif // __UNIX__
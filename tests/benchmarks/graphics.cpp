@@ -66,6 +66,7 @@ struct GraphicsBenchmarkOptions
         testRectangles =
         testCircles =
         testEllipses =
+        testGradients =
         testTextExtent =
         testMultiLineTextExtent =
         testPartialTextExtents = false;
@@ -97,6 +98,7 @@ struct GraphicsBenchmarkOptions
          testRectangles,
          testCircles,
          testEllipses,
+         testGradients,
          testTextExtent,
          testMultiLineTextExtent,
          testPartialTextExtents;
@@ -404,6 +406,7 @@ private:
         BenchmarkRoundedRectangles(msg, dc);
         BenchmarkCircles(msg, dc);
         BenchmarkEllipses(msg, dc);
+        BenchmarkGradients(msg, dc);
         BenchmarkTextExtent(msg, dc);
         BenchmarkPartialTextExtents(msg, dc);
     }
@@ -635,6 +638,82 @@ private:
                  opts.numIters, t, (1000. * t)/opts.numIters);
     }
 
+    void BenchmarkGradients(const wxString& msg, wxDC& dc)
+    {
+        if ( !opts.testGradients )
+            return;
+
+        SetupDC(dc);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        // Filling the same rectangles repeatedly is common when redrawing
+        // and allows wxGCDC to reuse the gradient brushes it creates.
+        const wxRect rects[] =
+        {
+            wxRect(0, 0, 64, 32),
+            wxRect(opts.width / 2, 0, 64, 32),
+            wxRect(0, opts.height / 2, 64, 32),
+            wxRect(opts.width / 2, opts.height / 2, 64, 32),
+        };
+
+        wxStopWatch sw;
+        for ( long n = 0; n < opts.numIters; n++ )
+        {
+            dc.GradientFillLinear(rects[n % WXSIZEOF(rects)], *wxRED, *wxBLUE);
+        }
+
+        long t = sw.Time();
+
+        wxPrintf("%ld gradients in the same rectangles done in %ldms = %gus/gradient\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+
+        // And filling rectangles at different positions, which can't reuse
+        // them as the gradient brushes are created in absolute coordinates.
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        for ( long n = 0; n < opts.numIters; n++ )
+        {
+            int x = rand() % opts.width,
+                y = rand() % opts.height;
+
+            dc.GradientFillLinear(wxRect(x, y, 64, 32), *wxRED, *wxBLUE);
+        }
+
+        t = sw.Time();
+
+        wxPrintf("%ld gradients done in %ldms = %gus/gradient\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+
+        // Switching between a few pens and brushes is very common in real
+        // drawing code and requires converting them to the graphics objects
+        // every time when using wxGCDC.
+        const wxPen pens[] = { *wxBLACK_PEN, *wxRED_PEN, *wxBLUE_PEN };
+        const wxBrush brushes[] = { *wxWHITE_BRUSH, *wxYELLOW_BRUSH };
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        for ( long n = 0; n < opts.numIters; n++ )
+        {
+            int x = rand() % opts.width,
+                y = rand() % opts.height;
+
+            dc.SetPen(pens[n % WXSIZEOF(pens)]);
+            dc.SetBrush(brushes[n % WXSIZEOF(brushes)]);
+            dc.DrawRectangle(x, y, 32, 32);
+        }
+
+        const long t2 = sw.Time();
+
+        wxPrintf("%ld pen and brush changes done in %ldms = %gus/rect\n",
+                 opts.numIters, t2, (1000. * t2)/opts.numIters);
+    }
+
     void BenchmarkTextExtent(const wxString& msg, wxDC& dc)
     {
         if ( !opts.testTextExtent )
@@ -866,6 +945,7 @@ public:
             { wxCMD_LINE_SWITCH, "",  "rectangles" },
             { wxCMD_LINE_SWITCH, "",  "circles" },
             { wxCMD_LINE_SWITCH, "",  "ellipses" },
+            { wxCMD_LINE_SWITCH, "",  "gradients" },
             { wxCMD_LINE_SWITCH, "",  "textextent" },
             { wxCMD_LINE_SWITCH, "",  "multilinetextextent" },
             { wxCMD_LINE_SWITCH, "",  "partialtextextents" },
@@ -956,12 +1036,14 @@ public:
         opts.testRectangles = parser.Found("rectangles");
         opts.testCircles = parser.Found("circles");
         opts.testEllipses = parser.Found("ellipses");
+        opts.testGradients = parser.Found("gradients");
         opts.testTextExtent = parser.Found("textextent");
         opts.testMultiLineTextExtent = parser.Found("multilinetextextent");
         opts.testPartialTextExtents = parser.Found("partialtextextents");
         if ( !(opts.testBitmaps || opts.testImages || opts.testLines
                     || opts.testRawBitmaps || opts.testRectangles
                     || opts.testCircles || opts.testEllipses
+                    || opts.testGradients
                     || opts.testTextExtent || opts.testPartialTextExtents) )
         {
             // Do everything by default.
@@ -972,6 +1054,7 @@ public:
             opts.testRectangles =
             opts.testCircles =
             opts.testEllipses =
+            opts.testGradients =
             opts.testTextExtent =
             opts.testPartialTextExtents = true;
         }
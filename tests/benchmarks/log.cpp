@@ -10,6 +10,11 @@
 #include "bench.h"
 
 #include "wx/log.h"
+#include "wx/logasync.h"
+#include "wx/logbinary.h"
+#include "wx/filename.h"
+
+#include <memory>
 
 // This class is used to check that the arguments of log functions are not
 // evaluated.
@@ -106,3 +111,137 @@ BENCHMARK_FUNC(LogTraceInactive)
 
     return true;
 }
+
+// Check the messages from a component when levels are set for several other
+// components and one of its parents.
+#undef wxLOG_COMPONENT
+#define wxLOG_COMPONENT "logbench/sub/subsub"
+
+BENCHMARK_FUNC(LogDebugComponentDisabled)
+{
+    static bool s_set = false;
+    if ( !s_set )
+    {
+        s_set = true;
+
+        wxLog::SetComponentLevel("logbench/other", wxLOG_Max);
+        wxLog::SetComponentLevel("logbench/sub", wxLOG_Info);
+        wxLog::SetComponentLevel("logbench/sub/other", wxLOG_Max);
+        wxLog::SetComponentLevel("otherbench", wxLOG_Max);
+    }
+
+    wxLogDebug("Ignored debug message: %s", NotCreated().AsStr());
+
+    return true;
+}
+
+BENCHMARK_FUNC(LogTraceInactiveWithMasks)
+{
+    static bool s_added = false;
+    if ( !s_added )
+    {
+        s_added = true;
+        wxLog::AddTraceMask("logbench1");
+        wxLog::AddTraceMask("logbench2");
+        wxLog::AddTraceMask("logbench3");
+    }
+
+    wxLogTrace("bloordyblop", "Trace message");
+
+    return true;
+}
+
+// Compare writing messages synchronously and asynchronously: we write them to
+// the null device to measure the overhead for the logging thread only.
+#ifdef __WINDOWS__
+    #define NULL_DEVICE "NUL"
+#else
+    #define NULL_DEVICE "/dev/null"
+#endif
+
+// Temporarily change the active log target to the given one.
+class LogTargetSetter
+{
+public:
+    explicit LogTargetSetter(wxLog* log)
+        : m_logOld(wxLog::SetActiveTarget(log))
+    {
+    }
+
+    ~LogTargetSetter()
+    {
+        wxLog::SetActiveTarget(m_logOld);
+    }
+
+private:
+    wxLog* const m_logOld;
+
+    wxDECLARE_NO_COPY_CLASS(LogTargetSetter);
+};
+
+#undef wxLOG_COMPONENT
+#define wxLOG_COMPONENT "logbench"
+
+BENCHMARK_FUNC(LogStderrNull)
+{
+    static FILE* const s_fp = fopen(NULL_DEVICE, "w");
+    static wxLogStderr s_log(s_fp);
+
+    LogTargetSetter target(&s_log);
+
+    wxLogMessage("Message number %d", 17);
+
+    return true;
+}
+
+#if wxUSE_THREADS
+
+BENCHMARK_FUNC(LogAsyncNull)
+{
+    static FILE* const s_fp = fopen(NULL_DEVICE, "w");
+    static wxLogAsync s_log(s_fp);
+
+    LogTargetSetter target(&s_log);
+
+    wxLogMessage("Message number %d", 17);
+
+    return true;
+}
+
+#endif // wxUSE_THREADS
+
+// wxLogBinary writing to a temporary file deleted when it is destroyed.
+class LogBinaryTempFile
+{
+public:
+    LogBinaryTempFile()
+        : m_filename(wxFileName::CreateTempFileName("logbench")),
+          m_log(new wxLogBinary(m_filename))
+    {
+    }
+
+    ~LogBinaryTempFile()
+    {
+        m_log.reset();
+        wxRemoveFile(m_filename);
+    }
+
+    wxLog* Get() const { return m_log.get(); }
+
+private:
+    const wxString m_filename;
+    std::unique_ptr<wxLogBinary> m_log;
+
+    wxDECLARE_NO_COPY_CLASS(LogBinaryTempFile);
+};
+
+BENCHMARK_FUNC(LogBinaryFile)
+{
+    static LogBinaryTempFile s_log;
+
+    LogTargetSetter target(s_log.Get());
+
+    wxLogMessage("Message number %d", 17);
+
+    return true;
+}
@@ -42,6 +42,74 @@ bool ConvertToMB(const wxMBConv& conv)
     return conv.FromWChar(buf.data(), outlen, TEST_STRING) == outlen;
 }
 
+// Default length of the text used in UTF-8 benchmarks, can be changed with -n.
+const long DEFAULT_UTF8_TEXT_LENGTH = 1024*1024;
+
+// Return the UTF-8 text consisting of the test string, possibly with some
+// non-ASCII characters, repeated as many times as necessary.
+const wxCharBuffer& GetUTF8Text(bool ascii)
+{
+    static wxCharBuffer s_texts[2];
+
+    wxCharBuffer& text = s_texts[ascii];
+    if ( !text.length() )
+    {
+        const size_t len = Bench::GetNumericParameter(DEFAULT_UTF8_TEXT_LENGTH);
+
+        wxString str;
+        while ( str.length() < len )
+        {
+            str += TEST_STRING;
+            if ( !ascii )
+                str += wxString::FromUTF8("\xc3\xa9t\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80");
+        }
+
+        text = str.utf8_str();
+    }
+
+    return text;
+}
+
+const wxWCharBuffer& GetWideText(bool ascii)
+{
+    static wxWCharBuffer s_texts[2];
+
+    wxWCharBuffer& text = s_texts[ascii];
+    if ( !text.length() )
+    {
+        const wxCharBuffer& utf8 = GetUTF8Text(ascii);
+        text = wxConvUTF8.cMB2WC(utf8.data(), utf8.length(), nullptr);
+    }
+
+    return text;
+}
+
+bool DecodeUTF8(const wxMBConv& conv, bool ascii)
+{
+    const wxCharBuffer& text = GetUTF8Text(ascii);
+    const wxWCharBuffer& wide = GetWideText(ascii);
+
+    static wxWCharBuffer s_buf;
+    if ( s_buf.length() < wide.length() )
+        s_buf.extend(wide.length());
+
+    return conv.ToWChar(s_buf.data(), wide.length(),
+                        text.data(), text.length()) == wide.length();
+}
+
+bool EncodeUTF8(const wxMBConv& conv, bool ascii)
+{
+    const wxCharBuffer& text = GetUTF8Text(ascii);
+    const wxWCharBuffer& wide = GetWideText(ascii);
+
+    static wxCharBuffer s_buf;
+    if ( s_buf.length() < text.length() )
+        s_buf.extend(text.length());
+
+    return conv.FromWChar(s_buf.data(), text.length(),
+                          wide.data(), wide.length()) == text.length();
+}
+
 } // anonymous namespace
 
 BENCHMARK_FUNC(UTF16InitWX)
@@ -76,3 +144,40 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+BENCHMARK_FUNC(UTF8DecodeASCII)
+{
+    return DecodeUTF8(wxConvUTF8, true);
+}
+
+BENCHMARK_FUNC(UTF8DecodeMixed)
+{
+    return DecodeUTF8(wxConvUTF8, false);
+}
+
+BENCHMARK_FUNC(UTF8DecodePUA)
+{
+    return DecodeUTF8(wxMBConvUTF8(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA), true);
+}
+
+BENCHMARK_FUNC(UTF8EncodeASCII)
+{
+    return EncodeUTF8(wxConvUTF8, true);
+}
+
+BENCHMARK_FUNC(UTF8EncodeMixed)
+{
+    return EncodeUTF8(wxConvUTF8, false);
+}
+
+BENCHMARK_FUNC(UTF8EncodePUA)
+{
+    return EncodeUTF8(wxMBConvUTF8(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA), true);
+}
+
+BENCHMARK_FUNC(UTF8StringFromASCII)
+{
+    const wxCharBuffer& text = GetUTF8Text(true);
+
+    return wxString::FromUTF8(text.data(), text.length()).length() == text.length();
+}
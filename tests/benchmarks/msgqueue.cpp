@@ -0,0 +1,150 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/msgqueue.cpp
+// Purpose:     wxMessageQueue and wxBoundedMessageQueue benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/msgqueue.h"
+
+#include <memory>
+#include <vector>
+
+#include "bench.h"
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Capacity of the bounded queues used in the benchmarks.
+const size_t QUEUE_CAPACITY = 1024;
+
+template <typename Queue>
+class ProducerThread : public wxThread
+{
+public:
+    ProducerThread(Queue& queue, long numMessages)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_queue(queue),
+          m_numMessages(numMessages)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( long n = 1; n <= m_numMessages; n++ )
+            m_queue.Post(n);
+
+        return nullptr;
+    }
+
+private:
+    Queue& m_queue;
+    const long m_numMessages;
+};
+
+// Receive a single message, adding it to the sum, and return the number of
+// messages received or -1 on error.
+template <typename Queue>
+long ReceiveOne(Queue& queue, long& sum)
+{
+    long msg;
+    if ( queue.Receive(msg) != wxMSGQUEUE_NO_ERROR )
+        return -1;
+
+    sum += msg;
+    return 1;
+}
+
+// Same as ReceiveOne() but receive all the available messages at once.
+template <typename Queue>
+long ReceiveAll(Queue& queue, long& sum)
+{
+    std::vector<long> messages;
+    if ( queue.ReceiveAll(messages) != wxMSGQUEUE_NO_ERROR )
+        return -1;
+
+    for ( long msg : messages )
+        sum += msg;
+
+    return messages.size();
+}
+
+// Post messages to the given queue from the given number of threads while
+// receiving them using the provided function in the main thread and return
+// true if all of them were received.
+template <typename Queue>
+bool PostFromThreads(Queue& queue, int numThreads,
+                     long (*receive)(Queue&, long&) = ReceiveOne<Queue>)
+{
+    const long numPerThread = Bench::GetNumericParameter(100000) / numThreads;
+
+    std::vector<std::unique_ptr<ProducerThread<Queue>>> threads;
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        threads.emplace_back(new ProducerThread<Queue>(queue, numPerThread));
+        if ( threads.back()->Run() != wxTHREAD_NO_ERROR )
+            return false;
+    }
+
+    const long numMessages = numPerThread*numThreads;
+    long numReceived = 0,
+         sum = 0;
+    while ( numReceived < numMessages )
+    {
+        const long count = receive(queue, sum);
+        if ( count < 0 )
+            return false;
+
+        numReceived += count;
+    }
+
+    for ( const auto& thread : threads )
+        thread->Wait();
+
+    return sum == numThreads*(numPerThread*(numPerThread + 1)/2);
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(MessageQueue1Producer)
+{
+    wxMessageQueue<long> queue;
+    return PostFromThreads(queue, 1);
+}
+
+BENCHMARK_FUNC(MessageQueue4Producers)
+{
+    wxMessageQueue<long> queue;
+    return PostFromThreads(queue, 4);
+}
+
+BENCHMARK_FUNC(BoundedMessageQueueSPSC)
+{
+    wxBoundedMessageQueue<long, wxMSGQUEUE_SPSC> queue(QUEUE_CAPACITY);
+    return PostFromThreads(queue, 1);
+}
+
+BENCHMARK_FUNC(BoundedMessageQueueSPSCReceiveAll)
+{
+    wxBoundedMessageQueue<long, wxMSGQUEUE_SPSC> queue(QUEUE_CAPACITY);
+    return PostFromThreads(queue, 1, ReceiveAll);
+}
+
+BENCHMARK_FUNC(BoundedMessageQueueMPMC4Producers)
+{
+    wxBoundedMessageQueue<long> queue(QUEUE_CAPACITY);
+    return PostFromThreads(queue, 4);
+}
+
+BENCHMARK_FUNC(BoundedMessageQueueMPMC4ProducersReceiveAll)
+{
+    wxBoundedMessageQueue<long> queue(QUEUE_CAPACITY);
+    return PostFromThreads(queue, 4, ReceiveAll);
+}
+
+#endif // wxUSE_THREADS
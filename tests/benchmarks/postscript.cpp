@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/postscript.cpp
+// Purpose:     wxPostScriptDC benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/bitmap.h"
+#include "wx/dcps.h"
+#include "wx/filename.h"
+#include "wx/image.h"
+
+#include "bench.h"
+
+#if wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
+
+namespace
+{
+
+// Print a report-like document with a few lines of text, some lines and a
+// small bitmap on each page and return the size of the output.
+wxFileOffset PrintReport()
+{
+    const long numPages = Bench::GetNumericParameter(100);
+
+    const wxString filename = wxFileName::CreateTempFileName("wxbench");
+
+    wxPrintData printData;
+    printData.SetPrintMode(wxPRINT_MODE_FILE);
+    printData.SetFilename(filename);
+
+    wxImage image(64, 64);
+    for ( int y = 0; y < 64; y++ )
+    {
+        for ( int x = 0; x < 64; x++ )
+            image.SetRGB(x, y, x*4, y*4, 128);
+    }
+    const wxBitmap bitmap(image);
+
+    {
+        wxPostScriptDC dc(printData);
+        dc.StartDoc("Benchmark");
+        dc.SetFont(*wxNORMAL_FONT);
+
+        for ( long page = 0; page < numPages; page++ )
+        {
+            dc.StartPage();
+
+            dc.DrawBitmap(bitmap, 10, 10);
+
+            for ( int line = 0; line < 50; line++ )
+            {
+                const int y = 100 + line*15;
+
+                dc.SetPen(line % 5 ? *wxBLACK_PEN : *wxGREY_PEN);
+                dc.DrawLine(10, y, 500, y);
+                dc.DrawText(wxString::Format("Line %d of page %ld", line, page),
+                            20, y + 2);
+            }
+
+            dc.EndPage();
+        }
+
+        dc.EndDoc();
+    }
+
+    const wxFileOffset size = wxFileName::GetSize(filename).GetValue();
+    wxRemoveFile(filename);
+
+    return size;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(PostScriptReport)
+{
+    return PrintReport() > 0;
+}
+
+#endif // wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
@@ -132,3 +132,42 @@ BENCHMARK_FUNC(SystemSnprintf)
     return true;
 }
 
+
+// ----------------------------------------------------------------------------
+// wxString::Format() benchmarks
+// ----------------------------------------------------------------------------
+
+BENCHMARK_FUNC(StringFormat)
+{
+    static int s_n = 0;
+
+    return !wxString::Format("Item %d of %d", ++s_n, 100).empty();
+}
+
+BENCHMARK_FUNC(StringFormatMixed)
+{
+    static const wxString s_name("wxWidgets");
+
+    return !wxString::Format("%s: %5d items, %.2f%% done, id %#x",
+                             s_name, 42, 99.5, 0xbeef).empty();
+}
+
+BENCHMARK_FUNC(StringFormatLong)
+{
+    return !wxString::Format
+            (
+                "This is a reasonably long string with various %s arguments, "
+                "exactly %d, and is used as benchmark for %s - %% %.2f %d %s",
+                "(many!!)", 6, "this program", 23.342f, 999, g_verylongString
+            ).empty();
+}
+
+// This one can't be formatted by wxString itself and uses the CRT.
+BENCHMARK_FUNC(StringFormatWithPositionals)
+{
+    return !wxString::Format
+            (
+                "This is a %2$s and thus is harder to parse... nonetheless, %1$s !",
+                "test it", "string with positional arguments"
+            ).empty();
+}
@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/region.cpp
+// Purpose:     wxRegion benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/region.h"
+
+#include <vector>
+
+#include "bench.h"
+
+namespace
+{
+
+// Return the given number of small rectangles scattered over a big area, as
+// could be accumulated when tracking the damaged parts of a window.
+const std::vector<wxRect>& GetDamageRects()
+{
+    static std::vector<wxRect> s_rects;
+    if ( s_rects.empty() )
+    {
+        const long numRects = Bench::GetNumericParameter(10000);
+
+        // Use a simple LCG to get the same rectangles every time.
+        unsigned seed = 17;
+        auto next = [&seed](int max)
+        {
+            seed = seed*1103515245 + 12345;
+            return static_cast<int>((seed >> 16) % max);
+        };
+
+        s_rects.reserve(numRects);
+        for ( long n = 0; n < numRects; n++ )
+        {
+            s_rects.push_back(wxRect(next(2000), next(2000),
+                                     next(20) + 1, next(20) + 1));
+        }
+    }
+
+    return s_rects;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(RegionUnionEachRect)
+{
+    const std::vector<wxRect>& rects = GetDamageRects();
+
+    wxRegion region;
+    for ( const auto& rect : rects )
+        region.Union(rect);
+
+    return !region.IsEmpty();
+}
+
+BENCHMARK_FUNC(RegionUnionAllRects)
+{
+    const std::vector<wxRect>& rects = GetDamageRects();
+
+    wxRegion region;
+    region.Union(rects.size(), rects.data());
+
+    return !region.IsEmpty();
+}
+
+BENCHMARK_FUNC(RegionContains)
+{
+    static wxRegion s_region;
+    if ( !s_region.IsOk() )
+    {
+        const std::vector<wxRect>& rects = GetDamageRects();
+        s_region.Union(rects.size(), rects.data());
+    }
+
+    int numInside = 0;
+    for ( int y = 0; y < 2000; y += 10 )
+    {
+        for ( int x = 0; x < 2000; x += 10 )
+        {
+            if ( s_region.Contains(x, y) == wxInRegion )
+                numInside++;
+        }
+    }
+
+    return numInside > 0;
+}
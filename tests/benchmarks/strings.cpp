@@ -10,6 +10,7 @@
 #include "wx/string.h"
 #include "wx/ffile.h"
 #include "wx/arrstr.h"
+#include "wx/numformatter.h"
 
 #include "bench.h"
 #include "htmlparser/htmlpars.h"
@@ -190,6 +191,77 @@ BENCHMARK_FUNC(FromAsciiWithLen)
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// short strings such as widget labels
+// ----------------------------------------------------------------------------
+
+static const char* const labels[] =
+{
+    "OK",
+    "Cancel",
+    "&Apply",
+    "&File",
+    "&Open...\tCtrl-O",
+    "Save &As...\tCtrl-Shift-S",
+    "Show &hidden files",
+    "Preferences",
+    "Ready",
+    "\xD0\xA4\xD0\xB0\xD0\xB9\xD0\xBB",
+};
+
+namespace
+{
+
+const std::vector<wxString>& GetLabels()
+{
+    static std::vector<wxString> s_labels;
+    if ( s_labels.empty() )
+    {
+        for ( const char* label : labels )
+            s_labels.push_back(wxString::FromUTF8(label));
+    }
+
+    return s_labels;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(LabelsFromLiterals)
+{
+    size_t len = 0;
+    for ( const char* label : labels )
+        len += wxString(label).length();
+
+    return len != 0;
+}
+
+// This simulates repainting the controls using the same labels, which are
+// converted to UTF-8 every time, as wxGTK does.
+BENCHMARK_FUNC(LabelsUTF8)
+{
+    size_t len = 0;
+    for ( const wxString& label : GetLabels() )
+        len += strlen(label.utf8_str());
+
+    return len != 0;
+}
+
+// And this is the same but for a string which changes every time before being
+// converted, e.g. a status bar text.
+BENCHMARK_FUNC(LabelsUTF8Changed)
+{
+    static wxString s_label;
+
+    size_t len = 0;
+    for ( const wxString& label : GetLabels() )
+    {
+        s_label = label;
+        len += strlen(s_label.utf8_str());
+    }
+
+    return len != 0;
+}
+
 // ----------------------------------------------------------------------------
 // simple string iteration
 // ----------------------------------------------------------------------------
@@ -716,3 +788,78 @@ BENCHMARK_FUNC(StdToChars)
 #endif // __cpp_lib_to_chars
 
 #endif // wxHAS_CXX17_INCLUDE(<charconv>)
+
+// ----------------------------------------------------------------------------
+// wxNumberFormatter
+// ----------------------------------------------------------------------------
+
+BENCHMARK_FUNC(NumFormatterToString)
+{
+    for ( long n = 0; n < 100; n++ )
+    {
+        if ( wxNumberFormatter::ToString(n * 12345).empty() )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(NumFormatterToChars)
+{
+    wxChar buf[32];
+    for ( long n = 0; n < 100; n++ )
+    {
+        if ( !wxNumberFormatter::ToChars(buf, WXSIZEOF(buf), n * 12345) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(NumFormatterDoubleToString)
+{
+    for ( const auto& data : fromDoubleData )
+    {
+        if ( wxNumberFormatter::ToString(data.value * 1000, data.prec).empty() )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(NumFormatterDoubleToChars)
+{
+    wxChar buf[64];
+    for ( const auto& data : fromDoubleData )
+    {
+        if ( !wxNumberFormatter::ToChars(buf, WXSIZEOF(buf),
+                                         data.value * 1000, data.prec) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(NumFormatterFromString)
+{
+    static const wxString s("1234567");
+
+    long l;
+    return wxNumberFormatter::FromString(s, &l) && l == 1234567;
+}
+
+BENCHMARK_FUNC(NumFormatterFromChars)
+{
+    static const wxChar s[] = wxS("1234567");
+
+    long l;
+    return wxNumberFormatter::FromChars(s, WXSIZEOF(s) - 1, &l) && l == 1234567;
+}
+
+BENCHMARK_FUNC(NumFormatterDoubleFromString)
+{
+    static const wxString s("1234.5678");
+
+    double d;
+    return wxNumberFormatter::FromString(s, &d) && d == 1234.5678;
+}
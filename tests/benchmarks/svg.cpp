@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/svg.cpp
+// Purpose:     wxSVGFileDC benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/dcsvg.h"
+#include "wx/mstream.h"
+#include "wx/zstream.h"
+
+#include <memory>
+
+#include "bench.h"
+
+#if wxUSE_SVG
+
+namespace
+{
+
+// Draw a schematic-like picture consisting of the given number of primitives
+// mostly drawn with just a few different pens and brushes.
+void DrawSchematic(wxDC& dc, long numElements)
+{
+    const wxPen pens[] = { *wxBLACK_PEN, *wxRED_PEN, *wxBLUE_PEN };
+
+    for ( long n = 0; n < numElements; n++ )
+    {
+        // Change the pen only occasionally, as real drawing code does.
+        if ( n % 100 == 0 )
+            dc.SetPen(pens[(n / 100) % WXSIZEOF(pens)]);
+
+        const int x = n % 1000,
+                  y = (n / 1000) % 1000;
+
+        if ( n % 10 == 0 )
+            dc.DrawRectangle(x, y, 8, 8);
+        else
+            dc.DrawLine(x, y, x + 10, y + 5);
+    }
+}
+
+size_t ExportSVG(bool compress)
+{
+    const long numElements = Bench::GetNumericParameter(100000);
+
+    wxMemoryOutputStream mem;
+
+    {
+        std::unique_ptr<wxOutputStream> zstream;
+#if wxUSE_ZLIB
+        if ( compress )
+            zstream.reset(new wxZlibOutputStream(mem, -1, wxZLIB_GZIP));
+#else
+        wxUnusedVar(compress);
+#endif
+
+        {
+            wxSVGFileDC dc(zstream ? *zstream : mem, 1000, 1000);
+            DrawSchematic(dc, numElements);
+        }
+    }
+
+    return mem.GetSize();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(SVGExport)
+{
+    return ExportSVG(false) != 0;
+}
+
+BENCHMARK_FUNC(SVGExportCompressed)
+{
+    return ExportSVG(true) != 0;
+}
+
+BENCHMARK_FUNC(SVGExportSize)
+{
+    // This is not really a benchmark, but it's convenient to be able to see
+    // the size of the output produced by the other ones.
+    static bool s_shown = false;
+    if ( !s_shown )
+    {
+        s_shown = true;
+
+        wxPrintf("SVG size: %zu bytes, compressed: %zu bytes\n",
+                 ExportSVG(false), ExportSVG(true));
+    }
+
+    return true;
+}
+
+#endif // wxUSE_SVG
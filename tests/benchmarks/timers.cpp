@@ -0,0 +1,144 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/timers.cpp
+// Purpose:     wxTimer benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/evtloop.h"
+#include "wx/timer.h"
+#include "wx/utils.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+#if wxUSE_TIMER
+
+namespace
+{
+
+class TimerCounter : public wxEvtHandler
+{
+public:
+    TimerCounter()
+    {
+        m_count = 0;
+
+        Bind(wxEVT_TIMER, &TimerCounter::OnTimer, this);
+    }
+
+    long GetCount() const { return m_count; }
+
+private:
+    void OnTimer(wxTimerEvent& WXUNUSED(event)) { m_count++; }
+
+    long m_count;
+};
+
+// Contains the given number of timers, 100000 by default, and the order in
+// which to stop them.
+class ManyTimers
+{
+public:
+    ManyTimers()
+    {
+        const long count = Bench::GetNumericParameter(100000);
+
+        for ( long n = 0; n < count; n++ )
+        {
+            m_timers.emplace_back(new wxTimer(&m_counter));
+            m_order.push_back(n);
+        }
+
+        std::shuffle(m_order.begin(), m_order.end(), std::mt19937());
+    }
+
+    ~ManyTimers()
+    {
+        StopAll();
+    }
+
+    // Start all timers with the intervals long enough for them not to expire
+    // during the benchmark, but different for all of them.
+    void StartAll()
+    {
+        for ( size_t n = 0; n < m_timers.size(); n++ )
+            m_timers[n]->Start(1000000 + m_order[n]);
+    }
+
+    // Stop all timers in random order.
+    void StopAll()
+    {
+        for ( long n : m_order )
+            m_timers[n]->Stop();
+    }
+
+    size_t GetTimersCount() const { return m_timers.size(); }
+
+    wxTimer& GetTimer(size_t n) { return *m_timers[n]; }
+
+    long GetNotifiedCount() const { return m_counter.GetCount(); }
+
+private:
+    TimerCounter m_counter;
+
+    std::vector<std::unique_ptr<wxTimer>> m_timers;
+    std::vector<long> m_order;
+};
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(TimerStartStop)
+{
+    static ManyTimers timers;
+
+    timers.StartAll();
+    timers.StopAll();
+
+    return true;
+}
+
+BENCHMARK_FUNC(TimerRestart)
+{
+    static ManyTimers timers;
+    static bool s_started = false;
+    if ( !s_started )
+    {
+        timers.StartAll();
+        s_started = true;
+    }
+
+    // Restarting a running timer stops it and starts it again.
+    for ( size_t n = 0; n < timers.GetTimersCount(); n++ )
+        timers.GetTimer(n).Start();
+
+    return true;
+}
+
+BENCHMARK_FUNC(TimerNotifyMany)
+{
+    static ManyTimers timers;
+
+    wxEventLoop loop;
+    wxEventLoopActivator activate(&loop);
+
+    const long countBefore = timers.GetNotifiedCount();
+    const long count = timers.GetTimersCount();
+    for ( long n = 0; n < count; n++ )
+        timers.GetTimer(n).StartOnce(1);
+
+    wxMilliSleep(2);
+
+    while ( timers.GetNotifiedCount() < countBefore + count )
+        loop.DispatchTimeout(0);
+
+    return true;
+}
+
+#endif // wxUSE_TIMER
@@ -0,0 +1,269 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/translation.cpp
+// Purpose:     Message catalogs loading and translation lookup benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/ffile.h"
+#include "wx/filename.h"
+#include "wx/translation.h"
+
+#include "bench.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#if wxUSE_INTL
+
+namespace
+{
+
+// Number of messages in the test catalog, can be changed with -n option.
+const long DEFAULT_NUM_MESSAGES = 40000;
+
+typedef wxUint32 size_t32;
+
+// The hash function used by GNU gettext for the hash table in .mo files.
+size_t32 HashString(const char* str)
+{
+    size_t32 hval = 0;
+    while ( *str )
+    {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(*str++);
+
+        const size_t32 g = hval & (size_t32(0xf) << 28);
+        if ( g )
+        {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+
+    return hval;
+}
+
+bool IsPrime(size_t32 n)
+{
+    for ( size_t32 d = 2; d*d <= n; d++ )
+    {
+        if ( n % d == 0 )
+            return false;
+    }
+
+    return true;
+}
+
+void AppendNumber(std::string& data, size_t32 n)
+{
+    data.append(reinterpret_cast<const char*>(&n), sizeof(n));
+}
+
+// Build .mo file contents for the given (msgid, msgstr) pairs, which must be
+// sorted by msgid, including the hash table as msgfmt does.
+std::string
+BuildCatalog(const std::vector<std::pair<std::string, std::string>>& entries)
+{
+    const size_t32 count = entries.size();
+
+    size_t32 hashSize = count*4/3 + 3;
+    while ( !IsPrime(hashSize) )
+        hashSize++;
+
+    std::vector<size_t32> hashTable(hashSize, 0);
+    for ( size_t32 n = 0; n < count; n++ )
+    {
+        const size_t32 hval = HashString(entries[n].first.c_str());
+        size_t32 idx = hval % hashSize;
+        const size_t32 incr = 1 + hval % (hashSize - 2);
+        while ( hashTable[idx] )
+        {
+            if ( idx >= hashSize - incr )
+                idx -= hashSize - incr;
+            else
+                idx += incr;
+        }
+
+        hashTable[idx] = n + 1;
+    }
+
+    const size_t32 ofsOrig = 28;
+    const size_t32 ofsTrans = ofsOrig + 8*count;
+    const size_t32 ofsHash = ofsTrans + 8*count;
+    size_t32 ofsStrings = ofsHash + 4*hashSize;
+
+    std::string data;
+    AppendNumber(data, 0x950412de);
+    AppendNumber(data, 0);
+    AppendNumber(data, count);
+    AppendNumber(data, ofsOrig);
+    AppendNumber(data, ofsTrans);
+    AppendNumber(data, hashSize);
+    AppendNumber(data, ofsHash);
+
+    std::string strings;
+    for ( int table = 0; table < 2; table++ )
+    {
+        for ( const auto& entry : entries )
+        {
+            const std::string& str = table == 0 ? entry.first : entry.second;
+            AppendNumber(data, str.length());
+            AppendNumber(data, ofsStrings + strings.length());
+            strings.append(str.c_str(), str.length() + 1);
+        }
+    }
+
+    for ( size_t32 n : hashTable )
+        AppendNumber(data, n);
+
+    return data + strings;
+}
+
+wxString MakeMessage(long n)
+{
+    return wxString::Format("Message number %ld used in the benchmark", n);
+}
+
+class BenchLoader : public wxTranslationsLoader
+{
+public:
+    explicit BenchLoader(const wxString& filename) : m_filename(filename) { }
+
+    virtual wxMsgCatalog *LoadCatalog(const wxString& domain,
+                                      const wxString& WXUNUSED(lang)) override
+    {
+        return wxMsgCatalog::CreateFromFile(m_filename, domain);
+    }
+
+    virtual wxArrayString
+    GetAvailableTranslations(const wxString& WXUNUSED(domain)) const override
+    {
+        wxArrayString langs;
+        langs.push_back("fr");
+        return langs;
+    }
+
+private:
+    const wxString m_filename;
+};
+
+wxString gs_catalogFile;
+std::vector<wxString> gs_messages;
+
+bool InitCatalog()
+{
+    const long count = Bench::GetNumericParameter(DEFAULT_NUM_MESSAGES);
+
+    std::vector<std::pair<std::string, std::string>> entries;
+    entries.emplace_back("",
+        "Content-Type: text/plain; charset=UTF-8\n"
+        "Plural-Forms: nplurals=2; plural=(n != 1);\n");
+
+    gs_messages.clear();
+    for ( long n = 0; n < count; n++ )
+    {
+        const wxString msg = MakeMessage(n);
+        gs_messages.push_back(msg);
+
+        entries.emplace_back(msg.utf8_string(),
+                             ("Traduction " + msg).utf8_string());
+    }
+
+    std::sort(entries.begin(), entries.end());
+
+    gs_catalogFile = wxFileName::CreateTempFileName("wxbench");
+
+    const std::string data = BuildCatalog(entries);
+
+    wxFFile file(gs_catalogFile, "wb");
+    return file.Write(data.data(), data.size()) == data.size();
+}
+
+void DoneCatalog()
+{
+    wxRemoveFile(gs_catalogFile);
+}
+
+bool InitTranslations()
+{
+    if ( !InitCatalog() )
+        return false;
+
+    wxTranslations* const trans = new wxTranslations;
+    trans->SetLoader(new BenchLoader(gs_catalogFile));
+    trans->SetLanguage("fr");
+    if ( !trans->AddCatalog("bench") )
+    {
+        delete trans;
+        return false;
+    }
+
+    wxTranslations::Set(trans);
+
+    return true;
+}
+
+void DoneTranslations()
+{
+    wxTranslations::Set(nullptr);
+
+    DoneCatalog();
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// Benchmark loading the catalog
+// ----------------------------------------------------------------------------
+
+BENCHMARK_FUNC_WITH_INIT(TranslationLoadCatalog, InitCatalog, DoneCatalog)
+{
+    wxMsgCatalog* const cat = wxMsgCatalog::CreateFromFile(gs_catalogFile,
+                                                           "bench");
+    if ( !cat )
+        return false;
+
+    delete cat;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark looking up translations
+// ----------------------------------------------------------------------------
+
+BENCHMARK_FUNC_WITH_INIT(TranslationLookup, InitTranslations, DoneTranslations)
+{
+    static size_t s_n = 0;
+
+    const wxString& msg = gs_messages[s_n++ % gs_messages.size()];
+
+    return wxGetTranslation(msg).length() > msg.length();
+}
+
+BENCHMARK_FUNC_WITH_INIT(TranslationLookupMissing, InitTranslations, DoneTranslations)
+{
+    static const wxString s_msg("This message is not in the catalog");
+
+    return wxGetTranslation(s_msg) == s_msg;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark translating literals with and without caching
+// ----------------------------------------------------------------------------
+
+BENCHMARK_FUNC_WITH_INIT(TranslationLiteral, InitTranslations, DoneTranslations)
+{
+    return _("Message number 1234 used in the benchmark").length() > 40;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TranslationLiteralCached, InitTranslations, DoneTranslations)
+{
+    return wxGETTEXT_CACHED("Message number 1234 used in the benchmark").length() > 40;
+}
+
+#endif // wxUSE_INTL
@@ -837,6 +837,27 @@ TEST_CASE("wxDateTime::ParseFormat", "[datetime]")
         CHECK( dt.GetMonth() == wxDateTime::Nov );
     }
 
+    SECTION("%w")
+    {
+        REQUIRE( dt.ParseFormat("2024-01-31 3", "%Y-%m-%d %w") );
+        CHECK( dt.GetDay() == 31 );
+
+        // the week day must be consistent with the date and valid
+        CHECK( !dt.ParseFormat("2024-01-31 4", "%Y-%m-%d %w") );
+        CHECK( !dt.ParseFormat("2024-01-31 7", "%Y-%m-%d %w") );
+    }
+
+    SECTION("%r")
+    {
+        const wxString s("01:14:15 PM rest");
+        wxString::const_iterator end;
+        REQUIRE( dt.ParseFormat(s, "%r", &end) );
+        CHECK( dt.GetHour() == 13 );
+        CHECK( dt.GetMinute() == 14 );
+        CHECK( dt.GetSecond() == 15 );
+        CHECK( wxString(end, s.end()) == " rest" );
+    }
+
     // test partially specified dates too
     SECTION("partial")
     {
@@ -882,6 +903,122 @@ TEST_CASE("wxDateTime::ParseFormat", "[datetime]")
     }
 }
 
+TEST_CASE("wxDateTimeFormatter", "[datetime]")
+{
+    static const char* const formats[] =
+    {
+        "%Y-%m-%d %H:%M:%S",
+        "%a, %d %b %Y %H:%M:%S %z",
+        "%A %B %e %Y, %I:%M:%S %p",
+        "%F %H:%M:%S.%l",
+        "%j %U %W %V %g %G %u %w",
+        "%x %X",
+        "%c",
+        "%-5H|%+4Y|%02l",
+        "%%%C %h %y%n",
+    };
+
+    SECTION("Format")
+    {
+        const wxDateTime::TimeZone timeZones[] =
+        {
+            wxDateTime::Local,
+            wxDateTime::UTC,
+            wxDateTime::TimeZone(-(3600 + 2*60)),
+        };
+
+        // start a little before the end of a year and go past midnight
+        const wxDateTime dtStart(31, wxDateTime::Dec, 2023, 23, 30);
+
+        for ( const auto& tz : timeZones )
+        {
+            for ( const auto& format : formats )
+            {
+                INFO("Format \"" << format << "\" in TZ " << tz.GetOffset());
+
+                wxDateTimeFormatter formatter(format, tz);
+                CHECK( formatter.GetFormat() == format );
+
+                wxDateTime dt = dtStart;
+                for ( int n = 0; n < 100; ++n )
+                {
+                    CHECK( formatter.Format(dt) == dt.Format(format, tz) );
+
+                    dt += wxTimeSpan::Milliseconds(37*n*n + 1);
+                }
+            }
+        }
+
+        wxDateTimeFormatter formatter("%H:%M");
+        wxString s = "Time: ";
+        formatter.AppendFormat(s, dtStart);
+        CHECK( s == "Time: 23:30" );
+
+        formatter.SetFormat("%Y");
+        CHECK( formatter.Format(dtStart) == "2023" );
+    }
+
+    SECTION("Parse")
+    {
+        const wxDateTime dtDef(26, wxDateTime::Sep, 2008, 1, 2, 3, 456);
+
+        static const struct
+        {
+            const char* format;
+            const char* date;
+        } parseTestData[] =
+        {
+            { "%Y-%m-%d %H:%M:%S",  "2024-05-17 12:34:56 and more" },
+            { "%Y-%m-%d %H:%M:%S",  "2024-02-30 12:34:56" },
+            { "%Y-%m-%d %H:%M:%S",  "2024-05-17 12:34" },
+            { "%F %T.%l",           "2011-03-04 05:06:07.089" },
+            { "%F %T",              "2011-03-04 05:06:60" },
+            { "%d %b %Y",           "4 Mar 2011" },
+            { "%A, %d %B %Y",       "Friday, 04 March 2011" },
+            { "%A, %d %B %Y",       "Saturday, 04 March 2011" },
+            { "%I:%M %p",           "07:08 PM" },
+            { "%H:%M",              "07:08" },
+            { "%d",                 "17" },
+            { "%j/%y",              "60/24" },
+            { "%-d.%-m.%Y",         "8.5.2024" },
+            { "%Y%m%d",             "20240517" },
+            { "%x",                 "05/17/24" },
+        };
+
+        for ( const auto& d : parseTestData )
+        {
+            INFO("Parsing \"" << d.date << "\" using \"" << d.format << "\"");
+
+            const wxString date = d.date;
+
+            wxDateTime dt1,
+                       dt2;
+            wxString::const_iterator end1,
+                                     end2;
+            const bool ok1 = dt1.ParseFormat(date, d.format, dtDef, &end1);
+
+            wxDateTimeFormatter formatter(d.format);
+            const bool ok2 = formatter.Parse(date, &dt2, &end2, dtDef);
+
+            REQUIRE( ok1 == ok2 );
+            if ( ok1 )
+            {
+                CHECK( dt1 == dt2 );
+                CHECK( end1 == end2 );
+            }
+        }
+
+        // check that formatting and parsing with the same object round trips
+        wxDateTimeFormatter formatter("%Y-%m-%d %H:%M:%S.%l");
+        const wxDateTime dt(17, wxDateTime::May, 2024, 12, 34, 56, 789);
+
+        wxDateTime dtParsed;
+        wxString::const_iterator end;
+        REQUIRE( formatter.Parse(formatter.Format(dt), &dtParsed, &end) );
+        CHECK( dtParsed == dt );
+    }
+}
+
 // Test parsing time in free format.
 TEST_CASE("wxDateTime::TimeParse", "[datetime]")
 {
@@ -13,8 +13,14 @@
 #include "testprec.h"
 
 
+#include "wx/app.h"
 #include "wx/event.h"
 
+#include "wx/private/safecall.h"
+
+#include <functional>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // test events and their handlers
 // ----------------------------------------------------------------------------
@@ -510,6 +516,205 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+TEST_CASE("Event::BindMany", "[event][bind]")
+{
+    // Bind enough handlers to use the index of the dynamic event handlers and
+    // check that it preserves their order and handles unbinding correctly.
+    wxEvtHandler handler;
+
+    std::vector<int> called;
+    std::vector<std::function<void (MyEvent&)>> functors;
+    for ( int n = 0; n < 50; n++ )
+    {
+        functors.push_back([&called, n](MyEvent& event)
+            {
+                called.push_back(n);
+                event.Skip();
+            });
+    }
+
+    for ( int n = 0; n < 50; n++ )
+    {
+        handler.Bind(MyEventType, functors[n]);
+        handler.Bind(wxEVT_IDLE, [](wxIdleEvent&) { });
+    }
+
+    MyEvent e;
+    handler.ProcessEvent(e);
+    REQUIRE( called.size() == 50 );
+    CHECK( called.front() == 49 );
+    CHECK( called.back() == 0 );
+
+    for ( int n = 0; n < 50; n += 2 )
+        CHECK( handler.Unbind(MyEventType, functors[n]) );
+
+    called.clear();
+    handler.ProcessEvent(e);
+    REQUIRE( called.size() == 25 );
+    CHECK( called.front() == 49 );
+    CHECK( called.back() == 1 );
+
+    // Unbinding all the remaining handlers should work too.
+    for ( int n = 1; n < 50; n += 2 )
+        CHECK( handler.Unbind(MyEventType, functors[n]) );
+
+    called.clear();
+    handler.ProcessEvent(e);
+    CHECK( called.empty() );
+}
+
+// Helper for BindManyFromHandler() test: unbinds itself and all the other
+// handlers and binds a new one instead the first time it is called.
+class UnbindAllHandler
+{
+public:
+    UnbindAllHandler(wxEvtHandler& handler,
+                     std::vector<std::function<void (MyEvent&)>>& functors,
+                     const std::function<void (MyEvent&)>& newFunctor,
+                     std::vector<int>& called)
+        : m_handler(handler),
+          m_functors(functors),
+          m_newFunctor(newFunctor),
+          m_called(called)
+    {
+    }
+
+    void OnEvent(MyEvent& event)
+    {
+        m_called.push_back(-1);
+
+        CHECK( m_handler.Unbind(MyEventType, &UnbindAllHandler::OnEvent, this) );
+        for ( size_t n = 0; n < m_functors.size(); n++ )
+            CHECK( m_handler.Unbind(MyEventType, m_functors[n]) );
+
+        m_handler.Bind(MyEventType, m_newFunctor);
+
+        event.Skip();
+    }
+
+private:
+    wxEvtHandler& m_handler;
+    std::vector<std::function<void (MyEvent&)>>& m_functors;
+    const std::function<void (MyEvent&)>& m_newFunctor;
+    std::vector<int>& m_called;
+
+    wxDECLARE_NO_COPY_CLASS(UnbindAllHandler);
+};
+
+TEST_CASE("Event::BindManyFromHandler", "[event][bind][unbind]")
+{
+    // Check that unbinding and binding handlers while an event is dispatched
+    // works when using the index of the dynamic event handlers too.
+    wxEvtHandler handler;
+
+    std::vector<int> called;
+    std::vector<std::function<void (MyEvent&)>> functors;
+    for ( int n = 0; n < 20; n++ )
+    {
+        functors.push_back([&called, n](MyEvent& event)
+            {
+                called.push_back(n);
+                event.Skip();
+            });
+    }
+
+    const std::function<void (MyEvent&)> newFunctor = [&called](MyEvent& event)
+        {
+            called.push_back(100);
+            event.Skip();
+        };
+
+    for ( int n = 0; n < 20; n++ )
+        handler.Bind(MyEventType, functors[n]);
+
+    // This handler is bound last and so is called first.
+    UnbindAllHandler unbindAll(handler, functors, newFunctor, called);
+    handler.Bind(MyEventType, &UnbindAllHandler::OnEvent, &unbindAll);
+
+    // Neither the unbound handlers nor the new one must be called now.
+    MyEvent e;
+    handler.ProcessEvent(e);
+    REQUIRE( called.size() == 1 );
+    CHECK( called[0] == -1 );
+
+    // But the new one must be called for the next event.
+    called.clear();
+    handler.ProcessEvent(e);
+    REQUIRE( called.size() == 1 );
+    CHECK( called[0] == 100 );
+}
+
+#if wxUSE_EXCEPTIONS && wxUSE_SYSTEM_OPTIONS
+
+TEST_CASE("Event::CatchUnhandledExceptionsOption", "[event][sysopt]")
+{
+    // The value of this option is cached, check that changing it still works.
+    CHECK( wxShouldCatchUnhandledExceptions() );
+
+    wxSystemOptions::SetOption("catch-unhandled-exceptions", 0);
+    CHECK( !wxShouldCatchUnhandledExceptions() );
+    CHECK( !wxShouldCatchUnhandledExceptions() );
+
+    wxSystemOptions::SetOption("catch-unhandled-exceptions", 1);
+    CHECK( wxShouldCatchUnhandledExceptions() );
+}
+
+#endif // wxUSE_EXCEPTIONS && wxUSE_SYSTEM_OPTIONS
+
+TEST_CASE("Event::QueueCoalesce", "[event][queue]")
+{
+    wxEvtHandler handler;
+
+    std::vector<int> values;
+    handler.Bind(wxEVT_THREAD,
+                 [&values](wxThreadEvent& event) { values.push_back(event.GetInt()); });
+
+    const auto queue = [&handler](int value,
+                                  wxUIntPtr key = 0,
+                                  wxEventQueuePriority priority = wxEVENT_QUEUE_PRIORITY_NORMAL)
+    {
+        wxThreadEvent* const event = new wxThreadEvent();
+        event->SetInt(value);
+        event->SetCoalescingKey(key);
+        event->SetQueuePriority(priority);
+        handler.QueueEvent(event);
+    };
+
+    SECTION("Coalesce")
+    {
+        queue(1);
+        queue(2, 17);
+        queue(3);
+        queue(4, 17);
+        queue(5, 18);
+
+        wxTheApp->ProcessPendingEvents();
+        CHECK( values == std::vector<int>{1, 4, 3, 5} );
+    }
+
+    SECTION("Priority")
+    {
+        queue(1, 0, wxEVENT_QUEUE_PRIORITY_LOW);
+        queue(2);
+        queue(3, 0, wxEVENT_QUEUE_PRIORITY_HIGH);
+        queue(4);
+        queue(5, 0, wxEVENT_QUEUE_PRIORITY_HIGH);
+
+        wxTheApp->ProcessPendingEvents();
+        CHECK( values == std::vector<int>{3, 5, 2, 4, 1} );
+    }
+
+    SECTION("CoalesceWithPriority")
+    {
+        queue(1, 17, wxEVENT_QUEUE_PRIORITY_LOW);
+        queue(2);
+        queue(3, 17, wxEVENT_QUEUE_PRIORITY_HIGH);
+
+        wxTheApp->ProcessPendingEvents();
+        CHECK( values == std::vector<int>{3, 2} );
+    }
+}
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
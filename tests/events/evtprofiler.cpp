@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/events/evtprofiler.cpp
+// Purpose:     Tests for wxEventProfiler
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/evtprofiler.h"
+#include "wx/utils.h"
+
+#include "wx/private/evtprofiler.h"
+
+// ----------------------------------------------------------------------------
+// test helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxDEFINE_EVENT(wxEVT_PROFILER_FAST, wxThreadEvent);
+wxDEFINE_EVENT(wxEVT_PROFILER_SLOW, wxThreadEvent);
+
+class ProfiledHandler : public wxEvtHandler
+{
+public:
+    ProfiledHandler()
+    {
+        Bind(wxEVT_PROFILER_FAST, &ProfiledHandler::OnFast, this);
+        Bind(wxEVT_PROFILER_SLOW, [](wxThreadEvent&) { wxMilliSleep(5); });
+    }
+
+private:
+    void OnFast(wxThreadEvent&) { }
+};
+
+// Disable the profiler on scope exit, even if the test fails.
+class ProfilerEnabler
+{
+public:
+    ProfilerEnabler() { wxEventProfiler::Enable(); }
+    ~ProfilerEnabler() { wxEventProfiler::Enable(false); }
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxEventProfiler::Disabled", "[event][profiler]")
+{
+    REQUIRE( !wxEventProfiler::IsEnabled() );
+
+    wxEventProfiler::Reset();
+
+    ProfiledHandler handler;
+    wxThreadEvent event(wxEVT_PROFILER_FAST);
+    handler.ProcessEvent(event);
+
+    CHECK( wxEventProfiler::GetEventTypeStats().empty() );
+    CHECK( wxEventProfiler::GetSlowestHandlers().empty() );
+}
+
+TEST_CASE("wxEventProfiler::Handlers", "[event][profiler]")
+{
+    ProfilerEnabler enable;
+
+    ProfiledHandler handler;
+
+    wxThreadEvent fast(wxEVT_PROFILER_FAST);
+    for ( int n = 0; n < 10; n++ )
+        handler.ProcessEvent(fast);
+
+    wxThreadEvent slow(wxEVT_PROFILER_SLOW);
+    handler.ProcessEvent(slow);
+
+    const std::vector<wxEventProfiler::EventTypeStats>
+        stats = wxEventProfiler::GetEventTypeStats();
+    REQUIRE( stats.size() == 2 );
+
+    // The slow handler must come first as the stats are sorted by time.
+    CHECK( stats[0].type == wxEVT_PROFILER_SLOW );
+    CHECK( stats[0].eventClass == "wxThreadEvent" );
+    CHECK( stats[0].count == 1 );
+    CHECK( stats[0].totalTime >= 5000 );
+    CHECK( stats[0].maxTime == stats[0].totalTime );
+
+    CHECK( stats[1].type == wxEVT_PROFILER_FAST );
+    CHECK( stats[1].count == 10 );
+
+    const std::vector<wxEventProfiler::HandlerCall>
+        slowest = wxEventProfiler::GetSlowestHandlers();
+    REQUIRE( slowest.size() == 11 );
+    CHECK( slowest[0].type == wxEVT_PROFILER_SLOW );
+    CHECK( slowest[0].duration >= 5000 );
+    CHECK( slowest[1].duration <= slowest[0].duration );
+
+#ifndef wxNO_RTTI
+    CHECK( slowest[0].handlerClass.Contains("ProfiledHandler") );
+    CHECK( slowest.back().functorClass.Contains("wxEventFunctorMethod") );
+#endif // !wxNO_RTTI
+
+    SECTION("SlowestCount")
+    {
+        wxEventProfiler::SetSlowestHandlersCount(3);
+        CHECK( wxEventProfiler::GetSlowestHandlers().size() == 3 );
+        CHECK( wxEventProfiler::GetSlowestHandlers()[0].type == wxEVT_PROFILER_SLOW );
+
+        wxEventProfiler::SetSlowestHandlersCount(20);
+    }
+
+    SECTION("ChromeTrace")
+    {
+        const wxString trace = wxEventProfiler::GetChromeTrace();
+        CHECK( trace.StartsWith("{\"traceEvents\":[") );
+        CHECK( trace.Contains("\"name\":\"wxThreadEvent\"") );
+        CHECK( trace.Contains("\"ph\":\"X\"") );
+        CHECK( trace.Contains(wxString::Format("\"type\":%d",
+                                              static_cast<wxEventType>(wxEVT_PROFILER_SLOW))) );
+    }
+
+    SECTION("MaxRecords")
+    {
+        wxEventProfiler::Reset();
+        wxEventProfiler::SetMaxTraceRecords(1);
+
+        handler.ProcessEvent(fast);
+        handler.ProcessEvent(fast);
+
+        // The stats are still updated even when no more records are kept.
+        CHECK( wxEventProfiler::GetEventTypeStats()[0].count == 2 );
+        CHECK( wxEventProfiler::GetChromeTrace().Contains("\"droppedRecords\":1") );
+
+        wxEventProfiler::SetMaxTraceRecords(100000);
+    }
+}
+
+TEST_CASE("wxEventProfiler::Pending", "[event][profiler]")
+{
+    ProfilerEnabler enable;
+
+    ProfiledHandler handler;
+    for ( int n = 0; n < 3; n++ )
+        handler.QueueEvent(new wxThreadEvent(wxEVT_PROFILER_FAST));
+
+    wxTheApp->ProcessPendingEvents();
+
+    const std::vector<wxEventProfiler::PendingSample>
+        samples = wxEventProfiler::GetPendingSamples();
+    REQUIRE( samples.size() == 3 );
+    CHECK( samples[0].events == 3 );
+    CHECK( samples[1].events == 2 );
+    CHECK( samples[2].events == 1 );
+
+    CHECK( wxEventProfiler::GetChromeTrace().Contains("\"ph\":\"C\"") );
+}
+
+TEST_CASE("wxEventProfiler::Idle", "[event][profiler]")
+{
+    ProfilerEnabler enable;
+
+    wxEvtHandler handler;
+    handler.Bind(wxEVT_IDLE, [](wxIdleEvent&) { wxMilliSleep(2); });
+
+    {
+        // Nested idle timers must not count the same processing twice.
+        wxEventProfilerTimer outer(wxEventProfilerTimer::Idle);
+        wxEventProfilerTimer inner(wxEventProfilerTimer::Idle);
+
+        // And anything but the idle events handlers is not counted at all.
+        wxMilliSleep(20);
+
+        wxIdleEvent event;
+        handler.ProcessEvent(event);
+    }
+
+    const wxEventProfiler::IdleStats stats = wxEventProfiler::GetIdleStats();
+    CHECK( stats.count == 1 );
+    CHECK( stats.totalTime >= 2000 );
+    CHECK( stats.totalTime < 20000 );
+    CHECK( stats.maxTime == stats.totalTime );
+}
@@ -0,0 +1,296 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/events/fdiodispatcher.cpp
+// Purpose:     wxFDIODispatcher implementations unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#ifdef __UNIX__
+
+#include "wx/private/selectdispatcher.h"
+#include "wx/unix/private/epolldispatcher.h"
+#include "wx/unix/private/iouringdispatcher.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Pair of connected sockets closed when this object is destroyed.
+class SocketPair
+{
+public:
+    SocketPair()
+    {
+        if ( socketpair(AF_UNIX, SOCK_STREAM, 0, m_fds) != 0 )
+            m_fds[0] = m_fds[1] = -1;
+    }
+
+    ~SocketPair()
+    {
+        for ( int fd : m_fds )
+        {
+            if ( fd != -1 )
+                close(fd);
+        }
+    }
+
+    bool IsOk() const { return m_fds[0] != -1; }
+
+    int GetReadFD() const { return m_fds[0]; }
+
+    bool WriteByte() const { return write(m_fds[1], "x", 1) == 1; }
+
+private:
+    int m_fds[2];
+
+    wxDECLARE_NO_COPY_CLASS(SocketPair);
+};
+
+// Handler counting the notifications it gets.
+class CountingHandler : public wxFDIOHandler
+{
+public:
+    CountingHandler() = default;
+
+    virtual void OnReadWaiting() override { read++; }
+    virtual void OnWriteWaiting() override { write++; }
+    virtual void OnExceptionWaiting() override { exception++; }
+
+    int read = 0,
+        write = 0,
+        exception = 0;
+
+    wxDECLARE_NO_COPY_CLASS(CountingHandler);
+};
+
+// Handler reading all the available data when it's notified.
+class DrainingHandler : public CountingHandler
+{
+public:
+    explicit DrainingHandler(int fd) : m_fd(fd) { }
+
+    virtual void OnReadWaiting() override
+    {
+        CountingHandler::OnReadWaiting();
+
+        char buf[64];
+        while ( recv(m_fd, buf, sizeof(buf), MSG_DONTWAIT) > 0 )
+            ;
+    }
+
+private:
+    const int m_fd;
+};
+
+// Check the behaviour common to all dispatchers.
+void CheckDispatcher(wxFDIODispatcher& dispatcher)
+{
+    SocketPair sockets;
+    REQUIRE( sockets.IsOk() );
+
+    DrainingHandler handler(sockets.GetReadFD());
+    REQUIRE( dispatcher.RegisterFD(sockets.GetReadFD(), &handler,
+                                   wxFDIO_INPUT) );
+
+    // Checking for the pending events must not change anything, so do it
+    // several times.
+    CHECK( !dispatcher.HasPending() );
+    CHECK( !dispatcher.HasPending() );
+    CHECK( dispatcher.Dispatch(0) == 0 );
+    CHECK( handler.read == 0 );
+
+    REQUIRE( sockets.WriteByte() );
+    CHECK( dispatcher.HasPending() );
+    CHECK( dispatcher.HasPending() );
+
+    CHECK( dispatcher.Dispatch(0) == 1 );
+    CHECK( handler.read == 1 );
+
+    // The handler has read all the data, so there is nothing to do any more.
+    CHECK( !dispatcher.HasPending() );
+    CHECK( dispatcher.Dispatch(0) == 0 );
+    CHECK( handler.read == 1 );
+
+    // Until more data is written.
+    REQUIRE( sockets.WriteByte() );
+    CHECK( dispatcher.Dispatch(0) == 1 );
+    CHECK( handler.read == 2 );
+
+    // And no notifications must be received after unregistering.
+    CHECK( dispatcher.UnregisterFD(sockets.GetReadFD()) );
+    REQUIRE( sockets.WriteByte() );
+    CHECK( !dispatcher.HasPending() );
+    CHECK( dispatcher.Dispatch(0) == 0 );
+    CHECK( handler.read == 2 );
+}
+
+// Handler unregistering another descriptor when it's notified.
+class UnregisteringHandler : public CountingHandler
+{
+public:
+    UnregisteringHandler(wxFDIODispatcher& dispatcher)
+        : m_dispatcher(dispatcher)
+    {
+    }
+
+    void SetFDToUnregister(int fd) { m_fd = fd; }
+
+    virtual void OnReadWaiting() override
+    {
+        CountingHandler::OnReadWaiting();
+
+        if ( m_fd != -1 )
+        {
+            m_dispatcher.UnregisterFD(m_fd);
+            m_fd = -1;
+        }
+    }
+
+private:
+    wxFDIODispatcher& m_dispatcher;
+    int m_fd = -1;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+#if wxUSE_SELECT_DISPATCHER
+
+TEST_CASE("wxSelectDispatcher::Dispatch", "[fdio][select]")
+{
+    wxSelectDispatcher dispatcher;
+    CheckDispatcher(dispatcher);
+}
+
+#endif // wxUSE_SELECT_DISPATCHER
+
+#if wxUSE_EPOLL_DISPATCHER
+
+TEST_CASE("wxEpollDispatcher::Dispatch", "[fdio][epoll]")
+{
+    std::unique_ptr<wxEpollDispatcher> dispatcher(wxEpollDispatcher::Create());
+    REQUIRE( dispatcher );
+
+    CheckDispatcher(*dispatcher);
+}
+
+#ifdef wxHAS_IO_URING
+
+TEST_CASE("wxIOUringDispatcher::Dispatch", "[fdio][io_uring]")
+{
+    std::unique_ptr<wxIOUringDispatcher> dispatcher(wxIOUringDispatcher::Create());
+    if ( !dispatcher )
+    {
+        WARN("Skipping the test as io_uring is not available.");
+        return;
+    }
+
+    CheckDispatcher(*dispatcher);
+}
+
+#endif // wxHAS_IO_URING
+
+TEST_CASE("wxEpollDispatcher::LevelTriggered", "[fdio][epoll]")
+{
+    std::unique_ptr<wxEpollDispatcher> dispatcher(wxEpollDispatcher::Create());
+    REQUIRE( dispatcher );
+
+    SocketPair sockets;
+    REQUIRE( sockets.IsOk() );
+    REQUIRE( sockets.WriteByte() );
+
+    CountingHandler handler;
+    REQUIRE( dispatcher->RegisterFD(sockets.GetReadFD(), &handler,
+                                    wxFDIO_INPUT | wxFDIO_OUTPUT) );
+
+    // As the data is not read, the handler is notified about it every time,
+    // and only about it, as only a single event is processed at once.
+    for ( int n = 0; n < 3; n++ )
+        CHECK( dispatcher->Dispatch(0) == 1 );
+
+    CHECK( handler.read == 3 );
+    CHECK( handler.write == 0 );
+
+    CHECK( dispatcher->UnregisterFD(sockets.GetReadFD()) );
+}
+
+TEST_CASE("wxEpollDispatcher::EdgeTriggered", "[fdio][epoll]")
+{
+    std::unique_ptr<wxEpollDispatcher> dispatcher(wxEpollDispatcher::Create());
+    REQUIRE( dispatcher );
+
+    SocketPair sockets;
+    REQUIRE( sockets.IsOk() );
+    REQUIRE( sockets.WriteByte() );
+
+    CountingHandler handler;
+    REQUIRE( dispatcher->RegisterFD(sockets.GetReadFD(), &handler,
+                                    wxFDIO_INPUT | wxFDIO_OUTPUT |
+                                    wxFDIO_EDGE_TRIGGERED) );
+
+    // All events must be reported at once, as they're not reported again.
+    CHECK( dispatcher->Dispatch(0) == 1 );
+    CHECK( handler.read == 1 );
+    CHECK( handler.write == 1 );
+
+    CHECK( dispatcher->Dispatch(0) == 0 );
+    CHECK( handler.read == 1 );
+    CHECK( handler.write == 1 );
+
+    // But new data must be reported again.
+    REQUIRE( sockets.WriteByte() );
+    CHECK( dispatcher->Dispatch(0) == 1 );
+    CHECK( handler.read == 2 );
+
+    CHECK( dispatcher->UnregisterFD(sockets.GetReadFD()) );
+}
+
+TEST_CASE("wxEpollDispatcher::UnregisterFromHandler", "[fdio][epoll]")
+{
+    std::unique_ptr<wxEpollDispatcher> dispatcher(wxEpollDispatcher::Create());
+    REQUIRE( dispatcher );
+
+    SocketPair sockets1,
+               sockets2;
+    REQUIRE( sockets1.IsOk() );
+    REQUIRE( sockets2.IsOk() );
+    REQUIRE( sockets1.WriteByte() );
+    REQUIRE( sockets2.WriteByte() );
+
+    // Whichever handler is called first unregisters the other descriptor, so
+    // its handler must not be called, even if its event was already returned.
+    UnregisteringHandler handler1(*dispatcher),
+                         handler2(*dispatcher);
+    handler1.SetFDToUnregister(sockets2.GetReadFD());
+    handler2.SetFDToUnregister(sockets1.GetReadFD());
+
+    REQUIRE( dispatcher->RegisterFD(sockets1.GetReadFD(), &handler1,
+                                    wxFDIO_INPUT) );
+    REQUIRE( dispatcher->RegisterFD(sockets2.GetReadFD(), &handler2,
+                                    wxFDIO_INPUT) );
+
+    CHECK( dispatcher->Dispatch(0) == 1 );
+    CHECK( handler1.read + handler2.read == 1 );
+}
+
+#endif // wxUSE_EPOLL_DISPATCHER
+
+#endif // __UNIX__
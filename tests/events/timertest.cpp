@@ -65,10 +65,12 @@ private:
     CPPUNIT_TEST_SUITE( TimerEventTestCase );
         CPPUNIT_TEST( OneShot );
         CPPUNIT_TEST( Multiple );
+        CPPUNIT_TEST( ZeroInterval );
     CPPUNIT_TEST_SUITE_END();
 
     void OneShot();
     void Multiple();
+    void ZeroInterval();
 
     wxDECLARE_NO_COPY_CLASS(TimerEventTestCase);
 };
@@ -137,3 +139,43 @@ void TimerEventTestCase::Multiple()
     // more than one
     CPPUNIT_ASSERT( numTicks > 1 );
 }
+
+void TimerEventTestCase::ZeroInterval()
+{
+    class StopAfterTicksHandler : public TimerCounterHandler
+    {
+    public:
+        StopAfterTicksHandler(wxEventLoopBase& loop, wxTimer& timer)
+            : TimerCounterHandler(),
+              m_loop(loop),
+              m_timer(timer)
+        {
+        }
+
+    private:
+        virtual void Tick() override
+        {
+            if ( GetNumEvents() == 10 )
+            {
+                m_timer.Stop();
+                m_loop.Exit();
+            }
+        }
+
+        wxEventLoopBase& m_loop;
+        wxTimer& m_timer;
+    };
+
+    wxEventLoop loop;
+
+    // A timer with zero interval must still be notified repeatedly, without
+    // blocking the event loop.
+    wxTimer timer;
+    StopAfterTicksHandler handler(loop, timer);
+    timer.SetOwner(&handler);
+    timer.Start(0);
+
+    loop.Run();
+
+    CPPUNIT_ASSERT_EQUAL( 10, handler.GetNumEvents() );
+}
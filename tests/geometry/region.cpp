@@ -134,3 +134,198 @@ void RegionTestCase::Intersect()
     CPPUNIT_ASSERT( region1.Intersect(region2) );
     CPPUNIT_ASSERT( region1.IsEmpty() );
 }
+
+// ----------------------------------------------------------------------------
+// Union() with many rectangles and Contains()
+// ----------------------------------------------------------------------------
+
+// Notice that these tests only exercise the generic implementation in
+// src/generic/regiong.cpp, with its band merging and binary search, in the
+// ports using it as wxRegion, i.e. wxOSX/iPhone. It isn't compiled at all in
+// the other ports, which check their native wxRegion implementation instead.
+
+namespace
+{
+
+// Check that Union(count, rects) gives the same result as adding the
+// rectangles one by one and that Contains() agrees with the rectangles.
+void CheckUnionOfRects(const wxRect* rects, size_t count)
+{
+    wxRegion expected;
+    for ( size_t n = 0; n < count; n++ )
+        expected.Union(rects[n]);
+
+    wxRegion region;
+    CHECK( region.Union(count, rects) );
+    CHECK( region == expected );
+    CHECK( region.GetBox() == expected.GetBox() );
+
+    // Check all points in and just around the bounding box.
+    const wxRect box = expected.GetBox();
+    for ( int y = box.GetTop() - 1; y <= box.GetBottom() + 1; y++ )
+    {
+        for ( int x = box.GetLeft() - 1; x <= box.GetRight() + 1; x++ )
+        {
+            bool inside = false;
+            for ( size_t n = 0; n < count; n++ )
+            {
+                if ( rects[n].Contains(x, y) )
+                {
+                    inside = true;
+                    break;
+                }
+            }
+
+            INFO("Point (" << x << ", " << y << ")");
+            CHECK( region.Contains(x, y) == (inside ? wxInRegion : wxOutRegion) );
+        }
+    }
+
+    // Each rectangle must also be entirely inside the region.
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( !rects[n].IsEmpty() )
+        {
+            INFO("Rectangle #" << n);
+            CHECK( region.Contains(rects[n]) == wxInRegion );
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxRegion::UnionRects", "[region]")
+{
+    SECTION("None")
+    {
+        wxRegion region;
+        CHECK( region.Union(0, nullptr) );
+        CHECK( !region.IsOk() );
+
+        wxRegion region2(1, 2, 3, 4);
+        CHECK( region2.Union(0, nullptr) );
+        CHECK( region2 == wxRegion(1, 2, 3, 4) );
+    }
+
+    SECTION("Disjoint")
+    {
+        const wxRect rects[] =
+        {
+            wxRect( 0,  0, 5, 5),
+            wxRect(10,  0, 5, 5),
+            wxRect( 0, 10, 5, 5),
+            wxRect(20, 20, 3, 2),
+        };
+        CheckUnionOfRects(rects, WXSIZEOF(rects));
+    }
+
+    SECTION("Overlapping")
+    {
+        const wxRect rects[] =
+        {
+            wxRect( 0,  0, 10, 10),
+            wxRect( 5,  5, 10, 10),
+            wxRect( 2,  3,  4,  4),
+            wxRect(-3,  8, 20,  2),
+            wxRect( 0,  0, 10, 10),
+        };
+        CheckUnionOfRects(rects, WXSIZEOF(rects));
+    }
+
+    SECTION("Touching")
+    {
+        const wxRect rects[] =
+        {
+            wxRect( 0, 0, 5, 5),
+            wxRect( 5, 0, 5, 5),
+            wxRect( 0, 5, 10, 5),
+            wxRect(10, 2, 3, 3),
+        };
+        CheckUnionOfRects(rects, WXSIZEOF(rects));
+
+        // Touching rectangles must be merged in a single band.
+        wxRegion region;
+        region.Union(2, rects);
+        CHECK( GetRectsCount(region) == 1 );
+        CHECK( region.GetBox() == wxRect(0, 0, 10, 5) );
+    }
+
+    SECTION("Empty")
+    {
+        const wxRect rects[] =
+        {
+            wxRect(),
+            wxRect(3, 4, 5, 6),
+            wxRect(10, 10, 0, 5),
+            wxRect(10, 10, 5, 0),
+        };
+        CheckUnionOfRects(rects, WXSIZEOF(rects));
+
+        wxRegion region;
+        // Empty rectangles are ignored, so the region remains invalid.
+        CHECK( region.Union(1, rects) );
+        CHECK( !region.IsOk() );
+    }
+
+    SECTION("Many")
+    {
+        // Use enough rectangles for several merge passes to be needed.
+        wxRect rects[50];
+        for ( size_t n = 0; n < WXSIZEOF(rects); n++ )
+        {
+            const int i = static_cast<int>(n);
+            rects[n] = wxRect((i*7) % 23, (i*11) % 19, 1 + i % 4, 1 + i % 3);
+        }
+        CheckUnionOfRects(rects, WXSIZEOF(rects));
+    }
+
+    SECTION("Existing")
+    {
+        const wxRect rects[] =
+        {
+            wxRect(5, 5, 10, 10),
+            wxRect(30, 0, 2, 2),
+        };
+
+        wxRegion region(0, 0, 10, 10);
+        CHECK( region.Union(WXSIZEOF(rects), rects) );
+
+        wxRegion expected(0, 0, 10, 10);
+        expected.Union(rects[0]);
+        expected.Union(rects[1]);
+        CHECK( region == expected );
+
+        CHECK( region.Contains(0, 0) == wxInRegion );
+        CHECK( region.Contains(14, 14) == wxInRegion );
+        CHECK( region.Contains(12, 2) == wxOutRegion );
+        CHECK( region.Contains(31, 1) == wxInRegion );
+        CHECK( region.Contains(20, 1) == wxOutRegion );
+    }
+}
+
+TEST_CASE("wxRegion::Contains", "[region]")
+{
+    // Region with several bands with gaps between them.
+    wxRegion region(0, 0, 10, 2);
+    region.Union(20, 0, 5, 2);
+    region.Union(0, 5, 3, 3);
+    region.Union(6, 5, 3, 3);
+    region.Union(0, 10, 30, 1);
+
+    CHECK( region.Contains(0, 0) == wxInRegion );
+    CHECK( region.Contains(9, 1) == wxInRegion );
+    CHECK( region.Contains(10, 1) == wxOutRegion );
+    CHECK( region.Contains(22, 1) == wxInRegion );
+    CHECK( region.Contains(5, 3) == wxOutRegion );   // between the bands
+    CHECK( region.Contains(4, 6) == wxOutRegion );   // between the boxes
+    CHECK( region.Contains(8, 7) == wxInRegion );
+    CHECK( region.Contains(29, 10) == wxInRegion );
+    CHECK( region.Contains(29, 11) == wxOutRegion ); // below the last band
+    CHECK( region.Contains(-1, 0) == wxOutRegion );
+
+    CHECK( region.Contains(wxRect(1, 0, 5, 2)) == wxInRegion );
+    CHECK( region.Contains(wxRect(8, 0, 5, 2)) == wxPartRegion );
+    CHECK( region.Contains(wxRect(3, 5, 3, 3)) == wxOutRegion );
+    CHECK( region.Contains(wxRect(0, 3, 10, 2)) == wxOutRegion );
+    CHECK( region.Contains(wxRect(0, 0, 30, 11)) == wxPartRegion );
+}
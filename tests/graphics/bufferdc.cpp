@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/bufferdc.cpp
+// Purpose:     wxBufferedDC unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/bitmap.h"
+    #include "wx/brush.h"
+    #include "wx/dcmemory.h"
+    #include "wx/pen.h"
+#endif // WX_PRECOMP
+
+#include "wx/dcbuffer.h"
+#include "wx/image.h"
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const int WIDTH = 20;
+const int HEIGHT = 10;
+
+// Buffered DC allowing to set the update area, as wxBufferedPaintDC does.
+class UpdateAreaBufferedDC : public wxBufferedDC
+{
+public:
+    UpdateAreaBufferedDC(wxDC* dc, wxBitmap& buffer, const wxRect& rect)
+        : wxBufferedDC(dc, buffer,
+                       wxBUFFER_CLIENT_AREA | wxBUFFER_UPDATE_AREA_ONLY)
+    {
+        SetUpdateArea(rect);
+    }
+};
+
+wxBitmap CreateFilledBitmap(const wxColour& col)
+{
+    wxBitmap bmp(WIDTH, HEIGHT, 24);
+
+    wxMemoryDC dc(bmp);
+    dc.SetBackground(wxBrush(col));
+    dc.Clear();
+
+    return bmp;
+}
+
+void FillAll(wxDC& dc, const wxColour& col)
+{
+    dc.SetPen(wxPen(col));
+    dc.SetBrush(wxBrush(col));
+    dc.DrawRectangle(0, 0, WIDTH, HEIGHT);
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("BufferedDC::Blit", "[dc][buffer]")
+{
+    wxBitmap target = CreateFilledBitmap(*wxWHITE);
+
+    wxBufferedDC::ResetPixelsBlitted();
+    {
+        wxMemoryDC dc(target);
+        wxBufferedDC bdc(&dc, wxSize(WIDTH, HEIGHT));
+        FillAll(bdc, *wxRED);
+    }
+
+    CHECK( wxBufferedDC::GetPixelsBlitted() == WIDTH*HEIGHT );
+
+    const wxImage image = target.ConvertToImage();
+    for ( int y = 0; y < HEIGHT; y++ )
+    {
+        for ( int x = 0; x < WIDTH; x++ )
+        {
+            INFO("Pixel at (" << x << ", " << y << ")");
+            CHECK( image.GetRed(x, y) == 0xff );
+            CHECK( image.GetGreen(x, y) == 0 );
+            CHECK( image.GetBlue(x, y) == 0 );
+        }
+    }
+}
+
+TEST_CASE("BufferedDC::UpdateAreaOnly", "[dc][buffer]")
+{
+    wxBitmap target = CreateFilledBitmap(*wxWHITE);
+    wxBitmap buffer = CreateFilledBitmap(*wxBLUE);
+
+    const wxRect update(3, 2, 5, 4);
+
+    wxBufferedDC::ResetPixelsBlitted();
+    {
+        wxMemoryDC dc(target);
+        UpdateAreaBufferedDC bdc(&dc, buffer, update);
+        FillAll(bdc, *wxRED);
+    }
+
+    // Only the update area must have been copied to the target.
+    CHECK( wxBufferedDC::GetPixelsBlitted() == wxUint64(update.width*update.height) );
+
+    const wxImage image = target.ConvertToImage();
+    for ( int y = 0; y < HEIGHT; y++ )
+    {
+        for ( int x = 0; x < WIDTH; x++ )
+        {
+            INFO("Pixel at (" << x << ", " << y << ")");
+            if ( update.Contains(x, y) )
+            {
+                CHECK( image.GetRed(x, y) == 0xff );
+                CHECK( image.GetBlue(x, y) == 0 );
+            }
+            else
+            {
+                CHECK( image.GetRed(x, y) == 0xff );
+                CHECK( image.GetBlue(x, y) == 0xff );
+            }
+        }
+    }
+
+    // And drawing on the buffer must have been restricted to it too.
+    const wxImage imageBuffer = buffer.ConvertToImage();
+    CHECK( imageBuffer.GetRed(update.x, update.y) == 0xff );
+    CHECK( imageBuffer.GetBlue(update.x, update.y) == 0 );
+    CHECK( imageBuffer.GetRed(0, 0) == 0 );
+    CHECK( imageBuffer.GetBlue(0, 0) == 0xff );
+    CHECK( imageBuffer.GetRed(WIDTH - 1, HEIGHT - 1) == 0 );
+    CHECK( imageBuffer.GetBlue(WIDTH - 1, HEIGHT - 1) == 0xff );
+}
@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/psdc.cpp
+// Purpose:     wxPostScriptDC unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
+
+#ifndef WX_PRECOMP
+    #include "wx/bitmap.h"
+#endif // WX_PRECOMP
+
+#include "wx/dcps.h"
+#include "wx/ffile.h"
+#include "wx/image.h"
+
+#if wxUSE_ZLIB
+    #include "wx/mstream.h"
+    #include "wx/zstream.h"
+#endif
+
+#include "testfile.h"
+
+#include <string>
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the PostScript document containing the given bitmap printed using
+// the specified language level.
+std::string PrintBitmap(const wxBitmap& bmp, int level)
+{
+    TempFile file("test.ps");
+
+    wxPrintData printData;
+    printData.SetPrintMode(wxPRINT_MODE_FILE);
+    printData.SetFilename(file.GetName());
+
+    {
+        wxPostScriptDC dc(printData);
+        dc.SetLanguageLevel(level);
+        CHECK( dc.GetLanguageLevel() == level );
+
+        dc.StartDoc("Test");
+        dc.StartPage();
+        dc.DrawBitmap(bmp, 10, 20);
+        dc.EndPage();
+        dc.EndDoc();
+    }
+
+    wxFFile f(file.GetName(), "rb");
+    REQUIRE( f.IsOpened() );
+
+    const size_t len = static_cast<size_t>(f.Length());
+    std::string ps(len, '\0');
+    REQUIRE( f.Read(&ps[0], len) == len );
+
+    return ps;
+}
+
+// Decode the ASCII85-encoded data following the "exec" in the output.
+std::string DecodeBitmapData(const std::string& ps)
+{
+    const size_t start = ps.find("} exec\n");
+    REQUIRE( start != std::string::npos );
+
+    const size_t end = ps.find("~>", start);
+    REQUIRE( end != std::string::npos );
+
+    std::string decoded;
+
+    unsigned long value = 0;
+    int count = 0;
+    for ( size_t n = start + 7; n < end; n++ )
+    {
+        const char c = ps[n];
+        if ( c == 'z' && count == 0 )
+        {
+            decoded.append(4, '\0');
+            continue;
+        }
+
+        if ( c < '!' || c > 'u' )
+            continue;
+
+        value = value*85 + (c - '!');
+        if ( ++count == 5 )
+        {
+            for ( int shift = 24; shift >= 0; shift -= 8 )
+                decoded += static_cast<char>((value >> shift) & 0xff);
+
+            value = 0;
+            count = 0;
+        }
+    }
+
+    // A final partial group of N characters encodes N - 1 bytes.
+    if ( count )
+    {
+        const int bytes = count - 1;
+        for ( ; count < 5; count++ )
+            value = value*85 + 84;
+
+        for ( int n = 0; n < bytes; n++ )
+            decoded += static_cast<char>((value >> (24 - 8*n)) & 0xff);
+    }
+
+    return decoded;
+}
+
+wxBitmap CreateTestBitmap()
+{
+    wxImage image(7, 5);
+    for ( int y = 0; y < image.GetHeight(); y++ )
+    {
+        for ( int x = 0; x < image.GetWidth(); x++ )
+            image.SetRGB(x, y, x*30, y*50, (x + y) % 2 ? 255 : 0);
+    }
+
+    return wxBitmap(image);
+}
+
+std::string GetBitmapData(const wxBitmap& bmp)
+{
+    const wxImage image = bmp.ConvertToImage();
+
+    return std::string(reinterpret_cast<const char*>(image.GetData()),
+                       3*image.GetWidth()*image.GetHeight());
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxPostScriptDC::LanguageLevel", "[psdc]")
+{
+    const wxBitmap bmp = CreateTestBitmap();
+
+    SECTION("Default")
+    {
+        wxPostScriptDC dc;
+        CHECK( dc.GetLanguageLevel() == 2 );
+    }
+
+    SECTION("Level 2")
+    {
+        const std::string ps = PrintBitmap(bmp, 2);
+
+        CHECK( ps.find("%%LanguageLevel: 2\n") != std::string::npos );
+        CHECK( ps.find("/ASCII85Decode filter") != std::string::npos );
+        CHECK( ps.find("FlateDecode") == std::string::npos );
+
+        CHECK( DecodeBitmapData(ps) == GetBitmapData(bmp) );
+    }
+
+    SECTION("Level 3")
+    {
+        const std::string ps = PrintBitmap(bmp, 3);
+
+        CHECK( ps.find("%%LanguageLevel: 3\n") != std::string::npos );
+        CHECK( ps.find("/ASCII85Decode filter") != std::string::npos );
+
+#if wxUSE_ZLIB
+        CHECK( ps.find("/FlateDecode filter") != std::string::npos );
+
+        const std::string compressed = DecodeBitmapData(ps);
+        wxMemoryInputStream mis(compressed.data(), compressed.size());
+        wxZlibInputStream zis(mis, wxZLIB_ZLIB);
+
+        std::string decoded;
+        char buf[256];
+        while ( zis.Read(buf, sizeof(buf)).LastRead() )
+            decoded.append(buf, zis.LastRead());
+
+        CHECK( decoded == GetBitmapData(bmp) );
+#else // !wxUSE_ZLIB
+        CHECK( DecodeBitmapData(ps) == GetBitmapData(bmp) );
+#endif // wxUSE_ZLIB/!wxUSE_ZLIB
+    }
+}
+
+#endif // wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
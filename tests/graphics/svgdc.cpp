@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/svgdc.cpp
+// Purpose:     wxSVGFileDC unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_SVG
+
+#ifndef WX_PRECOMP
+    #include "wx/brush.h"
+    #include "wx/pen.h"
+#endif // WX_PRECOMP
+
+#include "wx/dcsvg.h"
+#include "wx/mstream.h"
+
+#if wxUSE_ZLIB
+    #include "wx/wfstream.h"
+    #include "wx/zstream.h"
+
+    #include "testfile.h"
+#endif
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the SVG document written to the given stream.
+wxString GetSVG(const wxMemoryOutputStream& stream)
+{
+    const size_t len = stream.GetLength();
+    wxCharBuffer buf(len);
+    stream.CopyTo(buf.data(), len);
+
+    return wxString::FromUTF8(buf.data(), len);
+}
+
+// Count the number of (non-overlapping) occurrences of the given substring.
+size_t CountOf(const wxString& s, const wxString& sub)
+{
+    size_t count = 0;
+    for ( size_t pos = s.find(sub); pos != wxString::npos;
+          pos = s.find(sub, pos + sub.length()) )
+    {
+        count++;
+    }
+
+    return count;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("SVGFileDC::Document", "[dc][svg]")
+{
+    wxMemoryOutputStream stream;
+    {
+        wxSVGFileDC dc(stream, 100, 50, 72, "Test");
+        dc.DrawLine(0, 0, 10, 10);
+    }
+
+    const wxString svg = GetSVG(stream);
+    INFO(svg);
+
+    CHECK( svg.StartsWith("<?xml version=\"1.0\" encoding=\"UTF-8\"") );
+    CHECK( svg.Contains("<title>Test</title>") );
+    CHECK( svg.EndsWith("</g>\n</svg>\n") );
+
+    // The line must be inside the initial group.
+    const size_t posGroup = svg.find("<g style=\"fill:black; stroke:black; stroke-width:1\">");
+    REQUIRE( posGroup != wxString::npos );
+    CHECK( svg.find("<path d=\"M0 0 L10 10\"") > posGroup );
+}
+
+TEST_CASE("SVGFileDC::CombineLines", "[dc][svg]")
+{
+    wxMemoryOutputStream stream;
+    {
+        wxSVGFileDC dc(stream);
+        dc.SetPen(*wxRED_PEN);
+        dc.DrawLine(0, 0, 10, 10);
+        dc.DrawLine(10, 10, 20, -5);
+
+        const wxPoint points[] = { wxPoint(1, 2), wxPoint(3, 4), wxPoint(5, 6) };
+        dc.DrawLines(WXSIZEOF(points), points);
+        dc.DrawLines(WXSIZEOF(points), points, 10, 20);
+
+        // Changing the pen must start a new path.
+        dc.SetPen(*wxBLUE_PEN);
+        dc.DrawLine(-1, -2, -3, -4);
+    }
+
+    const wxString svg = GetSVG(stream);
+    INFO(svg);
+
+    CHECK( CountOf(svg, "<path ") == 3 );
+    CHECK( svg.Contains("<path d=\"M0 0 L10 10 M10 10 L20 -5\" ") );
+    CHECK( svg.Contains("<path d=\"M1 2 L3 4 L5 6 M11 22 L13 24 L15 26\" style=\"fill:none\" ") );
+    CHECK( svg.Contains("<path d=\"M-1 -2 L-3 -4\" ") );
+
+    // And the lines drawn with the second pen must come after the group using
+    // this pen is started.
+    CHECK( svg.find("M-1 -2") > svg.find("stroke:#0000FF;") );
+}
+
+TEST_CASE("SVGFileDC::CombineTranslucent", "[dc][svg]")
+{
+    wxMemoryOutputStream stream;
+    {
+        wxSVGFileDC dc(stream);
+        dc.SetPen(wxPen(wxColour(255, 0, 0, 128)));
+        dc.DrawLine(0, 0, 10, 10);
+        dc.DrawLine(10, 10, 20, 0);
+    }
+
+    const wxString svg = GetSVG(stream);
+    INFO(svg);
+
+    // Overlapping translucent lines can't be combined.
+    CHECK( CountOf(svg, "<path ") == 2 );
+    CHECK( svg.Contains("<path d=\"M0 0 L10 10\" ") );
+    CHECK( svg.Contains("<path d=\"M10 10 L20 0\" ") );
+}
+
+TEST_CASE("SVGFileDC::CombineRectangles", "[dc][svg]")
+{
+    wxMemoryOutputStream stream;
+    {
+        wxSVGFileDC dc(stream);
+
+        // Unfilled rectangles are combined with each other.
+        dc.SetPen(*wxBLUE_PEN);
+        dc.SetBrush(*wxTRANSPARENT_BRUSH);
+        dc.DrawRectangle(0, 0, 10, 20);
+        dc.DrawRectangle(5, 5, 10, 20);
+
+        // So are filled rectangles without outline.
+        dc.SetPen(*wxTRANSPARENT_PEN);
+        dc.SetBrush(*wxGREEN_BRUSH);
+        dc.DrawRectangle(1, 2, 3, 4);
+        dc.DrawRectangle(2, 3, 4, 5);
+
+        // But not the filled rectangles with outline.
+        dc.SetPen(*wxBLACK_PEN);
+        dc.DrawRectangle(7, 8, 9, 10);
+        dc.DrawRectangle(8, 9, 10, 11);
+    }
+
+    const wxString svg = GetSVG(stream);
+    INFO(svg);
+
+    CHECK( CountOf(svg, "<path ") == 2 );
+    CHECK( svg.Contains("<path d=\"M0 0 h10 v20 h-10 z M5 5 h10 v20 h-10 z\" style=\"fill:none\" ") );
+    CHECK( svg.Contains("<path d=\"M1 2 h3 v4 h-3 z M2 3 h4 v5 h-4 z\" shape-rendering") );
+
+    CHECK( CountOf(svg, "<rect ") == 2 );
+    CHECK( svg.Contains("<rect x=\"7\" y=\"8\" width=\"9\" height=\"10\" rx=\"0.00\" ") );
+    CHECK( svg.Contains("<rect x=\"8\" y=\"9\" width=\"10\" height=\"11\" rx=\"0.00\" ") );
+}
+
+TEST_CASE("SVGFileDC::StyleClasses", "[dc][svg]")
+{
+    wxMemoryOutputStream stream;
+    {
+        wxSVGFileDC dc(stream);
+        dc.EnableStyleClasses();
+
+        for ( int n = 0; n < 3; n++ )
+        {
+            dc.SetPen(*wxRED_PEN);
+            dc.DrawLine(0, 0, 10, 10);
+            dc.SetPen(*wxBLUE_PEN);
+            dc.DrawLine(0, 0, 10, 10);
+        }
+    }
+
+    const wxString svg = GetSVG(stream);
+    INFO(svg);
+
+    // The classes must be defined once, in the header.
+    CHECK( CountOf(svg, "<style") == 1 );
+    CHECK( CountOf(svg, ".g0 {") == 1 );
+    CHECK( CountOf(svg, ".g1 {") == 1 );
+    CHECK( !svg.Contains(".g2 {") );
+
+    const size_t posDefs = svg.find("<defs>\n<style type=\"text/css\">\n");
+    REQUIRE( posDefs != wxString::npos );
+    CHECK( posDefs > svg.find("</desc>") );
+    CHECK( posDefs < svg.find("<g ") );
+
+    // And then just referenced by the groups.
+    CHECK( CountOf(svg, "<g class=\"g0\"") == 3 );
+    CHECK( CountOf(svg, "<g class=\"g1\"") == 3 );
+
+    CHECK( svg.EndsWith("</g>\n</svg>\n") );
+}
+
+#if wxUSE_ZLIB
+
+TEST_CASE("SVGFileDC::Compressed", "[dc][svg]")
+{
+    TempFile file("test.svgz");
+    {
+        wxSVGFileDC dc(file.GetName());
+        dc.DrawLine(0, 0, 10, 10);
+    }
+
+    wxFileInputStream fileStream(file.GetName());
+    REQUIRE( fileStream.IsOk() );
+
+    wxZlibInputStream zstream(fileStream, wxZLIB_GZIP);
+    wxMemoryOutputStream stream;
+    stream.Write(zstream);
+
+    const wxString svg = GetSVG(stream);
+    INFO(svg);
+
+    CHECK( svg.StartsWith("<?xml") );
+    CHECK( svg.Contains("<path d=\"M0 0 L10 10\" ") );
+    CHECK( svg.EndsWith("</svg>\n") );
+}
+
+#endif // wxUSE_ZLIB
+
+#endif // wxUSE_SVG
@@ -23,6 +23,11 @@
 
 #include "wx/private/glibc.h"
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
 #if wxUSE_INTL
 
 // ----------------------------------------------------------------------------
@@ -359,6 +364,229 @@ TEST_CASE("wxTranslations::GetBestTranslation", "[translations]")
     }
 }
 
+namespace
+{
+
+typedef wxUint32 size_t32;
+
+size_t32 HashMsgId(const std::string& str)
+{
+    size_t32 hval = 0;
+    for ( unsigned char ch : str )
+    {
+        hval = (hval << 4) + ch;
+
+        const size_t32 g = hval & 0xf0000000;
+        if ( g )
+            hval ^= (g >> 24) ^ g;
+    }
+
+    return hval;
+}
+
+void AppendNumber(std::string& data, size_t32 n)
+{
+    data.append(reinterpret_cast<const char*>(&n), sizeof(n));
+}
+
+// Build the contents of a .mo file with the given (msgid, msgstr) pairs sorted
+// by msgid, with the hash table of the given size, which must be prime, or
+// without it if the size is 0.
+std::string
+BuildCatalog(const std::vector<std::pair<std::string, std::string>>& entries,
+             size_t32 hashSize)
+{
+    const size_t32 count = entries.size();
+
+    std::vector<size_t32> hashTable(hashSize, 0);
+    for ( size_t32 n = 0; n < count && hashSize; n++ )
+    {
+        // Only the singular form of the plural entries is hashed, so stop
+        // at the first NUL.
+        const size_t32 hval = HashMsgId(entries[n].first.c_str());
+        const size_t32 incr = 1 + hval % (hashSize - 2);
+        size_t32 idx = hval % hashSize;
+        while ( hashTable[idx] )
+            idx = (idx + incr) % hashSize;
+
+        hashTable[idx] = n + 1;
+    }
+
+    const size_t32 ofsOrig = 28;
+    const size_t32 ofsTrans = ofsOrig + 8*count;
+    const size_t32 ofsHash = ofsTrans + 8*count;
+    const size_t32 ofsStrings = ofsHash + 4*hashSize;
+
+    std::string data;
+    AppendNumber(data, 0x950412de);
+    AppendNumber(data, 0);
+    AppendNumber(data, count);
+    AppendNumber(data, ofsOrig);
+    AppendNumber(data, ofsTrans);
+    AppendNumber(data, hashSize);
+    AppendNumber(data, ofsHash);
+
+    std::string strings;
+    for ( int table = 0; table < 2; table++ )
+    {
+        for ( const auto& entry : entries )
+        {
+            const std::string& str = table == 0 ? entry.first : entry.second;
+            AppendNumber(data, str.length());
+            AppendNumber(data, ofsStrings + strings.length());
+            strings.append(str.c_str(), str.length() + 1);
+        }
+    }
+
+    for ( size_t32 n : hashTable )
+        AppendNumber(data, n);
+
+    return data + strings;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxMsgCatalog::CreateFromFile", "[translations]")
+{
+    std::unique_ptr<wxMsgCatalog>
+        cat(wxMsgCatalog::CreateFromFile("./intl/fr/internat.mo", "internat"));
+    REQUIRE( cat );
+
+    const wxString* str = cat->GetString("&Open bogus file");
+    REQUIRE( str );
+    CHECK( *str == "&Ouvrir un fichier" );
+
+    str = cat->GetString("Enter your number:");
+    REQUIRE( str );
+    CHECK( *str == wxString::FromUTF8("Entrez votre num\xc3\xa9ro:") );
+
+    CHECK( !cat->GetString("Not translated") );
+    CHECK( !cat->GetString("&Open bogus file", UINT_MAX, "context") );
+}
+
+TEST_CASE("wxMsgCatalog::GetString", "[translations]")
+{
+    // Notice that the plural entry contains embedded NULs, so its length
+    // must be given explicitly.
+    std::vector<std::pair<std::string, std::string>> entries =
+    {
+        { "",
+          "Content-Type: text/plain; charset=UTF-8\n"
+          "Plural-Forms: nplurals=2; plural=(n != 1);\n" },
+        { "Empty", "" },
+        { std::string("One file\0%d files", 17),
+          std::string("Un fichier\0%d fichiers", 22) },
+        { "menu\x04" "File", "Fichier" },
+        { "\xc3\xa9t\xc3\xa9", "summer" },
+        { "File", "Dossier" },
+    };
+    std::sort(entries.begin(), entries.end());
+
+    std::string data;
+    std::unique_ptr<wxMsgCatalog> cat;
+    SECTION("Hash")
+    {
+        data = BuildCatalog(entries, 11);
+        cat.reset(wxMsgCatalog::CreateFromData(data.data(), data.size(), "test"));
+    }
+    SECTION("NoHash")
+    {
+        data = BuildCatalog(entries, 0);
+        cat.reset(wxMsgCatalog::CreateFromData(data.data(), data.size(), "test"));
+    }
+    SECTION("Unsorted")
+    {
+        // Binary search can't be used if the strings are not sorted.
+        std::reverse(entries.begin() + 1, entries.end());
+        data = BuildCatalog(entries, 0);
+        cat.reset(wxMsgCatalog::CreateFromData(data.data(), data.size(), "test"));
+    }
+    SECTION("Copy")
+    {
+        // The data must be copied by this overload, so check that the catalog
+        // still works after destroying the original buffer.
+        std::string temp = BuildCatalog(entries, 11);
+        cat.reset(wxMsgCatalog::CreateFromData(
+                    wxScopedCharBuffer::CreateNonOwned(temp.data(), temp.size()),
+                    "test"));
+        temp.assign(temp.size(), '\0');
+    }
+
+    REQUIRE( cat );
+
+    const wxString* str = cat->GetString("File");
+    REQUIRE( str );
+    CHECK( *str == "Dossier" );
+
+    str = cat->GetString("File", UINT_MAX, "menu");
+    REQUIRE( str );
+    CHECK( *str == "Fichier" );
+
+    str = cat->GetString(wxString::FromUTF8("\xc3\xa9t\xc3\xa9"));
+    REQUIRE( str );
+    CHECK( *str == "summer" );
+
+    str = cat->GetString("One file", 1);
+    REQUIRE( str );
+    CHECK( *str == "Un fichier" );
+
+    str = cat->GetString("One file", 3);
+    REQUIRE( str );
+    CHECK( *str == "%d fichiers" );
+
+    CHECK( !cat->GetString("Empty") );
+    CHECK( !cat->GetString("Fil") );
+    CHECK( !cat->GetString("Files") );
+    CHECK( !cat->GetString("File", UINT_MAX, "other") );
+}
+
+#ifdef wxHAS_CACHED_TRANSLATIONS
+
+namespace
+{
+
+const wxString& GetCachedOpen()
+{
+    return wxGETTEXT_CACHED("&Open bogus file");
+}
+
+const wxString& GetCachedInContext()
+{
+    return wxGETTEXT_IN_CONTEXT_CACHED("context", "&Open bogus file");
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxTranslations::Cached", "[translations]")
+{
+    static_assert( wxGetTranslationHash("&Open bogus file") != 0,
+                   "hash must be usable at compile-time" );
+
+    wxFileTranslationsLoader::AddCatalogLookupPathPrefix("./intl");
+
+    wxTranslations* const trans = new wxTranslations;
+    wxTranslations::Set(trans);
+    wxON_BLOCK_EXIT1( wxTranslations::Set, static_cast<wxTranslations*>(nullptr) );
+
+    // Without any catalogs, the string itself is returned.
+    CHECK( GetCachedOpen() == "&Open bogus file" );
+
+    // Adding a catalog must invalidate the cached value.
+    trans->SetLanguage(wxLANGUAGE_FRENCH);
+    REQUIRE( trans->AddCatalog("internat") );
+    CHECK( GetCachedOpen() == "&Ouvrir un fichier" );
+    CHECK( &GetCachedOpen() == &GetCachedOpen() );
+
+    // There is no translation in this context.
+    CHECK( GetCachedInContext() == "&Open bogus file" );
+
+    // And so must resetting the translations.
+    wxTranslations::Set(nullptr);
+    CHECK( GetCachedOpen() == "&Open bogus file" );
+}
+
+#endif // wxHAS_CACHED_TRANSLATIONS
+
 // This test can be used to check how GetBestTranslation() and
 // GetAvailableTranslations() work with the given preferred languages: set
 // WXLANGUAGE environment variable to the colon-separated list of preferred
@@ -0,0 +1,276 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/log/logasync.cpp
+// Purpose:     wxLogAsync unit test
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+#endif // WX_PRECOMP
+
+#include "wx/logasync.h"
+
+#if wxUSE_LOG && wxUSE_THREADS
+
+#include <stdio.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Formatter outputting just the message itself and blocking while formatting
+// the message "block" until Unblock() is called.
+class BlockingFormatter : public wxLogFormatter
+{
+public:
+    BlockingFormatter() = default;
+
+    virtual wxString Format(wxLogLevel WXUNUSED(level),
+                            const wxString& msg,
+                            const wxLogRecordInfo& WXUNUSED(info)) const override
+    {
+        if ( msg == "block" )
+        {
+            m_blocked.Post();
+            m_unblock.Wait();
+        }
+
+        return msg;
+    }
+
+    void WaitUntilBlocked() { m_blocked.Wait(); }
+    void Unblock() { m_unblock.Post(); }
+
+private:
+    mutable wxSemaphore m_blocked,
+                        m_unblock;
+};
+
+// Set up wxLogAsync writing to a temporary file as the active log target.
+class LogAsyncFixture
+{
+public:
+    explicit LogAsyncFixture(size_t queueSize = 1024,
+                             wxMessageQueueOverflow overflow
+                                = wxMSGQUEUE_OVERFLOW_BLOCK)
+        : m_fp(tmpfile()),
+          m_formatter(new BlockingFormatter),
+          m_log(new wxLogAsync(m_fp, queueSize, overflow))
+    {
+        delete m_log->SetFormatter(m_formatter);
+        m_logOld = wxLog::SetActiveTarget(m_log.get());
+    }
+
+    ~LogAsyncFixture()
+    {
+        wxLog::SetActiveTarget(m_logOld);
+        m_log.reset();
+        fclose(m_fp);
+    }
+
+    // Wait until all the messages are written and return them.
+    std::vector<wxString> GetLines()
+    {
+        m_log->FlushAndWait();
+
+        std::vector<wxString> lines;
+
+        rewind(m_fp);
+
+        char buf[256];
+        while ( fgets(buf, sizeof(buf), m_fp) )
+            lines.push_back(wxString(buf).BeforeLast('\n'));
+
+        return lines;
+    }
+
+    FILE* const m_fp;
+    BlockingFormatter* const m_formatter;
+    std::unique_ptr<wxLogAsync> m_log;
+
+private:
+    wxLog* m_logOld;
+};
+
+class LogThread : public wxThread
+{
+public:
+    LogThread(int n, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_n(n),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int i = 0; i < m_count; i++ )
+            wxLogMessage("thread %d message %d", m_n, i);
+
+        return nullptr;
+    }
+
+private:
+    const int m_n,
+              m_count;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(LogAsyncFixture, "wxLogAsync::Threads", "[log][async]")
+{
+    const int NUM_THREADS = 4;
+    const int NUM_MESSAGES = 1000;
+
+    std::vector<std::unique_ptr<LogThread>> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        threads.emplace_back(new LogThread(n, NUM_MESSAGES));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    wxLogMessage("main thread message");
+
+    for ( auto& thread : threads )
+        thread->Wait();
+
+    const std::vector<wxString> lines = GetLines();
+    REQUIRE( lines.size() == NUM_THREADS*NUM_MESSAGES + 1 );
+
+    // The messages from each thread must be written in order.
+    std::vector<int> next(NUM_THREADS, 0);
+    bool hasMain = false;
+    for ( const auto& line : lines )
+    {
+        int n, i;
+        if ( sscanf(line.utf8_str(), "thread %d message %d", &n, &i) == 2 )
+        {
+            REQUIRE( n >= 0 );
+            REQUIRE( n < NUM_THREADS );
+            CHECK( i == next[n]++ );
+        }
+        else
+        {
+            CHECK( line == "main thread message" );
+            hasMain = true;
+        }
+    }
+
+    CHECK( hasMain );
+    CHECK( m_log->GetDroppedCount() == 0 );
+}
+
+TEST_CASE_METHOD(LogAsyncFixture, "wxLogAsync::Text", "[log][async]")
+{
+    const int NUM_MESSAGES = 1000;
+
+    // Text logged directly must not be mixed with the text written by the
+    // writer thread at the same time.
+    LogThread thread(0, NUM_MESSAGES);
+    REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+
+    for ( int i = 0; i < NUM_MESSAGES; i++ )
+        m_log->LogTextAtLevel(wxLOG_Message, wxString::Format("text %d", i));
+
+    thread.Wait();
+
+    const std::vector<wxString> lines = GetLines();
+    REQUIRE( lines.size() == 2*NUM_MESSAGES );
+
+    int nextMessage = 0,
+        nextText = 0;
+    for ( const auto& line : lines )
+    {
+        int n, i;
+        if ( sscanf(line.utf8_str(), "thread %d message %d", &n, &i) == 2 )
+        {
+            CHECK( i == nextMessage++ );
+        }
+        else
+        {
+            INFO("Line \"" << line << "\"");
+            REQUIRE( sscanf(line.utf8_str(), "text %d", &i) == 1 );
+            CHECK( i == nextText++ );
+        }
+    }
+}
+
+TEST_CASE("wxLogAsync::Overflow", "[log][async]")
+{
+    SECTION("Fail")
+    {
+        LogAsyncFixture fixture(2, wxMSGQUEUE_OVERFLOW_FAIL);
+
+        wxLogMessage("block");
+        fixture.m_formatter->WaitUntilBlocked();
+
+        for ( int i = 0; i < 5; i++ )
+            wxLogMessage("message %d", i);
+
+        fixture.m_formatter->Unblock();
+
+        const std::vector<wxString> lines = fixture.GetLines();
+        REQUIRE( lines.size() == 3 );
+        CHECK( lines[1] == "message 0" );
+        CHECK( lines[2] == "message 1" );
+        CHECK( fixture.m_log->GetDroppedCount() == 3 );
+    }
+
+    SECTION("DropOldest")
+    {
+        LogAsyncFixture fixture(2, wxMSGQUEUE_OVERFLOW_DROP_OLDEST);
+
+        wxLogMessage("block");
+        fixture.m_formatter->WaitUntilBlocked();
+
+        for ( int i = 0; i < 5; i++ )
+            wxLogMessage("message %d", i);
+
+        fixture.m_formatter->Unblock();
+
+        const std::vector<wxString> lines = fixture.GetLines();
+        REQUIRE( lines.size() == 3 );
+        CHECK( lines[1] == "message 3" );
+        CHECK( lines[2] == "message 4" );
+        CHECK( fixture.m_log->GetDroppedCount() == 3 );
+    }
+
+    SECTION("Block")
+    {
+        LogAsyncFixture fixture(2, wxMSGQUEUE_OVERFLOW_BLOCK);
+
+        wxLogMessage("block");
+        fixture.m_formatter->WaitUntilBlocked();
+
+        // The thread will block after logging the first 2 messages.
+        LogThread thread(0, 10);
+        REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+
+        fixture.m_formatter->Unblock();
+        thread.Wait();
+
+        const std::vector<wxString> lines = fixture.GetLines();
+        REQUIRE( lines.size() == 11 );
+        CHECK( lines[10] == "thread 0 message 9" );
+        CHECK( fixture.m_log->GetDroppedCount() == 0 );
+    }
+}
+
+#endif // wxUSE_LOG && wxUSE_THREADS
@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/log/logbinary.cpp
+// Purpose:     wxLogBinary and wxLogBinaryReader unit test
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+#endif // WX_PRECOMP
+
+#include "wx/logbinary.h"
+
+#if wxUSE_LOG
+
+#include "testfile.h"
+
+#ifdef __UNIX__
+    #include <unistd.h>
+#endif
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Set up wxLogBinary writing to a temporary file as the active log target.
+class LogBinaryFixture
+{
+public:
+    LogBinaryFixture()
+        : m_file(wxFileName::CreateTempFileName("wxlogbin")),
+          m_log(new wxLogBinary(m_file.GetName()))
+    {
+        m_logOld = wxLog::SetActiveTarget(m_log.get());
+    }
+
+    ~LogBinaryFixture()
+    {
+        wxLog::SetActiveTarget(m_logOld);
+    }
+
+    // Stop logging to the file, if not done yet.
+    void Close()
+    {
+        wxLog::SetActiveTarget(m_logOld);
+        m_log.reset();
+    }
+
+    // Read all the records from the file.
+    std::vector<wxLogBinaryRecord> ReadRecords(bool* hasError = nullptr)
+    {
+        std::vector<wxLogBinaryRecord> records;
+
+        wxLogBinaryReader reader;
+        REQUIRE( reader.Open(m_file.GetName()) );
+
+        wxLogBinaryRecord record;
+        while ( reader.GetNext(record) )
+            records.push_back(record);
+
+        if ( hasError )
+            *hasError = reader.HasError();
+        else
+            CHECK( !reader.HasError() );
+
+        return records;
+    }
+
+    TempFile m_file;
+    std::unique_ptr<wxLogBinary> m_log;
+
+private:
+    wxLog* m_logOld;
+};
+
+#if wxUSE_THREADS
+
+class LogThread : public wxThread
+{
+public:
+    LogThread(int n, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_n(n),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int i = 0; i < m_count; i++ )
+            wxLogMessage("thread %d message %d", m_n, i);
+
+        return nullptr;
+    }
+
+private:
+    const int m_n,
+              m_count;
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(LogBinaryFixture, "wxLogBinary::Records", "[log][binary]")
+{
+    REQUIRE( m_log->IsOk() );
+
+    const int line = __LINE__ + 1;
+    wxLogger(wxLOG_Warning, "file.cpp", line, "Func", "comp/sub").Log("%d", 17);
+    const wxString nonASCII = wxString::FromUTF8("\xc3\xa9t\xc3\xa9");
+    wxLogger(wxLOG_Error, "file.cpp", 99, "Other", nullptr).Log("%s", nonASCII);
+    wxLogMessage("%s", wxString('x', 100000));
+
+    Close();
+
+    const std::vector<wxLogBinaryRecord> records = ReadRecords();
+    REQUIRE( records.size() == 3 );
+
+    CHECK( records[0].level == wxLOG_Warning );
+    CHECK( records[0].msg == "17" );
+    CHECK( records[0].filename == "file.cpp" );
+    CHECK( records[0].line == line );
+    CHECK( records[0].func == "Func" );
+    CHECK( records[0].component == "comp/sub" );
+    CHECK( records[0].timestampMS != 0 );
+#if wxUSE_THREADS
+    CHECK( records[0].threadId == wxThread::GetCurrentId() );
+#endif // wxUSE_THREADS
+
+    CHECK( records[1].level == wxLOG_Error );
+    CHECK( records[1].msg == nonASCII );
+    CHECK( records[1].filename == "file.cpp" );
+    CHECK( records[1].line == 99 );
+    CHECK( records[1].func == "Other" );
+    CHECK( records[1].component.empty() );
+
+    CHECK( records[2].level == wxLOG_Message );
+    CHECK( records[2].msg.length() == 100000 );
+    CHECK( records[2].filename == __FILE__ );
+}
+
+TEST_CASE_METHOD(LogBinaryFixture, "wxLogBinary::Unclosed", "[log][binary]")
+{
+    // The file is not truncated to its real size before it is closed, check
+    // that it can still be read, as it would be if the program crashed.
+    for ( int i = 0; i < 100000; i++ )
+        wxLogMessage("message %d", i);
+
+    const std::vector<wxLogBinaryRecord> records = ReadRecords();
+    REQUIRE( records.size() == 100000 );
+    CHECK( records[99999].msg == "message 99999" );
+}
+
+TEST_CASE_METHOD(LogBinaryFixture, "wxLogBinary::Truncated", "[log][binary]")
+{
+    wxLogMessage("first");
+    wxLogMessage("second");
+
+    Close();
+
+#ifdef __UNIX__
+    const wxFileOffset size = wxFile(m_file.GetName()).Length();
+    REQUIRE( size > 0 );
+
+    // Drop the last byte of the second record.
+    REQUIRE( truncate(m_file.GetName().fn_str(), size - 1) == 0 );
+
+    bool hasError = false;
+    const std::vector<wxLogBinaryRecord> records = ReadRecords(&hasError);
+    REQUIRE( records.size() == 1 );
+    CHECK( records[0].msg == "first" );
+    CHECK( hasError );
+#endif // __UNIX__
+}
+
+TEST_CASE("wxLogBinaryReader::Invalid", "[log][binary]")
+{
+    TempFile file(wxFileName::CreateTempFileName("wxlogbin"));
+
+    wxLogNull noLog;
+
+    wxLogBinaryReader reader;
+    CHECK( !reader.Open(file.GetName()) );
+    CHECK( !reader.Open(file.GetName() + ".nonexistent") );
+}
+
+#if wxUSE_THREADS
+
+TEST_CASE_METHOD(LogBinaryFixture, "wxLogBinary::Threads", "[log][binary]")
+{
+    const int NUM_THREADS = 4;
+    const int NUM_MESSAGES = 1000;
+
+    std::vector<std::unique_ptr<LogThread>> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        threads.emplace_back(new LogThread(n, NUM_MESSAGES));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    for ( auto& thread : threads )
+        thread->Wait();
+
+    Close();
+
+    const std::vector<wxLogBinaryRecord> records = ReadRecords();
+    REQUIRE( records.size() == NUM_THREADS*NUM_MESSAGES );
+
+    // The messages from each thread must be written in order.
+    std::vector<int> next(NUM_THREADS, 0);
+    for ( const auto& record : records )
+    {
+        int n, i;
+        REQUIRE( sscanf(record.msg.utf8_str(), "thread %d message %d",
+                        &n, &i) == 2 );
+        REQUIRE( n >= 0 );
+        REQUIRE( n < NUM_THREADS );
+        CHECK( i == next[n]++ );
+        CHECK( record.threadId != wxThread::GetCurrentId() );
+    }
+}
+
+#endif // wxUSE_THREADS
+
+#endif // wxUSE_LOG
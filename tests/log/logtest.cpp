@@ -360,6 +360,65 @@ void macroCompilabilityTest()
         wxLogDebug("hello debug %d", 42);
 }
 
+TEST_CASE("wxLog::GetComponentLevel", "[log]")
+{
+    const wxLogLevel level = wxLog::GetLogLevel();
+
+    CHECK( wxLog::GetComponentLevel("logtest-comp/sub") == level );
+
+    wxLog::SetComponentLevel("logtest-comp", wxLOG_Error);
+    wxLog::SetComponentLevel("logtest-comp/sub/verbose", wxLOG_Max);
+
+    // Both overloads must give the same results.
+    CHECK( wxLog::GetComponentLevel("logtest-comp") == wxLOG_Error );
+    CHECK( wxLog::GetComponentLevel(wxString("logtest-comp")) == wxLOG_Error );
+
+    CHECK( wxLog::GetComponentLevel("logtest-comp/sub") == wxLOG_Error );
+    CHECK( wxLog::GetComponentLevel(wxString("logtest-comp/sub")) == wxLOG_Error );
+
+    CHECK( wxLog::GetComponentLevel("logtest-comp/sub/verbose/x") == wxLOG_Max );
+    CHECK( wxLog::GetComponentLevel(wxString("logtest-comp/sub/verbose/x")) == wxLOG_Max );
+
+    // Only full components must match, not prefixes.
+    CHECK( wxLog::GetComponentLevel("logtest-compo") == level );
+    CHECK( wxLog::GetComponentLevel("logtest") == level );
+
+    CHECK( !wxLog::IsLevelEnabled(wxLOG_Warning, "logtest-comp/sub") );
+    CHECK( wxLog::IsLevelEnabled(wxLOG_Error, "logtest-comp/sub") );
+
+    wxLog::SetComponentLevel("logtest-comp", level);
+    wxLog::SetComponentLevel("logtest-comp/sub/verbose", level);
+}
+
+#if wxDEBUG_LEVEL
+
+TEST_CASE("wxLog::IsAllowedTraceMask", "[log]")
+{
+    CHECK( !wxLog::IsAllowedTraceMask("logtest-mask") );
+
+    wxLog::AddTraceMask("logtest-mask");
+    wxLog::AddTraceMask("logtest-other");
+
+    CHECK( wxLog::IsAllowedTraceMask("logtest-mask") );
+    CHECK( wxLog::IsAllowedTraceMask(wxString("logtest-mask")) );
+    CHECK( wxLog::IsAllowedTraceMask("logtest-other") );
+    // A prefix of an allowed mask must not be allowed.
+    CHECK( !wxLog::IsAllowedTraceMask("logtest-mas") );
+    CHECK( !wxLog::IsAllowedTraceMask(wxString("logtest-mask2")) );
+
+    wxLog::RemoveTraceMask("logtest-mask");
+
+    CHECK( !wxLog::IsAllowedTraceMask("logtest-mask") );
+    CHECK( wxLog::IsAllowedTraceMask("logtest-other") );
+
+    wxLog::RemoveTraceMask("logtest-other");
+
+    CHECK( !wxLog::IsAllowedTraceMask("logtest-other") );
+    CHECK( !wxLog::IsAllowedTraceMask(wxString("logtest-other")) );
+}
+
+#endif // wxDEBUG_LEVEL
+
 // This allows to check wxLogTrace() interactively by running this test with
 // WXTRACE=logtest.
 TEST_CASE("wxLog::Trace", "[log][.]")
@@ -1508,3 +1508,49 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     CHECK( wxConvUTF7.cMB2WC(wxCharBuffer()).length() == 0 );
     CHECK( wxConvUTF7.cMB2WC("+AKM-").length() == 1 );
 }
+
+TEST_CASE("wxMBConv::UTF8Long", "[mbconv][utf8]")
+{
+    // ASCII characters are converted in blocks, check that non-ASCII ones at
+    // all positions relative to the block boundaries are handled correctly.
+    const wxMBConvUTF8 convPUA(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+    const wxMBConvUTF8 convOctal(wxMBConvUTF8::MAP_INVALID_UTF8_TO_OCTAL);
+
+    for ( size_t pos = 0; pos < 40; pos++ )
+    {
+        INFO( "Non-ASCII character at " << pos );
+
+        std::string utf8(40, 'x');
+        utf8.insert(pos, "\xc3\xa9");
+
+        std::wstring wide(40, L'x');
+        wide.insert(pos, 1, L'\xe9');
+
+        CHECK( wxConvUTF8.ToWChar(nullptr, 0, utf8.data(), utf8.length())
+                == wide.length() );
+        CHECK( wxString::FromUTF8(utf8.data(), utf8.length()) == wide );
+        CHECK( wxString(utf8.data(), convPUA, utf8.length()) == wide );
+
+        CHECK( wxString(wide).utf8_string() == utf8 );
+
+        CHECK( wxConvUTF8.FromWChar(nullptr, 0, wide.data(), wide.length())
+                == utf8.length() );
+
+        // Invalid sequences must be still detected.
+        utf8.erase(pos + 1, 1);
+        CHECK( wxConvUTF8.ToWChar(nullptr, 0, utf8.data(), utf8.length())
+                == wxCONV_FAILED );
+
+        // The invalid byte is mapped to U+100000 + byte in PUA mode.
+        wxString str(wide);
+        str[pos] = wxUniChar(0x1000c3);
+        CHECK( wxString(utf8.data(), convPUA, utf8.length()) == str );
+
+        // And backslashes still escaped in octal mode.
+        utf8[pos] = '\\';
+        wide.replace(pos, 1, L"\\\\");
+        CHECK( wxString(utf8.data(), convOctal, utf8.length()) == wide );
+        CHECK( convOctal.FromWChar(nullptr, 0, wide.data(), wide.length())
+                == utf8.length() );
+    }
+}
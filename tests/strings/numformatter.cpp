@@ -156,6 +156,45 @@ TEST_CASE_METHOD(NumFormatterTestCase, "NumFormatter::NoTrailingZeroes", "[numfo
     CHECK( ToStringWithoutTrailingZeroes(   1e-120, -1) ==        "1e-120" );
 }
 
+TEST_CASE_METHOD(NumFormatterTestCase, "NumFormatter::ToChars", "[numformatter]")
+{
+    wxChar buf[32];
+
+    // Check that the buffer size is respected independently of the locale.
+    CHECK( wxNumberFormatter::ToChars(buf, 4, 123L, wxNumberFormatter::Style_None) == 3 );
+    CHECK( wxString(buf) == "123" );
+    CHECK( wxNumberFormatter::ToChars(buf, 3, 123L, wxNumberFormatter::Style_None) == 0 );
+    CHECK( wxNumberFormatter::ToChars(buf, 0, 123L, wxNumberFormatter::Style_None) == 0 );
+
+    if ( !CanRunTest() )
+        return;
+
+    CHECK( wxNumberFormatter::ToChars(buf, WXSIZEOF(buf), 1234567L) == 9 );
+    CHECK( wxString(buf) == "1,234,567" );
+
+    CHECK( wxNumberFormatter::ToChars(buf, 10, -123456L) == 8 );
+    CHECK( wxString(buf) == "-123,456" );
+    CHECK( wxNumberFormatter::ToChars(buf, 8, -123456L) == 0 );
+
+    CHECK( wxNumberFormatter::ToChars(buf, WXSIZEOF(buf), wxUINT64_MAX) == 26 );
+    CHECK( wxString(buf) == "18,446,744,073,709,551,615" );
+
+#ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+    CHECK( wxNumberFormatter::ToChars(buf, WXSIZEOF(buf), wxINT64_MIN) == 26 );
+    CHECK( wxString(buf) == "-9,223,372,036,854,775,808" );
+#endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+
+    CHECK( wxNumberFormatter::ToChars(buf, WXSIZEOF(buf), 1234.5, 3) == 9 );
+    CHECK( wxString(buf) == "1,234.500" );
+
+    CHECK( wxNumberFormatter::ToChars(buf, WXSIZEOF(buf), -1234.5, 3,
+                                      wxNumberFormatter::Style_WithThousandsSep |
+                                      wxNumberFormatter::Style_NoTrailingZeroes) == 8 );
+    CHECK( wxString(buf) == "-1,234.5" );
+
+    CHECK( wxNumberFormatter::ToChars(buf, 9, 1234.5, 3) == 0 );
+}
+
 TEST_CASE_METHOD(NumFormatterTestCase, "NumFormatter::LongFromString", "[numformatter]")
 {
     if ( !CanRunTest() )
@@ -341,3 +380,27 @@ TEST_CASE_METHOD(NumFormatterTestCase, "NumFormatter::DoubleFromString", "[numfo
     CHECK( wxNumberFormatter::FromString("123456789.012", &d) );
     CHECK( d == 123456789.012 );
 }
+
+TEST_CASE_METHOD(NumFormatterTestCase, "NumFormatter::FromChars", "[numformatter]")
+{
+    if ( !CanRunTest() )
+        return;
+
+    static const wxChar s[] = wxS("1,234,567.89 and more");
+
+    long l;
+    CHECK( wxNumberFormatter::FromChars(s, 9, &l) );
+    CHECK( l == 1234567 );
+    CHECK_FALSE( wxNumberFormatter::FromChars(s, 12, &l) );
+    CHECK_FALSE( wxNumberFormatter::FromChars(s, 0, &l) );
+
+    wxULongLong_t u;
+    CHECK( wxNumberFormatter::FromChars(s, 5, &u) );
+    CHECK( u == 1234 );
+
+    double d;
+    CHECK( wxNumberFormatter::FromChars(s, 12, &d) );
+    CHECK( d == 1234567.89 );
+    CHECK_FALSE( wxNumberFormatter::FromChars(s, WXSIZEOF(s) - 1, &d) );
+}
+
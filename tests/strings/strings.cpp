@@ -998,6 +998,106 @@ TEST_CASE("StringUTF8Buf", "[wxString]")
     CHECK(s == wxString(textUTF16, 0, 3));
 }
 
+TEST_CASE("StringUTF8Str", "[wxString]")
+{
+    wxString s("Hello");
+    CHECK( s.utf8_str().length() == 5 );
+    CHECK( strcmp(s.utf8_str(), "Hello") == 0 );
+
+    // The returned buffer must own its data and remain valid even after the
+    // string is modified or destroyed.
+    {
+        wxString tmp("Hello");
+        const wxScopedCharBuffer buf = tmp.utf8_str();
+        tmp = "Goodbye";
+        CHECK( strcmp(tmp.utf8_str(), "Goodbye") == 0 );
+        tmp.clear();
+        tmp.Shrink();
+        CHECK( strcmp(buf, "Hello") == 0 );
+    }
+
+    // Modifying the string in any way must be taken into account.
+    s[0] = 'J';
+    CHECK( strcmp(s.utf8_str(), "Jello") == 0 );
+
+    s.Replace("ll", wxString::FromUTF8("\xc3\xa9\xc3\xa9"));
+    CHECK( s.utf8_str().length() == 7 );
+    CHECK( s.utf8_string() == "Je\xc3\xa9\xc3\xa9o" );
+
+    *s.begin() = 'H';
+    CHECK( s.utf8_string() == "He\xc3\xa9\xc3\xa9o" );
+
+    {
+        wxStringBuffer buf(s, 5);
+        wxStrcpy(buf, "Hallo");
+    }
+    CHECK( s.utf8_string() == "Hallo" );
+
+    s.clear();
+    CHECK( s.utf8_str().length() == 0 );
+    CHECK( strcmp(s.utf8_str(), "") == 0 );
+
+    // Check that longer strings, which are converted differently, work too.
+    const std::string longUTF8 = std::string(100, 'x') + "\xc3\xa9";
+    s = wxString::FromUTF8(longUTF8);
+    CHECK( s.utf8_str().length() == longUTF8.length() );
+    CHECK( s.utf8_string() == longUTF8 );
+
+    // Copies of the string must be independent.
+    s = "copy";
+    CHECK( s.utf8_string() == "copy" );
+
+    wxString copy(s);
+    copy += "!";
+    CHECK( copy.utf8_string() == "copy!" );
+    CHECK( s.utf8_string() == "copy" );
+}
+
+TEST_CASE("StringFromMB", "[wxString]")
+{
+    CHECK( wxString("").empty() );
+    CHECK( wxString(static_cast<const char*>(nullptr)).empty() );
+    CHECK( wxString("Hello", size_t(0)).empty() );
+    CHECK( wxString("Hello", 4) == L"Hell" );
+    CHECK( wxString("Hello") == L"Hello" );
+
+    // Check strings of different lengths, as short strings are handled
+    // differently from the long ones.
+    for ( size_t len = 1; len < 200; len++ )
+    {
+        const std::string str(len, 'x');
+        const wxString s(str.c_str());
+        REQUIRE( s.length() == len );
+        CHECK( s == std::wstring(len, L'x') );
+
+        CHECK( wxString(str.c_str(), wxConvUTF8, len - 1).length() == len - 1 );
+    }
+
+    // Embedded NULs must be preserved if the length is given explicitly.
+    CHECK( wxString("a\0b", 3).length() == 3 );
+
+    CHECK( wxString("h\xc3\xa9llo", wxConvUTF8) == wxString::FromUTF8("h\xc3\xa9llo") );
+
+    // Invalid strings result in empty strings, whatever their length.
+    CHECK( wxString("\xff", wxConvUTF8).empty() );
+    CHECK( wxString(std::string(100, '\xff').c_str(), wxConvUTF8).empty() );
+
+    // Check that the conversions using multibyte NULs work too.
+    static const char textUTF16[] = "H\0e\0l\0l\0o\0\0";
+    CHECK( wxString(textUTF16, wxMBConvUTF16LE()) == L"Hello" );
+    CHECK( wxString(textUTF16, wxMBConvUTF16LE(), 4) == L"He" );
+
+    wxString s;
+    s = "assigned";
+    CHECK( s == L"assigned" );
+
+    s = static_cast<const char*>(nullptr);
+    CHECK( s.empty() );
+
+    s.assign("assigned", 6);
+    CHECK( s == L"assign" );
+}
+
 
 template<typename T> bool CheckStr(const wxString& expected, T s)
 {
@@ -188,6 +188,50 @@ TEST_CASE("RepeatedPrintf", "[wxString][Printf][vararg]")
     CHECK( s == "buffer hi, len 2" );
 }
 
+TEST_CASE("FormatSpecifiers", "[wxString][Format][vararg]")
+{
+    // The most common specifiers are handled by wxString itself instead of
+    // the CRT, so check that they give the standard results.
+    CHECK( wxString::Format("%d|%5d|%-5d|%05d|%+d|% d", 42, 42, 42, 42, 42, 42)
+            == "42|   42|42   |00042|+42| 42" );
+    CHECK( wxString::Format("%.3d|%.0d|%8.3d|%-6.3d|", 7, 0, -7, 7)
+            == "007||    -007|007   |" );
+    CHECK( wxString::Format("%x|%X|%#x|%#X|%#x", 255, 255, 255, 255, 0)
+            == "ff|FF|0xff|0XFF|0" );
+    CHECK( wxString::Format("%o|%#o|%#o|%#.0o", 8, 8, 0, 0) == "10|010|0|0" );
+    CHECK( wxString::Format("%u|%lu|%llu|%zu", 1u, 2ul, 3ull, size_t(4))
+            == "1|2|3|4" );
+    CHECK( wxString::Format("%d|%u", INT_MIN, UINT_MAX)
+            == "-2147483648|4294967295" );
+    CHECK( wxString::Format("%lld", wxLL(-9223372036854775807) - 1)
+            == "-9223372036854775808" );
+    CHECK( wxString::Format("%*d|%-*d|%.*d|%*d", 4, 1, 4, 2, 3, 3, -3, 4)
+            == "   1|2   |003|4  " );
+
+    CHECK( wxString::Format("%.2f|%8.3f|%-8.1f|%08.2f|%+.1f|%f",
+                            3.14159, 2.5, 2.75, -1.5, 1.0, 0.1)
+            == "3.14|   2.500|2.8     |-0001.50|+1.0|0.100000" );
+    CHECK( wxString::Format("%e|%.2E|%g|%G|%g|%.3g|%g",
+                            12345.678, 0.000123, 0.0001, 1e20,
+                            1234567.0, 3.14159, 100000.0)
+            == "1.234568e+04|1.23E-04|0.0001|1E+20|1.23457e+06|3.14|100000" );
+
+    CHECK( wxString::Format("%s|%5s|%-5s|%.2s|", "abc", "abc", "abc", "abc")
+            == "abc|  abc|abc  |ab|" );
+    CHECK( wxString::Format("%c%c|%3c|%-3c|", 'a', wxUniChar(0xe9), 'x', 'y')
+            == wxString::FromUTF8("a\xc3\xa9|  x|y  |") );
+    CHECK( wxString::Format("100%% %s", "done") == "100% done" );
+
+    // Check that reusing the same buffer for a different format string works.
+    char fmt[16];
+    strcpy(fmt, "%d");
+    CHECK( wxString::Format(fmt, 10) == "10" );
+    strcpy(fmt, "%x");
+    CHECK( wxString::Format(fmt, 10) == "a" );
+    strcpy(fmt, "<%s>");
+    CHECK( wxString::Format(fmt, "ten") == "<ten>" );
+}
+
 TEST_CASE("ArgsValidation", "[wxString][vararg][error]")
 {
     int written;
@@ -235,6 +279,11 @@ TEST_CASE("ArgsValidation", "[wxString][vararg][error]")
     WX_ASSERT_FAILS_WITH_ASSERT( wxString::Format("%s", (void*)&written) );
     WX_ASSERT_FAILS_WITH_ASSERT( wxString::Format("%d", ptr) );
 
+    // errors must be detected even if the format string was already used
+    wxString::Format("%d and %s", 1, "foo");
+    WX_ASSERT_FAILS_WITH_ASSERT( wxString::Format("%d and %s", ptr, "foo") );
+    WX_ASSERT_FAILS_WITH_ASSERT( wxString::Format("%d and %s", 1) );
+
     // we don't check wxNO_PRINTF_PERCENT_N here as these expressions should
     // result in an assert in our code before the CRT functions are even called
     WX_ASSERT_FAILS_WITH_ASSERT( wxString::Format("foo%i%n", &written) );
@@ -16,6 +16,7 @@
 
 #ifndef WX_PRECOMP
     #include "wx/thread.h"
+    #include "wx/utils.h"
 #endif // WX_PRECOMP
 
 #include "wx/msgqueue.h"
@@ -215,3 +216,199 @@ TEST_CASE("wxMessageQueue::NonCopyable", "[msgqueue]")
 
     CHECK( queue.ReceiveTimeout(0, nc2) == wxMSGQUEUE_TIMEOUT );
 }
+
+TEST_CASE("wxBoundedMessageQueue::Overflow", "[msgqueue]")
+{
+    SECTION("Fail")
+    {
+        wxBoundedMessageQueue<int> queue(3, wxMSGQUEUE_OVERFLOW_FAIL);
+        REQUIRE( queue.IsOk() );
+        CHECK( queue.GetCapacity() == 4 );
+
+        for ( int n = 0; n < 4; n++ )
+            CHECK( queue.Post(n) == wxMSGQUEUE_NO_ERROR );
+
+        CHECK( queue.Post(4) == wxMSGQUEUE_FULL );
+        CHECK( queue.GetStats().rejected == 1 );
+
+        int msg = -1;
+        CHECK( queue.Receive(msg) == wxMSGQUEUE_NO_ERROR );
+        CHECK( msg == 0 );
+
+        const std::vector<int> batch{10, 11, 12};
+        CHECK( queue.PostBatch(batch.begin(), batch.end()) == 1 );
+
+        std::vector<int> all;
+        CHECK( queue.ReceiveAll(all) == wxMSGQUEUE_NO_ERROR );
+        CHECK( all == std::vector<int>({1, 2, 3, 10}) );
+
+        CHECK( queue.ReceiveTimeout(0, msg) == wxMSGQUEUE_TIMEOUT );
+        CHECK( queue.ReceiveAllTimeout(10, all) == wxMSGQUEUE_TIMEOUT );
+    }
+
+    SECTION("DropOldest")
+    {
+        wxBoundedMessageQueue<int, wxMSGQUEUE_SPSC>
+            queue(4, wxMSGQUEUE_OVERFLOW_DROP_OLDEST);
+
+        for ( int n = 1; n <= 6; n++ )
+            CHECK( queue.Post(n) == wxMSGQUEUE_NO_ERROR );
+
+        std::vector<int> all;
+        CHECK( queue.ReceiveAll(all) == wxMSGQUEUE_NO_ERROR );
+        CHECK( all == std::vector<int>({3, 4, 5, 6}) );
+        CHECK( queue.GetStats().dropped == 2 );
+    }
+}
+
+TEST_CASE("wxBoundedMessageQueue::NonCopyable", "[msgqueue]")
+{
+    wxBoundedMessageQueue<std::unique_ptr<int>> queue(2);
+
+    CHECK( queue.Post(std::unique_ptr<int>(new int(17))) == wxMSGQUEUE_NO_ERROR );
+    CHECK( queue.Post(std::unique_ptr<int>(new int(18))) == wxMSGQUEUE_NO_ERROR );
+
+    std::unique_ptr<int> msg;
+    CHECK( queue.Receive(msg) == wxMSGQUEUE_NO_ERROR );
+    CHECK( *msg == 17 );
+
+    // The remaining message is destroyed together with the queue.
+}
+
+namespace
+{
+
+typedef wxBoundedMessageQueue<int> BoundedQueue;
+
+// Thread posting the numbers from base to base + count to the queue.
+class BoundedProducer : public wxThread
+{
+public:
+    BoundedProducer(BoundedQueue& queue, int base, int count)
+       : wxThread(wxTHREAD_JOINABLE),
+         m_queue(queue), m_base(base), m_count(count)
+    {}
+
+    virtual void *Entry() override
+    {
+        for ( int n = 0; n < m_count; n++ )
+        {
+            if ( m_queue.Post(m_base + n) != wxMSGQUEUE_NO_ERROR )
+                return (wxThread::ExitCode)wxMSGQUEUE_MISC_ERROR;
+        }
+
+        return (wxThread::ExitCode)wxMSGQUEUE_NO_ERROR;
+    }
+
+private:
+    BoundedQueue& m_queue;
+    const int m_base;
+    const int m_count;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxBoundedMessageQueue::Threads", "[msgqueue]")
+{
+    const int threadCount = 4;
+    const int msgCount = 10000;
+
+    // Use a small queue to ensure that the producers have to wait.
+    BoundedQueue queue(16);
+
+    std::vector<std::unique_ptr<BoundedProducer>> threads;
+    for ( int i = 0; i < threadCount; ++i )
+    {
+        threads.emplace_back(new BoundedProducer(queue, i*msgCount, msgCount));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    // Messages from each producer must be received in order.
+    std::vector<int> next(threadCount);
+    for ( int i = 0; i < threadCount; ++i )
+        next[i] = i*msgCount;
+
+    int received = 0;
+    std::vector<int> msgs;
+    while ( received < threadCount*msgCount )
+    {
+        msgs.clear();
+        REQUIRE( queue.ReceiveAll(msgs) == wxMSGQUEUE_NO_ERROR );
+        REQUIRE( msgs.size() <= queue.GetCapacity() );
+
+        for ( int msg : msgs )
+        {
+            REQUIRE( msg == next[msg / msgCount]++ );
+        }
+
+        received += msgs.size();
+    }
+
+    for ( const auto& thread : threads )
+    {
+        CHECK( thread->Wait() == (wxThread::ExitCode)wxMSGQUEUE_NO_ERROR );
+    }
+
+    CHECK( queue.ReceiveTimeout(0, received) == wxMSGQUEUE_TIMEOUT );
+}
+
+namespace
+{
+
+// Thread filling the queue and posting one more message to it, which blocks
+// until the consumer receives a message, and then acknowledging it.
+class HandshakeProducer : public wxThread
+{
+public:
+    HandshakeProducer(BoundedQueue& queue, BoundedQueue& acks)
+       : wxThread(wxTHREAD_JOINABLE),
+         m_queue(queue), m_acks(acks)
+    {}
+
+    virtual void *Entry() override
+    {
+        for ( size_t n = 0; n <= m_queue.GetCapacity(); n++ )
+        {
+            if ( m_queue.Post(static_cast<int>(n)) != wxMSGQUEUE_NO_ERROR )
+                return (wxThread::ExitCode)wxMSGQUEUE_MISC_ERROR;
+        }
+
+        return (wxThread::ExitCode)m_acks.Post(-1);
+    }
+
+private:
+    BoundedQueue& m_queue;
+    BoundedQueue& m_acks;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxBoundedMessageQueue::WakeUpProducer", "[msgqueue]")
+{
+    BoundedQueue queue(8),
+                 acks(1);
+
+    HandshakeProducer producer(queue, acks);
+    REQUIRE( producer.Run() == wxTHREAD_NO_ERROR );
+
+    // Wait until the producer blocks on the full queue.
+    while ( !queue.GetStats().producerWaits )
+        wxMilliSleep(1);
+
+    // Receiving a single message must allow the producer to continue, even
+    // though the queue is still almost full.
+    int msg = -1;
+    CHECK( queue.Receive(msg) == wxMSGQUEUE_NO_ERROR );
+    CHECK( msg == 0 );
+
+    CHECK( acks.ReceiveTimeout(10000, msg) == wxMSGQUEUE_NO_ERROR );
+    CHECK( msg == -1 );
+
+    // Receive all the remaining messages, which unblocks the producer even if
+    // the check above failed.
+    std::vector<int> all;
+    CHECK( queue.ReceiveAll(all) == wxMSGQUEUE_NO_ERROR );
+    CHECK( all.size() == queue.GetCapacity() );
+
+    CHECK( producer.Wait() == (wxThread::ExitCode)wxMSGQUEUE_NO_ERROR );
+}
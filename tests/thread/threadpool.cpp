@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/threadpool.cpp
+// Purpose:     Unit test for wxThreadPool
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/thread.h"
+#endif // WX_PRECOMP
+
+#include "wx/threadpool.h"
+
+#include <stdexcept>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxThreadPool::Submit", "[threadpool]")
+{
+    wxThreadPool pool(4);
+    CHECK( pool.GetThreadCount() == 4 );
+    CHECK( !pool.IsWorkerThread() );
+
+    std::vector<std::future<int>> results;
+    for ( int n = 0; n < 100; n++ )
+        results.push_back(pool.Submit([n]() { return n*n; }));
+
+    for ( int n = 0; n < 100; n++ )
+        CHECK( results[n].get() == n*n );
+
+    auto inWorker = pool.Submit([&pool]() { return pool.IsWorkerThread(); });
+    CHECK( inWorker.get() );
+
+    auto failed = pool.Submit([]() -> int { throw std::runtime_error("oops"); });
+    CHECK_THROWS_AS( failed.get(), std::runtime_error );
+}
+
+TEST_CASE("wxThreadPool::Post", "[threadpool]")
+{
+    std::atomic<int> count{0};
+
+    {
+        wxThreadPool pool(3);
+
+        // Tasks posting other tasks should be executed too and the pool
+        // destructor must wait for all of them.
+        for ( int n = 0; n < 50; n++ )
+        {
+            pool.Post([&pool, &count]()
+                {
+                    for ( int m = 0; m < 10; m++ )
+                        pool.Post([&count]() { count++; });
+
+                    count++;
+                });
+        }
+    }
+
+    CHECK( count == 550 );
+}
+
+TEST_CASE("wxThreadPool::ParallelFor", "[threadpool]")
+{
+    wxThreadPool pool(4);
+
+    SECTION("All")
+    {
+        const size_t count = 10000;
+        std::vector<std::atomic<int>> calls(count);
+        pool.ParallelFor(0, count, [&calls](size_t n) { calls[n]++; });
+
+        for ( size_t n = 0; n < count; n++ )
+        {
+            INFO("n=" << n);
+            CHECK( calls[n] == 1 );
+        }
+    }
+
+    SECTION("Empty")
+    {
+        pool.ParallelFor(10, 10, [](size_t) { FAIL("unexpected call"); });
+    }
+
+    SECTION("Nested")
+    {
+        std::atomic<size_t> sum{0};
+        pool.ParallelFor(0, 20, [&pool, &sum](size_t n)
+            {
+                pool.ParallelFor(0, 100, [&sum, n](size_t m) { sum += n*m; });
+            });
+
+        // Sum of n*m for n in [0, 20) and m in [0, 100).
+        CHECK( sum == 190*4950 );
+    }
+
+    SECTION("Cancel")
+    {
+        wxCancellationToken cancel;
+        std::atomic<int> calls{0};
+        pool.ParallelFor(0, 100000, [&cancel, &calls](size_t)
+            {
+                if ( ++calls == 100 )
+                    cancel.Cancel();
+            }, cancel);
+
+        CHECK( cancel.IsCancelled() );
+        CHECK( calls < 100000 );
+    }
+
+    SECTION("Exception")
+    {
+        CHECK_THROWS_AS
+        (
+            pool.ParallelFor(0, 1000, [](size_t n)
+                {
+                    if ( n == 500 )
+                        throw std::runtime_error("oops");
+                }),
+            std::runtime_error
+        );
+    }
+}
+
+TEST_CASE("wxThreadPool::Get", "[threadpool]")
+{
+    // The global pool is created on demand and reused after this, it will be
+    // destroyed during the library cleanup.
+    wxThreadPool& pool = wxThreadPool::Get();
+    CHECK( &wxThreadPool::Get() == &pool );
+    CHECK( pool.GetThreadCount() > 0 );
+    CHECK( !pool.IsWorkerThread() );
+
+    auto inWorker = pool.Submit([]() { return wxThreadPool::Get().IsWorkerThread(); });
+    CHECK( inWorker.get() );
+
+    std::atomic<int> count{0};
+    pool.ParallelFor(0, 100, [&count](size_t) { count++; });
+    CHECK( count == 100 );
+}
+
+TEST_CASE("wxThreadPool::NoThreads", "[threadpool]")
+{
+    // Without any worker threads, everything is done in the calling thread.
+    wxThreadPool pool(0);
+    CHECK( pool.GetThreadCount() == 0 );
+
+    int count = 0;
+    pool.Post([&count]() { count++; });
+    CHECK( count == 1 );
+
+    CHECK( pool.Submit([]() { return 17; }).get() == 17 );
+
+    pool.ParallelFor(0, 100, [&count](size_t) { count++; });
+    CHECK( count == 101 );
+}
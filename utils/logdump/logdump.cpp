@@ -0,0 +1,268 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        logdump.cpp
+// Purpose:     Decode and filter binary log files written by wxLogBinary
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+// For compilers that support precompilation, includes "wx/wx.h".
+#include "wx/wxprec.h"
+
+
+// for all others, include the necessary headers
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+    #include "wx/crt.h"
+    #include "wx/log.h"
+#endif
+
+#include "wx/cmdline.h"
+#include "wx/datetime.h"
+#include "wx/logbinary.h"
+
+// ----------------------------------------------------------------------------
+// command line
+// ----------------------------------------------------------------------------
+
+#define LEVEL_OPTION                "l"
+#define COMPONENT_OPTION            "c"
+#define THREAD_OPTION               "t"
+#define SEARCH_OPTION               "s"
+
+#define LOCATION_SWITCH             "L"
+#define UTC_SWITCH                  "u"
+#define HELP_SWITCH                 "h"
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] =
+{
+    { wxCMD_LINE_OPTION, LEVEL_OPTION, "level",
+        "show only the records of this level or more important ones "
+        "(error, warning, message, status, info, debug, trace or a number)",
+        wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR },
+    { wxCMD_LINE_OPTION, COMPONENT_OPTION, "component",
+        "show only the records of this component or its sub-components",
+        wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR },
+    { wxCMD_LINE_OPTION, THREAD_OPTION, "thread",
+        "show only the records logged by the thread with this id",
+        wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR },
+    { wxCMD_LINE_OPTION, SEARCH_OPTION, "search",
+        "show only the records with messages containing this string",
+        wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR },
+    { wxCMD_LINE_SWITCH, LOCATION_SWITCH, "location",
+        "show the source file, line and function of each record",
+        wxCMD_LINE_VAL_NONE, 0 },
+    { wxCMD_LINE_SWITCH, UTC_SWITCH, "utc",
+        "show the time stamps in UTC instead of local time",
+        wxCMD_LINE_VAL_NONE, 0 },
+    { wxCMD_LINE_SWITCH, HELP_SWITCH, "help",
+        "show help message", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_PARAM,  nullptr, nullptr,
+        "log file", wxCMD_LINE_VAL_STRING,
+        wxCMD_LINE_OPTION_MANDATORY | wxCMD_LINE_PARAM_MULTIPLE },
+    wxCMD_LINE_DESC_END
+};
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+static const struct LevelName
+{
+    wxLogLevel level;
+    const char* name;
+} g_levelNames[] =
+{
+    { wxLOG_FatalError, "fatal"     },
+    { wxLOG_Error,      "error"     },
+    { wxLOG_Warning,    "warning"   },
+    { wxLOG_Message,    "message"   },
+    { wxLOG_Status,     "status"    },
+    { wxLOG_Info,       "info"      },
+    { wxLOG_Debug,      "debug"     },
+    { wxLOG_Trace,      "trace"     },
+};
+
+static wxString GetLevelName(wxLogLevel level)
+{
+    for ( const auto& levelName : g_levelNames )
+    {
+        if ( levelName.level == level )
+            return levelName.name;
+    }
+
+    return wxString::Format("level %lu", level);
+}
+
+static bool ParseLevel(const wxString& str, wxLogLevel& level)
+{
+    for ( const auto& levelName : g_levelNames )
+    {
+        if ( str.IsSameAs(levelName.name, false) )
+        {
+            level = levelName.level;
+            return true;
+        }
+    }
+
+    unsigned long num;
+    if ( !str.ToULong(&num) )
+        return false;
+
+    level = num;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// LogDumpApp
+// ----------------------------------------------------------------------------
+
+class LogDumpApp : public wxAppConsole
+{
+public:
+    // don't use built-in cmd line parsing:
+    virtual bool OnInit() override { return true; }
+    virtual int OnRun() override;
+
+private:
+    // Return true if the record passes all the filters.
+    bool Matches(const wxLogBinaryRecord& record) const;
+
+    void Dump(const wxLogBinaryRecord& record) const;
+
+    wxLogLevel m_maxLevel = wxLOG_Max;
+    wxString m_component;
+    wxULongLong_t m_threadId = 0;
+    bool m_filterThread = false;
+    wxString m_search;
+
+    bool m_showLocation = false;
+    wxDateTime::TimeZone m_tz = wxDateTime::Local;
+};
+
+wxIMPLEMENT_APP_CONSOLE(LogDumpApp);
+
+int LogDumpApp::OnRun()
+{
+    wxCmdLineParser parser(g_cmdLineDesc, argc, argv);
+    parser.SetLogo(
+        wxString::Format("wxWidgets binary log files decoder (built against %s)",
+                         wxVERSION_STRING));
+
+    switch ( parser.Parse() )
+    {
+        case -1:
+            // help was shown
+            return 0;
+
+        case 0:
+            break;
+
+        default:
+            return 1;
+    }
+
+    wxString str;
+    if ( parser.Found(LEVEL_OPTION, &str) && !ParseLevel(str, m_maxLevel) )
+    {
+        wxLogError("Invalid log level \"%s\".", str);
+        return 1;
+    }
+
+    parser.Found(COMPONENT_OPTION, &m_component);
+
+    if ( parser.Found(THREAD_OPTION, &str) )
+    {
+        if ( !str.ToULongLong(&m_threadId, 0) )
+        {
+            wxLogError("Invalid thread id \"%s\".", str);
+            return 1;
+        }
+
+        m_filterThread = true;
+    }
+
+    parser.Found(SEARCH_OPTION, &m_search);
+
+    m_showLocation = parser.Found(LOCATION_SWITCH);
+    if ( parser.Found(UTC_SWITCH) )
+        m_tz = wxDateTime::UTC;
+
+    int rc = 0;
+    for ( size_t n = 0; n < parser.GetParamCount(); n++ )
+    {
+        const wxString& filename = parser.GetParam(n);
+
+        wxLogBinaryReader reader;
+        if ( !reader.Open(filename) )
+        {
+            rc = 1;
+            continue;
+        }
+
+        wxLogBinaryRecord record;
+        while ( reader.GetNext(record) )
+        {
+            if ( Matches(record) )
+                Dump(record);
+        }
+
+        if ( reader.HasError() )
+        {
+            wxLogWarning("File \"%s\" is truncated or corrupted.", filename);
+            rc = 1;
+        }
+    }
+
+    return rc;
+}
+
+bool LogDumpApp::Matches(const wxLogBinaryRecord& record) const
+{
+    if ( record.level > m_maxLevel )
+        return false;
+
+    if ( m_filterThread && record.threadId != m_threadId )
+        return false;
+
+    if ( !m_component.empty() )
+    {
+        if ( !record.component.StartsWith(m_component) )
+            return false;
+
+        if ( record.component.length() != m_component.length() &&
+                record.component[m_component.length()] != '/' )
+            return false;
+    }
+
+    if ( !m_search.empty() && record.msg.find(m_search) == wxString::npos )
+        return false;
+
+    return true;
+}
+
+void LogDumpApp::Dump(const wxLogBinaryRecord& record) const
+{
+    const wxDateTime dt(wxLongLong(record.timestampMS));
+
+    wxString line;
+    line << dt.Format("%Y-%m-%d %H:%M:%S.%l", m_tz)
+         << wxString::Format(" [%" wxLongLongFmtSpec "x] ", record.threadId)
+         << GetLevelName(record.level);
+
+    if ( !record.component.empty() )
+        line << " (" << record.component << ")";
+
+    if ( m_showLocation && !record.filename.empty() )
+    {
+        line << " " << record.filename << "(" << record.line << ")";
+        if ( !record.func.empty() )
+            line << " in " << record.func << "()";
+    }
+
+    line << ": " << record.msg;
+
+    wxPuts(line);
+}